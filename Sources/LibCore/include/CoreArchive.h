@@ -0,0 +1,432 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+#include <LibCore/include/CoreByteBuffer.h>
+#include <LibCore/include/CoreFile.h>
+
+namespace Core
+{
+    //----------------------------------------------------------------------------
+    /// \brief Portable serializer of archive section: fixed little-endian layout and varint sizes.
+    /// Unlike ByteBuffer (native memory copy), data can be read on any build/platform.
+    /// \code{ .cpp }
+    ///     Core::ArchiveStream stream;
+    ///     stream << uint32_t(12) << Core::String("glyph") << std::vector<float>{ 1.0f, 2.0f };
+    /// \endcode
+    /// \see ArchiveWriter, ArchiveReader
+    class ArchiveStream
+    {
+        MOUCA_NOCOPY_DEFAULTMOVE(ArchiveStream);
+
+        public:
+            /// Constructor
+            ArchiveStream() = default;
+            /// Destructor
+            ~ArchiveStream() = default;
+
+            //------------------------------------------------------------------------
+            /// \brief  Prepare memory for next writing.
+            ///
+            /// \param[in] sizeInByte: total size of stream expected.
+            void reserve(const size_t sizeInByte)
+            {
+                _buffer.reserve(sizeInByte);
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Return how many bytes are written into stream.
+            ///
+            /// \returns Size in bytes.
+            size_t size() const
+            {
+                return _buffer.size();
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Check all data has been read.
+            ///
+            /// \returns True if nothing remains to read.
+            bool isEnd() const
+            {
+                return _buffer.getReadPosition() == _buffer.size();
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Write unsigned integer with 7 bits per byte (LEB128).
+            ///
+            /// \param[in] value: data to save.
+            void writeVarint(uint64_t value);
+
+            //------------------------------------------------------------------------
+            /// \brief  Read unsigned integer written by writeVarint().
+            ///
+            /// \returns Read value.
+            /// \throw Core::Exception if stream is corrupted.
+            uint64_t readVarint();
+
+            //------------------------------------------------------------------------
+            /// \brief Writer of arithmetic or enum value in little-endian.
+            ///
+            /// \param[in] data: data to save.
+            /// \returns Stream.
+            template<typename DataType>
+            ArchiveStream& operator<<(const DataType& data)
+            {
+                if constexpr (std::is_enum_v<DataType>)
+                {
+                    return *this << static_cast<std::underlying_type_t<DataType>>(data);
+                }
+                else
+                {
+                    static_assert(std::is_arithmetic_v<DataType>, "Archive needs arithmetic, enum, string or vector");
+                    if constexpr (std::endian::native == std::endian::little)
+                    {
+                        _buffer.append(&data, sizeof(DataType));
+                    }
+                    else
+                    {
+                        std::array<uint8_t, sizeof(DataType)> bytes;
+                        memcpy(bytes.data(), &data, sizeof(DataType));
+                        std::reverse(bytes.begin(), bytes.end());
+                        _buffer.append(bytes.data(), bytes.size());
+                    }
+                    return *this;
+                }
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief Writer of string (varint size + UTF-8 bytes).
+            ///
+            /// \param[in] data: data to save.
+            /// \returns Stream.
+            ArchiveStream& operator<<(const Core::String& data)
+            {
+                writeVarint(data.size());
+                _buffer.append(data.data(), data.size());
+                return *this;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief Writer of std::vector (varint count + elements). Contained type MUST be savable using <<.
+            ///
+            /// \param[in] data: data to save.
+            /// \returns Stream.
+            template<typename DataType>
+            ArchiveStream& operator<<(const std::vector<DataType>& data)
+            {
+                writeVarint(data.size());
+                if constexpr (isBulk<DataType>)
+                {
+                    _buffer.append(data.data(), data.size() * sizeof(DataType));
+                }
+                else
+                {
+                    for (const auto& element : data)
+                        *this << element;
+                }
+                return *this;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief Reader of arithmetic or enum value in little-endian.
+            ///
+            /// \param[out] data: read data.
+            /// \returns Stream.
+            /// \throw Core::Exception if stream is corrupted.
+            template<typename DataType>
+            ArchiveStream& operator>>(DataType& data)
+            {
+                if constexpr (std::is_enum_v<DataType>)
+                {
+                    std::underlying_type_t<DataType> value;
+                    *this >> value;
+                    data = static_cast<DataType>(value);
+                }
+                else
+                {
+                    static_assert(std::is_arithmetic_v<DataType>, "Archive needs arithmetic, enum, string or vector");
+                    checkReading(sizeof(DataType));
+                    _buffer.extract(&data, sizeof(DataType));
+                    if constexpr (std::endian::native != std::endian::little)
+                    {
+                        auto* bytes = reinterpret_cast<uint8_t*>(&data);
+                        std::reverse(bytes, bytes + sizeof(DataType));
+                    }
+                }
+                return *this;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief Reader of string.
+            ///
+            /// \param[out] data: read data.
+            /// \returns Stream.
+            /// \throw Core::Exception if stream is corrupted.
+            ArchiveStream& operator>>(Core::String& data)
+            {
+                const size_t size = readSize(1);
+                data.resize(size);
+                _buffer.extract(data.data(), size);
+                return *this;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief Reader of std::vector.
+            ///
+            /// \param[out] data: read data.
+            /// \returns Stream.
+            /// \throw Core::Exception if stream is corrupted.
+            template<typename DataType>
+            ArchiveStream& operator>>(std::vector<DataType>& data)
+            {
+                if constexpr (isBulk<DataType>)
+                {
+                    data.resize(readSize(sizeof(DataType)));
+                    _buffer.extract(data.data(), data.size() * sizeof(DataType));
+                }
+                else
+                {
+                    // Each element needs one byte at least: avoid huge allocation on corrupted size
+                    data.resize(readSize(1));
+                    for (auto& element : data)
+                        *this >> element;
+                }
+                return *this;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Access to memory of stream.
+            ///
+            /// \returns Internal buffer.
+            const ByteBuffer& getBuffer() const
+            {
+                return _buffer;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Replace content of stream by memory and allow to read.
+            ///
+            /// \param[in] data: memory to copy.
+            /// \param[in] sizeInByte: size of memory.
+            void readBuffer(const void* data, const size_t sizeInByte)
+            {
+                _buffer.readBuffer(data, sizeInByte);
+            }
+
+        private:
+            /// Vector elements can be copied in one block (same memory as little-endian layout).
+            template<typename DataType>
+            static constexpr bool isBulk = std::is_arithmetic_v<DataType> && !std::is_same_v<DataType, bool>
+                                        && std::endian::native == std::endian::little;
+
+            //------------------------------------------------------------------------
+            /// \brief  Check next reading stays into stream.
+            ///
+            /// \param[in] sizeInByte: size to read.
+            /// \throw Core::Exception if stream is too small.
+            void checkReading(const size_t sizeInByte) const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Read varint size of elements and check it stays into stream.
+            ///
+            /// \param[in] elementSize: minimal size in bytes of one element.
+            /// \returns Number of elements.
+            /// \throw Core::Exception if stream is too small.
+            size_t readSize(const size_t elementSize);
+
+            ByteBuffer _buffer;     ///< Memory of stream.
+    };
+
+    //----------------------------------------------------------------------------
+    /// \brief Common definitions of archive file.
+    /// Layout (all little-endian):
+    ///     - header: magic "MCAR" + uint32 format version.
+    ///     - section data (optionally compressed) one after another.
+    ///     - table: varint count, then per section: name, varint version, uint8 compression,
+    ///       varint offset, varint stored size, varint raw size, uint32 checksum.
+    ///     - footer: uint64 table offset, uint32 table size, magic "MCAR".
+    /// Table is at the end so writer streams data and reader finds any section with two reads.
+    struct Archive
+    {
+        /// Compression of section data.
+        enum class Compression : uint8_t
+        {
+            None,
+            LZ4     ///< LZ4 block format: fast to decode.
+        };
+
+        static constexpr uint32_t formatVersion = 1;            ///< Version of archive layout (not of sections).
+        static constexpr size_t   headerSize    = 8;            ///< Size of header.
+        static constexpr size_t   footerSize    = 16;           ///< Size of footer.
+
+        //------------------------------------------------------------------------
+        /// \brief  Compress memory with LZ4 block format.
+        ///
+        /// \param[in] data: memory to compress.
+        /// \param[in] sizeInByte: size of memory.
+        /// \returns Compressed block.
+        static std::vector<uint8_t> compressLZ4(const uint8_t* data, const size_t sizeInByte);
+
+        //------------------------------------------------------------------------
+        /// \brief  Decompress LZ4 block.
+        ///
+        /// \param[in] data: compressed block.
+        /// \param[in] sizeInByte: size of compressed block.
+        /// \param[out] output: memory of raw size to fill.
+        /// \param[in] outputSize: raw size.
+        /// \throw Core::Exception if block is corrupted.
+        static void decompressLZ4(const uint8_t* data, const size_t sizeInByte, uint8_t* output, const size_t outputSize);
+    };
+
+    //----------------------------------------------------------------------------
+    /// \brief Build archive made of named and versioned sections.
+    /// \code{ .cpp }
+    ///     Core::ArchiveStream glyphs;
+    ///     glyphs << outlines;
+    ///     Core::ArchiveWriter writer;
+    ///     writer.addSection("glyphs", 2, glyphs, Core::Archive::Compression::LZ4);
+    ///     writer.save(cacheFolder / "font.mcar");
+    /// \endcode
+    class ArchiveWriter final
+    {
+        MOUCA_NOCOPY_NOMOVE(ArchiveWriter);
+
+        public:
+            /// Constructor
+            ArchiveWriter() = default;
+            /// Destructor
+            ~ArchiveWriter() = default;
+
+            //------------------------------------------------------------------------
+            /// \brief  Add section (data are copied/compressed immediately).
+            ///
+            /// \param[in] name: unique name of section.
+            /// \param[in] version: version of data type (reader chooses how to read it).
+            /// \param[in] content: data of section.
+            /// \param[in] compression: compression of data (stored raw if compression is useless).
+            void addSection(const String& name, const uint32_t version, const ArchiveStream& content, const Archive::Compression compression = Archive::Compression::None);
+
+            //------------------------------------------------------------------------
+            /// \brief  Build whole archive into memory.
+            ///
+            /// \param[out] output: archive (cleared before).
+            void write(ByteBuffer& output) const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Write archive on disk.
+            ///
+            /// \param[in] filename: path of archive.
+            /// \throw Core::Exception if file can't be written.
+            void save(const Path& filename) const;
+
+        private:
+            struct Section
+            {
+                String                  _name;          ///< Unique name.
+                uint32_t                _version;       ///< Version of data type.
+                Archive::Compression    _compression;   ///< Compression of _data.
+                uint64_t                _rawSize;       ///< Size of uncompressed data.
+                std::vector<uint8_t>    _data;          ///< Stored data.
+            };
+            std::vector<Section> _sections;     ///< All sections in writing order.
+    };
+
+    //----------------------------------------------------------------------------
+    /// \brief Read sections of archive on demand.
+    /// Only header and table are read at opening: each section is read/decompressed when requested.
+    /// Memory can be provided by caller (mapped file) to avoid any file reading.
+    class ArchiveReader final
+    {
+        MOUCA_NOCOPY_NOMOVE(ArchiveReader);
+
+        public:
+            /// Constructor
+            ArchiveReader() = default;
+            /// Destructor
+            ~ArchiveReader();
+
+            //------------------------------------------------------------------------
+            /// \brief  Open archive from memory.
+            ///
+            /// \param[in] data: archive memory: MUST stay valid until close().
+            /// \param[in] sizeInByte: size of archive.
+            /// \throw Core::Exception if archive is corrupted.
+            void open(const void* data, const size_t sizeInByte);
+
+            //------------------------------------------------------------------------
+            /// \brief  Open archive file (read table only).
+            ///
+            /// \param[in] filename: path of archive.
+            /// \throw Core::Exception if file can't be read or archive is corrupted.
+            void open(const Path& filename);
+
+            //------------------------------------------------------------------------
+            /// \brief  Close archive.
+            void close();
+
+            bool isNull() const
+            {
+                return _memory == nullptr && !_file.isLoaded();
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Check if section exists.
+            ///
+            /// \param[in] name: name of section.
+            /// \returns True if archive contains section.
+            bool hasSection(const String& name) const
+            {
+                return _sections.find(name) != _sections.cend();
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get version of data type of section.
+            ///
+            /// \param[in] name: name of section (MUST exist).
+            /// \returns Version given to ArchiveWriter::addSection().
+            uint32_t getVersion(const String& name) const
+            {
+                MouCa::preCondition(hasSection(name));
+                return _sections.at(name)._version;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get all section names.
+            ///
+            /// \returns Names sorted alphabetically.
+            std::vector<String> getSectionNames() const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Read, check and decompress section.
+            ///
+            /// \param[in] name: name of section (MUST exist).
+            /// \param[out] content: data of section ready to read.
+            /// \throw Core::Exception if section is corrupted.
+            void readSection(const String& name, ArchiveStream& content) const;
+
+        private:
+            struct Section
+            {
+                uint32_t                _version;       ///< Version of data type.
+                Archive::Compression    _compression;   ///< Compression of data.
+                uint64_t                _offset;        ///< Position of data into archive.
+                uint64_t                _storedSize;    ///< Size of data into archive.
+                uint64_t                _rawSize;       ///< Size of uncompressed data.
+                uint32_t                _checksum;      ///< FNV-1a of stored data.
+            };
+
+            //------------------------------------------------------------------------
+            /// \brief  Read bytes from memory or file.
+            void read(const uint64_t offset, void* data, const size_t sizeInByte) const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Read footer and table.
+            void readTable(const uint64_t archiveSize);
+
+            std::map<String, Section>   _sections;              ///< All sections by name.
+            const uint8_t*              _memory = nullptr;      ///< [LINK] Archive memory (when open from memory).
+            File                        _file;                  ///< Archive file (when open from file).
+    };
+}
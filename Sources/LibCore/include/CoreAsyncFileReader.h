@@ -0,0 +1,104 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+#include <LibCore/include/CoreThread.h>
+
+namespace Core
+{
+    //----------------------------------------------------------------------------
+    /// \brief Read batches of file ranges on dedicated I/O threads.
+    /// Loading jobs submit next reads then decode previous data: I/O and decoding overlap.
+    /// Each batch opens file once and reads ranges sorted by offset with positional reads (no shared seek).
+    /// \code{ .cpp }
+    ///     Core::AsyncFileReader::Batch batch = { { offset, size, memory } };
+    ///     auto pending = reader.read(path, std::move(batch));
+    ///     // ... decode previous data ...
+    ///     batch = pending.get(); // Rethrow reading error
+    /// \endcode
+    /// \see MappedFile
+    class AsyncFileReader final
+    {
+        MOUCA_NOCOPY_NOMOVE(AsyncFileReader);
+
+        public:
+            /// Range of file to read.
+            struct Request
+            {
+                uint64_t _offset;       ///< Position into file.
+                size_t   _size;         ///< Size to read.
+                void*    _output;       ///< Memory to fill (size of _size at least).
+                size_t   _read = 0;     ///< [OUT] Really read bytes (less than _size at end of file).
+            };
+            using Batch = std::vector<Request>;
+
+            /// Constructor
+            AsyncFileReader() = default;
+            /// Destructor
+            ~AsyncFileReader()
+            {
+                MouCa::preCondition(isNull()); //DEV Issue: call release() before.
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Launch I/O threads.
+            ///
+            /// \param[in] nbThreads: number of concurrent batches.
+            void initialize(const uint32_t nbThreads = 2);
+
+            //------------------------------------------------------------------------
+            /// \brief  Finish all pending batches and stop threads.
+            void release();
+
+            bool isNull() const
+            {
+                return _workers.empty();
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Submit batch of reads.
+            ///
+            /// \param[in] filename: file to read.
+            /// \param[in] batch: ranges to read.
+            /// \returns Future of batch with read size filled (rethrows Core::Exception when file can't be read).
+            std::future<Batch> read(const Path& filename, Batch&& batch);
+
+            //------------------------------------------------------------------------
+            /// \brief  Read batch on current thread (used by I/O threads).
+            ///
+            /// \param[in] filename: file to read.
+            /// \param[in,out] batch: ranges to read.
+            /// \throw Core::Exception if file can't be read.
+            static void readNow(const Path& filename, Batch& batch);
+
+        private:
+            struct Job
+            {
+                Path                _filename;  ///< File to read.
+                Batch               _batch;     ///< Ranges to read.
+                std::promise<Batch> _promise;   ///< Result of job.
+            };
+
+            class Worker final : public Thread
+            {
+                public:
+                    explicit Worker(AsyncFileReader& reader):
+                    _reader(reader)
+                    {}
+
+                    ~Worker() override = default;
+
+                private:
+                    void run() override;
+
+                    AsyncFileReader& _reader;   ///< [LINK] Owner of jobs.
+            };
+
+            std::vector<std::unique_ptr<Worker>>  _workers;        ///< I/O threads.
+            std::deque<Job>                       _jobs;           ///< Pending jobs.
+            std::mutex                            _jobMutex;       ///< Protect _jobs and _run.
+            std::condition_variable               _waitJob;        ///< Wake up workers.
+            bool                                  _run = false;    ///< Workers loop until false.
+    };
+}
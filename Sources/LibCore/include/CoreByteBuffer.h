@@ -22,9 +22,18 @@ namespace Core
     ///     buf.write(file);
     ///     file.close();
     /// \endcode
+    /// Vectors and spans of trivially copyable types are copied with one memcpy (count + raw memory).
+    /// For big flows, reserve() or use a Writer to avoid repeated reallocation.
     class ByteBuffer
     {
         public:
+            //------------------------------------------------------------------------
+            /// \brief Type can be copied as raw memory (vector<bool> has no contiguous memory).
+            template<typename DataType>
+            static constexpr bool isRaw = std::is_trivially_copyable_v<DataType> && !std::is_same_v<DataType, bool>;
+
+            class Writer;
+
             /// Constructor
             ByteBuffer() = default;
             /// Destructor
@@ -39,6 +48,58 @@ namespace Core
                 return _buffer.size();
             }
 
+            //------------------------------------------------------------------------
+            /// \brief  Return how many bytes can be written without reallocation.
+            /// 
+            /// \returns Capacity in bytes.
+            size_t capacity() const
+            {
+                return _buffer.capacity();
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Return position of next reading.
+            /// 
+            /// \returns Read position in bytes.
+            size_t getReadPosition() const
+            {
+                return _readPointer;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Prepare memory for next writing.
+            /// 
+            /// \param[in] sizeInByte: total size of buffer expected.
+            void reserve(const size_t sizeInByte)
+            {
+                _buffer.reserve(sizeInByte);
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Copy raw memory at end of buffer.
+            /// 
+            /// \param[in] data: memory to copy.
+            /// \param[in] sizeInByte: size of memory.
+            void append(const void* data, const size_t sizeInByte)
+            {
+                const size_t position = _buffer.size();
+                _buffer.resize(position + sizeInByte);
+                memcpy(_buffer.data() + position, data, sizeInByte);
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Copy raw memory from current read position.
+            /// 
+            /// \param[out] data: memory to fill.
+            /// \param[in] sizeInByte: size of memory.
+            void extract(void* data, const size_t sizeInByte)
+            {
+                MouCa::assertion(_readPointer + sizeInByte <= _buffer.size());
+
+                memcpy(data, _buffer.data() + _readPointer, sizeInByte);
+                _readPointer += sizeInByte;
+            }
+
             //------------------------------------------------------------------------
             /// \brief  Clean, copy buffer to byteBuffer and allow to read.
             /// 
@@ -69,8 +130,7 @@ namespace Core
             template<typename DataType>
             ByteBuffer& operator<<(const DataType& data)
             {
-                const MemoryByte* dataA = reinterpret_cast<const MemoryByte*>(&data);
-                _buffer.insert(_buffer.end(), dataA, &dataA[sizeof(data)]);
+                append(&data, sizeof(data));
                 return *this;
             }
 
@@ -82,7 +142,7 @@ namespace Core
             template<>
             ByteBuffer& operator<<(const ByteBuffer& data)
             {
-                _buffer.insert(_buffer.end(), data._buffer.data(), &data._buffer.data()[data._buffer.size()]);
+                append(data._buffer.data(), data._buffer.size());
                 return *this;
             }
 
@@ -95,7 +155,7 @@ namespace Core
             ByteBuffer& operator<<(const Core::String& data)
             {
                 *this << data.size();
-                _buffer.insert(_buffer.end(), data.data(), &data.data()[data.size()]);
+                append(data.data(), data.size());
                 return *this;
             }
 
@@ -107,9 +167,32 @@ namespace Core
             template<typename DataType>
             ByteBuffer& operator<<(const std::vector<DataType>& data)
             {
+                if constexpr (isRaw<DataType>)
+                {
+                    *this << std::span<const DataType>(data);
+                }
+                else
+                {
+                    *this << data.size();
+                    for (const auto& element : data)
+                        *this << element;
+                }
+                return *this;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief Writer of contiguous raw elements (same format as std::vector).
+            /// Any span (const or not, fixed extent or not) is written by elements: never as raw span object.
+            /// 
+            /// \param[in] data: data to save.
+            /// \returns New buffer with element.
+            template<typename DataType, size_t Extent>
+            ByteBuffer& operator<<(const std::span<DataType, Extent> data)
+            {
+                static_assert(isRaw<std::remove_cv_t<DataType>>, "Span needs trivially copyable type");
+                _buffer.reserve(_buffer.size() + sizeof(size_t) + data.size_bytes());
                 *this << data.size();
-                for (const auto& element : data)
-                    *this << element;
+                append(data.data(), data.size_bytes());
                 return *this;
             }
 
@@ -121,10 +204,7 @@ namespace Core
             template<typename DataType>
             ByteBuffer& operator>>(DataType& data)
             {
-                MouCa::assertion(_readPointer + sizeof(DataType) <= _buffer.size());
-
-                memcpy(&data, reinterpret_cast<const MemoryByte*>(&_buffer[_readPointer]), sizeof(DataType));
-                _readPointer += sizeof(DataType);
+                extract(&data, sizeof(DataType));
                 return *this;
             }           
 
@@ -139,10 +219,8 @@ namespace Core
                 size_t sizeS = 0;
                 *this >> sizeS;
 
-                MouCa::assertion(_readPointer + sizeS * sizeof(char) <= _buffer.size());
                 data.resize(sizeS);
-                memcpy(data.data(), reinterpret_cast<const MemoryByte*>(&_buffer[_readPointer]), sizeS);
-                _readPointer += sizeS;
+                extract(data.data(), sizeS);
                 return *this;
             }
 
@@ -171,8 +249,31 @@ namespace Core
                 // Allocate
                 data.resize(size);
                 // Fill
-                for(auto& element : data)
-                    *this >> element;
+                if constexpr (isRaw<DataType>)
+                {
+                    extract(data.data(), size * sizeof(DataType));
+                }
+                else
+                {
+                    for(auto& element : data)
+                        *this >> element;
+                }
+                return *this;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief Reader of contiguous raw elements into existing memory.
+            /// 
+            /// \param[out] data: memory to fill: MUST have size of written elements.
+            /// \returns New buffer with jump to next element.
+            template<typename DataType, size_t Extent>
+            ByteBuffer& operator>>(const std::span<DataType, Extent> data)
+            {
+                static_assert(isRaw<DataType>, "Span needs trivially copyable type");
+                size_t size = 0;
+                *this >> size;
+                MouCa::assertion(size == data.size()); //DEV Issue: Bad memory size.
+                extract(data.data(), data.size_bytes());
                 return *this;
             }
 
@@ -230,6 +331,8 @@ namespace Core
             }
 
         private:
+            friend class Writer;
+
             using MemoryByte = unsigned char;
             using MemoryArray = std::vector<MemoryByte>;
 
@@ -237,5 +340,117 @@ namespace Core
             std::size_t _readPointer = 0;       ///< Pointer where we are into buffer.
     };
 
+    //----------------------------------------------------------------------------
+    /// \brief Cursor writing at end of ByteBuffer without reallocation per element.
+    /// Memory is allocated once with size hint (then grows by doubling) and buffer is
+    /// truncated to written data when writer is destroyed.
+    /// \code{ .cpp }
+    ///     Core::ByteBuffer buf;
+    ///     {
+    ///         Core::ByteBuffer::Writer writer(buf, vertices.size() * sizeof(Vertex) + 64);
+    ///         writer << header << vertices;
+    ///     }
+    /// \endcode
+    class ByteBuffer::Writer final
+    {
+        MOUCA_NOCOPY_NOMOVE(Writer);
+
+        public:
+            //------------------------------------------------------------------------
+            /// \brief  Constructor: prepare memory.
+            /// 
+            /// \param[in,out] buffer: buffer where data are appended.
+            /// \param[in] sizeHint: bytes expected to be written.
+            Writer(ByteBuffer& buffer, const size_t sizeHint):
+            _buffer(buffer._buffer), _cursor(buffer._buffer.size())
+            {
+                _buffer.resize(_cursor + sizeHint);
+            }
+
+            /// Destructor: remove unused memory.
+            ~Writer()
+            {
+                _buffer.resize(_cursor);
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Copy raw memory at cursor.
+            /// 
+            /// \param[in] data: memory to copy.
+            /// \param[in] sizeInByte: size of memory.
+            void append(const void* data, const size_t sizeInByte)
+            {
+                if (_cursor + sizeInByte > _buffer.size())
+                {
+                    _buffer.resize(std::max(_buffer.size() * 2, _cursor + sizeInByte));
+                }
+                memcpy(_buffer.data() + _cursor, data, sizeInByte);
+                _cursor += sizeInByte;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief Writer of raw data (trivially copyable).
+            /// 
+            /// \param[in] data: data to save.
+            /// \returns Writer.
+            template<typename DataType>
+            Writer& operator<<(const DataType& data)
+            {
+                static_assert(isRaw<DataType>, "Writer needs trivially copyable type");
+                append(&data, sizeof(data));
+                return *this;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief Writer of Core::String (same format as ByteBuffer).
+            /// 
+            /// \param[in] data: data to save.
+            /// \returns Writer.
+            Writer& operator<<(const Core::String& data)
+            {
+                *this << data.size();
+                append(data.data(), data.size());
+                return *this;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief Writer of contiguous raw elements (same format as ByteBuffer).
+            /// 
+            /// \param[in] data: data to save.
+            /// \returns Writer.
+            template<typename DataType, size_t Extent>
+            Writer& operator<<(const std::span<DataType, Extent> data)
+            {
+                static_assert(isRaw<std::remove_cv_t<DataType>>, "Writer needs trivially copyable type");
+                *this << data.size();
+                append(data.data(), data.size_bytes());
+                return *this;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief Writer of std::vector of raw elements (same format as ByteBuffer).
+            /// 
+            /// \param[in] data: data to save.
+            /// \returns Writer.
+            template<typename DataType>
+            Writer& operator<<(const std::vector<DataType>& data)
+            {
+                return *this << std::span<const DataType>(data);
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get number of bytes into buffer (without unused memory).
+            /// 
+            /// \returns Position of cursor.
+            size_t getCursor() const
+            {
+                return _cursor;
+            }
+
+        private:
+            ByteBuffer::MemoryArray& _buffer;  ///< [LINK] Memory of buffer.
+            size_t                   _cursor;  ///< Position of next writing.
+    };
+
 }
 
@@ -0,0 +1,134 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+namespace Core
+{
+    //----------------------------------------------------------------------------
+    /// \brief Type-erased callable with small buffer (like std::function without heap for small callables).
+    /// Callable is stored into internal buffer when it fits (instance + pointer to member, weak_ptr + pointer to member, ...),
+    /// otherwise it is allocated.
+    /// \code{.cpp}
+    ///     Core::Callable<int> callable([&](int value) { receiver.doSomething(value); });
+    ///     callable(42);
+    /// \endcode
+    /// \see Signal, SignalQueue
+    template <typename... Args>
+    class Callable
+    {
+        public:
+            /// Size of internal buffer.
+            static constexpr size_t _bufferSize = 6 * sizeof(void*);
+
+            template <typename Function>
+            explicit Callable(Function&& function):
+            _invoke(&invoke<std::decay_t<Function>>), _manage(&manage<std::decay_t<Function>>)
+            {
+                using Type = std::decay_t<Function>;
+                if constexpr (isLocal<Type>())
+                {
+                    new (_buffer) Type(std::forward<Function>(function));
+                }
+                else
+                {
+                    *reinterpret_cast<Type**>(_buffer) = new Type(std::forward<Function>(function));
+                }
+            }
+
+            Callable(const Callable& copy):
+            _invoke(copy._invoke), _manage(copy._manage)
+            {
+                _manage(Operation::Copy, _buffer, const_cast<std::byte*>(copy._buffer));
+            }
+
+            Callable(Callable&& move) noexcept:
+            _invoke(move._invoke), _manage(move._manage)
+            {
+                _manage(Operation::Move, _buffer, move._buffer);
+            }
+
+            Callable& operator=(const Callable&) = delete;
+            Callable& operator=(Callable&&) = delete;
+
+            ~Callable()
+            {
+                _manage(Operation::Destroy, _buffer, nullptr);
+            }
+
+            void operator()(Args... args) const
+            {
+                _invoke(_buffer, args...);
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Check if callable of type is stored without allocation.
+            ///
+            /// \returns True if stored into internal buffer.
+            template <typename Function>
+            static constexpr bool isLocal()
+            {
+                return sizeof(Function) <= _bufferSize
+                    && alignof(Function) <= alignof(std::max_align_t)
+                    && std::is_nothrow_copy_constructible_v<Function>
+                    && std::is_nothrow_move_constructible_v<Function>;
+            }
+
+        private:
+            enum class Operation : uint8_t
+            {
+                Copy,
+                Move,
+                Destroy
+            };
+
+            using Invoke = void (*)(const void*, Args...);
+            using Manage = void (*)(const Operation, void*, void*);
+
+            template <typename Type>
+            static const Type& getFunction(const void* buffer)
+            {
+                if constexpr (isLocal<Type>())
+                {
+                    return *static_cast<const Type*>(buffer);
+                }
+                else
+                {
+                    return **static_cast<Type* const*>(buffer);
+                }
+            }
+
+            template <typename Type>
+            static void invoke(const void* buffer, Args... args)
+            {
+                getFunction<Type>(buffer)(std::forward<Args>(args)...);
+            }
+
+            template <typename Type>
+            static void manage(const Operation operation, void* buffer, void* source)
+            {
+                if constexpr (isLocal<Type>())
+                {
+                    switch (operation)
+                    {
+                        case Operation::Copy:    new (buffer) Type(getFunction<Type>(source));           break;
+                        case Operation::Move:    new (buffer) Type(std::move(*static_cast<Type*>(source))); break;
+                        case Operation::Destroy: static_cast<Type*>(buffer)->~Type();                     break;
+                    }
+                }
+                else
+                {
+                    switch (operation)
+                    {
+                        case Operation::Copy:    *static_cast<Type**>(buffer) = new Type(getFunction<Type>(source)); break;
+                        case Operation::Move:    *static_cast<Type**>(buffer) = std::exchange(*static_cast<Type**>(source), nullptr); break;
+                        case Operation::Destroy: delete *static_cast<Type**>(buffer);                              break;
+                    }
+                }
+            }
+
+            alignas(std::max_align_t) std::byte _buffer[_bufferSize];  ///< Function or pointer to function when too big.
+            Invoke                              _invoke;                ///< Call function of buffer.
+            Manage                              _manage;                ///< Copy/move/destroy function of buffer.
+    };
+}
@@ -46,13 +46,6 @@ namespace MouCa
     {
         assertHeader(min <= value && value < max, std::format("{} <= {} < {}", std::to_string(min), std::to_string(value), std::to_string(max)), location);
     }
-
-    template<typename DataType>
-    void logConsole(const DataType& message, const std::source_location& location = std::source_location::current())
-    {
-        std::cout << message;
-        logVisualStudio(message);
-    }
 #else 
     // For MOUCA_ACTIVE_ASSERT: To avoid warning redeclare function
 
@@ -75,10 +68,6 @@ namespace MouCa
     template<typename DataType>
     void assertBetween(const DataType& , const DataType& , const DataType& , const std::source_location&  = std::source_location::current())
     {}
-
-    template<typename DataType>
-    void logConsole(const DataType&, const std::source_location&  = std::source_location::current())
-    {}
 #endif
 }
 
@@ -0,0 +1,186 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+#include <LibCore/include/CoreCallable.h>
+
+namespace Core
+{
+    //----------------------------------------------------------------------------
+    /// \brief Asynchronous logger: each thread pushes records into its own lock-free queue,
+    /// a background thread formats them and writes to console, debugger output and rotating file.
+    /// Formatting is deferred to background thread: arguments are copied, message is built only when written.
+    /// Use MOUCA_LOG_* macros: when severity is filtered, call site only pays for level check (arguments are not evaluated).
+    /// \code{.cpp}
+    ///     Core::Logger::initialize(configuration);
+    ///     MOUCA_LOG_INFO(Loader, "Load {} ({} bytes)", filename.string(), size);
+    ///     Core::Logger::release();
+    /// \endcode
+    /// \note Without initialize(), records are written immediately on calling thread.
+    /// \note initialize()/release() are counted: outputs of first initialize() are kept until last release().
+    class Logger final
+    {
+        public:
+            enum class Severity : uint8_t
+            {
+                Trace,
+                Debug,
+                Info,
+                Warning,
+                Error,
+                Critical,
+
+                NbSeverities
+            };
+
+            enum class Category : uint8_t
+            {
+                General,
+                Core,
+                Loader,
+                Media,
+                Render,
+                Vulkan,
+
+                NbCategories
+            };
+
+            /// Outputs of background thread.
+            struct Configuration
+            {
+                Path     _filename;                     ///< Log file (empty: no file).
+                size_t   _maxFileSize = 8 * 1024 * 1024; ///< Size before rotation (bytes).
+                uint32_t _nbFiles     = 3;              ///< Number of rotated files kept (name.1.ext, name.2.ext, ...).
+                bool     _console     = true;           ///< Write to standard output (and debugger on Windows).
+            };
+
+            struct Statistics
+            {
+                uint64_t _written = 0;  ///< Number of written records.
+                uint64_t _dropped = 0;  ///< Number of lost records (queue full).
+            };
+
+            /// Number of records kept by each thread queue.
+            static constexpr size_t _capacity = 1024;
+
+            //------------------------------------------------------------------------
+            /// \brief  Open outputs and start background thread (only add user when already initialized).
+            ///
+            /// \param[in] configuration: outputs (ignored when already initialized).
+            /// \throw Core::Exception if log file can't be opened.
+            static void initialize(const Configuration& configuration);
+
+            //------------------------------------------------------------------------
+            /// \brief  Remove user: last one writes pending records, stops background thread and closes outputs.
+            static void release();
+
+            static bool isInitialized();
+
+            //------------------------------------------------------------------------
+            /// \brief  Wait until all records pushed before this call are written.
+            static void flush();
+
+            static Statistics getStatistics();
+
+            //------------------------------------------------------------------------
+            /// \brief  Change minimum severity of all categories.
+            ///
+            /// \param[in] minimum: lowest written severity.
+            static void setLevel(const Severity minimum);
+
+            //------------------------------------------------------------------------
+            /// \brief  Change minimum severity of one category.
+            ///
+            /// \param[in] category: filtered category.
+            /// \param[in] minimum: lowest written severity.
+            static void setLevel(const Category category, const Severity minimum);
+
+            static bool isEnabled(const Category category, const Severity severity)
+            {
+                return severity >= _levels[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Push record (prefer MOUCA_LOG_* macros to skip filtered records).
+            ///
+            /// \param[in] category: category of record.
+            /// \param[in] severity: severity of record.
+            /// \param[in] location: source of record.
+            /// \param[in] format: std::format string (must be string literal).
+            /// \param[in] args: arguments copied until formatting (text is copied into String).
+            template<typename... Args>
+            static void log(const Category category, const Severity severity, const std::source_location& location, std::format_string<Args...> format, Args&&... args)
+            {
+                push(Record(category, severity, location, Callable<String&>(
+                     [format = format.get(), arguments = std::make_tuple(keep(std::forward<Args>(args))...)](String& message)
+                     {
+                         std::apply([&](const auto&... values) { message = std::vformat(format, std::make_format_args(values...)); }, arguments);
+                     })));
+            }
+
+            static const char* getLabel(const Severity severity);
+
+            static const char* getLabel(const Category category);
+
+        private:
+            // Pointed text can be released before formatting: take a copy.
+            template<typename Type>
+            static decltype(auto) keep(Type&& value)
+            {
+                if constexpr (std::is_convertible_v<const std::decay_t<Type>&, std::string_view>)
+                {
+                    return String(value);
+                }
+                else
+                {
+                    return std::forward<Type>(value);
+                }
+            }
+
+            /// Data kept until formatting.
+            struct Record
+            {
+                Record(const Category category, const Severity severity, const std::source_location& location, Callable<String&>&& formatter);
+
+                int64_t           _time;        ///< Wall-clock time (ns since epoch).
+                const char*       _file;        ///< Source file.
+                uint32_t          _line;        ///< Source line.
+                uint32_t          _threadID;    ///< Logger id of thread.
+                Category          _category;    ///< Category of record.
+                Severity          _severity;    ///< Severity of record.
+                Callable<String&> _formatter;   ///< Build message.
+            };
+
+            struct ThreadQueue;
+            struct Sink;
+
+            static void push(Record&& record);
+
+            static inline std::array<std::atomic<Severity>, static_cast<size_t>(Category::NbCategories)> _levels =
+            {
+#ifdef NDEBUG
+                Severity::Info, Severity::Info, Severity::Info, Severity::Info, Severity::Info, Severity::Info
+#else
+                Severity::Debug, Severity::Debug, Severity::Debug, Severity::Debug, Severity::Debug, Severity::Debug
+#endif
+            };  ///< Minimum severity by category.
+    };
+}
+
+/// Push record when category/severity is enabled: arguments are evaluated only in this case.
+#define MOUCA_LOG(category, severity, ...)                                                                                                           \
+    do                                                                                                                                               \
+    {                                                                                                                                                \
+        if (Core::Logger::isEnabled(Core::Logger::Category::category, severity))                                                                    \
+        {                                                                                                                                            \
+            Core::Logger::log(Core::Logger::Category::category, severity, std::source_location::current(), __VA_ARGS__);                            \
+        }                                                                                                                                            \
+    } while (false)
+
+#define MOUCA_LOG_TRACE(category, ...)    MOUCA_LOG(category, Core::Logger::Severity::Trace,    __VA_ARGS__)
+#define MOUCA_LOG_DEBUG(category, ...)    MOUCA_LOG(category, Core::Logger::Severity::Debug,    __VA_ARGS__)
+#define MOUCA_LOG_INFO(category, ...)     MOUCA_LOG(category, Core::Logger::Severity::Info,     __VA_ARGS__)
+#define MOUCA_LOG_WARNING(category, ...)  MOUCA_LOG(category, Core::Logger::Severity::Warning,  __VA_ARGS__)
+#define MOUCA_LOG_ERROR(category, ...)    MOUCA_LOG(category, Core::Logger::Severity::Error,    __VA_ARGS__)
+#define MOUCA_LOG_CRITICAL(category, ...) MOUCA_LOG(category, Core::Logger::Severity::Critical, __VA_ARGS__)
@@ -0,0 +1,129 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+#include <LibCore/include/CoreResource.h>
+
+namespace Core
+{
+    //----------------------------------------------------------------------------
+    /// \brief Read-only memory mapping of whole file.
+    /// Data are read directly from page cache: no copy into ByteBuffer/BufferCPU and
+    /// any thread can read any view without lock.
+    /// \code{ .cpp }
+    ///     Core::MappedFile file(path);
+    ///     file.open(Core::MappedFile::Advice::Sequential);
+    ///     const auto header = file.getView(0, sizeof(Header));
+    /// \endcode
+    /// \see File, AsyncFileReader
+    class MappedFile final : public Resource
+    {
+        MOUCA_NOCOPY_NOMOVE(MappedFile);
+
+        public:
+            /// Access pattern given to OS (madvise/PrefetchVirtualMemory).
+            enum class Advice : uint8_t
+            {
+                Normal,
+                Sequential,     ///< Read ahead aggressively, free behind.
+                Random,         ///< No read ahead.
+                WillNeed,       ///< Prefetch range now.
+                DontNeed        ///< Range can be released from memory.
+            };
+
+            //------------------------------------------------------------------------
+            /// \brief  Constructor
+            ///
+            /// \param[in] filename: file to map.
+            /// \param[in] eMode: kind of resource is this file.
+            MappedFile(const Path& filename = Path(), const Mode eMode = Mode::NoRefresh):
+            Resource(filename, eMode)
+            {}
+
+            /// Destructor
+            ~MappedFile() override
+            {
+                close();
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Map whole file in read-only.
+            ///
+            /// \param[in] advice: access pattern of whole file.
+            /// \throw Core::Exception if file can't be mapped.
+            void open(const Advice advice = Advice::Normal);
+
+            //------------------------------------------------------------------------
+            /// \brief  Unmap file: all views become invalid.
+            void close();
+
+            void release() override
+            {
+                close();
+            }
+
+            bool isNull() const override
+            {
+                return !isLoaded()
+                    && _filename.empty();
+            }
+
+            bool isLoaded() const override
+            {
+                return _opened;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get size of mapped file.
+            ///
+            /// \returns Size in bytes.
+            size_t getSize() const
+            {
+                MouCa::preCondition(isLoaded());
+                return _size;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get memory of whole file.
+            ///
+            /// \returns Pointer on first byte (nullptr if file is empty).
+            const uint8_t* getData() const
+            {
+                MouCa::preCondition(isLoaded());
+                return _data;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get read-only view of file.
+            ///
+            /// \param[in] offset: position into file.
+            /// \param[in] sizeInByte: size of view.
+            /// \returns View of file memory.
+            /// \throw Core::Exception if view is outside of file.
+            std::span<const uint8_t> getView(const size_t offset, const size_t sizeInByte) const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Give access pattern of range to OS.
+            ///
+            /// \param[in] advice: access pattern.
+            /// \param[in] offset: position into file.
+            /// \param[in] sizeInByte: size of range (0: until end of file).
+            /// \note Hint only: unsupported advices are ignored.
+            void advise(const Advice advice, const size_t offset = 0, const size_t sizeInByte = 0) const;
+
+        private:
+            const uint8_t*  _data   = nullptr;      ///< First byte of mapping.
+            size_t          _size   = 0;            ///< Size of file.
+            bool            _opened = false;        ///< Mapping is valid (even for empty file).
+        #ifdef MOUCA_OS_WINDOWS
+            void*           _fileHandle    = nullptr;   ///< HANDLE of file.
+            void*           _mappingHandle = nullptr;   ///< HANDLE of mapping object.
+        #else
+            int             _descriptor    = -1;        ///< Descriptor of file.
+        #endif
+    };
+
+    using MappedFileSPtr = std::shared_ptr<MappedFile>;
+    using MappedFileWPtr = std::weak_ptr<MappedFile>;
+}
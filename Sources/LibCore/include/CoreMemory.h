@@ -0,0 +1,197 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+namespace Core
+{
+    //----------------------------------------------------------------------------
+    /// \brief Counters of heap used by memory resources of Core (arenas, pools).
+    /// Compare statistics between two frames to check that steady state doesn't allocate.
+    class Memory final
+    {
+        public:
+            struct Statistics
+            {
+                uint64_t _nbAllocations   = 0;  ///< Number of heap allocations.
+                uint64_t _nbDeallocations = 0;  ///< Number of heap releases.
+                uint64_t _allocatedBytes  = 0;  ///< Current size allocated on heap.
+            };
+
+            //------------------------------------------------------------------------
+            /// \brief  Get heap resource counting allocations (default upstream of arenas and pools).
+            ///
+            /// \returns Thread-safe resource.
+            static std::pmr::memory_resource* getHeapResource();
+
+            static Statistics getStatistics();
+    };
+
+    //----------------------------------------------------------------------------
+    /// \brief Linear allocator: allocation moves pointer, deallocation does nothing, memory is given back by rewind/reset.
+    /// Chunks are kept between resets (and merged into one) so steady state never touches heap.
+    /// Not thread-safe: use getThreadArena() and ArenaScope.
+    /// \code{.cpp}
+    ///     Core::ArenaScope scope;                                    // Rewind at end of scope
+    ///     std::pmr::vector<float> temporary(&scope.getArena());      // No heap
+    /// \endcode
+    class LinearArena final : public std::pmr::memory_resource
+    {
+        MOUCA_NOCOPY_NOMOVE(LinearArena);
+
+        public:
+            /// Position into arena.
+            struct Marker
+            {
+                size_t _chunk;
+                size_t _offset;
+            };
+
+            explicit LinearArena(const size_t chunkSize = 64 * 1024, std::pmr::memory_resource* upstream = Memory::getHeapResource());
+
+            ~LinearArena() override;
+
+            //------------------------------------------------------------------------
+            /// \brief  Get arena of current thread (transient allocations of frame/job).
+            ///
+            /// \returns Arena owned by current thread.
+            static LinearArena& getThreadArena();
+
+            Marker getMarker() const
+            {
+                return { _current, _offset };
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Release all allocations done after marker.
+            ///
+            /// \param[in] marker: previous position.
+            void rewind(const Marker& marker);
+
+            //------------------------------------------------------------------------
+            /// \brief  Release all allocations and merge chunks: next cycle uses only one chunk.
+            void reset();
+
+            //------------------------------------------------------------------------
+            /// \brief  Give all chunks back to upstream.
+            void release();
+
+            //------------------------------------------------------------------------
+            /// \brief  Get size of all chunks.
+            ///
+            /// \returns Size in bytes.
+            size_t getCapacity() const;
+
+            size_t getNbChunks() const
+            {
+                return _chunks.size();
+            }
+
+        private:
+            struct Chunk
+            {
+                std::byte* _data;
+                size_t     _size;
+            };
+
+            void* do_allocate(size_t bytes, size_t alignment) override;
+
+            void do_deallocate(void*, size_t, size_t) override
+            {}
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+
+            std::pmr::memory_resource* _upstream;   ///< Source of chunks.
+            std::vector<Chunk>         _chunks;     ///< Memory blocks (kept until release()).
+            size_t                     _chunkSize;  ///< Minimum size of new chunk.
+            size_t                     _current;    ///< Chunk in use.
+            size_t                     _offset;     ///< Next free byte into current chunk.
+    };
+
+    //----------------------------------------------------------------------------
+    /// \brief Rewind arena at end of scope (per frame, per job, per call).
+    /// Outermost scope resets arena (chunks are merged).
+    class ArenaScope final
+    {
+        MOUCA_NOCOPY_NOMOVE(ArenaScope);
+
+        public:
+            explicit ArenaScope(LinearArena& arena = LinearArena::getThreadArena()):
+            _arena(arena), _marker(arena.getMarker())
+            {}
+
+            ~ArenaScope()
+            {
+                _arena.rewind(_marker);
+            }
+
+            LinearArena& getArena() const
+            {
+                return _arena;
+            }
+
+        private:
+            LinearArena&        _arena;     ///< [LINK] Rewound arena.
+            LinearArena::Marker _marker;    ///< Position at beginning of scope.
+    };
+
+    //----------------------------------------------------------------------------
+    /// \brief Thread-safe pool of fixed-size blocks: objects of same type are reused without heap.
+    /// Bigger allocations are forwarded to upstream.
+    /// \code{.cpp}
+    ///     Core::PoolResource pool(sizeof(Object) + 32);
+    ///     auto object = std::allocate_shared<Object>(std::pmr::polymorphic_allocator<Object>(&pool));
+    /// \endcode
+    /// \note All blocks must be given back before pool destruction.
+    class PoolResource final : public std::pmr::memory_resource
+    {
+        MOUCA_NOCOPY_NOMOVE(PoolResource);
+
+        public:
+            PoolResource(const size_t blockSize, const size_t nbBlocksByChunk = 64, std::pmr::memory_resource* upstream = Memory::getHeapResource());
+
+            ~PoolResource() override;
+
+            size_t getBlockSize() const
+            {
+                return _blockSize;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get number of blocks currently given to users.
+            ///
+            /// \returns Number of blocks.
+            size_t getNbUsed() const;
+
+        private:
+            struct FreeBlock
+            {
+                FreeBlock* _next;
+            };
+
+            bool isBlock(const size_t bytes, const size_t alignment) const
+            {
+                return bytes <= _blockSize && alignment <= alignof(std::max_align_t);
+            }
+
+            void* do_allocate(size_t bytes, size_t alignment) override;
+
+            void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+
+            std::pmr::memory_resource* _upstream;          ///< Source of chunks.
+            const size_t               _blockSize;         ///< Size of block (aligned on std::max_align_t).
+            const size_t               _nbBlocksByChunk;   ///< Number of blocks of new chunk.
+            mutable std::mutex         _lock;              ///< Protect free list.
+            FreeBlock*                 _free   = nullptr;  ///< Available blocks.
+            std::vector<void*>         _chunks;            ///< Memory blocks.
+            size_t                     _nbUsed = 0;        ///< Blocks given to users.
+    };
+}
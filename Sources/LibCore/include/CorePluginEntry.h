@@ -24,8 +24,16 @@ namespace Core
     using PlugInEntryUPtr = std::unique_ptr<PlugInEntry>;
 }
 
+#ifdef MOUCA_OS_WINDOWS
+#   define MOUCA_PLUGIN_EXPORT extern "C" __declspec(dllexport)
+#   define MOUCA_PLUGIN_CALL   CALLBACK
+#else
+#   define MOUCA_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+#   define MOUCA_PLUGIN_CALL
+#endif
+
 #define DECLARE_PLUG_IN(classPlugIn)														\
-extern "C" __declspec(dllexport) Core::PlugInEntry* CALLBACK PlugInLoadingEntryPoint()	    \
+MOUCA_PLUGIN_EXPORT Core::PlugInEntry* MOUCA_PLUGIN_CALL PlugInLoadingEntryPoint()	        \
 {																							\
     return new classPlugIn(); 											                    \
 }                                                                                           \
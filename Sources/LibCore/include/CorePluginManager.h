@@ -8,18 +8,52 @@ namespace Core
     class PlugInEntry;
     using PluginEntrySPtr = std::shared_ptr<PlugInEntry>;
 
+    class ThreadPools;
+
+    //----------------------------------------------------------------------------
+    /// \brief Load plugins (dynamic libraries exporting DECLARE_PLUG_IN).
+    /// Plugins are declared by manifest (read without loading library) and loaded at first use:
+    /// \code{.txt}
+    ///     # MyPlugIn.plugin
+    ///     name=MyPlugIn
+    ///     library=MyPlugIn.dll
+    ///     version=1.0
+    ///     dependencies=OtherPlugIn, ThirdPlugIn
+    /// \endcode
+    /// Library path is relative to manifest. Independent plugins can be loaded in parallel with preloadAll().
     class PlugInManager : public std::enable_shared_from_this<PlugInManager>
     {
         MOUCA_NOCOPY_NOMOVE(PlugInManager);
 
+        public:
+            /// Metadata of manifest.
+            struct PlugInInformation
+            {
+                String              _name;          ///< Unique name.
+                Path                _library;       ///< Dynamic library.
+                String              _version;       ///< Free version label.
+                std::vector<String> _dependencies;  ///< Plugins to load before.
+            };
+
+            /// Startup cost of one plugin.
+            struct LoadingReport
+            {
+                String  _name;                      ///< Name of plugin.
+                double  _loadingTime    = 0.0;      ///< Library loading + instantiation (ms).
+                double  _initializeTime = 0.0;      ///< PlugInEntry::initialize() (ms).
+            };
+
         protected:
             class PlugInState final
             {
                 public:
-                    void*			_hHandle;
-                    Path  	        _name;
-                    PluginEntrySPtr _plugInInstance;
-            
+                    void*			  _hHandle;
+                    Path  	          _name;
+                    PluginEntrySPtr   _plugInInstance;
+                    PlugInInformation _information;             ///< Manifest (empty when loaded by path).
+                    bool              _registered  = false;     ///< Declared by manifest: manager initializes/releases instance.
+                    std::mutex        _loading;                 ///< Only one thread loads library.
+
                     PlugInState(const std::wstring& strName):
                     _hHandle(nullptr), _name(strName)
                     {}
@@ -35,13 +69,31 @@ namespace Core
                         return _name == _instance._name;
                     }
             };
-    
-            using PlugInArray = std::vector<std::shared_ptr<PlugInState>>;
-            PlugInArray _loadedPlugins;
+            using PlugInStateSPtr = std::shared_ptr<PlugInState>;
+
+            std::unordered_map<String, PlugInStateSPtr> _plugins;        ///< All plugins by name (manifest) or by path.
+            std::vector<PlugInStateSPtr>                _loadedPlugins;  ///< Loaded plugins by order (released in reverse order).
+            std::vector<LoadingReport>                  _reports;        ///< Startup cost of loaded plugins.
+            mutable std::mutex                          _lock;           ///< Protect containers.
 
             void release();
 
-            PlugInArray::const_iterator searchPlugIn(const PlugInState& _instance) const;
+            PlugInStateSPtr searchPlugIn(const String& name) const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Load library of state and create instance (thread-safe).
+            ///
+            /// \param[in] state: plugin to load.
+            /// \throw Core::Exception when library, entry point or instance is invalid.
+            void load(const PlugInStateSPtr& state);
+
+            //------------------------------------------------------------------------
+            /// \brief  Check dependencies of registered plugin exist and have no cycle.
+            ///
+            /// \param[in] name: plugin to check.
+            /// \param[in,out] stack: plugins being visited.
+            /// \throw Core::Exception when dependency is missing or cyclic.
+            void checkDependencies(const String& name, std::vector<String>& stack) const;
 
         public:
             PlugInManager() = default;
@@ -53,7 +105,54 @@ namespace Core
 
             bool isNull() const { return _loadedPlugins.empty(); }
 
+            //------------------------------------------------------------------------
+            /// \brief  Load library now (instance is not initialized).
+            ///
+            /// \param[in] strDynamicLibraryPath: path of library.
+            /// \returns Instance of plugin (same instance when library is already loaded).
+            /// \throw Core::Exception when library, entry point or instance is invalid.
             PluginEntrySPtr loadDynamicLibrary(const Path& strDynamicLibraryPath);
+
+            //------------------------------------------------------------------------
+            /// \brief  Read manifest without loading library.
+            ///
+            /// \param[in] manifest: manifest file.
+            /// \returns Name of plugin.
+            /// \throw Core::Exception when manifest is invalid or name is already registered.
+            String registerPlugIn(const Path& manifest);
+
+            //------------------------------------------------------------------------
+            /// \brief  Register all manifests (*.plugin) of folder.
+            ///
+            /// \param[in] folder: folder to scan.
+            /// \returns Number of registered plugins.
+            /// \throw Core::Exception when one manifest is invalid.
+            size_t registerFolder(const Path& folder);
+
+            //------------------------------------------------------------------------
+            /// \brief  Get registered plugin: library and dependencies are loaded and initialized at first call.
+            ///
+            /// \param[in] name: name of manifest.
+            /// \returns Initialized instance.
+            /// \throw Core::Exception when plugin is unknown or can't be loaded.
+            PluginEntrySPtr getPlugIn(const String& name);
+
+            //------------------------------------------------------------------------
+            /// \brief  Load all registered plugins: independent plugins are loaded in parallel by workers.
+            ///
+            /// \param[in] pools: workers (must be initialized).
+            /// \throw Core::Exception of first failed plugin.
+            void preloadAll(ThreadPools& pools);
+
+            bool isLoaded(const String& name) const;
+
+            const PlugInInformation& getInformation(const String& name) const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Get startup cost of all loaded plugins.
+            ///
+            /// \returns Reports by loading order.
+            std::vector<LoadingReport> getLoadingReports() const;
     };
 
-};
\ No newline at end of file
+};
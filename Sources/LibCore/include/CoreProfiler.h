@@ -0,0 +1,149 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+namespace Core
+{
+    //----------------------------------------------------------------------------
+    /// \brief Frame-scoped profiling: zones, counters and frame markers exported to Chrome trace (chrome://tracing, Perfetto).
+    /// Each thread writes into its own ring buffer without lock nor allocation (oldest events are overwritten).
+    /// At thread exit, ring buffer is released and only written events are kept until clear().
+    /// When disabled, zone only costs one relaxed atomic load.
+    /// \code{.cpp}
+    ///     Core::Profiler::enable(true);
+    ///     {
+    ///         MOUCA_PROFILE_ZONE("Load mesh");
+    ///         // ...
+    ///     }
+    ///     Core::Profiler::markFrame();
+    ///     Core::Profiler::exportChromeTrace(L"trace.json");
+    /// \endcode
+    /// \note Names MUST be string literals (pointer is kept until export).
+    class Profiler final
+    {
+        public:
+            enum class Type : uint8_t
+            {
+                Zone,       ///< _value is duration (ns).
+                Counter,    ///< _value is counter value.
+                Frame       ///< _value is frame index.
+            };
+
+            /// Recorded item.
+            struct Event
+            {
+                const char* _name;      ///< Label (string literal).
+                int64_t     _begin;     ///< Time (ns).
+                int64_t     _value;     ///< Duration, counter or frame index.
+                uint32_t    _threadID;  ///< Profiler id of thread.
+                Type        _type;      ///< Kind of event.
+            };
+
+            /// Number of events kept by each thread.
+            static constexpr size_t _capacity = 8192;
+
+            static void enable(const bool enabled)
+            {
+                _enabled.store(enabled, std::memory_order_relaxed);
+            }
+
+            static bool isEnabled()
+            {
+                return _enabled.load(std::memory_order_relaxed);
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get current time of profiler.
+            ///
+            /// \returns Time in nanoseconds.
+            static int64_t now()
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Give name of current thread into trace.
+            ///
+            /// \param[in] name: label of thread.
+            static void setThreadName(const String& name);
+
+            //------------------------------------------------------------------------
+            /// \brief  Record zone of current thread (ProfileZone is easier).
+            ///
+            /// \param[in] name: label (string literal).
+            /// \param[in] begin: start time (ns).
+            /// \param[in] end: end time (ns).
+            static void addZone(const char* name, const int64_t begin, const int64_t end);
+
+            //------------------------------------------------------------------------
+            /// \brief  Record counter value (memory, number of draws, ...).
+            ///
+            /// \param[in] name: label (string literal).
+            /// \param[in] value: current value.
+            static void addCounter(const char* name, const int64_t value);
+
+            //------------------------------------------------------------------------
+            /// \brief  Record beginning of new frame.
+            static void markFrame();
+
+            //------------------------------------------------------------------------
+            /// \brief  Get all recorded events of all threads (call when profiled threads are idle).
+            ///
+            /// \returns Events sorted by time.
+            static std::vector<Event> collect();
+
+            //------------------------------------------------------------------------
+            /// \brief  Export recorded events into Chrome trace JSON (call when profiled threads are idle).
+            ///
+            /// \param[in] filename: JSON file.
+            /// \throw Core::Exception if file can't be written.
+            static void exportChromeTrace(const Path& filename);
+
+            //------------------------------------------------------------------------
+            /// \brief  Remove all recorded events (call when profiled threads are idle).
+            static void clear();
+
+            //------------------------------------------------------------------------
+            /// \brief  Get number of registered threads: running threads which used profiler and finished threads with events (until clear()).
+            ///
+            /// \returns Number of thread buffers.
+            static size_t getNbThreads();
+
+        private:
+            static void push(const Event& event);
+
+            static inline std::atomic<bool> _enabled = false;   ///< Global switch.
+    };
+
+    //----------------------------------------------------------------------------
+    /// \brief Record scope duration into Profiler.
+    /// \see MOUCA_PROFILE_ZONE
+    class ProfileZone final
+    {
+        MOUCA_NOCOPY_NOMOVE(ProfileZone);
+
+        public:
+            explicit ProfileZone(const char* name):
+            _name(name), _begin(Profiler::isEnabled() ? Profiler::now() : -1)
+            {}
+
+            ~ProfileZone()
+            {
+                if (_begin >= 0)
+                {
+                    Profiler::addZone(_name, _begin, Profiler::now());
+                }
+            }
+
+        private:
+            const char* _name;      ///< Label (string literal).
+            int64_t     _begin;     ///< Start time (-1: profiler disabled).
+    };
+}
+
+#define MOUCA_PROFILE_CONCAT_IMPL(first, second) first##second
+#define MOUCA_PROFILE_CONCAT(first, second) MOUCA_PROFILE_CONCAT_IMPL(first, second)
+
+/// Record duration of current scope.
+#define MOUCA_PROFILE_ZONE(name) Core::ProfileZone MOUCA_PROFILE_CONCAT(profileZone, __LINE__)(name)
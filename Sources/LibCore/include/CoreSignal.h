@@ -3,8 +3,25 @@
 /// \license No license
 #pragma once
 
+#include <LibCore/include/CoreCallable.h>
+#include <LibCore/include/CoreSignalQueue.h>
+
 namespace Core
 {
+    //----------------------------------------------------------------------------
+    /// \brief Observer system: call all connected slots when signal is emitted.
+    /// Slots are stored into immutable flat array: emit() takes current snapshot with one atomic load and
+    /// connect()/disconnect() build a new array (copy-on-write). So slots can be (dis)connected by any thread
+    /// during emission, even by slot itself: current emission finishes with its snapshot.
+    /// \note std::atomic<std::shared_ptr> is generally not lock-free (see isLockFree()): standard library protects
+    ///       the pointer copy with an internal lock, but this lock is never held while slots are called.
+    /// Member slots are stored into small buffer of slot: no allocation at emission.
+    /// Queued slots are not called by emitting thread but posted to SignalQueue of target thread.
+    /// \code{.cpp}
+    ///     Core::Signal<int> signal;
+    ///     signal.connectMember(&receiver, &Receiver::doSomething);
+    ///     signal.emit(42);
+    /// \endcode
     template <typename... Args>
     class Signal
     {
@@ -45,8 +62,9 @@ namespace Core
                 return connect(reinterpret_cast<IdConnexion>(inst.lock().get()),
                                [=](Args... args)
                                {
-                                   MouCa::assertion(!inst.expired());
-                                   ( inst.lock().get()->*func )( args... );
+                                   const auto instance = inst.lock();
+                                   MouCa::assertion(instance != nullptr);
+                                   ( instance.get()->*func )( args... );
                                });
             }
 
@@ -56,22 +74,116 @@ namespace Core
                 return connect(reinterpret_cast<IdConnexion>(inst.lock().get()),
                                [=](Args... args)
                                {
-                                   MouCa::assertion(!inst.expired());
-                                   ( inst.lock().get()->*func )( args... );
+                                   const auto instance = inst.lock();
+                                   MouCa::assertion(instance != nullptr);
+                                   ( instance.get()->*func )( args... );
                                });
             }
 
+            //------------------------------------------------------------------------
+            /// \brief  Connect member function called by target thread when its queue is dispatched.
+            /// Arguments are copied into event except non-const references (referenced object must live until dispatch).
+            /// Pending events of slot are ignored after disconnection.
+            ///
+            /// \param[in] queue: events queue of target thread.
+            /// \param[in] inst: receiver.
+            /// \param[in] func: method to call.
+            /// \param[in] coalesce: merge emissions while event is pending (only latest arguments are sent).
+            /// \returns Current pointer added.
+            template <typename ClassInstance>
+            IdConnexion connectQueued(SignalQueue& queue, ClassInstance* inst, void (ClassInstance::* func)(Args...), const bool coalesce = false)
+            {
+                auto state = std::make_shared<QueuedState>();
+                std::shared_ptr<std::atomic<bool>> connected(state, &state->_connected);
+                SignalQueue* target = &queue;
+
+                if (coalesce)
+                {
+                    return connect(reinterpret_cast<IdConnexion>(inst),
+                                   [=](Args... args)
+                                   {
+                                       std::lock_guard<std::mutex> lock(state->_lock);
+                                       state->_latest.emplace(args...);
+                                       if (state->_queued)
+                                       {
+                                           target->_coalesced.fetch_add(1, std::memory_order_relaxed);
+                                           return;
+                                       }
+                                       state->_queued = true;
+                                       target->post(SignalQueue::Event([=]()
+                                       {
+                                           std::optional<Arguments> arguments;
+                                           {
+                                               std::lock_guard<std::mutex> lockEvent(state->_lock);
+                                               arguments.swap(state->_latest);
+                                               state->_queued = false;
+                                           }
+                                           if (state->_connected.load(std::memory_order_acquire) && arguments.has_value())
+                                           {
+                                               std::apply([&](auto&... values) { ( inst->*func )( values... ); }, *arguments);
+                                           }
+                                       }));
+                                   }, connected);
+                }
+
+                return connect(reinterpret_cast<IdConnexion>(inst),
+                               [=](Args... args)
+                               {
+                                   target->post(SignalQueue::Event([=, arguments = Arguments(args...)]()
+                                   {
+                                       if (state->_connected.load(std::memory_order_acquire))
+                                       {
+                                           std::apply([&](auto&... values) { ( inst->*func )( values... ); }, arguments);
+                                       }
+                                   }));
+                               }, connected);
+            }
+
             // disconnects a previously connected function
             template <typename ClassInstance>
             void disconnect(ClassInstance* pointer)
             {
-                _slots.erase(reinterpret_cast<IdConnexion>(pointer));
+                const IdConnexion pointerID = reinterpret_cast<IdConnexion>(pointer);
+
+                std::lock_guard<std::mutex> lock(_writeMutex);
+                const auto current = _slots.load(std::memory_order_relaxed);
+                if (current == nullptr || find(*current, pointerID) == current->cend())
+                {
+                    return;
+                }
+
+                // Copy-on-write: emissions in progress keep old array
+                std::shared_ptr<Slots> slots;
+                if (current->size() > 1)
+                {
+                    slots = std::make_shared<Slots>();
+                    slots->reserve(current->size() - 1);
+                    for (const auto& slot : *current)
+                    {
+                        if (slot.getId() != pointerID)
+                        {
+                            slots->push_back(slot);
+                        }
+                    }
+                }
+                _slots.store(std::move(slots), std::memory_order_release);
+
+                // Pending queued events are cancelled
+                find(*current, pointerID)->disconnect();
             }
 
             // disconnects all previously connected functions
             void disconnectAll()
             {
-                _slots.clear();
+                std::lock_guard<std::mutex> lock(_writeMutex);
+                const auto current = _slots.exchange(nullptr, std::memory_order_acq_rel);
+                if (current != nullptr)
+                {
+                    for (const auto& slot : *current)
+                    {
+                        slot.disconnect();
+                    }
+                }
             }
 
             template <typename ClassInstance>
@@ -86,37 +198,115 @@ namespace Core
                 return isConnected(reinterpret_cast<IdConnexion>(pointer));
             }
 
+            // checks if snapshot load of emit() is lock-free on this platform
+            bool isLockFree() const
+            {
+                return _slots.is_lock_free();
+            }
+
             // calls all connected functions
             void emit(Args... p) const
             {
-                for(auto it : _slots)
+                // Snapshot: (dis)connection during emission doesn't change current list
+                const auto slots = _slots.load(std::memory_order_acquire);
+                if (slots != nullptr)
                 {
-                    it.second(p...);
+                    for (const auto& slot : *slots)
+                    {
+                        slot(p...);
+                    }
                 }
             }
 
         private:
-            // connects a std::function to the signal. The returned
+            /// Connected item.
+            struct Slot
+            {
+                template <typename Function>
+                Slot(const IdConnexion id, Function&& function, std::shared_ptr<std::atomic<bool>> connected = nullptr):
+                _id(id), _callable(std::forward<Function>(function)), _connected(std::move(connected))
+                {}
+
+                IdConnexion getId() const
+                {
+                    return _id;
+                }
+
+                void operator()(Args... args) const
+                {
+                    _callable(args...);
+                }
+
+                void disconnect() const
+                {
+                    if (_connected != nullptr)
+                    {
+                        _connected->store(false, std::memory_order_release);
+                    }
+                }
+
+                IdConnexion                         _id;            ///< Connection identifier.
+                Callable<Args...>                   _callable;      ///< Function to call.
+                std::shared_ptr<std::atomic<bool>>  _connected;     ///< State shared with queued events (nullptr: direct connection).
+            };
+            using Slots = std::vector<Slot>;
+
+            /// Copy of arguments into queued event (non-const references are kept).
+            using Arguments = std::tuple<std::conditional_t<std::is_lvalue_reference_v<Args> && !std::is_const_v<std::remove_reference_t<Args>>, Args, std::decay_t<Args>>...>;
+
+            /// Shared state between queued slot and its pending events.
+            struct QueuedState
+            {
+                std::atomic<bool>           _connected = true;  ///< Slot is still connected.
+                std::mutex                  _lock;              ///< Protect _queued and _latest.
+                bool                        _queued = false;    ///< Coalesced event is pending.
+                std::optional<Arguments>    _latest;            ///< Latest arguments of coalesced event.
+            };
+
+            // connects a callable to the signal. The returned
             // value can be used to disconnect the function again
             //------------------------------------------------------------------------
             /// \brief  Generic connect system. WARNING: IdConnexion is NOT unique when pointer is delete often. It can provide issue if disconnect is not call after deletion.
-            /// 
+            ///
             /// \param[in] pointerID: current pointer.
-            /// \param[in] slot: method to call.
+            /// \param[in] function: method to call.
+            /// \param[in] connected: state shared with queued events.
             /// \returns Current pointer added.
-            IdConnexion connect(IdConnexion pointerID, std::function<void(Args...)> const& slot)
+            template <typename Function>
+            IdConnexion connect(IdConnexion pointerID, Function&& function, std::shared_ptr<std::atomic<bool>> connected = nullptr)
             {
-                MouCa::preCondition(_slots.find(pointerID) == _slots.cend()); // DEV Issue: Must be unique ! This issue can happens if old pointer never call disconnect before this add (by multithreading ?).
+                std::lock_guard<std::mutex> lock(_writeMutex);
+                const auto current = _slots.load(std::memory_order_relaxed);
+                MouCa::preCondition(current == nullptr || find(*current, pointerID) == current->cend()); // DEV Issue: Must be unique ! This issue can happens if old pointer never call disconnect before this add (by multithreading ?).
 
-                _slots.insert(std::make_pair(pointerID, slot));
+                // Copy-on-write: emissions in progress keep old array
+                auto slots = std::make_shared<Slots>();
+                slots->reserve((current != nullptr ? current->size() : 0) + 1);
+                if (current != nullptr)
+                {
+                    for (const auto& slot : *current)
+                    {
+                        slots->push_back(slot);
+                    }
+                }
+                slots->emplace_back(pointerID, std::forward<Function>(function), std::move(connected));
+
+                _slots.store(std::move(slots), std::memory_order_release);
                 return pointerID;
             }
 
             bool isConnected(const IdConnexion pointerID) const
             {
-                return _slots.find(pointerID) != _slots.cend();
+                const auto slots = _slots.load(std::memory_order_acquire);
+                return slots != nullptr && find(*slots, pointerID) != slots->cend();
+            }
+
+            static typename Slots::const_iterator find(const Slots& slots, const IdConnexion pointerID)
+            {
+                return std::find_if(slots.cbegin(), slots.cend(), [&](const Slot& slot) { return slot.getId() == pointerID; });
             }
 
-            std::map<IdConnexion, std::function<void(Args...)>> _slots; ///< List of all connected items.
+            std::atomic<std::shared_ptr<const Slots>>   _slots;         ///< Current immutable list of all connected items (nullptr: empty).
+            std::mutex                                  _writeMutex;    ///< Serialize (dis)connections.
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,120 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+#include <LibCore/include/CoreCallable.h>
+#include <LibCore/include/CoreElapser.h>
+
+namespace Core
+{
+    template <typename... Args>
+    class Signal;
+
+    //----------------------------------------------------------------------------
+    /// \brief Deferred events of one target thread.
+    /// Any thread can post events (multi-producer), only target thread calls dispatch() (single consumer):
+    /// events run in batch at chosen point (like beginning of frame) without any lock on receiver side.
+    /// Events are stored into bounded ring buffer: when full, events are kept into overflow list (with lock) until next dispatch.
+    /// \code{.cpp}
+    ///     Core::SignalQueue mainEvents;
+    ///     tracker.signalFileChanged().connectQueued(mainEvents, &manager, &Manager::afterShaderEdition);
+    ///     while(loop)
+    ///     {
+    ///         mainEvents.dispatch();
+    ///         // ... draw frame ...
+    ///     }
+    /// \endcode
+    /// \see Signal::connectQueued
+    class SignalQueue final
+    {
+        MOUCA_NOCOPY_NOMOVE(SignalQueue);
+
+        public:
+            using Event = Callable<>;
+
+            /// Counters of queue (approximate when read during posting).
+            struct Statistics
+            {
+                uint64_t                 _posted         = 0;    ///< Number of posted events.
+                uint64_t                 _dispatched     = 0;    ///< Number of executed events.
+                uint64_t                 _coalesced      = 0;    ///< Number of emissions merged into pending event.
+                uint64_t                 _overflowed     = 0;    ///< Number of events posted when ring buffer was full.
+                size_t                   _depth          = 0;    ///< Current number of pending events.
+                size_t                   _maxDepth       = 0;    ///< Maximum number of pending events at dispatch.
+                std::chrono::nanoseconds _averageLatency = {};   ///< Average time between post and execution.
+                std::chrono::nanoseconds _maxLatency     = {};   ///< Maximum time between post and execution.
+            };
+
+            //------------------------------------------------------------------------
+            /// \brief  Constructor
+            ///
+            /// \param[in] capacity: size of ring buffer (rounded to power of 2).
+            explicit SignalQueue(const size_t capacity = 1024);
+
+            /// Destructor
+            ~SignalQueue() = default;
+
+            //------------------------------------------------------------------------
+            /// \brief  Add event to queue (thread-safe, no allocation until ring buffer is full).
+            ///
+            /// \param[in] event: function to call at next dispatch.
+            void post(Event&& event);
+
+            //------------------------------------------------------------------------
+            /// \brief  Execute all events posted before this call (call ONLY by target thread).
+            /// Events posted by executed events are kept for next dispatch.
+            /// \returns Number of executed events.
+            size_t dispatch();
+
+            //------------------------------------------------------------------------
+            /// \brief  Get current counters.
+            ///
+            /// \returns Copy of statistics.
+            Statistics getStatistics() const;
+
+            size_t getCapacity() const
+            {
+                return _mask + 1;
+            }
+
+        private:
+            template <typename... Args>
+            friend class Signal;
+
+            struct PostedEvent
+            {
+                Event           _event;     ///< Function to call.
+                ChronoTimePoint _posted;    ///< Time of post.
+            };
+
+            struct Cell
+            {
+                std::atomic<size_t>         _sequence;  ///< Turn of cell: position when free, position+1 when filled.
+                std::optional<PostedEvent>  _data;      ///< Event of cell.
+            };
+
+            bool tryPush(PostedEvent&& event);
+            bool tryPop(std::optional<PostedEvent>& event);
+            void execute(PostedEvent& event, const ChronoTimePoint& now);
+
+            std::unique_ptr<Cell[]>     _cells;                     ///< Ring buffer.
+            size_t                      _mask;                      ///< Capacity - 1.
+            alignas(64)
+            std::atomic<size_t>         _enqueue = 0;               ///< Next position to fill (producers).
+            alignas(64)
+            size_t                      _dequeue = 0;               ///< Next position to read (consumer).
+
+            std::mutex                  _overflowLock;              ///< Protect _overflow.
+            std::deque<PostedEvent>     _overflow;                  ///< Events posted when ring buffer was full.
+            std::atomic<bool>           _hasOverflow = false;       ///< Keep order: producers use overflow until next dispatch.
+
+            std::atomic<uint64_t>       _posted = 0;                ///< Number of posted events.
+            std::atomic<uint64_t>       _dispatched = 0;            ///< Number of executed events.
+            std::atomic<uint64_t>       _coalesced = 0;             ///< Number of merged emissions.
+            std::atomic<uint64_t>       _overflowed = 0;            ///< Number of events into overflow.
+            std::atomic<size_t>         _maxDepth = 0;              ///< Maximum depth at dispatch.
+            std::atomic<int64_t>        _totalLatency = 0;          ///< Sum of latencies (ns).
+            std::atomic<int64_t>        _maxLatency = 0;            ///< Maximum latency (ns).
+    };
+}
@@ -8,10 +8,70 @@
 namespace Core
 {
 
+class ThreadPools;
+
+//----------------------------------------------------------------------------
+/// \brief Job executed by workers of ThreadPools.
+/// Task starts when it is submitted and all its dependencies are finished.
+/// When dependency fails, task is not executed and receives same exception.
+/// \see ThreadPools::createTask
+class Task final
+{
+    MOUCA_NOCOPY_NOMOVE(Task);
+    public:
+        enum class Priority : uint8_t
+        {
+            High,
+            Normal,
+            Low,
+            NbPriorities
+        };
+
+        Task(std::function<void()>&& function, const Priority priority):
+        _function(std::move(function)), _priority(priority)
+        {}
+
+        ~Task() = default;
+
+        bool isFinished() const
+        {
+            return _finished.load();
+        }
+
+        Priority getPriority() const
+        {
+            return _priority;
+        }
+
+    private:
+        friend class ThreadPools;
+
+        std::function<void()>               _function;          ///< Job.
+        const Priority                      _priority;          ///< Order of execution between ready tasks.
+        std::atomic<uint32_t>               _remaining = 1;     ///< Dependencies + submission not finished.
+        std::atomic<bool>                   _finished = false;  ///< Job is done (or skipped by error).
+        bool                                _submitted = false; ///< Task is given to pool.
+        std::exception_ptr                  _exception;         ///< Error of job or of dependency.
+        std::mutex                          _lock;              ///< Protect _continuations and _exception.
+        std::vector<std::shared_ptr<Task>>  _continuations;     ///< Tasks waiting this one.
+};
+
+using TaskSPtr = std::shared_ptr<Task>;
+
 //----------------------------------------------------------------------------
 /// \brief ThreadPool allows to manage ALL threads of application.
 /// ThreadPool allows to manage ALL threads of application.
 /// It can manage some group too (and provide sync method).
+///
+/// It owns shared workers too: tasks graph (dependencies, continuations, parallel for, priorities)
+/// runs on fixed number of threads instead of dedicated threads for each system.
+/// \code{.cpp}
+///     auto load   = pools.createTask([&]() { load(); });
+///     auto decode = pools.then(load, [&]() { decode(); });
+///     pools.submit(load);
+///     pools.wait(pools.parallelFor(0, nbItems, 64, [&](size_t begin, size_t end) { cull(begin, end); }));
+///     pools.wait(decode); // Help workers until decode is finished
+/// \endcode
 /// \see IThreadPools
 class ThreadPools final
 {
@@ -21,9 +81,76 @@ class ThreadPools final
 
         ~ThreadPools()
         {
+            if (!_workers.empty())
+            {
+                releaseWorkers();
+            }
             closeAllThreads();
         }
 
+        //------------------------------------------------------------------------
+        /// \brief  Launch workers of task graph.
+        ///
+        /// \param[in] nbWorkers: number of threads (0: one by core except current thread).
+        void initializeWorkers(const uint32_t nbWorkers = 0);
+
+        //------------------------------------------------------------------------
+        /// \brief  Execute all pending tasks and stop workers.
+        void releaseWorkers();
+
+        size_t getNbWorkers() const
+        {
+            return _workers.size();
+        }
+
+        //------------------------------------------------------------------------
+        /// \brief  Create task not submitted: dependencies can be added before submit().
+        ///
+        /// \param[in] function: job to execute.
+        /// \param[in] priority: order of execution between ready tasks.
+        /// \returns New task (allocated into pool of tasks).
+        TaskSPtr createTask(std::function<void()> function, const Task::Priority priority = Task::Priority::Normal) const;
+
+        //------------------------------------------------------------------------
+        /// \brief  Task will start only when dependency is finished.
+        ///
+        /// \param[in] task: task not submitted.
+        /// \param[in] dependency: task to wait (can be already finished).
+        void addDependency(const TaskSPtr& task, const TaskSPtr& dependency);
+
+        //------------------------------------------------------------------------
+        /// \brief  Give task to workers: it starts when all dependencies are finished.
+        ///
+        /// \param[in] task: task to execute (only one submission).
+        void submit(const TaskSPtr& task);
+
+        //------------------------------------------------------------------------
+        /// \brief  Create and submit task executed after another one.
+        ///
+        /// \param[in] task: previous task (submitted or not).
+        /// \param[in] continuation: job to execute after task.
+        /// \param[in] priority: order of execution between ready tasks.
+        /// \returns Submitted continuation task.
+        TaskSPtr then(const TaskSPtr& task, std::function<void()> continuation, const Task::Priority priority = Task::Priority::Normal);
+
+        //------------------------------------------------------------------------
+        /// \brief  Split range into tasks executed by workers.
+        ///
+        /// \param[in] begin: first index.
+        /// \param[in] end: last index (excluded).
+        /// \param[in] grain: maximum number of indices by task (0: automatic).
+        /// \param[in] function: job on sub-range [begin, end[.
+        /// \param[in] priority: order of execution between ready tasks.
+        /// \returns Submitted task finished when all range is done.
+        TaskSPtr parallelFor(const size_t begin, const size_t end, const size_t grain, std::function<void(const size_t, const size_t)> function, const Task::Priority priority = Task::Priority::Normal);
+
+        //------------------------------------------------------------------------
+        /// \brief  Wait end of task: current thread executes pending tasks instead of blocking.
+        ///
+        /// \param[in] task: submitted task.
+        /// \note Rethrow exception of task.
+        void wait(const TaskSPtr& task);
+
         size_t createThreadsGroup()
         {
             const size_t currentID = _groupList.size();
@@ -108,12 +235,41 @@ class ThreadPools final
             }
             _threadList.clear();
         }
+
+        class Worker final : public Thread
+        {
+            public:
+                explicit Worker(ThreadPools& pools):
+                _pools(pools)
+                {}
+
+                ~Worker() override = default;
+
+            private:
+                void run() override;
+
+                ThreadPools& _pools;   ///< [LINK] Owner of tasks.
+        };
+
+        void enqueue(const TaskSPtr& task);
+        TaskSPtr tryPop();
+        void execute(const TaskSPtr& task);
+        void finish(const TaskSPtr& task);
+
     protected:
     #pragma warning(push)
     #pragma warning(disable: 4251)
         std::vector<Core::ThreadSPtr>              _threadList; ///< All thread of application.
 
         std::vector<std::vector<Core::ThreadWPtr>> _groupList;  ///< All groups of thread.
+
+        std::vector<std::unique_ptr<Worker>>       _workers;    ///< Threads of task graph.
+        std::array<std::deque<TaskSPtr>, static_cast<size_t>(Task::Priority::NbPriorities)> _readyTasks; ///< Tasks ready to execute by priority.
+        std::mutex                                 _taskLock;   ///< Protect _readyTasks and _run.
+        std::condition_variable                    _waitTask;   ///< Wake up workers.
+        std::condition_variable                    _waitDone;   ///< Wake up wait(): task finished or new task to help.
+        std::atomic<uint32_t>                      _nbWaiting = 0; ///< Number of threads into wait().
+        bool                                       _run = false;   ///< Workers loop until false.
     #pragma warning(pop)
 };
 
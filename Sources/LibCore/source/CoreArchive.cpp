@@ -0,0 +1,517 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibCore/include/CoreArchive.h"
+
+namespace Core
+{
+
+namespace
+{
+    const std::array<uint8_t, 4> archiveMagic = { 'M', 'C', 'A', 'R' };
+
+    uint32_t computeChecksum(const uint8_t* data, const size_t sizeInByte)
+    {
+        // FNV-1a
+        uint32_t hash = 2166136261u;
+        for (size_t id = 0; id < sizeInByte; ++id)
+        {
+            hash = (hash ^ data[id]) * 16777619u;
+        }
+        return hash;
+    }
+
+    [[noreturn]] void throwCorrupted()
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "ArchiveCorruptedError"));
+    }
+
+    // LZ4 block format constants
+    const size_t lz4MinMatch     = 4;
+    const size_t lz4LastLiterals = 5;     ///< Last bytes are always literals.
+    const size_t lz4MatchLimit   = 12;    ///< Last match starts before this distance to end.
+    const size_t lz4MaxOffset    = 65535;
+
+    void writeLZ4Length(std::vector<uint8_t>& output, size_t length)
+    {
+        while (length >= 255)
+        {
+            output.push_back(255);
+            length -= 255;
+        }
+        output.push_back(static_cast<uint8_t>(length));
+    }
+
+    void writeLZ4Sequence(std::vector<uint8_t>& output, const uint8_t* literals, const size_t nbLiterals, const size_t offset, const size_t matchLength)
+    {
+        const size_t matchCode = matchLength > 0 ? matchLength - lz4MinMatch : 0;
+        output.push_back(static_cast<uint8_t>((std::min<size_t>(nbLiterals, 15) << 4) | std::min<size_t>(matchCode, 15)));
+        if (nbLiterals >= 15)
+        {
+            writeLZ4Length(output, nbLiterals - 15);
+        }
+        output.insert(output.end(), literals, literals + nbLiterals);
+
+        if (matchLength > 0)
+        {
+            output.push_back(static_cast<uint8_t>(offset));
+            output.push_back(static_cast<uint8_t>(offset >> 8));
+            if (matchCode >= 15)
+            {
+                writeLZ4Length(output, matchCode - 15);
+            }
+        }
+    }
+
+    size_t readLZ4Length(const uint8_t*& input, const uint8_t* end, size_t length)
+    {
+        if (length == 15)
+        {
+            uint8_t value;
+            do
+            {
+                if (input >= end)
+                {
+                    throwCorrupted();
+                }
+                value = *input++;
+                length += value;
+            }
+            while (value == 255);
+        }
+        return length;
+    }
+}
+
+//------------------------------------------------------------------------------------------
+//                                      ArchiveStream
+//------------------------------------------------------------------------------------------
+void ArchiveStream::writeVarint(uint64_t value)
+{
+    std::array<uint8_t, 10> bytes;
+    size_t size = 0;
+    while (value >= 0x80)
+    {
+        bytes[size++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    bytes[size++] = static_cast<uint8_t>(value);
+    _buffer.append(bytes.data(), size);
+}
+
+uint64_t ArchiveStream::readVarint()
+{
+    uint64_t value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        uint8_t byte;
+        *this >> byte;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+    throwCorrupted();
+}
+
+void ArchiveStream::checkReading(const size_t sizeInByte) const
+{
+    if (sizeInByte > _buffer.size() - _buffer.getReadPosition())
+    {
+        throwCorrupted();
+    }
+}
+
+size_t ArchiveStream::readSize(const size_t elementSize)
+{
+    const uint64_t size = readVarint();
+    if (size > (_buffer.size() - _buffer.getReadPosition()) / elementSize)
+    {
+        throwCorrupted();
+    }
+    return static_cast<size_t>(size);
+}
+
+//------------------------------------------------------------------------------------------
+//                                      Archive
+//------------------------------------------------------------------------------------------
+std::vector<uint8_t> Archive::compressLZ4(const uint8_t* data, const size_t sizeInByte)
+{
+    std::vector<uint8_t> output;
+    output.reserve(sizeInByte + sizeInByte / 255 + 16);
+
+    size_t anchor = 0;
+    if (sizeInByte > lz4MatchLimit)
+    {
+        // Greedy parsing with hash of 4 bytes
+        const uint32_t hashBits = 16;
+        std::vector<uint32_t> table(size_t(1) << hashBits, std::numeric_limits<uint32_t>::max());
+        auto read32 = [&](const size_t position)
+        {
+            uint32_t value;
+            memcpy(&value, &data[position], sizeof(value));
+            return value;
+        };
+
+        const size_t matchStartLimit = sizeInByte - lz4MatchLimit;
+        const size_t matchEndLimit   = sizeInByte - lz4LastLiterals;
+        size_t position = 0;
+        while (position < matchStartLimit)
+        {
+            const uint32_t sequence  = read32(position);
+            const uint32_t hash      = (sequence * 2654435761u) >> (32 - hashBits);
+            const size_t   candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(position);
+
+            if (candidate == std::numeric_limits<uint32_t>::max() || position - candidate > lz4MaxOffset || read32(candidate) != sequence)
+            {
+                ++position;
+                continue;
+            }
+
+            size_t matchLength = lz4MinMatch;
+            while (position + matchLength < matchEndLimit && data[candidate + matchLength] == data[position + matchLength])
+            {
+                ++matchLength;
+            }
+
+            writeLZ4Sequence(output, &data[anchor], position - anchor, position - candidate, matchLength);
+            position += matchLength;
+            anchor    = position;
+        }
+    }
+
+    // Last literals
+    writeLZ4Sequence(output, &data[anchor], sizeInByte - anchor, 0, 0);
+    return output;
+}
+
+void Archive::decompressLZ4(const uint8_t* data, const size_t sizeInByte, uint8_t* output, const size_t outputSize)
+{
+    const uint8_t* input    = data;
+    const uint8_t* inputEnd = data + sizeInByte;
+    size_t         written  = 0;
+    while (input < inputEnd)
+    {
+        const uint8_t token = *input++;
+
+        // Literals
+        const size_t nbLiterals = readLZ4Length(input, inputEnd, token >> 4);
+        if (nbLiterals > static_cast<size_t>(inputEnd - input) || nbLiterals > outputSize - written)
+        {
+            throwCorrupted();
+        }
+        if (nbLiterals > 0)
+        {
+            memcpy(&output[written], input, nbLiterals);
+        }
+        input   += nbLiterals;
+        written += nbLiterals;
+        if (input == inputEnd)
+        {
+            break;
+        }
+
+        // Match (may overlap current output)
+        if (inputEnd - input < 2)
+        {
+            throwCorrupted();
+        }
+        const size_t offset = static_cast<size_t>(input[0]) | (static_cast<size_t>(input[1]) << 8);
+        input += 2;
+        const size_t matchLength = readLZ4Length(input, inputEnd, token & 0x0F) + lz4MinMatch;
+        if (offset == 0 || offset > written || matchLength > outputSize - written)
+        {
+            throwCorrupted();
+        }
+        for (size_t id = 0; id < matchLength; ++id, ++written)
+        {
+            output[written] = output[written - offset];
+        }
+    }
+
+    if (written != outputSize)
+    {
+        throwCorrupted();
+    }
+}
+
+//------------------------------------------------------------------------------------------
+//                                      ArchiveWriter
+//------------------------------------------------------------------------------------------
+void ArchiveWriter::addSection(const String& name, const uint32_t version, const ArchiveStream& content, const Archive::Compression compression)
+{
+    MouCa::preCondition(!name.empty());
+    MouCa::preCondition(std::find_if(_sections.cbegin(), _sections.cend(), [&](const auto& section) { return section._name == name; }) == _sections.cend()); //DEV Issue: Unique name.
+
+    const auto* data = reinterpret_cast<const uint8_t*>(content.getBuffer().getData());
+
+    Section section{ name, version, Archive::Compression::None, content.size(), {} };
+    if (compression == Archive::Compression::LZ4)
+    {
+        section._data = Archive::compressLZ4(data, content.size());
+        section._compression = Archive::Compression::LZ4;
+    }
+
+    // Keep raw data when compression is useless
+    if (section._compression == Archive::Compression::None || section._data.size() >= content.size())
+    {
+        section._data.assign(data, data + content.size());
+        section._compression = Archive::Compression::None;
+    }
+    _sections.emplace_back(std::move(section));
+}
+
+void ArchiveWriter::write(ByteBuffer& output) const
+{
+    size_t dataSize = 0;
+    for (const auto& section : _sections)
+    {
+        dataSize += section._data.size();
+    }
+
+    // Table
+    ArchiveStream table;
+    table.writeVarint(_sections.size());
+    uint64_t offset = Archive::headerSize;
+    for (const auto& section : _sections)
+    {
+        table << section._name;
+        table.writeVarint(section._version);
+        table << section._compression;
+        table.writeVarint(offset);
+        table.writeVarint(section._data.size());
+        table.writeVarint(section._rawSize);
+        table << computeChecksum(section._data.data(), section._data.size());
+        offset += section._data.size();
+    }
+
+    ArchiveStream header;
+    for (const auto byte : archiveMagic)
+    {
+        header << byte;
+    }
+    header << Archive::formatVersion;
+
+    ArchiveStream footer;
+    footer << offset << static_cast<uint32_t>(table.size());
+    for (const auto byte : archiveMagic)
+    {
+        footer << byte;
+    }
+
+    // Header + data + table + footer
+    output = ByteBuffer();
+    output.reserve(Archive::headerSize + dataSize + table.size() + Archive::footerSize);
+    output << header.getBuffer();
+    for (const auto& section : _sections)
+    {
+        output.append(section._data.data(), section._data.size());
+    }
+    output << table.getBuffer() << footer.getBuffer();
+
+    MouCa::postCondition(output.size() == Archive::headerSize + dataSize + table.size() + Archive::footerSize);
+}
+
+void ArchiveWriter::save(const Path& filename) const
+{
+    MouCa::preCondition(!filename.empty());
+
+    ByteBuffer archive;
+    write(archive);
+
+    File file(filename);
+    file.open(L"wb");
+    const size_t written = archive.write(file);
+    file.close();
+    if (written != archive.size())
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "InvalidPathError") << filename.string());
+    }
+}
+
+//------------------------------------------------------------------------------------------
+//                                      ArchiveReader
+//------------------------------------------------------------------------------------------
+ArchiveReader::~ArchiveReader()
+{
+    close();
+}
+
+void ArchiveReader::open(const void* data, const size_t sizeInByte)
+{
+    MouCa::preCondition(isNull());
+    MouCa::preCondition(data != nullptr);
+
+    _memory = reinterpret_cast<const uint8_t*>(data);
+    try
+    {
+        readTable(sizeInByte);
+    }
+    catch (...)
+    {
+        close();
+        throw;
+    }
+
+    MouCa::postCondition(!isNull());
+}
+
+void ArchiveReader::open(const Path& filename)
+{
+    MouCa::preCondition(isNull());
+
+    _file.setFileInfo(filename);
+    _file.open(L"rb");
+    try
+    {
+        readTable(_file.getSizeOfFile());
+    }
+    catch (...)
+    {
+        close();
+        throw;
+    }
+
+    MouCa::postCondition(!isNull());
+}
+
+void ArchiveReader::close()
+{
+    if (_file.isLoaded())
+    {
+        _file.close();
+    }
+    _memory = nullptr;
+    _sections.clear();
+}
+
+std::vector<String> ArchiveReader::getSectionNames() const
+{
+    std::vector<String> names;
+    names.reserve(_sections.size());
+    for (const auto& section : _sections)
+    {
+        names.emplace_back(section.first);
+    }
+    return names;
+}
+
+void ArchiveReader::read(const uint64_t offset, void* data, const size_t sizeInByte) const
+{
+    if (_memory != nullptr)
+    {
+        memcpy(data, &_memory[offset], sizeInByte);
+    }
+    else if (_file.read(static_cast<size_t>(offset), data, sizeInByte) != sizeInByte)
+    {
+        throwCorrupted();
+    }
+}
+
+void ArchiveReader::readTable(const uint64_t archiveSize)
+{
+    if (archiveSize < Archive::headerSize + Archive::footerSize)
+    {
+        throwCorrupted();
+    }
+
+    // Header
+    std::array<uint8_t, Archive::headerSize> headerData;
+    read(0, headerData.data(), headerData.size());
+    ArchiveStream header;
+    header.readBuffer(headerData.data(), headerData.size());
+    std::array<uint8_t, 4> magic;
+    uint32_t version;
+    header >> magic[0] >> magic[1] >> magic[2] >> magic[3] >> version;
+    if (magic != archiveMagic || version != Archive::formatVersion)
+    {
+        throwCorrupted();
+    }
+
+    // Footer
+    std::array<uint8_t, Archive::footerSize> footerData;
+    read(archiveSize - Archive::footerSize, footerData.data(), footerData.size());
+    ArchiveStream footer;
+    footer.readBuffer(footerData.data(), footerData.size());
+    uint64_t tableOffset;
+    uint32_t tableSize;
+    footer >> tableOffset >> tableSize >> magic[0] >> magic[1] >> magic[2] >> magic[3];
+    // Never add offsets read from file: sum can overflow
+    const uint64_t tableEnd = archiveSize - Archive::footerSize;
+    if (magic != archiveMagic || tableOffset < Archive::headerSize || tableOffset > tableEnd || tableSize != tableEnd - tableOffset)
+    {
+        throwCorrupted();
+    }
+
+    // Table
+    std::vector<uint8_t> tableData(tableSize);
+    read(tableOffset, tableData.data(), tableData.size());
+    ArchiveStream table;
+    table.readBuffer(tableData.data(), tableData.size());
+
+    const uint64_t nbSections = table.readVarint();
+    for (uint64_t id = 0; id < nbSections; ++id)
+    {
+        String name;
+        Section section;
+        table >> name;
+        section._version = static_cast<uint32_t>(table.readVarint());
+        table >> section._compression;
+        section._offset     = table.readVarint();
+        section._storedSize = table.readVarint();
+        section._rawSize    = table.readVarint();
+        table >> section._checksum;
+
+        if (section._compression > Archive::Compression::LZ4
+         || section._offset < Archive::headerSize || section._offset > tableOffset || section._storedSize > tableOffset - section._offset
+         || (section._compression == Archive::Compression::None && section._storedSize != section._rawSize))
+        {
+            throwCorrupted();
+        }
+        _sections[name] = section;
+    }
+}
+
+void ArchiveReader::readSection(const String& name, ArchiveStream& content) const
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(hasSection(name));
+
+    const auto& section = _sections.at(name);
+
+    // Use archive memory directly when possible
+    std::vector<uint8_t> stored;
+    const uint8_t* data = nullptr;
+    if (_memory != nullptr)
+    {
+        data = &_memory[section._offset];
+    }
+    else
+    {
+        stored.resize(static_cast<size_t>(section._storedSize));
+        read(section._offset, stored.data(), stored.size());
+        data = stored.data();
+    }
+
+    if (computeChecksum(data, static_cast<size_t>(section._storedSize)) != section._checksum)
+    {
+        throwCorrupted();
+    }
+
+    if (section._compression == Archive::Compression::LZ4)
+    {
+        std::vector<uint8_t> raw(static_cast<size_t>(section._rawSize));
+        Archive::decompressLZ4(data, static_cast<size_t>(section._storedSize), raw.data(), raw.size());
+        content.readBuffer(raw.data(), raw.size());
+    }
+    else
+    {
+        content.readBuffer(data, static_cast<size_t>(section._storedSize));
+    }
+}
+
+}
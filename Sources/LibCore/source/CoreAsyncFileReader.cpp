@@ -0,0 +1,169 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibCore/include/CoreAsyncFileReader.h"
+#include "LibCore/include/CoreException.h"
+
+#ifdef MOUCA_OS_WINDOWS
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+namespace Core
+{
+
+void AsyncFileReader::initialize(const uint32_t nbThreads)
+{
+    MouCa::preCondition(isNull());
+    MouCa::preCondition(nbThreads > 0);
+
+    _run = true;
+    for (uint32_t id = 0; id < nbThreads; ++id)
+    {
+        _workers.emplace_back(std::make_unique<Worker>(*this));
+        _workers.back()->start();
+    }
+
+    MouCa::postCondition(!isNull());
+}
+
+void AsyncFileReader::release()
+{
+    MouCa::preCondition(!isNull());
+
+    {
+        std::lock_guard<std::mutex> lock(_jobMutex);
+        _run = false;
+    }
+    _waitJob.notify_all();
+
+    for (auto& worker : _workers)
+    {
+        worker->join();
+    }
+    _workers.clear();
+
+    MouCa::postCondition(isNull());
+    MouCa::postCondition(_jobs.empty());
+}
+
+std::future<AsyncFileReader::Batch> AsyncFileReader::read(const Path& filename, Batch&& batch)
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(!filename.empty());
+
+    std::future<Batch> result;
+    {
+        std::lock_guard<std::mutex> lock(_jobMutex);
+        _jobs.push_back({ filename, std::move(batch), std::promise<Batch>() });
+        result = _jobs.back()._promise.get_future();
+    }
+    _waitJob.notify_one();
+    return result;
+}
+
+void AsyncFileReader::readNow(const Path& filename, Batch& batch)
+{
+    // Read in file order: sort indirection to keep batch order for caller
+    std::vector<size_t> order(batch.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](const size_t a, const size_t b) { return batch[a]._offset < batch[b]._offset; });
+
+#ifdef MOUCA_OS_WINDOWS
+    const HANDLE file = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "InvalidPathError") << filename.string());
+    }
+
+    bool success = true;
+    for (const size_t id : order)
+    {
+        auto& request = batch[id];
+        request._read = 0;
+        while (success && request._read < request._size)
+        {
+            // Positional read: offset is given by OVERLAPPED (no shared seek)
+            const uint64_t offset = request._offset + request._read;
+            OVERLAPPED position{};
+            position.Offset     = static_cast<DWORD>(offset);
+            position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+            const DWORD toRead = static_cast<DWORD>(std::min<size_t>(request._size - request._read, std::numeric_limits<DWORD>::max()));
+            DWORD read = 0;
+            success = ReadFile(file, reinterpret_cast<uint8_t*>(request._output) + request._read, toRead, &read, &position) || GetLastError() == ERROR_HANDLE_EOF;
+            request._read += read;
+            if (read == 0)
+            {
+                break;
+            }
+        }
+    }
+    CloseHandle(file);
+#else
+    const int file = ::open(filename.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "InvalidPathError") << filename.string());
+    }
+
+    bool success = true;
+    for (const size_t id : order)
+    {
+        auto& request = batch[id];
+        request._read = 0;
+        while (success && request._read < request._size)
+        {
+            const ssize_t read = pread(file, reinterpret_cast<uint8_t*>(request._output) + request._read, request._size - request._read, static_cast<off_t>(request._offset + request._read));
+            success = read >= 0;
+            if (read <= 0)
+            {
+                break;
+            }
+            request._read += static_cast<size_t>(read);
+        }
+    }
+    ::close(file);
+#endif
+
+    if (!success)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "InvalidFileRead") << filename.string());
+    }
+}
+
+void AsyncFileReader::Worker::run()
+{
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(_reader._jobMutex);
+            _reader._waitJob.wait(lock, [&]() { return !_reader._jobs.empty() || !_reader._run; });
+
+            // Finish pending jobs before leaving
+            if (_reader._jobs.empty())
+            {
+                return;
+            }
+            job = std::move(_reader._jobs.front());
+            _reader._jobs.pop_front();
+        }
+
+        try
+        {
+            readNow(job._filename, job._batch);
+            job._promise.set_value(std::move(job._batch));
+        }
+        catch (...)
+        {
+            job._promise.set_exception(std::current_exception());
+        }
+    }
+}
+
+}
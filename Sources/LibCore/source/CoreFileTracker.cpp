@@ -5,6 +5,7 @@
 
 #include "LibCore/include/CoreError.h"
 #include "LibCore/include/CoreException.h"
+#include "LibCore/include/CoreLogger.h"
 #include "LibCore/include/CoreResource.h"
 #include "LibCore/include/CoreFileTracker.h"
 
@@ -190,7 +191,7 @@ void FileTracker::TrackerThread::run()
                             const auto newTime = std::filesystem::last_write_time( resource->getTrackedFilename() );
                             if( newTime != fileInfo._lastEdited )
                             {
-                                MouCa::logConsole(std::format("FileTracker: {} has changed.", resource->getTrackedFilename().string()));
+                                MOUCA_LOG_INFO(Core, "FileTracker: {} has changed.", resource->getTrackedFilename().string());
 
                                 // Update time
                                 fileInfo._lastEdited = newTime;
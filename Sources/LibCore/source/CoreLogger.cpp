@@ -0,0 +1,452 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibCore/include/CoreException.h"
+#include "LibCore/include/CoreLogger.h"
+
+namespace Core
+{
+
+static_assert((Logger::_capacity & (Logger::_capacity - 1)) == 0, "Capacity must be power of 2");
+
+// Records of one thread: only owner writes, sink reads
+struct Logger::ThreadQueue
+{
+    explicit ThreadQueue(const uint32_t threadID):
+    _records(std::make_unique<std::optional<Record>[]>(_capacity)), _threadID(threadID)
+    {}
+
+    std::unique_ptr<std::optional<Record>[]> _records;          ///< Ring buffer.
+    alignas(64) std::atomic<uint64_t>        _write   = 0;      ///< Number of pushed records (owner).
+    alignas(64) std::atomic<uint64_t>        _read    = 0;      ///< Number of consumed records (sink).
+    std::atomic<uint64_t>                    _dropped = 0;      ///< Lost records since last drain.
+    std::atomic<bool>                        _closed  = false;  ///< Owner thread is finished.
+    const uint32_t                           _threadID;         ///< Logger id of thread.
+};
+
+// Background thread and outputs
+struct Logger::Sink
+{
+    // Mark queue as removable when thread ends
+    struct QueueOwner
+    {
+        ~QueueOwner()
+        {
+            if (_queue != nullptr)
+            {
+                _queue->_closed.store(true, std::memory_order_release);
+            }
+        }
+
+        std::shared_ptr<ThreadQueue> _queue;
+    };
+
+    ~Sink()
+    {
+        // Application forgot release(): avoid std::terminate
+        if (_thread.joinable())
+        {
+            stop();
+        }
+    }
+
+    static Sink& get()
+    {
+        static Sink sink;
+        return sink;
+    }
+
+    static ThreadQueue& getThreadQueue()
+    {
+        // Registration is done only once by thread
+        thread_local QueueOwner owner;
+        if (owner._queue == nullptr)
+        {
+            auto& sink = get();
+            std::lock_guard<std::mutex> lock(sink._lock);
+            owner._queue = std::make_shared<ThreadQueue>(sink._nextThreadID++);
+            sink._queues.emplace_back(owner._queue);
+        }
+        return *owner._queue;
+    }
+
+    void stop()
+    {
+        _initialized.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _run = false;
+        }
+        _wakeUp.notify_one();
+        _thread.join();
+
+        std::lock_guard<std::mutex> lock(_writeLock);
+        _file.close();
+        _configuration = Configuration();
+    }
+
+    void run()
+    {
+        std::vector<std::shared_ptr<ThreadQueue>> queues;
+        std::vector<Record> records;
+        while (true)
+        {
+            uint64_t request;
+            bool     run;
+            {
+                std::unique_lock<std::mutex> lock(_lock);
+                _wakeUp.wait_for(lock, std::chrono::milliseconds(10), [&]() { return !_run || _flushRequest != _flushDone; });
+                request = _flushRequest;
+                run     = _run;
+
+                // Forget finished threads
+                std::erase_if(_queues, [](const auto& queue)
+                {
+                    return queue->_closed.load(std::memory_order_acquire)
+                        && queue->_read.load(std::memory_order_relaxed) == queue->_write.load(std::memory_order_acquire);
+                });
+                queues = _queues;
+            }
+
+            // Move records out of queues to release producers as soon as possible
+            uint64_t dropped = 0;
+            for (const auto& queue : queues)
+            {
+                uint64_t       read  = queue->_read.load(std::memory_order_relaxed);
+                const uint64_t write = queue->_write.load(std::memory_order_acquire);
+                for (; read < write; ++read)
+                {
+                    auto& slot = queue->_records[read & (_capacity - 1)];
+                    records.emplace_back(std::move(*slot));
+                    slot.reset();
+                }
+                queue->_read.store(read, std::memory_order_release);
+                dropped += queue->_dropped.exchange(0, std::memory_order_relaxed);
+            }
+            queues.clear();
+
+            write(records, dropped);
+            records.clear();
+
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                _flushDone = request;
+            }
+            _flushed.notify_all();
+
+            if (!run)
+            {
+                return;
+            }
+        }
+    }
+
+    void write(const std::vector<Record>& records, const uint64_t dropped)
+    {
+        if (records.empty() && dropped == 0)
+        {
+            return;
+        }
+
+        // Merge threads by time
+        std::vector<const Record*> sorted;
+        sorted.reserve(records.size());
+        for (const auto& record : records)
+        {
+            sorted.emplace_back(&record);
+        }
+        std::stable_sort(sorted.begin(), sorted.end(), [](const Record* a, const Record* b) { return a->_time < b->_time; });
+
+        std::lock_guard<std::mutex> lock(_writeLock);
+        if (dropped > 0)
+        {
+            _dropped.fetch_add(dropped, std::memory_order_relaxed);
+            writeLine(std::format("[{}] Logger: {} records lost (queue full)\n", getLabel(Severity::Warning), dropped));
+        }
+        for (const auto* record : sorted)
+        {
+            write(*record);
+        }
+        if (_file.is_open())
+        {
+            _file.flush();
+        }
+    }
+
+    void write(const Record& record)
+    {
+        String message;
+        try
+        {
+            record._formatter(message);
+        }
+        catch (const std::exception& exception)
+        {
+            message = std::format("Invalid format: {}", exception.what());
+        }
+
+        // UTC time
+        const auto time = std::chrono::sys_time<std::chrono::milliseconds>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(record._time)));
+        const auto day  = std::chrono::floor<std::chrono::days>(time);
+        const std::chrono::year_month_day date(day);
+        const std::chrono::hh_mm_ss<std::chrono::milliseconds> hour(time - day);
+
+        String line = std::format("{:04}-{:02}-{:02} {:02}:{:02}:{:02}.{:03} [{}] [{}] [{}] {}",
+                                  static_cast<int>(date.year()), static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()),
+                                  hour.hours().count(), hour.minutes().count(), hour.seconds().count(), hour.subseconds().count(),
+                                  getLabel(record._severity), getLabel(record._category), record._threadID, message);
+        if (record._severity >= Severity::Warning)
+        {
+            line += std::format(" ({}:{})", record._file, record._line);
+        }
+        if (line.back() != '\n')
+        {
+            line += '\n';
+        }
+        writeLine(line);
+        _written.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void writeLine(const String& line)
+    {
+        if (_configuration._console)
+        {
+            std::cout << line;
+            MouCa::logVisualStudio(line);
+        }
+
+        if (_file.is_open())
+        {
+            if (_fileSize > 0 && _fileSize + line.size() > _configuration._maxFileSize)
+            {
+                rotate();
+            }
+            _file << line;
+            _fileSize += line.size();
+        }
+    }
+
+    Path getRotatedFile(const uint32_t id) const
+    {
+        Path filename = _configuration._filename;
+        filename.replace_extension(std::format(".{}{}", id, _configuration._filename.extension().string()));
+        return filename;
+    }
+
+    void openFile()
+    {
+        std::error_code error;
+        const auto size = std::filesystem::file_size(_configuration._filename, error);
+        _fileSize = error ? 0 : static_cast<size_t>(size);
+
+        _file.open(_configuration._filename, std::ios::binary | std::ios::app);
+        if (!_file.is_open())
+        {
+            throw Core::Exception(Core::ErrorData("BasicError", "InvalidPathError") << _configuration._filename.string());
+        }
+    }
+
+    void rotate()
+    {
+        _file.close();
+
+        // Shift files: name.ext -> name.1.ext -> name.2.ext ... (oldest is removed)
+        std::error_code error;
+        if (_configuration._nbFiles > 0)
+        {
+            std::filesystem::remove(getRotatedFile(_configuration._nbFiles), error);
+            for (uint32_t id = _configuration._nbFiles; id > 1; --id)
+            {
+                std::filesystem::rename(getRotatedFile(id - 1), getRotatedFile(id), error);
+            }
+            std::filesystem::rename(_configuration._filename, getRotatedFile(1), error);
+        }
+
+        _file.open(_configuration._filename, std::ios::binary | std::ios::trunc);
+        _fileSize = 0;
+    }
+
+    std::mutex                                _lock;                ///< Protect queues list, state and flush.
+    std::vector<std::shared_ptr<ThreadQueue>> _queues;              ///< Queues of all living threads.
+    uint32_t                                  _nextThreadID = 0;    ///< Id of next registered thread.
+    std::condition_variable                   _wakeUp;              ///< Wake up background thread.
+    std::condition_variable                   _flushed;             ///< Signal end of flush.
+    uint64_t                                  _flushRequest = 0;    ///< Last asked flush.
+    uint64_t                                  _flushDone    = 0;    ///< Last finished flush.
+    bool                                      _run          = false;///< Background thread is running.
+    std::thread                               _thread;              ///< Background thread.
+    std::atomic<bool>                         _initialized  = false;///< Records are pushed into queues.
+    std::mutex                                _usersLock;           ///< Protect _nbUsers (initialize/release).
+    uint32_t                                  _nbUsers      = 0;    ///< Number of initialize() without release().
+
+    std::mutex                                _writeLock;           ///< Protect outputs (background thread or direct write).
+    Configuration                             _configuration;       ///< Outputs.
+    std::ofstream                             _file;                ///< Current log file.
+    size_t                                    _fileSize     = 0;    ///< Size of current log file.
+    std::atomic<uint64_t>                     _written      = 0;    ///< Number of written records.
+    std::atomic<uint64_t>                     _dropped      = 0;    ///< Number of lost records.
+};
+
+Logger::Record::Record(const Category category, const Severity severity, const std::source_location& location, Callable<String&>&& formatter):
+_time(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count()),
+_file(location.file_name()), _line(location.line()), _threadID(0), _category(category), _severity(severity), _formatter(std::move(formatter))
+{}
+
+void Logger::initialize(const Configuration& configuration)
+{
+    auto& sink = Sink::get();
+    std::lock_guard<std::mutex> users(sink._usersLock);
+
+    // Already running: outputs of first user are kept
+    if (sink._nbUsers++ > 0)
+    {
+        MouCa::postCondition(isInitialized());
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sink._writeLock);
+        sink._configuration = configuration;
+        if (!configuration._filename.empty())
+        {
+            sink.openFile();
+        }
+    }
+
+    sink._run    = true;
+    sink._thread = std::thread(&Sink::run, &sink);
+    sink._initialized.store(true, std::memory_order_release);
+
+    MouCa::postCondition(isInitialized());
+}
+
+void Logger::release()
+{
+    auto& sink = Sink::get();
+    std::lock_guard<std::mutex> users(sink._usersLock);
+    MouCa::preCondition(sink._nbUsers > 0); // DEV Issue: call release() before initialize().
+
+    // Last user stops background thread
+    if (--sink._nbUsers == 0)
+    {
+        sink.stop();
+        MouCa::postCondition(!isInitialized());
+    }
+}
+
+bool Logger::isInitialized()
+{
+    return Sink::get()._initialized.load(std::memory_order_acquire);
+}
+
+void Logger::flush()
+{
+    auto& sink = Sink::get();
+    if (!isInitialized())
+    {
+        std::lock_guard<std::mutex> lock(sink._writeLock);
+        std::cout.flush();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(sink._lock);
+    const uint64_t request = ++sink._flushRequest;
+    sink._wakeUp.notify_one();
+    sink._flushed.wait(lock, [&]() { return sink._flushDone >= request || !sink._run; });
+}
+
+Logger::Statistics Logger::getStatistics()
+{
+    auto& sink = Sink::get();
+
+    Statistics statistics;
+    statistics._written = sink._written.load(std::memory_order_relaxed);
+    statistics._dropped = sink._dropped.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(sink._lock);
+    for (const auto& queue : sink._queues)
+    {
+        statistics._dropped += queue->_dropped.load(std::memory_order_relaxed);
+    }
+    return statistics;
+}
+
+void Logger::setLevel(const Severity minimum)
+{
+    for (auto& level : _levels)
+    {
+        level.store(minimum, std::memory_order_relaxed);
+    }
+}
+
+void Logger::setLevel(const Category category, const Severity minimum)
+{
+    MouCa::preCondition(category < Category::NbCategories);
+
+    _levels[static_cast<size_t>(category)].store(minimum, std::memory_order_relaxed);
+}
+
+const char* Logger::getLabel(const Severity severity)
+{
+    MouCa::preCondition(severity < Severity::NbSeverities);
+
+    static const std::array<const char*, static_cast<size_t>(Severity::NbSeverities)> labels =
+    {
+        "TRACE", "DEBUG", "INFO ", "WARN ", "ERROR", "CRIT "
+    };
+    return labels[static_cast<size_t>(severity)];
+}
+
+const char* Logger::getLabel(const Category category)
+{
+    MouCa::preCondition(category < Category::NbCategories);
+
+    static const std::array<const char*, static_cast<size_t>(Category::NbCategories)> labels =
+    {
+        "General", "Core", "Loader", "Media", "Render", "Vulkan"
+    };
+    return labels[static_cast<size_t>(category)];
+}
+
+void Logger::push(Record&& record)
+{
+    auto& sink  = Sink::get();
+    auto& queue = Sink::getThreadQueue();
+    record._threadID = queue._threadID;
+
+    // No background thread: write now
+    if (!sink._initialized.load(std::memory_order_acquire))
+    {
+        std::vector<Record> records;
+        records.emplace_back(std::move(record));
+        sink.write(records, 0);
+        return;
+    }
+
+    const uint64_t write = queue._write.load(std::memory_order_relaxed);
+    while (write - queue._read.load(std::memory_order_acquire) >= _capacity)
+    {
+        // Queue is full: errors wait background thread, others are lost
+        if (record._severity < Severity::Error || !sink._initialized.load(std::memory_order_acquire))
+        {
+            queue._dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        sink._wakeUp.notify_one();
+        std::this_thread::yield();
+    }
+
+    const bool urgent = record._severity >= Severity::Error;
+    queue._records[write & (_capacity - 1)].emplace(std::move(record));
+    queue._write.store(write + 1, std::memory_order_release);
+
+    // Otherwise background thread wakes up periodically
+    if (urgent || write - queue._read.load(std::memory_order_relaxed) == _capacity / 2)
+    {
+        sink._wakeUp.notify_one();
+    }
+}
+
+}
@@ -0,0 +1,180 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibCore/include/CoreException.h"
+#include "LibCore/include/CoreMappedFile.h"
+
+#ifdef MOUCA_OS_WINDOWS
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace Core
+{
+
+void MappedFile::open(const Advice advice)
+{
+    MouCa::preCondition(!_filename.empty());
+
+    close();
+
+#ifdef MOUCA_OS_WINDOWS
+    // Access pattern is given to cache manager at opening
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (advice == Advice::Sequential)
+    {
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    }
+    else if (advice == Advice::Random)
+    {
+        flags |= FILE_FLAG_RANDOM_ACCESS;
+    }
+
+    _fileHandle = CreateFileW(_filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+    if (_fileHandle == INVALID_HANDLE_VALUE)
+    {
+        _fileHandle = nullptr;
+        throw Core::Exception(Core::ErrorData("BasicError", "InvalidPathError") << _filename.string());
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(_fileHandle, &size))
+    {
+        close();
+        throw Core::Exception(Core::ErrorData("BasicError", "InvalidFileRead") << _filename.string());
+    }
+    _size   = static_cast<size_t>(size.QuadPart);
+    _opened = true;
+
+    // Empty file can't be mapped
+    if (_size > 0)
+    {
+        _mappingHandle = CreateFileMappingW(_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mappingHandle != nullptr)
+        {
+            _data = reinterpret_cast<const uint8_t*>(MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        }
+        if (_data == nullptr)
+        {
+            close();
+            throw Core::Exception(Core::ErrorData("BasicError", "InvalidFileRead") << _filename.string());
+        }
+    }
+#else
+    _descriptor = ::open(_filename.c_str(), O_RDONLY);
+    struct stat status;
+    if (_descriptor < 0 || fstat(_descriptor, &status) != 0)
+    {
+        close();
+        throw Core::Exception(Core::ErrorData("BasicError", "InvalidPathError") << _filename.string());
+    }
+    _size   = static_cast<size_t>(status.st_size);
+    _opened = true;
+
+    // Empty file can't be mapped
+    if (_size > 0)
+    {
+        void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _descriptor, 0);
+        if (data == MAP_FAILED)
+        {
+            close();
+            throw Core::Exception(Core::ErrorData("BasicError", "InvalidFileRead") << _filename.string());
+        }
+        _data = reinterpret_cast<const uint8_t*>(data);
+    }
+#endif
+
+    if (advice != Advice::Normal)
+    {
+        this->advise(advice);
+    }
+
+    MouCa::postCondition(isLoaded());
+}
+
+void MappedFile::close()
+{
+#ifdef MOUCA_OS_WINDOWS
+    if (_data != nullptr)
+    {
+        UnmapViewOfFile(_data);
+    }
+    if (_mappingHandle != nullptr)
+    {
+        CloseHandle(_mappingHandle);
+        _mappingHandle = nullptr;
+    }
+    if (_fileHandle != nullptr)
+    {
+        CloseHandle(_fileHandle);
+        _fileHandle = nullptr;
+    }
+#else
+    if (_data != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(_data), _size);
+    }
+    if (_descriptor >= 0)
+    {
+        ::close(_descriptor);
+        _descriptor = -1;
+    }
+#endif
+    _data   = nullptr;
+    _size   = 0;
+    _opened = false;
+}
+
+std::span<const uint8_t> MappedFile::getView(const size_t offset, const size_t sizeInByte) const
+{
+    MouCa::preCondition(isLoaded());
+
+    if (offset > _size || sizeInByte > _size - offset)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "InvalidReadingPositionError"));
+    }
+    return std::span<const uint8_t>(_data + offset, sizeInByte);
+}
+
+void MappedFile::advise(const Advice advice, const size_t offset, const size_t sizeInByte) const
+{
+    MouCa::preCondition(isLoaded());
+    MouCa::preCondition(offset <= _size);
+
+    const size_t size = sizeInByte == 0 ? _size - offset : std::min(sizeInByte, _size - offset);
+    if (size == 0)
+    {
+        return;
+    }
+
+#ifdef MOUCA_OS_WINDOWS
+    // Sequential/Random are managed at opening: only prefetch exists for mapped file
+    if (advice == Advice::WillNeed)
+    {
+        WIN32_MEMORY_RANGE_ENTRY range{ const_cast<uint8_t*>(_data + offset), size };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+#else
+    // madvise needs address aligned on page
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t begin    = offset - (offset % pageSize);
+
+    int flag = MADV_NORMAL;
+    switch (advice)
+    {
+        case Advice::Sequential: flag = MADV_SEQUENTIAL; break;
+        case Advice::Random:     flag = MADV_RANDOM;     break;
+        case Advice::WillNeed:   flag = MADV_WILLNEED;   break;
+        case Advice::DontNeed:   flag = MADV_DONTNEED;   break;
+        default:                                         break;
+    }
+    madvise(const_cast<uint8_t*>(_data + begin), size + offset - begin, flag);
+#endif
+}
+
+}
@@ -0,0 +1,223 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibCore/include/CoreMemory.h"
+
+namespace Core
+{
+
+namespace
+{
+    // Count allocations done on heap by Core resources
+    class HeapResource final : public std::pmr::memory_resource
+    {
+        public:
+            std::atomic<uint64_t> _nbAllocations   = 0;
+            std::atomic<uint64_t> _nbDeallocations = 0;
+            std::atomic<uint64_t> _allocatedBytes  = 0;
+
+        private:
+            void* do_allocate(size_t bytes, size_t alignment) override
+            {
+                void* pointer = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+                _nbAllocations.fetch_add(1, std::memory_order_relaxed);
+                _allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+                return pointer;
+            }
+
+            void do_deallocate(void* pointer, size_t bytes, size_t alignment) override
+            {
+                std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+                _nbDeallocations.fetch_add(1, std::memory_order_relaxed);
+                _allocatedBytes.fetch_sub(bytes, std::memory_order_relaxed);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+    };
+
+    HeapResource& getHeap()
+    {
+        static HeapResource heap;
+        return heap;
+    }
+
+    size_t alignUp(const size_t value, const size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+//----------------------------------------------------------------------------
+std::pmr::memory_resource* Memory::getHeapResource()
+{
+    return &getHeap();
+}
+
+Memory::Statistics Memory::getStatistics()
+{
+    const auto& heap = getHeap();
+
+    Statistics statistics;
+    statistics._nbAllocations   = heap._nbAllocations.load(std::memory_order_relaxed);
+    statistics._nbDeallocations = heap._nbDeallocations.load(std::memory_order_relaxed);
+    statistics._allocatedBytes  = heap._allocatedBytes.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+//----------------------------------------------------------------------------
+LinearArena::LinearArena(const size_t chunkSize, std::pmr::memory_resource* upstream):
+_upstream(upstream), _chunkSize(chunkSize), _current(0), _offset(0)
+{
+    MouCa::preCondition(_upstream != nullptr);
+    MouCa::preCondition(_chunkSize > 0);
+}
+
+LinearArena::~LinearArena()
+{
+    release();
+}
+
+LinearArena& LinearArena::getThreadArena()
+{
+    thread_local LinearArena arena;
+    return arena;
+}
+
+void LinearArena::rewind(const Marker& marker)
+{
+    MouCa::preCondition(marker._chunk < _current || (marker._chunk == _current && marker._offset <= _offset)); // DEV Issue: rewind in wrong order !
+
+    // Beginning: take opportunity to merge chunks
+    if (marker._chunk == 0 && marker._offset == 0)
+    {
+        reset();
+        return;
+    }
+    _current = marker._chunk;
+    _offset  = marker._offset;
+}
+
+void LinearArena::reset()
+{
+    if (_chunks.size() > 1)
+    {
+        const size_t capacity = getCapacity();
+        release();
+        _chunks.emplace_back(Chunk{ static_cast<std::byte*>(_upstream->allocate(capacity, alignof(std::max_align_t))), capacity });
+    }
+    _current = 0;
+    _offset  = 0;
+}
+
+void LinearArena::release()
+{
+    for (const auto& chunk : _chunks)
+    {
+        _upstream->deallocate(chunk._data, chunk._size, alignof(std::max_align_t));
+    }
+    _chunks.clear();
+    _current = 0;
+    _offset  = 0;
+}
+
+size_t LinearArena::getCapacity() const
+{
+    return std::accumulate(_chunks.cbegin(), _chunks.cend(), size_t(0), [](const size_t size, const Chunk& chunk) { return size + chunk._size; });
+}
+
+void* LinearArena::do_allocate(size_t bytes, size_t alignment)
+{
+    // Search space into current or next kept chunks
+    while (_current < _chunks.size())
+    {
+        const auto&  chunk = _chunks[_current];
+        const size_t begin = static_cast<size_t>(alignUp(reinterpret_cast<uintptr_t>(chunk._data) + _offset, alignment) - reinterpret_cast<uintptr_t>(chunk._data));
+        if (begin + bytes <= chunk._size)
+        {
+            _offset = begin + bytes;
+            return chunk._data + begin;
+        }
+        if (_current + 1 == _chunks.size())
+        {
+            break;
+        }
+        ++_current;
+        _offset = 0;
+    }
+
+    // New chunk: grow geometrically to limit number of chunks
+    const size_t size = std::max({ _chunkSize, _chunks.empty() ? size_t(0) : _chunks.back()._size * 2, bytes + alignment });
+    _chunks.emplace_back(Chunk{ static_cast<std::byte*>(_upstream->allocate(size, alignof(std::max_align_t))), size });
+    _current = _chunks.size() - 1;
+    _offset  = 0;
+    return do_allocate(bytes, alignment);
+}
+
+//----------------------------------------------------------------------------
+PoolResource::PoolResource(const size_t blockSize, const size_t nbBlocksByChunk, std::pmr::memory_resource* upstream):
+_upstream(upstream), _blockSize(alignUp(std::max(blockSize, sizeof(FreeBlock)), alignof(std::max_align_t))), _nbBlocksByChunk(nbBlocksByChunk)
+{
+    MouCa::preCondition(_upstream != nullptr);
+    MouCa::preCondition(_nbBlocksByChunk > 0);
+}
+
+PoolResource::~PoolResource()
+{
+    MouCa::preCondition(_nbUsed == 0); // DEV Issue: object still alive !
+
+    for (auto* chunk : _chunks)
+    {
+        _upstream->deallocate(chunk, _blockSize * _nbBlocksByChunk, alignof(std::max_align_t));
+    }
+}
+
+size_t PoolResource::getNbUsed() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _nbUsed;
+}
+
+void* PoolResource::do_allocate(size_t bytes, size_t alignment)
+{
+    if (!isBlock(bytes, alignment))
+    {
+        return _upstream->allocate(bytes, alignment);
+    }
+
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_free == nullptr)
+    {
+        // Thread new chunk into free list
+        auto* chunk = static_cast<std::byte*>(_upstream->allocate(_blockSize * _nbBlocksByChunk, alignof(std::max_align_t)));
+        _chunks.emplace_back(chunk);
+        for (size_t id = _nbBlocksByChunk; id > 0; --id)
+        {
+            _free = new (chunk + (id - 1) * _blockSize) FreeBlock{ _free };
+        }
+    }
+
+    FreeBlock* block = _free;
+    _free = block->_next;
+    ++_nbUsed;
+    return block;
+}
+
+void PoolResource::do_deallocate(void* pointer, size_t bytes, size_t alignment)
+{
+    if (!isBlock(bytes, alignment))
+    {
+        _upstream->deallocate(pointer, bytes, alignment);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _free = new (pointer) FreeBlock{ _free };
+    --_nbUsed;
+}
+
+}
@@ -4,61 +4,94 @@
 #include "Dependencies.h"
 
 #include "LibCore/include/CoreException.h"
+#include "LibCore/include/CoreLogger.h"
 #include "LibCore/include/CorePluginEntry.h"
 #include "LibCore/include/CorePluginManager.h"
+#include "LibCore/include/CoreProfiler.h"
+#include "LibCore/include/CoreThreadPools.h"
 
 #ifdef MOUCA_OS_WINDOWS
 #   include <windows.h>
 #   define DYNLIB_HANDLE         HMODULE
-#   define DYNLIB_LOAD( a )      LoadLibrary( a ) 
-#   define DYNLIB_GETSYM( a, b ) GetProcAddress( a, b ) 
-#   define DYNLIB_UNLOAD( a )    !FreeLibrary( a ) 
+#   define DYNLIB_LOAD( a )      LoadLibrary( a )
+#   define DYNLIB_GETSYM( a, b ) GetProcAddress( a, b )
+#   define DYNLIB_UNLOAD( a )    !FreeLibrary( a )
+#   define DYNLIB_ERROR()        std::to_string(GetLastError())
 #elif defined MOUCA_OS_LINUX
 #   include <dlfcn.h>
-#   define DYNLIB_HANDLE         void* 
-#   define DYNLIB_LOAD( a )      dlopen( a, RTLD_LAZY ) 
-#   define DYNLIB_GETSYM( a, b ) dlsym( a, b ) 
-#   define DYNLIB_UNLOAD( a )    dlclose( a ) 
-#endif 
+#   define DYNLIB_HANDLE         void*
+#   define DYNLIB_LOAD( a )      dlopen( a, RTLD_LAZY )
+#   define DYNLIB_GETSYM( a, b ) dlsym( a, b )
+#   define DYNLIB_UNLOAD( a )    dlclose( a )
+#   define DYNLIB_ERROR()        getDlError()
+#endif
 
 namespace Core
 {
 
-using PlugInLoadingEntryPoint = PlugInEntry* (CALLBACK *)(void);
+using PlugInLoadingEntryPoint = PlugInEntry* (MOUCA_PLUGIN_CALL *)(void);
 
-PlugInManager::PlugInArray::const_iterator PlugInManager::searchPlugIn(const PlugInManager::PlugInState& _instance) const
+namespace
 {
-    auto itSearch = _loadedPlugins.cbegin();
-    while(itSearch != _loadedPlugins.cend())
+#ifdef MOUCA_OS_LINUX
+    String getDlError()
     {
-        if(**itSearch == _instance)
-            break;
-        ++itSearch;
+        // dlerror() clears error: read only once
+        const char* error = dlerror();
+        return error != nullptr ? String(error) : String();
+    }
+#endif
+
+    double getElapsedMs(const std::chrono::steady_clock::time_point& start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    String trim(const String& text)
+    {
+        const auto begin = text.find_first_not_of(" \t\r");
+        if (begin == String::npos)
+        {
+            return String();
+        }
+        return text.substr(begin, text.find_last_not_of(" \t\r") - begin + 1);
     }
-    return itSearch;
 }
 
-PlugInEntrySPtr PlugInManager::loadDynamicLibrary(const Path& dynamicLibraryPath)
+PlugInManager::PlugInStateSPtr PlugInManager::searchPlugIn(const String& name) const
 {
-    MouCa::assertion(!dynamicLibraryPath.empty());
+    auto itSearch = _plugins.find(name);
+    return itSearch != _plugins.cend() ? itSearch->second : nullptr;
+}
+
+void PlugInManager::load(const PlugInStateSPtr& state)
+{
+    // Only one thread loads library: others wait instance
+    std::lock_guard<std::mutex> lockLoading(state->_loading);
+    if (state->_plugInInstance != nullptr)
+    {
+        return;
+    }
 
-    PlugInEntrySPtr pPlugInInformation;
+    MOUCA_PROFILE_ZONE("PlugInManager::load");
+    LoadingReport report;
+    report._name = state->_registered ? state->_information._name : state->_name.string();
 
-    //Search if plugIn is already loaded
-    auto itPlugIn = searchPlugIn(PlugInState(dynamicLibraryPath));
-    if(itPlugIn==_loadedPlugins.cend())
+    const auto start = std::chrono::steady_clock::now();
+    DYNLIB_HANDLE hGetProcIDDLL = DYNLIB_LOAD(state->_name.c_str());
+    if(!hGetProcIDDLL)
     {
-        DYNLIB_HANDLE hGetProcIDDLL = DYNLIB_LOAD(dynamicLibraryPath.c_str());
-        if(!hGetProcIDDLL)
-        {
-            throw Core::Exception(Core::ErrorData("BasicError", "DLLLoadingMissingFile") << dynamicLibraryPath.string());
-        }
+        throw Core::Exception(Core::ErrorData("BasicError", "DLLLoadingMissingFile") << state->_name.string());
+    }
 
+    PluginEntrySPtr instance;
+    try
+    {
         //Try to load entry point
         auto pLauncher = reinterpret_cast<PlugInLoadingEntryPoint>(DYNLIB_GETSYM(hGetProcIDDLL, "PlugInLoadingEntryPoint"));
         if(pLauncher==nullptr)
         {
-            throw Core::Exception(Core::ErrorData("BasicError", "DLLMissingEntryPointFile") << std::to_string(GetLastError()));
+            throw Core::Exception(Core::ErrorData("BasicError", "DLLMissingEntryPointFile") << DYNLIB_ERROR());
         }
 
         auto pPlugInInstance = pLauncher();
@@ -66,28 +99,274 @@ PlugInEntrySPtr PlugInManager::loadDynamicLibrary(const Path& dynamicLibraryPath
         {
             throw Core::Exception(Core::ErrorData("BasicError", "DLLCorruptionFile"));
         }
+        instance = PluginEntrySPtr(pPlugInInstance);
+        report._loadingTime = getElapsedMs(start);
+
+        // Manager owns life of registered plugins
+        if (state->_registered)
+        {
+            const auto startInitialize = std::chrono::steady_clock::now();
+            instance->initialize();
+            report._initializeTime = getElapsedMs(startInitialize);
+        }
+    }
+    catch (...)
+    {
+        instance.reset();
+        static_cast<void>(DYNLIB_UNLOAD(hGetProcIDDLL));
+        throw;
+    }
+
+    MOUCA_LOG_INFO(Core, "PlugIn {}: loading {:.2f} ms, initialize {:.2f} ms", report._name, report._loadingTime, report._initializeTime);
+
+    //Memorize PlugIn
+    state->_hHandle        = hGetProcIDDLL;
+    state->_plugInInstance = instance;
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _loadedPlugins.emplace_back(state);
+    _reports.emplace_back(std::move(report));
+}
+
+void PlugInManager::checkDependencies(const String& name, std::vector<String>& stack) const
+{
+    auto state = searchPlugIn(name);
+    if (state == nullptr || !state->_registered)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "PlugInUnknownError") << name);
+    }
+    if (std::find(stack.cbegin(), stack.cend(), name) != stack.cend())
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "PlugInDependencyError") << name);
+    }
+
+    stack.emplace_back(name);
+    for (const auto& dependency : state->_information._dependencies)
+    {
+        checkDependencies(dependency, stack);
+    }
+    stack.pop_back();
+}
+
+PlugInEntrySPtr PlugInManager::loadDynamicLibrary(const Path& dynamicLibraryPath)
+{
+    MouCa::assertion(!dynamicLibraryPath.empty());
+
+    //Search if plugIn is already known
+    PlugInStateSPtr state;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        state = searchPlugIn(dynamicLibraryPath.string());
+        if (state == nullptr)
+        {
+            state = std::make_shared<PlugInState>(dynamicLibraryPath.wstring());
+            _plugins.emplace(dynamicLibraryPath.string(), state);
+        }
+    }
+
+    load(state);
+    return state->_plugInInstance;
+}
+
+String PlugInManager::registerPlugIn(const Path& manifest)
+{
+    std::ifstream file(manifest);
+    if (!file.is_open())
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "InvalidPathError") << manifest.string());
+    }
+
+    // Read "key=value" lines
+    PlugInInformation information;
+    String line;
+    while (std::getline(file, line))
+    {
+        line = trim(line);
+        if (line.empty() || line.front() == '#')
+        {
+            continue;
+        }
+
+        const auto separator = line.find('=');
+        if (separator == String::npos)
+        {
+            throw Core::Exception(Core::ErrorData("BasicError", "PlugInManifestError") << manifest.string() << line);
+        }
+        const String key   = trim(line.substr(0, separator));
+        const String value = trim(line.substr(separator + 1));
+        if (key == "name")
+        {
+            information._name = value;
+        }
+        else if (key == "library")
+        {
+            information._library = manifest.parent_path() / Path(value);
+        }
+        else if (key == "version")
+        {
+            information._version = value;
+        }
+        else if (key == "dependencies")
+        {
+            std::stringstream dependencies(value);
+            String dependency;
+            while (std::getline(dependencies, dependency, ','))
+            {
+                dependency = trim(dependency);
+                if (!dependency.empty())
+                {
+                    information._dependencies.emplace_back(dependency);
+                }
+            }
+        }
+    }
+
+    if (information._name.empty() || information._library.empty())
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "PlugInManifestError") << manifest.string() << "name/library");
+    }
+
+    auto state = std::make_shared<PlugInState>(information._library.wstring());
+    state->_information = information;
+    state->_registered  = true;
+
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_plugins.emplace(information._name, state).second)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "PlugInManifestError") << manifest.string() << information._name);
+    }
+    return information._name;
+}
+
+size_t PlugInManager::registerFolder(const Path& folder)
+{
+    if (!std::filesystem::is_directory(folder))
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "InvalidPathError") << folder.string());
+    }
+
+    // Same order on all platforms
+    std::vector<Path> manifests;
+    for (const auto& entry : std::filesystem::directory_iterator(folder))
+    {
+        if (entry.is_regular_file() && entry.path().extension() == ".plugin")
+        {
+            manifests.emplace_back(entry.path());
+        }
+    }
+    std::sort(manifests.begin(), manifests.end());
+
+    for (const auto& manifest : manifests)
+    {
+        registerPlugIn(manifest);
+    }
+    return manifests.size();
+}
+
+PlugInEntrySPtr PlugInManager::getPlugIn(const String& name)
+{
+    PlugInStateSPtr state;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        std::vector<String> stack;
+        checkDependencies(name, stack);
+        state = searchPlugIn(name);
+    }
+
+    {
+        std::lock_guard<std::mutex> lockLoading(state->_loading);
+        if (state->_plugInInstance != nullptr)
+        {
+            return state->_plugInInstance;
+        }
+    }
+
+    // First use
+    for (const auto& dependency : state->_information._dependencies)
+    {
+        getPlugIn(dependency);
+    }
+    load(state);
+    return state->_plugInInstance;
+}
+
+void PlugInManager::preloadAll(ThreadPools& pools)
+{
+    MouCa::preCondition(pools.getNbWorkers() > 0); // DEV Issue: need workers !
+
+    // One task by plugin: dependencies become edges of graph
+    std::unordered_map<String, TaskSPtr> tasks;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        for (const auto& [name, state] : _plugins)
+        {
+            if (state->_registered)
+            {
+                std::vector<String> stack;
+                checkDependencies(name, stack);
+                tasks[name] = pools.createTask([this, state]() { load(state); });
+            }
+        }
+        for (const auto& [name, task] : tasks)
+        {
+            for (const auto& dependency : _plugins.at(name)->_information._dependencies)
+            {
+                pools.addDependency(task, tasks.at(dependency));
+            }
+        }
+    }
+
+    auto join = pools.createTask([]() {});
+    for (const auto& [name, task] : tasks)
+    {
+        pools.addDependency(join, task);
+        pools.submit(task);
+    }
+    pools.submit(join);
 
-        pPlugInInformation = PluginEntrySPtr(pPlugInInstance);
+    // Throw error of first failed plugin
+    pools.wait(join);
+}
+
+bool PlugInManager::isLoaded(const String& name) const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    const auto state = searchPlugIn(name);
+    return state != nullptr && std::find(_loadedPlugins.cbegin(), _loadedPlugins.cend(), state) != _loadedPlugins.cend();
+}
 
-        //Memorize PlugIn
-        auto* completPlugIn = new PlugInState(hGetProcIDDLL, dynamicLibraryPath, pPlugInInformation);
-        _loadedPlugins.push_back(std::shared_ptr<PlugInState>(completPlugIn));
+const PlugInManager::PlugInInformation& PlugInManager::getInformation(const String& name) const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    const auto state = searchPlugIn(name);
+    if (state == nullptr || !state->_registered)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "PlugInUnknownError") << name);
     }
-    else
-        pPlugInInformation = (*itPlugIn)->_plugInInstance;
+    return state->_information;
+}
 
-    return pPlugInInformation;
+std::vector<PlugInManager::LoadingReport> PlugInManager::getLoadingReports() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _reports;
 }
 
 void PlugInManager::release()
 {
-    for(auto& plugIn : _loadedPlugins)
+    // Dependent plugins are released before their dependencies
+    for(auto itPlugIn = _loadedPlugins.rbegin(); itPlugIn != _loadedPlugins.rend(); ++itPlugIn)
     {
+        auto& plugIn = *itPlugIn;
         MouCa::assertion(plugIn->_plugInInstance.use_count() <= 1); // DEV Issue: Need latest instance to guaranty memory security !
 
         // Clean instance
+        if (plugIn->_registered)
+        {
+            plugIn->_plugInInstance->release();
+        }
         plugIn->_plugInInstance.reset();
-        
+
         // Remove DLL handle
         if(DYNLIB_UNLOAD((DYNLIB_HANDLE)plugIn->_hHandle))
         {
@@ -95,6 +374,8 @@ void PlugInManager::release()
         }
     }
     _loadedPlugins.clear();
+    _plugins.clear();
+    _reports.clear();
 }
 
-}
\ No newline at end of file
+}
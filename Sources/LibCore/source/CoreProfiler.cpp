@@ -0,0 +1,253 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibCore/include/CoreException.h"
+#include "LibCore/include/CoreProfiler.h"
+
+namespace Core
+{
+
+namespace
+{
+    static_assert((Profiler::_capacity & (Profiler::_capacity - 1)) == 0, "Capacity must be power of 2");
+
+    // Events of one thread: only owner writes, export reads
+    struct ThreadBuffer
+    {
+        explicit ThreadBuffer(const uint32_t threadID):
+        _events(std::make_unique<Profiler::Event[]>(Profiler::_capacity)), _threadID(threadID)
+        {}
+
+        //------------------------------------------------------------------------
+        /// \brief  Copy recorded events (oldest first).
+        ///
+        /// \param[in,out] events: list to complete.
+        void copyEvents(std::vector<Profiler::Event>& events) const
+        {
+            if (_events == nullptr)
+            {
+                events.insert(events.end(), _kept.cbegin(), _kept.cend());
+                return;
+            }
+            const uint64_t write = _write.load(std::memory_order_acquire);
+            const uint64_t first = write > Profiler::_capacity ? write - Profiler::_capacity : 0;
+            for (uint64_t id = first; id < write; ++id)
+            {
+                events.emplace_back(_events[id & (Profiler::_capacity - 1)]);
+            }
+        }
+
+        std::unique_ptr<Profiler::Event[]> _events;     ///< Ring buffer (nullptr when thread is finished).
+        std::atomic<uint64_t>              _write = 0;  ///< Number of written events.
+        const uint32_t                     _threadID;   ///< Profiler id of thread.
+        String                             _name;       ///< Label of thread.
+        std::vector<Profiler::Event>       _kept;       ///< Events of finished thread (until clear()).
+    };
+
+    struct Registry
+    {
+        std::mutex                                 _lock;             ///< Protect _buffers (registration/export only).
+        std::vector<std::unique_ptr<ThreadBuffer>> _buffers;          ///< Buffers of running threads and events of finished threads.
+        std::atomic<int64_t>                       _frame = 0;        ///< Current frame index.
+        uint32_t                                   _nextThreadID = 0; ///< Profiler id of next registered thread.
+    };
+
+    Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    // Unregister buffer at thread exit: ring buffer is released, only written events are kept
+    class ThreadRegistration final
+    {
+        MOUCA_NOCOPY_NOMOVE(ThreadRegistration);
+
+        public:
+            ThreadRegistration() = default;
+
+            ~ThreadRegistration()
+            {
+                if (_buffer == nullptr)
+                {
+                    return;
+                }
+
+                auto& registry = getRegistry();
+                std::lock_guard<std::mutex> lock(registry._lock);
+                if (_buffer->_write.load(std::memory_order_acquire) == 0)
+                {
+                    std::erase_if(registry._buffers, [&](const auto& buffer) { return buffer.get() == _buffer; });
+                    return;
+                }
+                _buffer->copyEvents(_buffer->_kept);
+                _buffer->_events.reset();
+            }
+
+            ThreadBuffer* _buffer = nullptr;    ///< [LINK] Buffer of thread.
+    };
+
+    ThreadBuffer& getThreadBuffer()
+    {
+        // Registration is done only once by thread
+        thread_local ThreadRegistration registration;
+        if (registration._buffer == nullptr)
+        {
+            auto& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry._lock);
+            registry._buffers.emplace_back(std::make_unique<ThreadBuffer>(registry._nextThreadID++));
+            registration._buffer = registry._buffers.back().get();
+        }
+        return *registration._buffer;
+    }
+
+    void writeEscaped(std::ostream& stream, const char* text)
+    {
+        for (; *text != '\0'; ++text)
+        {
+            if (*text == '"' || *text == '\\')
+            {
+                stream << '\\';
+            }
+            stream << *text;
+        }
+    }
+}
+
+void Profiler::push(const Event& event)
+{
+    auto& buffer = getThreadBuffer();
+    const uint64_t write = buffer._write.load(std::memory_order_relaxed);
+    buffer._events[write & (_capacity - 1)] = event;
+    buffer._events[write & (_capacity - 1)]._threadID = buffer._threadID;
+    buffer._write.store(write + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const String& name)
+{
+    auto& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(getRegistry()._lock);
+    buffer._name = name;
+}
+
+void Profiler::addZone(const char* name, const int64_t begin, const int64_t end)
+{
+    push({ name, begin, end - begin, 0, Type::Zone });
+}
+
+void Profiler::addCounter(const char* name, const int64_t value)
+{
+    if (isEnabled())
+    {
+        push({ name, now(), value, 0, Type::Counter });
+    }
+}
+
+void Profiler::markFrame()
+{
+    const int64_t frame = getRegistry()._frame.fetch_add(1, std::memory_order_relaxed);
+    if (isEnabled())
+    {
+        push({ "Frame", now(), frame, 0, Type::Frame });
+    }
+}
+
+std::vector<Profiler::Event> Profiler::collect()
+{
+    std::vector<Event> events;
+
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry._lock);
+    for (const auto& buffer : registry._buffers)
+    {
+        buffer->copyEvents(events);
+    }
+    std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a._begin < b._begin; });
+    return events;
+}
+
+void Profiler::exportChromeTrace(const Path& filename)
+{
+    const auto events = collect();
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "InvalidPathError") << filename.string());
+    }
+
+    // Chrome trace uses microseconds
+    file << std::fixed << std::setprecision(3);
+    file << "{\"traceEvents\":[";
+    bool first = true;
+    const auto separator = [&]()
+    {
+        file << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    {
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry._lock);
+        for (const auto& buffer : registry._buffers)
+        {
+            if (!buffer->_name.empty())
+            {
+                separator();
+                file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->_threadID << ",\"args\":{\"name\":\"";
+                writeEscaped(file, buffer->_name.c_str());
+                file << "\"}}";
+            }
+        }
+    }
+
+    for (const auto& event : events)
+    {
+        separator();
+        file << "{\"name\":\"";
+        writeEscaped(file, event._name);
+        file << "\",\"pid\":1,\"tid\":" << event._threadID << ",\"ts\":" << static_cast<double>(event._begin) / 1000.0;
+        switch (event._type)
+        {
+            case Type::Zone:
+                file << ",\"ph\":\"X\",\"dur\":" << static_cast<double>(event._value) / 1000.0 << "}";
+                break;
+            case Type::Counter:
+                file << ",\"ph\":\"C\",\"args\":{\"value\":" << event._value << "}}";
+                break;
+            case Type::Frame:
+                file << ",\"ph\":\"i\",\"s\":\"g\",\"args\":{\"frame\":" << event._value << "}}";
+                break;
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+    if (!file.good())
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "InvalidPathError") << filename.string());
+    }
+}
+
+void Profiler::clear()
+{
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry._lock);
+    // Events of finished threads are removed
+    std::erase_if(registry._buffers, [](const auto& buffer) { return buffer->_events == nullptr; });
+    for (const auto& buffer : registry._buffers)
+    {
+        buffer->_write.store(0, std::memory_order_release);
+    }
+    registry._frame = 0;
+}
+
+size_t Profiler::getNbThreads()
+{
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry._lock);
+    return registry._buffers.size();
+}
+
+}
@@ -0,0 +1,151 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibCore/include/CoreSignalQueue.h"
+
+namespace Core
+{
+
+SignalQueue::SignalQueue(const size_t capacity):
+_mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1)
+{
+    _cells = std::make_unique<Cell[]>(_mask + 1);
+    for (size_t id = 0; id <= _mask; ++id)
+    {
+        _cells[id]._sequence.store(id, std::memory_order_relaxed);
+    }
+}
+
+void SignalQueue::post(Event&& event)
+{
+    PostedEvent posted{ std::move(event), ChronoClock::now() };
+    _posted.fetch_add(1, std::memory_order_relaxed);
+
+    // Ring buffer is full (or was full since last dispatch): keep order into overflow
+    if (_hasOverflow.load(std::memory_order_acquire) || !tryPush(std::move(posted)))
+    {
+        std::lock_guard<std::mutex> lock(_overflowLock);
+        _overflow.emplace_back(std::move(posted));
+        _hasOverflow.store(true, std::memory_order_release);
+        _overflowed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool SignalQueue::tryPush(PostedEvent&& event)
+{
+    // Bounded MPMC queue of D. Vyukov used with one consumer
+    size_t position = _enqueue.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true)
+    {
+        cell = &_cells[position & _mask];
+        const size_t sequence = cell->_sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (diff == 0)
+        {
+            if (_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = _enqueue.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->_data.emplace(std::move(event));
+    cell->_sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool SignalQueue::tryPop(std::optional<PostedEvent>& event)
+{
+    Cell& cell = _cells[_dequeue & _mask];
+    if (cell._sequence.load(std::memory_order_acquire) != _dequeue + 1)
+    {
+        return false;
+    }
+
+    event.emplace(std::move(*cell._data));
+    cell._data.reset();
+    cell._sequence.store(_dequeue + _mask + 1, std::memory_order_release);
+    ++_dequeue;
+    return true;
+}
+
+void SignalQueue::execute(PostedEvent& event, const ChronoTimePoint& now)
+{
+    const int64_t latency = std::chrono::duration_cast<std::chrono::nanoseconds>(now - event._posted).count();
+    _totalLatency.fetch_add(latency, std::memory_order_relaxed);
+    if (latency > _maxLatency.load(std::memory_order_relaxed))
+    {
+        _maxLatency.store(latency, std::memory_order_relaxed);
+    }
+
+    event._event();
+    _dispatched.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t SignalQueue::dispatch()
+{
+    // Only events posted before now: events can post new events
+    const uint64_t dispatched = _dispatched.load(std::memory_order_relaxed);
+    const size_t   depth      = static_cast<size_t>(_posted.load(std::memory_order_acquire) - dispatched);
+    if (depth > _maxDepth.load(std::memory_order_relaxed))
+    {
+        _maxDepth.store(depth, std::memory_order_relaxed);
+    }
+
+    const ChronoTimePoint now = ChronoClock::now();
+    size_t count = 0;
+    std::optional<PostedEvent> event;
+    while (count < depth && tryPop(event))
+    {
+        execute(*event, now);
+        event.reset();
+        ++count;
+    }
+
+    // Overflow is always after ring buffer
+    if (count < depth && _hasOverflow.load(std::memory_order_acquire))
+    {
+        std::deque<PostedEvent> overflow;
+        {
+            std::lock_guard<std::mutex> lock(_overflowLock);
+            overflow.swap(_overflow);
+            _hasOverflow.store(false, std::memory_order_release);
+        }
+        for (auto& posted : overflow)
+        {
+            execute(posted, now);
+            ++count;
+        }
+    }
+    return count;
+}
+
+SignalQueue::Statistics SignalQueue::getStatistics() const
+{
+    Statistics statistics;
+    statistics._posted         = _posted.load(std::memory_order_relaxed);
+    statistics._dispatched     = _dispatched.load(std::memory_order_relaxed);
+    statistics._coalesced      = _coalesced.load(std::memory_order_relaxed);
+    statistics._overflowed     = _overflowed.load(std::memory_order_relaxed);
+    statistics._depth          = static_cast<size_t>(statistics._posted - std::min(statistics._posted, statistics._dispatched));
+    statistics._maxDepth       = _maxDepth.load(std::memory_order_relaxed);
+    statistics._maxLatency     = std::chrono::nanoseconds(_maxLatency.load(std::memory_order_relaxed));
+    if (statistics._dispatched > 0)
+    {
+        statistics._averageLatency = std::chrono::nanoseconds(_totalLatency.load(std::memory_order_relaxed) / static_cast<int64_t>(statistics._dispatched));
+    }
+    return statistics;
+}
+
+}
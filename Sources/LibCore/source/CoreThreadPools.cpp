@@ -0,0 +1,274 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibCore/include/CoreMemory.h"
+#include "LibCore/include/CoreThreadPools.h"
+
+namespace Core
+{
+
+namespace
+{
+    // Tasks are created by frame (parallelFor): reuse memory of finished tasks
+    PoolResource& getTaskPool()
+    {
+        // Block contains shared_ptr control block + task.
+        // Never destroyed: static objects can still own tasks during static destruction (system releases memory at exit).
+        static PoolResource* pool = new PoolResource(sizeof(Task) + 64, 256);
+        return *pool;
+    }
+}
+
+void ThreadPools::initializeWorkers(const uint32_t nbWorkers)
+{
+    MouCa::preCondition(_workers.empty()); // DEV Issue: call initializeWorkers() both time.
+
+    // Current thread helps into wait()
+    const uint32_t nbThreads = nbWorkers > 0 ? nbWorkers : std::max(1u, std::thread::hardware_concurrency() - 1);
+
+    _run = true;
+    for (uint32_t id = 0; id < nbThreads; ++id)
+    {
+        _workers.emplace_back(std::make_unique<Worker>(*this));
+        _workers.back()->start();
+    }
+
+    MouCa::postCondition(!_workers.empty());
+}
+
+void ThreadPools::releaseWorkers()
+{
+    MouCa::preCondition(!_workers.empty()); // DEV Issue: call releaseWorkers() before initializeWorkers().
+
+    {
+        std::lock_guard<std::mutex> lock(_taskLock);
+        _run = false;
+    }
+    _waitTask.notify_all();
+
+    for (auto& worker : _workers)
+    {
+        worker->join();
+    }
+    _workers.clear();
+
+    MouCa::postCondition(_workers.empty());
+}
+
+TaskSPtr ThreadPools::createTask(std::function<void()> function, const Task::Priority priority) const
+{
+    return std::allocate_shared<Task>(std::pmr::polymorphic_allocator<Task>(&getTaskPool()), std::move(function), priority);
+}
+
+void ThreadPools::addDependency(const TaskSPtr& task, const TaskSPtr& dependency)
+{
+    MouCa::preCondition(task != nullptr && dependency != nullptr);
+    MouCa::preCondition(!task->_submitted); // DEV Issue: dependencies must be added before submit().
+    MouCa::preCondition(task != dependency);
+
+    std::lock_guard<std::mutex> lock(dependency->_lock);
+    if (dependency->isFinished())
+    {
+        // Propagate error
+        if (dependency->_exception != nullptr && task->_exception == nullptr)
+        {
+            task->_exception = dependency->_exception;
+        }
+        return;
+    }
+    task->_remaining.fetch_add(1, std::memory_order_relaxed);
+    dependency->_continuations.emplace_back(task);
+}
+
+void ThreadPools::submit(const TaskSPtr& task)
+{
+    MouCa::preCondition(task != nullptr);
+    MouCa::preCondition(!task->_submitted); // DEV Issue: task submitted both time.
+
+    task->_submitted = true;
+
+    // Release submission token
+    if (task->_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        enqueue(task);
+    }
+}
+
+TaskSPtr ThreadPools::then(const TaskSPtr& task, std::function<void()> continuation, const Task::Priority priority)
+{
+    auto next = createTask(std::move(continuation), priority);
+    addDependency(next, task);
+    submit(next);
+    return next;
+}
+
+TaskSPtr ThreadPools::parallelFor(const size_t begin, const size_t end, const size_t grain, std::function<void(const size_t, const size_t)> function, const Task::Priority priority)
+{
+    MouCa::preCondition(begin <= end);
+
+    // Enough tasks to balance work between all threads
+    const size_t size      = end - begin;
+    const size_t nbThreads = _workers.size() + 1;
+    const size_t chunk     = grain > 0 ? grain : std::max<size_t>(1, size / (nbThreads * 4));
+
+    auto join = createTask([]() {}, priority);
+    auto job  = std::make_shared<std::function<void(const size_t, const size_t)>>(std::move(function));
+    for (size_t first = begin; first < end; first += chunk)
+    {
+        const size_t last = std::min(end, first + chunk);
+        auto part = createTask([job, first, last]() { (*job)(first, last); }, priority);
+        addDependency(join, part);
+        submit(part);
+    }
+    submit(join);
+    return join;
+}
+
+void ThreadPools::wait(const TaskSPtr& task)
+{
+    MouCa::preCondition(task != nullptr);
+    MouCa::preCondition(task->_submitted); // DEV Issue: task never submitted: infinite wait !
+
+    _nbWaiting.fetch_add(1);
+    while (!task->isFinished())
+    {
+        // Help workers
+        if (auto pending = tryPop())
+        {
+            execute(pending);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_taskLock);
+        _waitDone.wait(lock, [&]()
+        {
+            return task->isFinished()
+                || std::any_of(_readyTasks.cbegin(), _readyTasks.cend(), [](const auto& tasks) { return !tasks.empty(); });
+        });
+    }
+    _nbWaiting.fetch_sub(1);
+
+    std::lock_guard<std::mutex> lock(task->_lock);
+    if (task->_exception != nullptr)
+    {
+        std::rethrow_exception(task->_exception);
+    }
+}
+
+void ThreadPools::enqueue(const TaskSPtr& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_taskLock);
+        _readyTasks[static_cast<size_t>(task->getPriority())].emplace_back(task);
+    }
+    _waitTask.notify_one();
+    if (_nbWaiting.load() > 0)
+    {
+        _waitDone.notify_all();
+    }
+}
+
+TaskSPtr ThreadPools::tryPop()
+{
+    std::lock_guard<std::mutex> lock(_taskLock);
+    for (auto& tasks : _readyTasks)
+    {
+        if (!tasks.empty())
+        {
+            auto task = std::move(tasks.front());
+            tasks.pop_front();
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void ThreadPools::execute(const TaskSPtr& task)
+{
+    // Error of dependency: skip job
+    if (task->_exception == nullptr)
+    {
+        try
+        {
+            task->_function();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(task->_lock);
+            task->_exception = std::current_exception();
+        }
+    }
+    task->_function = nullptr;
+    finish(task);
+}
+
+void ThreadPools::finish(const TaskSPtr& task)
+{
+    std::vector<TaskSPtr> continuations;
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> lock(task->_lock);
+        task->_finished.store(true); // Sequentially consistent with _nbWaiting
+        continuations.swap(task->_continuations);
+        exception = task->_exception;
+    }
+
+    for (const auto& continuation : continuations)
+    {
+        if (exception != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(continuation->_lock);
+            if (continuation->_exception == nullptr)
+            {
+                continuation->_exception = exception;
+            }
+        }
+        if (continuation->_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            enqueue(continuation);
+        }
+    }
+
+    if (_nbWaiting.load() > 0)
+    {
+        // Lock avoids lost wake up between predicate check and wait
+        std::lock_guard<std::mutex> lock(_taskLock);
+        _waitDone.notify_all();
+    }
+}
+
+void ThreadPools::Worker::run()
+{
+    while (true)
+    {
+        TaskSPtr task;
+        {
+            std::unique_lock<std::mutex> lock(_pools._taskLock);
+            _pools._waitTask.wait(lock, [&]()
+            {
+                return !_pools._run
+                    || std::any_of(_pools._readyTasks.cbegin(), _pools._readyTasks.cend(), [](const auto& tasks) { return !tasks.empty(); });
+            });
+
+            // Finish pending tasks before leaving
+            for (auto& tasks : _pools._readyTasks)
+            {
+                if (!tasks.empty())
+                {
+                    task = std::move(tasks.front());
+                    tasks.pop_front();
+                    break;
+                }
+            }
+            if (task == nullptr)
+            {
+                return;
+            }
+        }
+        _pools.execute(task);
+    }
+}
+
+}
@@ -1,4 +1,7 @@
 #include "Dependencies.h"
+
+#include <LibCore/include/CoreMemory.h>
+
 #include "LibGUI/include/GUIEclidianDistanceTransformAA.h"
 
 /*
@@ -622,11 +625,18 @@ void GUIEclidianDistanceTransformAA::distanceMap(double* pImage, const size_t sz
 	m_MemorySize	= szWidth*szHeight;
 	m_pImage		= pImage;
 
-	m_pGradiantPts = new RT::Vector2d[m_MemorySize];
+	// Temporary buffers into thread arena: memory is reused by next glyphs
+	Core::ArenaScope scope;
+	std::pmr::vector<RT::Vector2d>	gradiantPts(m_MemorySize, &scope.getArena());
+	std::pmr::vector<RT::Vector2us>	distancePts(m_MemorySize, &scope.getArena());
+	std::pmr::vector<double>		outside(m_MemorySize, &scope.getArena());
+	std::pmr::vector<double>		inside(m_MemorySize, &scope.getArena());
+
+	m_pGradiantPts = gradiantPts.data();
 
-	RT::Vector2us*	pDistancePts	= new RT::Vector2us[m_MemorySize];	
-	double*				pOutside		= new double[m_MemorySize];
-	double*				pInside			= new double[m_MemorySize];
+	RT::Vector2us*	pDistancePts	= distancePts.data();
+	double*				pOutside		= outside.data();
+	double*				pInside			= inside.data();
 
 	// Compute outside = edtaa3(bitmap); % Transform background (0's)
 	ComputeGradient(m_pGradiantPts);
@@ -666,7 +676,6 @@ void GUIEclidianDistanceTransformAA::distanceMap(double* pImage, const size_t sz
 			vmin = pOutside[szPixel];
 		}
 	}
-	delete [] pInside; //Release at this time
 	vmin = abs(vmin);
 	MouCa::assertion(vmin != std::numeric_limits<double>::infinity());
 
@@ -677,7 +686,5 @@ void GUIEclidianDistanceTransformAA::distanceMap(double* pImage, const size_t sz
 		m_pImage[szPixel] = (pOutside[szPixel]+vmin)*d1_2Vmin; 
 	}
 
-	delete [] m_pGradiantPts;
-	delete [] pDistancePts;
-	delete [] pOutside;
+	m_pGradiantPts = nullptr;
 }
\ No newline at end of file
@@ -8,5 +8,11 @@
 #include <Assimp.h>
 #include <LibKTX.h>
 
+//SIMD
+#if defined(_M_X64) || defined(__SSE2__)
+#   include <immintrin.h>
+#   define MOUCA_SIMD_SSE
+#endif
+
 //Main include
 #include <LibRT/RTGlobalDependencies.h>
\ No newline at end of file
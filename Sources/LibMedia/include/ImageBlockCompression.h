@@ -0,0 +1,72 @@
+#pragma once
+
+#include <LibRT/include/RTImage.h>
+
+namespace Media
+{
+    //----------------------------------------------------------------------------
+    /// \brief CPU encoder of BCn blocks (4x4 pixels RGBA 8 bits).
+    /// Encoders are fast range fit (bounding box + projection): quality is enough for runtime import,
+    /// offline tools are better for final assets.
+    class BlockCompression final
+    {
+        public:
+            using Format = RT::ImageImport::Options::Compression;
+            using Block  = std::array<Core::ColorUC32, 16>;
+
+            //------------------------------------------------------------------------
+            /// \brief  Get size in bytes of one 4x4 block.
+            ///
+            /// \param[in] format: compression format (not None).
+            /// \returns Size of block in bytes.
+            static size_t getBlockSize(const Format format);
+
+            //------------------------------------------------------------------------
+            /// \brief  Get size in bytes of compressed level.
+            ///
+            /// \param[in] format: compression format (None is RGBA 8 bits).
+            /// \param[in] width:  level width in pixels.
+            /// \param[in] height: level height in pixels.
+            /// \returns Size of level in bytes.
+            static size_t getLevelSize(const Format format, const uint32_t width, const uint32_t height);
+
+            //------------------------------------------------------------------------
+            /// \brief  Extract 4x4 block from RGBA picture (border pixels are duplicated).
+            ///
+            /// \param[in] pixels: RGBA picture.
+            /// \param[in] width:  picture width.
+            /// \param[in] height: picture height.
+            /// \param[in] blockX: column of block.
+            /// \param[in] blockY: row of block.
+            /// \param[out] block: extracted pixels.
+            static void extractBlock(const Core::ColorUC32* pixels, const uint32_t width, const uint32_t height,
+                                     const uint32_t blockX, const uint32_t blockY, Block& block);
+
+            //------------------------------------------------------------------------
+            /// \brief  Compress one block.
+            ///
+            /// \param[in] format: compression format (not None).
+            /// \param[in] block: RGBA pixels.
+            /// \param[out] output: getBlockSize() bytes.
+            static void compressBlock(const Format format, const Block& block, uint8_t* output);
+
+            //------------------------------------------------------------------------
+            /// \brief  Compress a row of blocks.
+            ///
+            /// \param[in] format: compression format (not None).
+            /// \param[in] pixels: RGBA picture.
+            /// \param[in] width:  picture width.
+            /// \param[in] height: picture height.
+            /// \param[in] blockY: row of block to compress.
+            /// \param[out] output: first byte of compressed level.
+            static void compressRow(const Format format, const Core::ColorUC32* pixels, const uint32_t width, const uint32_t height,
+                                    const uint32_t blockY, uint8_t* output);
+
+        private:
+            static void compressBC1(const Block& block, uint8_t* output, const bool allowAlpha);
+
+            static void compressBC4(const Block& block, const size_t channel, uint8_t* output);
+
+            static void compressBC7(const Block& block, uint8_t* output);
+    };
+}
@@ -23,6 +23,13 @@ namespace Media
 
             void initialize(const Core::Path& path);
 
+            //------------------------------------------------------------------------
+            /// \brief  Decode image from file content already read (see Core::AsyncFileReader).
+            ///
+            /// \param[in] path: file of content (format detection by extension and errors).
+            /// \param[in] fileData: whole file content.
+            void initialize(const Core::Path& path, const std::span<const uint8_t> fileData);
+
             void createFill(const RT::BufferCPUBase& imageBuffer, const uint32_t width, const uint32_t height) override;
 
             bool isNull() const override
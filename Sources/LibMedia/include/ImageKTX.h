@@ -1,5 +1,7 @@
 #pragma once
 
+#include <LibCore/include/CoreMappedFile.h>
+
 #include <LibRT/include/RTImage.h>
 
 namespace Media
@@ -17,8 +19,48 @@ namespace Media
                 MouCa::preCondition(isNull());
             }
 
+            //------------------------------------------------------------------------
+            /// \brief  Load all data of KTX file (blocking).
+            ///
+            /// \param[in] path: KTX/KTX2 file.
             void initialize(const Core::Path& path);
 
+            //------------------------------------------------------------------------
+            /// \brief  Read description of KTX file and allocate memory without reading data.
+            /// Data are read by decode() of each task (can be called on different threads).
+            /// \code{.cpp}
+            ///     image.prepare(path);
+            ///     for(size_t task = 0; task < image.getNbDecodeTasks(); ++task)
+            ///         pool.push([&image, task]() { image.decode(task); });
+            /// \endcode
+            /// \param[in] path: KTX/KTX2 file.
+            /// \note Non supercompressed KTX2 produces one task per level/layer (coarse levels first),
+            ///       other files are decoded by only one task.
+            void prepare(const Core::Path& path);
+
+            //------------------------------------------------------------------------
+            /// \brief  Get number of decoding tasks after prepare().
+            ///
+            /// \returns Number of tasks.
+            size_t getNbDecodeTasks() const { return _tasks.size(); }
+
+            //------------------------------------------------------------------------
+            /// \brief  Read/decode data of one task (thread-safe between different tasks).
+            ///
+            /// \param[in] task: id of task (< getNbDecodeTasks()).
+            void decode(const size_t task);
+
+            //------------------------------------------------------------------------
+            /// \brief  Check if file is still mapped (released when all levels are ready).
+            ///
+            /// \returns True if decode() can still read file mapping.
+            bool isMapped() const { return _mapped != nullptr; }
+
+            uint64_t getReadyLevels() const override
+            {
+                return _readyLevels.load(std::memory_order_acquire);
+            }
+
             void createFill(const RT::BufferCPUBase& imageBuffer, const uint32_t width, const uint32_t height) override;
 
             void saveImage(const Core::Path& filename) override;
@@ -27,6 +69,8 @@ namespace Media
 
             Target getTarget() const override;
 
+            uint32_t getFormat() const override;
+
             bool isNull() const override
             {
                 return _images == nullptr;
@@ -50,6 +94,29 @@ namespace Media
                          size_t* nbDefectPixels = nullptr, double* distance4D = nullptr) const override;
 
         protected:
-            ktxTexture* _images = nullptr;
+            struct Level
+            {
+                size_t _fileOffset;     ///< Offset of level into file.
+                size_t _memoryOffset;   ///< Offset of level into _data.
+                size_t _layerSize;      ///< Size of one layer (with all faces).
+            };
+
+            struct DecodeTask
+            {
+                static const uint32_t _allLevels = std::numeric_limits<uint32_t>::max();
+
+                uint32_t _level;        ///< Level to read (_allLevels: libktx loads all file).
+                uint32_t _layer;        ///< Layer to read.
+            };
+
+            ktxTexture*                         _images = nullptr;
+            Core::Path                          _filename;          ///< File read by tasks.
+            std::unique_ptr<Core::MappedFile>   _mapped;            ///< Mapping of file when read by level (released when all levels are ready).
+            std::vector<Level>                  _levels;            ///< Levels description when data are read by level (empty: data owned by libktx).
+            std::unique_ptr<uint8_t[]>          _data;              ///< Memory of all levels when read by level.
+            size_t                              _dataSize = 0;      ///< Size of _data.
+            std::vector<DecodeTask>             _tasks;             ///< Decoding jobs.
+            std::vector<std::atomic<uint32_t>>  _remainingLayers;   ///< Number of layers to read for each level.
+            std::atomic<uint64_t>               _readyLevels = 0;   ///< Mask of fully read levels.
     };
 }
\ No newline at end of file
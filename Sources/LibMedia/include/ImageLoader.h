@@ -1,23 +1,86 @@
 #pragma once
 
+#include <LibRT/include/RTImage.h>
+
+namespace Core
+{
+    class ThreadPools;
+}
 
 namespace RT
 {
     class BufferCPUBase;
-
-    class Image;
-    using ImageSPtr = std::shared_ptr<Image>;
+    class ImageComparison;
 }
 
 namespace Media
 {
+    class ImageKTX;
+
     class ImageLoader
     {
         public:
-            static RT::ImageSPtr openImage(const Core::Path& strFilename);
+            //------------------------------------------------------------------------
+            /// \brief  Open image.
+            ///
+            /// \param[in] fileName: path to image.
+            /// \param[in] fileData: content of file already read (empty: read file). Used by FreeImage formats only.
+            /// \returns New image.
+            static RT::ImageSPtr openImage(const Core::Path& fileName, const std::span<const uint8_t> fileData = {});
+
+            //------------------------------------------------------------------------
+            /// \brief  Open image and apply import options (mipmap chain/compression) on non GPU formats.
+            ///
+            /// \param[in] fileName: path to image.
+            /// \param[in] options: import options (KTX/DDS are kept as is).
+            /// \param[in] fileData: content of file already read (empty: read file).
+            /// \param[in] threadPools: workers of mipmap filtering and block compression (nullptr: current thread only).
+            /// \returns New image.
+            static RT::ImageSPtr openImage(const Core::Path& fileName, const RT::ImageImport::Options& options, const std::span<const uint8_t> fileData = {}, Core::ThreadPools* threadPools = nullptr);
+
+            //------------------------------------------------------------------------
+            /// \brief  Open image of resource: read baked KTX2 cache when exists, otherwise decode source then write cache.
+            ///
+            /// \param[in] imageImport: resource with filename, options and cache file.
+            /// \param[in] fileData: content of source file already read (empty: read file).
+            /// \param[in] threadPools: workers of mipmap filtering and block compression (nullptr: current thread only).
+            /// \returns New image (ImageKTX when read from cache).
+            static RT::ImageSPtr openImage(const RT::ImageImport& imageImport, const std::span<const uint8_t> fileData = {}, Core::ThreadPools* threadPools = nullptr);
+
+            //------------------------------------------------------------------------
+            /// \brief  Check if openImage() decodes source file with FreeImage: loading can read file in advance.
+            ///
+            /// \param[in] imageImport: resource with filename, options and cache file.
+            /// \returns True when source file is decoded (no GPU format, no baked cache).
+            static bool isDecodedFromSource(const RT::ImageImport& imageImport);
+
+            //------------------------------------------------------------------------
+            /// \brief  Prepare progressive decoding of resource when it is a KTX file (source or baked cache).
+            ///
+            /// \param[in] imageImport: resource with filename, options and cache file.
+            /// \returns Prepared image (decode tasks are not executed) or nullptr when image needs openImage().
+            static std::shared_ptr<ImageKTX> prepareImage(const RT::ImageImport& imageImport);
+
+            //------------------------------------------------------------------------
+            /// \brief  Write 2D image with all its levels as KTX2 file (data are copied as is: no conversion).
+            ///
+            /// \param[in] image: ImageFI or ImageMipmap (single layer).
+            /// \param[in] fileName: KTX2 file to write.
+            /// \param[in] sRGB: write sRGB Vulkan format.
+            /// \param[in] zstdLevel: Zstd supercompression level (0: none).
+            static void saveKTX2(const RT::Image& image, const Core::Path& fileName, const bool sRGB, const uint32_t zstdLevel);
 
             static RT::ImageSPtr createImageFI(const RT::BufferCPUBase& ImageBuffer, const uint32_t szWidth, const uint32_t szHeight);
 
             static void export2D(RT::Image& image, const Core::Path& fileName);
+
+            //------------------------------------------------------------------------
+            /// \brief  Save a compact heat map of comparison: one cell per tile.
+            /// Valid tiles are grey (brighter when mean distance grows), failed tiles are red (brighter with max distance)
+            /// and blue shows SSIM loss when computed.
+            /// \param[in] comparison: computed comparison.
+            /// \param[in] fileName: where save heat map (any FreeImage format).
+            /// \param[in] cellSize: size in pixels of one tile into heat map.
+            static void exportHeatMap(const RT::ImageComparison& comparison, const Core::Path& fileName, const uint32_t cellSize = 4);
     };
 }
\ No newline at end of file
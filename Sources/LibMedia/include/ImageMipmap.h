@@ -0,0 +1,119 @@
+#pragma once
+
+#include <LibRT/include/RTImage.h>
+
+namespace Core
+{
+    class ThreadPools;
+}
+
+namespace Media
+{
+    //----------------------------------------------------------------------------
+    /// \brief Image with full mipmap chain generated on CPU (optionally block compressed).
+    /// All levels are stored into one contiguous buffer (same layout as KTX: level 0 first),
+    /// so it can be uploaded with one staging buffer and getMemoryOffset().
+    /// \see ImageLoader, BlockCompression
+    class ImageMipmap : public RT::Image
+    {
+        public:
+            using Options     = RT::ImageImport::Options;
+            using Channels    = std::array<uint8_t, 4>;
+
+            ImageMipmap()
+            {
+                MouCa::preCondition(isNull());
+            }
+
+            ~ImageMipmap() override
+            {
+                MouCa::preCondition(isNull());
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Build mipmap chain from RGBA 8 bits image (layer 0 / level 0).
+            ///
+            /// \param[in] source: RGBA 8 bits image.
+            /// \param[in] options: filter and compression.
+            /// \param[in] channels: source index of R, G, B, A used by block compression (uncompressed levels keep source memory order).
+            /// \param[in] threadPools: workers of rows/blocks (nullptr: current thread only).
+            void initialize(const RT::Image& source, const Options& options, const Channels& channels = { 0, 1, 2, 3 }, Core::ThreadPools* threadPools = nullptr);
+
+            void createFill(const RT::BufferCPUBase& imageBuffer, const uint32_t width, const uint32_t height) override;
+
+            bool isNull() const override
+            {
+                return _levels.empty();
+            }
+
+            Target getTarget() const override { return Target::Type2D; }
+
+            void release() override;
+
+            void saveImage(const Core::Path& filename) override;
+
+            void export2D(const Core::Path& filename) override;
+
+            uint32_t getLayers() const override   { return 1; }
+
+            uint32_t getLevels() const override   { return static_cast<uint32_t>(_levels.size()); }
+
+            RT::Array3ui getExtents(const uint32_t level) const override
+            {
+                MouCa::preCondition(level < getLevels());
+                return _levels[level]._extents;
+            }
+
+            const HandlerMemory getRAWData(const uint32_t layer, const uint32_t level) const override;
+
+            size_t getMemoryOffset(const uint32_t layer, const uint32_t level) const override;
+
+            size_t getMemorySize() const override
+            {
+                return _data.size();
+            }
+
+            bool compare(const RT::Image& reference, const size_t nbMaxDefectPixels, const double maxDistance4D,
+                         size_t* nbDefectPixels = nullptr, double* distance4D = nullptr) const override;
+
+            //------------------------------------------------------------------------
+            /// \brief  Get compression of all levels.
+            ///
+            /// \returns Compression format.
+            Options::Compression getCompression() const { return _compression; }
+
+            uint32_t getFormat() const override
+            {
+                return computeFormat(_compression, _sRGB);
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Compute VkFormat value of levels.
+            ///
+            /// \param[in] compression: block compression (None: FreeImage memory order).
+            /// \param[in] sRGB: color is sRGB.
+            /// \returns VkFormat value.
+            static uint32_t computeFormat(const Options::Compression compression, const bool sRGB);
+
+            //------------------------------------------------------------------------
+            /// \brief  Compute number of levels of full mipmap chain.
+            ///
+            /// \param[in] width: size of level 0.
+            /// \param[in] height: size of level 0.
+            /// \returns Number of levels (until 1x1).
+            static uint32_t computeNbLevels(const uint32_t width, const uint32_t height);
+
+        private:
+            struct Level
+            {
+                RT::Array3ui _extents;  ///< Size of level.
+                size_t       _offset;   ///< Offset into _data.
+                size_t       _size;     ///< Size in bytes.
+            };
+
+            std::vector<Level>      _levels;                                ///< All levels description.
+            std::vector<uint8_t>    _data;                                  ///< All levels memory.
+            Options::Compression    _compression = Options::Compression::None; ///< Format of levels.
+            bool                    _sRGB = true;                           ///< Color of levels is sRGB.
+    };
+}
@@ -0,0 +1,429 @@
+#include "Dependencies.h"
+
+#include "LibMedia/include/ImageBlockCompression.h"
+
+namespace Media
+{
+
+namespace
+{
+    using Vector4 = std::array<float, 4>;
+
+    //------------------------------------------------------------------------
+    /// \brief  Search endpoints on principal axis of block (power iteration on covariance).
+    ///
+    /// \param[in] block: pixels.
+    /// \param[in] nbChannels: 3 (RGB) or 4 (RGBA).
+    /// \param[out] minimum: endpoint with lowest projection.
+    /// \param[out] maximum: endpoint with highest projection.
+    void searchEndpoints(const BlockCompression::Block& block, const size_t nbChannels, Vector4& minimum, Vector4& maximum)
+    {
+        Vector4 mean = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for (const auto& pixel : block)
+        {
+            for (size_t c = 0; c < nbChannels; ++c)
+                mean[c] += pixel.m_color[c];
+        }
+        for (size_t c = 0; c < nbChannels; ++c)
+            mean[c] /= static_cast<float>(block.size());
+
+        std::array<std::array<float, 4>, 4> covariance = {};
+        for (const auto& pixel : block)
+        {
+            for (size_t i = 0; i < nbChannels; ++i)
+            {
+                for (size_t j = 0; j < nbChannels; ++j)
+                {
+                    covariance[i][j] += (pixel.m_color[i] - mean[i]) * (pixel.m_color[j] - mean[j]);
+                }
+            }
+        }
+
+        // Power iteration: converges quickly on 4x4 blocks
+        Vector4 axis = { 1.0f, 1.0f, 1.0f, nbChannels == 4 ? 1.0f : 0.0f };
+        for (int iteration = 0; iteration < 8; ++iteration)
+        {
+            Vector4 next = { 0.0f, 0.0f, 0.0f, 0.0f };
+            float norm = 0.0f;
+            for (size_t i = 0; i < nbChannels; ++i)
+            {
+                for (size_t j = 0; j < nbChannels; ++j)
+                    next[i] += covariance[i][j] * axis[j];
+                norm = std::max(norm, std::abs(next[i]));
+            }
+            if (norm < 1e-6f)
+                break;
+            for (size_t i = 0; i < nbChannels; ++i)
+                axis[i] = next[i] / norm;
+        }
+
+        // Project to find extremes
+        float minProjection = std::numeric_limits<float>::max();
+        float maxProjection = std::numeric_limits<float>::lowest();
+        for (const auto& pixel : block)
+        {
+            float projection = 0.0f;
+            for (size_t c = 0; c < nbChannels; ++c)
+                projection += (pixel.m_color[c] - mean[c]) * axis[c];
+
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+
+        float axisLength = 0.0f;
+        for (size_t c = 0; c < nbChannels; ++c)
+            axisLength += axis[c] * axis[c];
+        axisLength = std::max(axisLength, 1e-6f);
+
+        for (size_t c = 0; c < 4; ++c)
+        {
+            const float base = c < nbChannels ? mean[c] : 255.0f;
+            const float step = c < nbChannels ? axis[c] / axisLength : 0.0f;
+            minimum[c] = std::clamp(base + step * minProjection, 0.0f, 255.0f);
+            maximum[c] = std::clamp(base + step * maxProjection, 0.0f, 255.0f);
+        }
+    }
+
+    uint16_t encode565(const Vector4& color)
+    {
+        const auto r = static_cast<uint16_t>((static_cast<uint32_t>(color[0] + 0.5f) * 31 + 127) / 255);
+        const auto g = static_cast<uint16_t>((static_cast<uint32_t>(color[1] + 0.5f) * 63 + 127) / 255);
+        const auto b = static_cast<uint16_t>((static_cast<uint32_t>(color[2] + 0.5f) * 31 + 127) / 255);
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    std::array<int, 3> decode565(const uint16_t color)
+    {
+        const int r = (color >> 11) & 0x1F;
+        const int g = (color >> 5)  & 0x3F;
+        const int b =  color        & 0x1F;
+        return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+    }
+
+    //------------------------------------------------------------------------
+    /// \brief Little endian bit writer for 128 bits blocks.
+    class BitWriter
+    {
+        public:
+            explicit BitWriter(uint8_t* output) :
+            _output(output)
+            {
+                memset(_output, 0, 16);
+            }
+
+            void write(const uint32_t value, const uint32_t nbBits)
+            {
+                for (uint32_t bit = 0; bit < nbBits; ++bit, ++_position)
+                {
+                    if ((value >> bit) & 1)
+                        _output[_position >> 3] |= static_cast<uint8_t>(1 << (_position & 7));
+                }
+            }
+
+        private:
+            uint8_t* _output;
+            uint32_t _position = 0;
+    };
+}
+
+size_t BlockCompression::getBlockSize(const Format format)
+{
+    switch (format)
+    {
+        case Format::BC1: return 8;
+        case Format::BC3:
+        case Format::BC5:
+        case Format::BC7: return 16;
+        default: MouCa::assertion(false); // DEV Issue: Not a block format.
+    }
+    return 0;
+}
+
+size_t BlockCompression::getLevelSize(const Format format, const uint32_t width, const uint32_t height)
+{
+    if (format == Format::None)
+    {
+        return static_cast<size_t>(width) * height * sizeof(Core::ColorUC32);
+    }
+    const size_t blocksX = (std::max(width,  1u) + 3) / 4;
+    const size_t blocksY = (std::max(height, 1u) + 3) / 4;
+    return blocksX * blocksY * getBlockSize(format);
+}
+
+void BlockCompression::extractBlock(const Core::ColorUC32* pixels, const uint32_t width, const uint32_t height,
+                                    const uint32_t blockX, const uint32_t blockY, Block& block)
+{
+    for (uint32_t y = 0; y < 4; ++y)
+    {
+        const uint32_t py = std::min(blockY * 4 + y, height - 1);
+        for (uint32_t x = 0; x < 4; ++x)
+        {
+            const uint32_t px = std::min(blockX * 4 + x, width - 1);
+            block[y * 4 + x] = pixels[static_cast<size_t>(py) * width + px];
+        }
+    }
+}
+
+void BlockCompression::compressBlock(const Format format, const Block& block, uint8_t* output)
+{
+    switch (format)
+    {
+        case Format::BC1:
+        {
+            compressBC1(block, output, true);
+        }
+        break;
+        case Format::BC3:
+        {
+            compressBC4(block, 3, output);
+            compressBC1(block, &output[8], false);
+        }
+        break;
+        case Format::BC5:
+        {
+            compressBC4(block, 0, output);
+            compressBC4(block, 1, &output[8]);
+        }
+        break;
+        case Format::BC7:
+        {
+            compressBC7(block, output);
+        }
+        break;
+        default: MouCa::assertion(false); // DEV Issue: Not a block format.
+    }
+}
+
+void BlockCompression::compressRow(const Format format, const Core::ColorUC32* pixels, const uint32_t width, const uint32_t height,
+                                   const uint32_t blockY, uint8_t* output)
+{
+    const uint32_t blocksX   = (width + 3) / 4;
+    const size_t   blockSize = getBlockSize(format);
+
+    uint8_t* row = &output[static_cast<size_t>(blockY) * blocksX * blockSize];
+    Block block;
+    for (uint32_t blockX = 0; blockX < blocksX; ++blockX)
+    {
+        extractBlock(pixels, width, height, blockX, blockY, block);
+        compressBlock(format, block, &row[blockX * blockSize]);
+    }
+}
+
+void BlockCompression::compressBC1(const Block& block, uint8_t* output, const bool allowAlpha)
+{
+    const bool hasAlpha = allowAlpha
+                       && std::any_of(block.cbegin(), block.cend(), [](const Core::ColorUC32& pixel) { return pixel.m_color[3] < 128; });
+
+    Vector4 minimum, maximum;
+    searchEndpoints(block, 3, minimum, maximum);
+
+    uint16_t color0 = encode565(maximum);
+    uint16_t color1 = encode565(minimum);
+    // Mode is driven by endpoints order: 4 colors when color0 > color1, 3 colors + transparent otherwise.
+    if (hasAlpha ? color0 > color1 : color0 < color1)
+    {
+        std::swap(color0, color1);
+    }
+
+    const auto end0 = decode565(color0);
+    const auto end1 = decode565(color1);
+    std::array<std::array<int, 3>, 4> palette;
+    palette[0] = end0;
+    palette[1] = end1;
+    const bool fourColors = color0 > color1;
+    for (size_t c = 0; c < 3; ++c)
+    {
+        if (fourColors)
+        {
+            palette[2][c] = (2 * end0[c] + end1[c]) / 3;
+            palette[3][c] = (end0[c] + 2 * end1[c]) / 3;
+        }
+        else
+        {
+            palette[2][c] = (end0[c] + end1[c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    const size_t nbColors = fourColors ? 4 : 3;
+
+    uint32_t indices = 0;
+    for (size_t id = 0; id < block.size(); ++id)
+    {
+        const auto& pixel = block[id];
+        uint32_t best = 0;
+        if (!fourColors && pixel.m_color[3] < 128)
+        {
+            best = 3; // Transparent
+        }
+        else
+        {
+            int bestError = std::numeric_limits<int>::max();
+            for (uint32_t index = 0; index < nbColors; ++index)
+            {
+                int error = 0;
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    const int delta = pixel.m_color[c] - palette[index][c];
+                    error += delta * delta;
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best      = index;
+                }
+            }
+        }
+        indices |= best << (2 * id);
+    }
+
+    output[0] = static_cast<uint8_t>(color0 & 0xFF);
+    output[1] = static_cast<uint8_t>(color0 >> 8);
+    output[2] = static_cast<uint8_t>(color1 & 0xFF);
+    output[3] = static_cast<uint8_t>(color1 >> 8);
+    memcpy(&output[4], &indices, sizeof(indices));
+}
+
+void BlockCompression::compressBC4(const Block& block, const size_t channel, uint8_t* output)
+{
+    int maximum = 0;
+    int minimum = 255;
+    for (const auto& pixel : block)
+    {
+        maximum = std::max<int>(maximum, pixel.m_color[channel]);
+        minimum = std::min<int>(minimum, pixel.m_color[channel]);
+    }
+
+    // 8 values mode (maximum > minimum)
+    std::array<int, 8> palette;
+    palette[0] = maximum;
+    palette[1] = minimum;
+    for (int index = 2; index < 8; ++index)
+    {
+        palette[index] = ((8 - index) * maximum + (index - 1) * minimum) / 7;
+    }
+
+    uint64_t indices = 0;
+    if (maximum != minimum)
+    {
+        for (size_t id = 0; id < block.size(); ++id)
+        {
+            const int value = block[id].m_color[channel];
+            uint64_t best = 0;
+            int bestError = std::numeric_limits<int>::max();
+            for (uint64_t index = 0; index < palette.size(); ++index)
+            {
+                const int error = std::abs(value - palette[index]);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best      = index;
+                }
+            }
+            indices |= best << (3 * id);
+        }
+    }
+
+    output[0] = static_cast<uint8_t>(maximum);
+    output[1] = static_cast<uint8_t>(minimum);
+    for (size_t byte = 0; byte < 6; ++byte)
+    {
+        output[2 + byte] = static_cast<uint8_t>((indices >> (8 * byte)) & 0xFF);
+    }
+}
+
+void BlockCompression::compressBC7(const Block& block, uint8_t* output)
+{
+    // Mode 6: one subset, RGBA 7.7.7.7 endpoints + unique p-bit, 4 bits indices.
+    static const std::array<int, 16> weights = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    Vector4 minimum, maximum;
+    searchEndpoints(block, 4, minimum, maximum);
+
+    // Opaque block must keep alpha at 255: only p-bit 1 can reach it.
+    const bool opaque = std::all_of(block.cbegin(), block.cend(), [](const Core::ColorUC32& color) { return color.m_color[3] == 255; });
+
+    // Quantize endpoint with best p-bit
+    auto quantize = [&](const Vector4& color, std::array<int, 4>& quantized, int& pBit)
+    {
+        int bestError = std::numeric_limits<int>::max();
+        for (int p = opaque ? 1 : 0; p < 2; ++p)
+        {
+            std::array<int, 4> candidate;
+            int error = 0;
+            for (size_t c = 0; c < 4; ++c)
+            {
+                candidate[c] = std::clamp(static_cast<int>((color[c] - static_cast<float>(p)) * 0.5f + 0.5f), 0, 127);
+                const int delta = ((candidate[c] << 1) | p) - static_cast<int>(color[c] + 0.5f);
+                error += delta * delta;
+            }
+            if (error < bestError)
+            {
+                bestError = error;
+                quantized = candidate;
+                pBit      = p;
+            }
+        }
+    };
+
+    std::array<int, 4> end0, end1;
+    int pBit0 = 0, pBit1 = 0;
+    quantize(minimum, end0, pBit0);
+    quantize(maximum, end1, pBit1);
+
+    std::array<std::array<int, 4>, 16> palette;
+    for (size_t index = 0; index < palette.size(); ++index)
+    {
+        for (size_t c = 0; c < 4; ++c)
+        {
+            const int e0 = (end0[c] << 1) | pBit0;
+            const int e1 = (end1[c] << 1) | pBit1;
+            palette[index][c] = ((64 - weights[index]) * e0 + weights[index] * e1 + 32) >> 6;
+        }
+    }
+
+    std::array<uint32_t, 16> indices;
+    for (size_t id = 0; id < block.size(); ++id)
+    {
+        int bestError = std::numeric_limits<int>::max();
+        for (uint32_t index = 0; index < palette.size(); ++index)
+        {
+            int error = 0;
+            for (size_t c = 0; c < 4; ++c)
+            {
+                const int delta = block[id].m_color[c] - palette[index][c];
+                error += delta * delta;
+            }
+            if (error < bestError)
+            {
+                bestError   = error;
+                indices[id] = index;
+            }
+        }
+    }
+
+    // Anchor index must have MSB at 0: swap endpoints
+    if (indices[0] & 0x8)
+    {
+        std::swap(end0, end1);
+        std::swap(pBit0, pBit1);
+        for (auto& index : indices)
+            index = 15 - index;
+    }
+
+    BitWriter writer(output);
+    writer.write(1 << 6, 7);
+    for (size_t c = 0; c < 4; ++c)
+    {
+        writer.write(static_cast<uint32_t>(end0[c]), 7);
+        writer.write(static_cast<uint32_t>(end1[c]), 7);
+    }
+    writer.write(static_cast<uint32_t>(pBit0), 1);
+    writer.write(static_cast<uint32_t>(pBit1), 1);
+    writer.write(indices[0], 3);
+    for (size_t id = 1; id < indices.size(); ++id)
+    {
+        writer.write(indices[id], 4);
+    }
+}
+
+}
@@ -1,11 +1,14 @@
 #include "Dependencies.h"
 
+#include <LibCore/include/CoreLogger.h>
+
 #include "LibMedia/include/ImageFI.h"
 
 #include "LibMedia/include/ImageLoader.h"
 
 #include "LibRT/include/RTBufferCPU.h"
 #include "LibRT/include/RTBufferDescriptor.h"
+#include "LibRT/include/RTImageComparison.h"
 
 namespace Media
 {
@@ -42,6 +45,43 @@ void ImageFI::initialize(const Core::Path& path)
     MouCa::preCondition(!isNull());
 }
 
+void ImageFI::initialize(const Core::Path& path, const std::span<const uint8_t> fileData)
+{
+    MouCa::preCondition(isNull());
+    MouCa::preCondition(!fileData.empty());
+
+    // FreeImage doesn't modify memory in read mode
+    FIMEMORY* memory = FreeImage_OpenMemory(const_cast<BYTE*>(fileData.data()), static_cast<DWORD>(fileData.size()));
+    if (memory == nullptr)
+    {
+        throw Core::Exception(Core::ErrorData("ModuleError", "FIReadFileError") << path.string());
+    }
+
+    //Get file format
+    FREE_IMAGE_FORMAT imageFormat = FreeImage_GetFileTypeFromMemory(memory, 0);
+    if (imageFormat == FIF_UNKNOWN)
+    {
+        //Check extension file
+        imageFormat = FreeImage_GetFIFFromFilenameU(path.c_str());
+    }
+
+    FIBITMAP* imageData = nullptr;
+    if (imageFormat != FIF_UNKNOWN && FreeImage_FIFSupportsReading(imageFormat))
+    {
+        imageData = FreeImage_LoadFromMemory(imageFormat, memory, 0);
+    }
+    FreeImage_CloseMemory(memory);
+
+    if (imageData == nullptr)
+    {
+        throw Core::Exception(Core::ErrorData("ModuleError", imageFormat == FIF_UNKNOWN ? "FIUnknownFileError" : "FIReadFileError") << path.string());
+    }
+    _imageData = FreeImage_ConvertTo32Bits(imageData);
+    FreeImage_Unload(imageData);
+
+    MouCa::postCondition(!isNull());
+}
+
 void ImageFI::createFill(const RT::BufferCPUBase& imageBuffer, const uint32_t width, const uint32_t height)
 {
     MouCa::preCondition( isNull() );
@@ -77,27 +117,15 @@ void ImageFI::createFill(const RT::BufferCPUBase& imageBuffer, const uint32_t wi
         throw Core::Exception(Core::ErrorData("BasicError", "NULLPointerError") << "_imageData");
     }
 
-    const uint8_t* pSource = reinterpret_cast<const uint8_t*>(imageBuffer.getData());
-    uint8_t* pPixel = FreeImage_GetBits(_imageData);
-
-    //Copy the picture
-    const uint64_t pitchRow = imageBuffer.getPitchRow();
-    if (pitchRow == 0)
+    //Copy the picture with orientation change to Y down: one pass, source row goes directly to its flipped scanline
+    const uint8_t* pSource  = reinterpret_cast<const uint8_t*>(imageBuffer.getData());
+    const uint64_t rowSize  = descriptor.getByteSize() * width;
+    const uint64_t pitchRow = imageBuffer.getPitchRow() == 0 ? rowSize : imageBuffer.getPitchRow();
+    for (uint32_t rowID = 0; rowID < height; ++rowID)
     {
-        memcpy(pPixel, pSource, descriptor.getByteSize() * imageBuffer.getNbElements());
+        memcpy(FreeImage_GetScanLine(_imageData, static_cast<int>(height - 1 - rowID)), pSource, rowSize);
+        pSource += pitchRow;
     }
-    else
-    {
-        for (uint64_t rowID = 0; rowID < height; ++rowID)
-        {
-            memcpy(pPixel, pSource, descriptor.getByteSize() * width);
-            pSource += pitchRow;
-            pPixel += descriptor.getByteSize() * width;
-        }
-    }
-
-    // Change orientation to Y down
-    FreeImage_FlipVertical(_imageData);
 
     MouCa::postCondition(!isNull());
 }
@@ -166,41 +194,24 @@ bool ImageFI::compare(const RT::Image& reference, const size_t nbMaxDefectPixels
 {
     MouCa::preCondition(!isNull());
 
-    const uint32_t layer = 0;
     const uint32_t level = 0;
     const RT::Array3ui extents = getExtents(level);
     const bool equal = extents == reference.getExtents(level);
     if(!equal)
     {
-#ifndef NDEBUG
-        const RT::Array3ui refExtents = reference.getExtents(level);
-        Core::String message = Core::String("Comparison image: different size: ") + std::to_string(extents.x) + Core::String("x") + std::to_string(extents.y)
-            + Core::String(" != ")
-            + std::to_string(refExtents.x) + Core::String("x") + std::to_string(refExtents.y)
-            + Core::String("\nComparison: FAILURE");
-        MouCa::logConsole(message);
-#endif
+        MOUCA_LOG_DEBUG(Media, "Comparison image: different size: {}x{} != {}x{}\nComparison: FAILURE",
+                        extents.x, extents.y, reference.getExtents(level).x, reference.getExtents(level).y);
         return equal;
     }
-    Core::ColorUC32 const* const src = getData<Core::ColorUC32>(layer, level);
-    Core::ColorUC32 const* const ref = reference.getData<Core::ColorUC32>(layer, level);
+    RT::ImageComparison::Settings settings;
+    settings._maxDistance4D     = maxDistance4D;
+    settings._nbMaxDefectPixels = nbMaxDefectPixels;
 
-    double max = 0;
-    size_t nbDefect = 0;
-    const size_t memory = extents.x * extents.y * extents.z;
-    for(size_t id = 0; id < memory; ++id)
-    {
-        const double distance4D = fabs(src[id].m_color[0] - ref[id].m_color[0])
-            + fabs(src[id].m_color[1] - ref[id].m_color[1])
-            + fabs(src[id].m_color[2] - ref[id].m_color[2])
-            + fabs(src[id].m_color[3] - ref[id].m_color[3]);
-        if(distance4D > maxDistance4D)
-        {
-            ++nbDefect;
-            max = std::max(max, distance4D);
-        }
-    }
+    RT::ImageComparison comparison;
+    comparison.compute(*this, reference, settings);
 
+    const double max      = comparison.getMaxDistance();
+    const size_t nbDefect = comparison.getNbDefects();
     if (nbDefectPixels != nullptr)
     {
         *nbDefectPixels = nbDefect;
@@ -210,13 +221,8 @@ bool ImageFI::compare(const RT::Image& reference, const size_t nbMaxDefectPixels
         *distance = max;
     }
 
-#ifndef NDEBUG
-    const Core::String state = (nbMaxDefectPixels >= nbDefect) ? Core::String("SUCCESS\n") : Core::String("FAILURE\n");
-    Core::String message = Core::String("Comparison image: max defect distance: ") + std::to_string(max) + Core::String(" < ") + std::to_string(maxDistance4D)
-        + Core::String("\n                  pixel count: ") + std::to_string(nbDefect) + Core::String(" < ") + std::to_string(nbMaxDefectPixels)
-        + Core::String("\nComparison: ") + state;
-    MouCa::logConsole(message);
-#endif
+    MOUCA_LOG_DEBUG(Media, "Comparison image: max defect distance: {} < {}\n                  pixel count: {} < {}\nComparison: {}",
+                    max, maxDistance4D, nbDefect, nbMaxDefectPixels, (nbMaxDefectPixels >= nbDefect) ? "SUCCESS" : "FAILURE");
     return nbMaxDefectPixels >= nbDefect;
 }
 
@@ -32,10 +32,169 @@ void ImageKTX::initialize(const Core::Path& path)
     {
         throw Core::Exception(Core::ErrorData("LibMedia", "KTXReadError") << path.string());
     }
+    _readyLevels = Image::getReadyLevels();
 
     MouCa::preCondition(!isNull());
 }
 
+namespace
+{
+    // KTX2 file description (see Khronos KTX 2.0 specification)
+    struct KTX2Header
+    {
+        std::array<uint8_t, 12> _identifier;
+        uint32_t _vkFormat;
+        uint32_t _typeSize;
+        uint32_t _pixelWidth;
+        uint32_t _pixelHeight;
+        uint32_t _pixelDepth;
+        uint32_t _layerCount;
+        uint32_t _faceCount;
+        uint32_t _levelCount;
+        uint32_t _supercompressionScheme;
+        uint32_t _dfdByteOffset;
+        uint32_t _dfdByteLength;
+        uint32_t _kvdByteOffset;
+        uint32_t _kvdByteLength;
+        uint64_t _sgdByteOffset;
+        uint64_t _sgdByteLength;
+    };
+    static_assert(sizeof(KTX2Header) == 80);
+
+    struct KTX2Level
+    {
+        uint64_t _byteOffset;
+        uint64_t _byteLength;
+        uint64_t _uncompressedByteLength;
+    };
+
+    const std::array<uint8_t, 12> ktx2Identifier = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+}
+
+void ImageKTX::prepare(const Core::Path& path)
+{
+    MouCa::preCondition(isNull());
+    MouCa::preCondition(!path.empty());
+
+    // Read only description: file stays open for ktxTexture_LoadImageData()
+    if (ktxTexture_CreateFromNamedFile(path.string().c_str(), KTX_TEXTURE_CREATE_NO_FLAGS, &_images) != KTX_SUCCESS)
+    {
+        throw Core::Exception(Core::ErrorData("LibMedia", "KTXReadError") << path.string());
+    }
+    _filename = path;
+
+    // Check if KTX2 without supercompression: each level/layer can be read directly from mapping
+    _mapped = std::make_unique<Core::MappedFile>(path);
+    try
+    {
+        _mapped->open(Core::MappedFile::Advice::Sequential);
+    }
+    catch (const Core::Exception&)
+    {
+        release();
+        throw;
+    }
+
+    KTX2Header header{};
+    if (_mapped->getSize() >= sizeof(header))
+    {
+        std::memcpy(&header, _mapped->getData(), sizeof(header));
+    }
+    const bool byLevel = header._identifier == ktx2Identifier && header._supercompressionScheme == 0;
+    if (byLevel)
+    {
+        const uint32_t nbLevels = std::max(1u, header._levelCount);
+        const uint32_t nbLayers = std::max(1u, header._layerCount);
+
+        std::vector<KTX2Level> index(nbLevels);
+        try
+        {
+            const auto view = _mapped->getView(sizeof(header), sizeof(KTX2Level) * index.size());
+            std::memcpy(index.data(), view.data(), view.size());
+            // Check all levels are inside file
+            for (const auto& level : index)
+            {
+                _mapped->getView(static_cast<size_t>(level._byteOffset), static_cast<size_t>(level._byteLength));
+            }
+        }
+        catch (const Core::Exception&)
+        {
+            release();
+            throw Core::Exception(Core::ErrorData("LibMedia", "KTXReadError") << path.string());
+        }
+
+        // Levels are stored from smallest to biggest: keep same layout into memory
+        const auto [first, last] = std::minmax_element(index.cbegin(), index.cend(), [](const auto& a, const auto& b) { return a._byteOffset < b._byteOffset; });
+        const size_t base = static_cast<size_t>(first->_byteOffset);
+        _dataSize = static_cast<size_t>(last->_byteOffset + last->_byteLength) - base;
+        _data     = std::make_unique_for_overwrite<uint8_t[]>(_dataSize);
+
+        _levels.reserve(nbLevels);
+        for (const auto& level : index)
+        {
+            _levels.push_back({ static_cast<size_t>(level._byteOffset), static_cast<size_t>(level._byteOffset) - base, static_cast<size_t>(level._byteLength / nbLayers) });
+        }
+
+        // Coarse levels first
+        _remainingLayers = std::vector<std::atomic<uint32_t>>(nbLevels);
+        for (uint32_t level = nbLevels; level > 0; --level)
+        {
+            _remainingLayers[level - 1] = nbLayers;
+            for (uint32_t layer = 0; layer < nbLayers; ++layer)
+            {
+                _tasks.push_back({ level - 1, layer });
+            }
+        }
+    }
+    else
+    {
+        // libktx reads file itself
+        _mapped.reset();
+        _tasks.push_back({ DecodeTask::_allLevels, 0 });
+    }
+    _readyLevels = 0;
+
+    MouCa::postCondition(!isNull());
+    MouCa::postCondition(!_tasks.empty());
+}
+
+void ImageKTX::decode(const size_t task)
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(task < _tasks.size());
+
+    const auto& job = _tasks[task];
+    if (job._level == DecodeTask::_allLevels)
+    {
+        if (ktxTexture_LoadImageData(_images, nullptr, 0) != KTX_SUCCESS)
+        {
+            throw Core::Exception(Core::ErrorData("LibMedia", "KTXReadError") << _filename.string());
+        }
+        _readyLevels.store(Image::getReadyLevels(), std::memory_order_release);
+        return;
+    }
+
+    // Mapping is shared by all tasks without lock: copy directly from page cache
+    const auto& level = _levels[job._level];
+    const size_t offset = level._layerSize * job._layer;
+
+    const auto view = _mapped->getView(level._fileOffset + offset, level._layerSize);
+    std::memcpy(&_data[level._memoryOffset + offset], view.data(), view.size());
+
+    // Latest layer of level
+    if (_remainingLayers[job._level].fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        const uint64_t levelBit = 1ull << job._level;
+        const uint64_t ready    = _readyLevels.fetch_or(levelBit, std::memory_order_acq_rel) | levelBit;
+
+        // Latest level: all tasks have finished to read mapping, release it now
+        if (ready == Image::getReadyLevels())
+        {
+            _mapped.reset();
+        }
+    }
+}
+
 void ImageKTX::createFill(const RT::BufferCPUBase& imageBuffer, const uint32_t width, const uint32_t height)
 {
     throw Core::Exception(Core::ErrorData("BasicError", "ImageNoneImplemented"));
@@ -48,6 +207,15 @@ void ImageKTX::release()
     ktxTexture_Destroy(_images);
     _images = nullptr;
 
+    _filename.clear();
+    _mapped.reset();
+    _levels.clear();
+    _data.reset();
+    _dataSize = 0;
+    _tasks.clear();
+    _remainingLayers.clear();
+    _readyLevels = 0;
+
     MouCa::postCondition(isNull());
 }
 
@@ -79,6 +247,11 @@ const ImageKTX::HandlerMemory ImageKTX::getRAWData(const uint32_t layer, const u
 {
     MouCa::preCondition(!isNull());
 
+    if (!_levels.empty())
+    {
+        return _data.get() + getMemoryOffset(layer, level);
+    }
+
     ktx_size_t offset;
     auto result = ktxTexture_GetImageOffset(_images, level, layer, 0, &offset);
     MouCa::assertion(result == KTX_SUCCESS);
@@ -89,6 +262,12 @@ size_t ImageKTX::getMemoryOffset(const uint32_t layer, const uint32_t level) con
 {
     MouCa::preCondition(!isNull());
 
+    if (!_levels.empty())
+    {
+        MouCa::preCondition(level < _levels.size() && layer < getLayers());
+        return _levels[level]._memoryOffset + _levels[level]._layerSize * layer;
+    }
+
     size_t offset = 0;
     auto result = ktxTexture_GetImageOffset(_images, level, layer, 0, &offset);
     MouCa::assertion(result == KTX_SUCCESS);
@@ -98,7 +277,7 @@ size_t ImageKTX::getMemoryOffset(const uint32_t layer, const uint32_t level) con
 size_t ImageKTX::getMemorySize() const
 {
     MouCa::preCondition(!isNull());
-    return _images->dataSize;
+    return _levels.empty() ? _images->dataSize : _dataSize;
 }
 
 void ImageKTX::saveImage(const Core::Path& filename)
@@ -106,6 +285,14 @@ void ImageKTX::saveImage(const Core::Path& filename)
     MouCa::preCondition(!isNull());
     MouCa::preCondition(!filename.empty());
 
+    // Data read by level are an exact copy of file
+    if (!_levels.empty())
+    {
+        MouCa::preCondition(getReadyLevels() == Image::getReadyLevels()); // DEV Issue: Decoding is not finished !
+        std::filesystem::copy_file(_filename, filename, std::filesystem::copy_options::overwrite_existing);
+        return;
+    }
+
     if(ktxTexture_WriteToNamedFile(_images, filename.string().c_str()))
     {
         throw Core::Exception(Core::ErrorData("BasicError", "ImageKTXSave") << filename.string());
@@ -123,6 +310,14 @@ bool ImageKTX::compare(const RT::Image& reference, const size_t nbMaxDefectPixel
     throw Core::Exception(Core::ErrorData("BasicError", "ImageNoneImplemented"));
 }
 
+uint32_t ImageKTX::getFormat() const
+{
+    MouCa::preCondition(!isNull());
+
+    // KTX1 stores OpenGL format: user defines it
+    return _images->classId == ktxTexture2_c ? reinterpret_cast<const ktxTexture2*>(_images)->vkFormat : 0;
+}
+
 ImageKTX::Target ImageKTX::getTarget() const
 {
     MouCa::preCondition(!isNull());
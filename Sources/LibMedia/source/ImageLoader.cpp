@@ -3,24 +3,28 @@
 /// \license No license
 #include "Dependencies.h"
 
+#include <LibCore/include/CoreLogger.h>
+
 #include <LibRT/include/RTBufferCPU.h>
 #include <LibRT/include/RTBufferDescriptor.h>
+#include <LibRT/include/RTImageComparison.h>
 
 #include <LibMedia/include/ImageFI.h>
 #include <LibMedia/include/ImageKTX.h>
+#include <LibMedia/include/ImageMipmap.h>
 
 #include <LibMedia/include/ImageLoader.h>
 
 namespace Media
 {
 
-RT::ImageSPtr ImageLoader::openImage(const Core::Path& fileName)
+RT::ImageSPtr ImageLoader::openImage(const Core::Path& fileName, const std::span<const uint8_t> fileData)
 {
     MouCa::preCondition( !fileName.empty() );
 
     const auto ext = fileName.extension().u8string();
     // Special OpenGL/Vulkan format
-    if(ext == u8".dds" || ext == u8".ktx" || ext == u8".kmg")
+    if(ext == u8".dds" || ext == u8".ktx" || ext == u8".ktx2" || ext == u8".kmg")
     {
         auto image = std::make_shared<ImageKTX>();
         image->initialize(fileName);
@@ -29,10 +33,175 @@ RT::ImageSPtr ImageLoader::openImage(const Core::Path& fileName)
 
     // All formats (PNG, JPG, ...)
     auto image = std::make_shared<ImageFI>();
-    image->initialize(fileName);
+    if (fileData.empty())
+    {
+        image->initialize(fileName);
+    }
+    else
+    {
+        image->initialize(fileName, fileData);
+    }
+    return image;
+}
+
+RT::ImageSPtr ImageLoader::openImage(const Core::Path& fileName, const RT::ImageImport::Options& options, const std::span<const uint8_t> fileData, Core::ThreadPools* threadPools)
+{
+    MouCa::preCondition(!fileName.empty());
+
+    auto image = openImage(fileName, fileData);
+    auto imageFI = std::dynamic_pointer_cast<ImageFI>(image);
+    if (imageFI == nullptr || options.isDefault())
+    {
+        return image;
+    }
+
+    // FreeImage memory is BGRA or RGBA depending on platform
+    const ImageMipmap::Channels channels = { FI_RGBA_RED, FI_RGBA_GREEN, FI_RGBA_BLUE, FI_RGBA_ALPHA };
+
+    auto mipmap = std::make_shared<ImageMipmap>();
+    mipmap->initialize(*imageFI, options, channels, threadPools);
+    imageFI->release();
+    return mipmap;
+}
+
+RT::ImageSPtr ImageLoader::openImage(const RT::ImageImport& imageImport, const std::span<const uint8_t> fileData, Core::ThreadPools* threadPools)
+{
+    MouCa::preCondition(!imageImport.getFilename().empty());
+
+    const auto& cache = imageImport.getCacheFilename();
+    if (!cache.empty() && std::filesystem::exists(cache))
+    {
+        try
+        {
+            return openImage(cache);
+        }
+        catch (const Core::Exception&)
+        {
+            // Corrupted cache (crash during writing ?): bake again
+            std::filesystem::remove(cache);
+        }
+    }
+
+    auto image = openImage(imageImport.getFilename(), imageImport.getOptions(), fileData, threadPools);
+    if (!cache.empty())
+    {
+        try
+        {
+            saveKTX2(*image, cache, imageImport.getOptions()._sRGB, imageImport.getCacheZstdLevel());
+        }
+        catch (const Core::Exception&)
+        {
+            // Cache is only an optimization: image is valid
+            MOUCA_LOG_WARNING(Media, "Impossible to write image cache: {}", cache.string());
+        }
+    }
+    return image;
+}
+
+bool ImageLoader::isDecodedFromSource(const RT::ImageImport& imageImport)
+{
+    const auto& cache = imageImport.getCacheFilename();
+    if (!cache.empty() && std::filesystem::exists(cache))
+    {
+        return false;
+    }
+
+    const auto ext = imageImport.getFilename().extension().u8string();
+    return ext != u8".dds" && ext != u8".ktx" && ext != u8".ktx2" && ext != u8".kmg";
+}
+
+std::shared_ptr<ImageKTX> ImageLoader::prepareImage(const RT::ImageImport& imageImport)
+{
+    MouCa::preCondition(!imageImport.getFilename().empty());
+
+    const auto& cache = imageImport.getCacheFilename();
+    const bool  isCached = !cache.empty() && std::filesystem::exists(cache);
+    const auto& fileName = isCached ? cache : imageImport.getFilename();
+
+    const auto ext = fileName.extension().u8string();
+    if (ext != u8".ktx" && ext != u8".ktx2")
+    {
+        return nullptr;
+    }
+
+    auto image = std::make_shared<ImageKTX>();
+    try
+    {
+        image->prepare(fileName);
+    }
+    catch (const Core::Exception&)
+    {
+        if (!isCached)
+        {
+            throw;
+        }
+        // Corrupted cache: openImage() bakes again
+        std::filesystem::remove(cache);
+        return nullptr;
+    }
     return image;
 }
 
+void ImageLoader::saveKTX2(const RT::Image& image, const Core::Path& fileName, const bool sRGB, const uint32_t zstdLevel)
+{
+    MouCa::preCondition(!image.isNull());
+    MouCa::preCondition(!fileName.empty());
+    MouCa::preCondition(image.getLayers() == 1 && image.getExtents(0).z == 1);
+
+    // Uncompressed image without format is FreeImage memory
+    const uint32_t format = image.getFormat() != 0 ? image.getFormat()
+                          : ImageMipmap::computeFormat(RT::ImageImport::Options::Compression::None, sRGB);
+
+    const auto extents = image.getExtents(0);
+    ktxTextureCreateInfo createInfo = {};
+    createInfo.vkFormat        = format;
+    createInfo.baseWidth       = extents.x;
+    createInfo.baseHeight      = extents.y;
+    createInfo.baseDepth       = 1;
+    createInfo.numDimensions   = 2;
+    createInfo.numLevels       = image.getLevels();
+    createInfo.numLayers       = 1;
+    createInfo.numFaces        = 1;
+    createInfo.isArray         = KTX_FALSE;
+    createInfo.generateMipmaps = KTX_FALSE;
+
+    ktxTexture2* texture = nullptr;
+    if (ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &texture) != KTX_SUCCESS)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "ImageKTXSave") << fileName.string());
+    }
+
+    KTX_error_code result = KTX_SUCCESS;
+    for (uint32_t level = 0; level < image.getLevels() && result == KTX_SUCCESS; ++level)
+    {
+        // Size from extent and format: memory of image can contain header (FreeImage) or padding
+        const size_t size = ktxTexture_GetImageSize(ktxTexture(texture), level);
+        result = ktxTexture_SetImageFromMemory(ktxTexture(texture), level, 0, 0,
+                                               reinterpret_cast<const ktx_uint8_t*>(image.getRAWData(0, level)), size);
+    }
+
+    if (result == KTX_SUCCESS && zstdLevel > 0)
+    {
+        result = ktxTexture2_DeflateZstd(texture, zstdLevel);
+    }
+
+    // Write into temporary file: a reader never sees partial cache
+    Core::Path temporary = fileName;
+    temporary += L".tmp";
+    if (result == KTX_SUCCESS)
+    {
+        result = ktxTexture_WriteToNamedFile(ktxTexture(texture), temporary.string().c_str());
+    }
+    ktxTexture_Destroy(ktxTexture(texture));
+
+    if (result != KTX_SUCCESS)
+    {
+        std::filesystem::remove(temporary);
+        throw Core::Exception(Core::ErrorData("BasicError", "ImageKTXSave") << fileName.string());
+    }
+    std::filesystem::rename(temporary, fileName);
+}
+
 RT::ImageSPtr ImageLoader::createImageFI(const RT::BufferCPUBase& imageBuffer, const uint32_t width, const uint32_t height)
 {
     auto image =std::make_shared<ImageFI>();
@@ -70,4 +239,66 @@ void ImageLoader::export2D(RT::Image& image, const Core::Path& fileName)
     }
 }
 
+void ImageLoader::exportHeatMap(const RT::ImageComparison& comparison, const Core::Path& fileName, const uint32_t cellSize)
+{
+    MouCa::preCondition(!fileName.empty());
+    MouCa::preCondition(cellSize > 0);
+
+    const RT::Array2ui& grid = comparison.getGrid();
+    if (grid.x == 0 || grid.y == 0)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "NULLPointerError") << "comparison");
+    }
+
+    static const int byteToBit = 8;
+    FIBITMAP* heatMap = FreeImage_Allocate(static_cast<int>(grid.x * cellSize), static_cast<int>(grid.y * cellSize), byteToBit * 4);
+    if (heatMap == nullptr)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "NULLPointerError") << "heatMap");
+    }
+
+    // Max distance 4D of RGBA 8 bits
+    const double maxDistance = 4.0 * 255.0;
+    for (uint32_t y = 0; y < grid.y; ++y)
+    {
+        for (uint32_t x = 0; x < grid.x; ++x)
+        {
+            const auto& tile = comparison.getTile(x, y);
+
+            std::array<BYTE, 4> color = { 0, 0, 0, 255 };
+            if (tile._failed)
+            {
+                color[FI_RGBA_RED] = static_cast<BYTE>(128.0 + 127.0 * std::min(1.0, tile._maxDistance / maxDistance));
+            }
+            else
+            {
+                const BYTE grey = static_cast<BYTE>(32.0 + 96.0 * std::min(1.0, tile._meanDistance / std::max(1.0, comparison.getSettings()._maxDistance4D)));
+                color[FI_RGBA_RED]   = grey;
+                color[FI_RGBA_GREEN] = grey;
+            }
+            color[FI_RGBA_BLUE]  = static_cast<BYTE>(255.0 * std::clamp(1.0 - tile._ssim, 0.0, 1.0));
+            color[FI_RGBA_ALPHA] = 255;
+
+            // Tile row 0 is bottom row of image (see RT::Image::getRowStride()) like FreeImage scan line 0: same orientation as compared image.
+            for (uint32_t cy = 0; cy < cellSize; ++cy)
+            {
+                BYTE* pixel = FreeImage_GetScanLine(heatMap, static_cast<int>(y * cellSize + cy)) + x * cellSize * 4;
+                for (uint32_t cx = 0; cx < cellSize; ++cx, pixel += 4)
+                {
+                    memcpy(pixel, color.data(), color.size());
+                }
+            }
+        }
+    }
+
+    const FREE_IMAGE_FORMAT imageFormat = FreeImage_GetFIFFromFilenameU(fileName.c_str());
+    const bool saved = imageFormat != FIF_UNKNOWN && FreeImage_SaveU(imageFormat, heatMap, fileName.c_str(), 0) == TRUE;
+    FreeImage_Unload(heatMap);
+
+    if (!saved)
+    {
+        throw Core::Exception(Core::ErrorData("ModuleError", "FISaveFileError") << fileName.string());
+    }
+}
+
 }
\ No newline at end of file
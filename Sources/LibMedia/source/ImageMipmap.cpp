@@ -0,0 +1,489 @@
+#include "Dependencies.h"
+
+#include "LibCore/include/CoreThreadPools.h"
+
+#include "LibMedia/include/ImageMipmap.h"
+
+#include "LibMedia/include/ImageBlockCompression.h"
+#include "LibMedia/include/ImageFI.h"
+
+#include "LibRT/include/RTBufferCPU.h"
+#include "LibRT/include/RTBufferDescriptor.h"
+#include "LibRT/include/RTImageComparison.h"
+
+namespace Media
+{
+
+namespace
+{
+    //------------------------------------------------------------------------
+    /// \brief  Execute functor on [0, count[ with workers of pools.
+    ///
+    /// \param[in] count: number of items.
+    /// \param[in] threadPools: workers (nullptr: current thread only).
+    /// \param[in] functor: job for one item.
+    void parallelFor(const size_t count, Core::ThreadPools* threadPools, const std::function<void(const size_t)>& functor)
+    {
+        auto range = [&](const size_t begin, const size_t end)
+        {
+            for (size_t id = begin; id < end; ++id)
+            {
+                functor(id);
+            }
+        };
+
+        if (threadPools != nullptr)
+        {
+            threadPools->wait(threadPools->parallelFor(0, count, 0, range));
+        }
+        else
+        {
+            range(0, count);
+        }
+    }
+
+    //------------------------------------------------------------------------
+    /// \brief sRGB <-> linear conversion tables.
+    struct ColorSpace
+    {
+        static const size_t precision = 4096;
+
+        std::array<float, 256>         _toLinear;
+        std::array<uint8_t, precision> _toSRGB;
+
+        ColorSpace()
+        {
+            for (size_t id = 0; id < _toLinear.size(); ++id)
+            {
+                const float value = static_cast<float>(id) / 255.0f;
+                _toLinear[id] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+            }
+            for (size_t id = 0; id < _toSRGB.size(); ++id)
+            {
+                const float value = static_cast<float>(id) / static_cast<float>(precision - 1);
+                const float srgb  = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+                _toSRGB[id] = static_cast<uint8_t>(std::clamp(srgb * 255.0f + 0.5f, 0.0f, 255.0f));
+            }
+        }
+
+        uint8_t encode(const float linear) const
+        {
+            return _toSRGB[static_cast<size_t>(std::clamp(linear, 0.0f, 1.0f) * static_cast<float>(precision - 1) + 0.5f)];
+        }
+
+        static const ColorSpace& get()
+        {
+            static const ColorSpace colorSpace;
+            return colorSpace;
+        }
+    };
+
+    /// Float RGBA picture (linear space).
+    struct LinearLevel
+    {
+        uint32_t           _width  = 0;
+        uint32_t           _height = 0;
+        std::vector<float> _pixels;     ///< 4 floats per pixel.
+
+        void allocate(const uint32_t width, const uint32_t height)
+        {
+            _width  = width;
+            _height = height;
+            _pixels.resize(static_cast<size_t>(width) * height * 4);
+        }
+
+        float* at(const uint32_t x, const uint32_t y)
+        {
+            return &_pixels[(static_cast<size_t>(y) * _width + x) * 4];
+        }
+
+        const float* at(const uint32_t x, const uint32_t y) const
+        {
+            return &_pixels[(static_cast<size_t>(y) * _width + x) * 4];
+        }
+    };
+
+    //------------------------------------------------------------------------
+    /// \brief  Accumulate weighted RGBA pixel (SIMD when available).
+    inline void accumulate(float* output, const float* input, const float weight)
+    {
+#ifdef MOUCA_SIMD_SSE
+        _mm_storeu_ps(output, _mm_add_ps(_mm_loadu_ps(output), _mm_mul_ps(_mm_loadu_ps(input), _mm_set1_ps(weight))));
+#else
+        for (size_t c = 0; c < 4; ++c)
+            output[c] += input[c] * weight;
+#endif
+    }
+
+    //------------------------------------------------------------------------
+    /// \brief  2x2 box filter of one row.
+    void boxRow(const LinearLevel& source, LinearLevel& target, const uint32_t y)
+    {
+        const uint32_t y0 = std::min(2 * y,     source._height - 1);
+        const uint32_t y1 = std::min(2 * y + 1, source._height - 1);
+        for (uint32_t x = 0; x < target._width; ++x)
+        {
+            const uint32_t x0 = std::min(2 * x,     source._width - 1);
+            const uint32_t x1 = std::min(2 * x + 1, source._width - 1);
+
+            float* output = target.at(x, y);
+#ifdef MOUCA_SIMD_SSE
+            const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(source.at(x0, y0)), _mm_loadu_ps(source.at(x1, y0))),
+                                          _mm_add_ps(_mm_loadu_ps(source.at(x0, y1)), _mm_loadu_ps(source.at(x1, y1))));
+            _mm_storeu_ps(output, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+            for (size_t c = 0; c < 4; ++c)
+            {
+                output[c] = 0.25f * (source.at(x0, y0)[c] + source.at(x1, y0)[c] + source.at(x0, y1)[c] + source.at(x1, y1)[c]);
+            }
+#endif
+        }
+    }
+
+    //------------------------------------------------------------------------
+    /// \brief  Weights of 4 taps Kaiser-windowed sinc for 2:1 reduction (distances 1.5, 0.5, 0.5, 1.5).
+    const std::array<float, 4>& getKaiserWeights()
+    {
+        static const std::array<float, 4> weights = []()
+        {
+            // Modified Bessel function of first kind (order 0)
+            auto bessel = [](const double x)
+            {
+                double sum = 1.0, term = 1.0;
+                for (int k = 1; k < 32; ++k)
+                {
+                    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                    sum  += term;
+                }
+                return sum;
+            };
+            const double alpha  = 4.0;
+            const double radius = 2.0;
+            const double pi     = 3.14159265358979323846;
+
+            std::array<float, 4> kernel;
+            const std::array<double, 4> distances = { 1.5, 0.5, 0.5, 1.5 };
+            double total = 0.0;
+            for (size_t id = 0; id < kernel.size(); ++id)
+            {
+                const double x      = distances[id] / radius;
+                const double sinc   = std::sin(pi * x) / (pi * x);
+                const double window = bessel(alpha * std::sqrt(1.0 - x * x)) / bessel(alpha);
+                kernel[id] = static_cast<float>(sinc * window);
+                total += kernel[id];
+            }
+            for (auto& weight : kernel)
+                weight = static_cast<float>(weight / total);
+            return kernel;
+        }();
+        return weights;
+    }
+
+    //------------------------------------------------------------------------
+    /// \brief  Horizontal Kaiser reduction of one row (source row y, target has half width).
+    void kaiserRowX(const LinearLevel& source, LinearLevel& target, const uint32_t y)
+    {
+        const auto& weights = getKaiserWeights();
+        for (uint32_t x = 0; x < target._width; ++x)
+        {
+            float* output = target.at(x, y);
+            std::fill(output, output + 4, 0.0f);
+            for (int tap = 0; tap < 4; ++tap)
+            {
+                const int sx = std::clamp(static_cast<int>(2 * x) - 1 + tap, 0, static_cast<int>(source._width) - 1);
+                accumulate(output, source.at(static_cast<uint32_t>(sx), y), weights[tap]);
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------
+    /// \brief  Vertical Kaiser reduction of one row (target row y from 4 source rows).
+    void kaiserRowY(const LinearLevel& source, LinearLevel& target, const uint32_t y)
+    {
+        const auto& weights = getKaiserWeights();
+        for (uint32_t x = 0; x < target._width; ++x)
+        {
+            float* output = target.at(x, y);
+            std::fill(output, output + 4, 0.0f);
+            for (int tap = 0; tap < 4; ++tap)
+            {
+                const int sy = std::clamp(static_cast<int>(2 * y) - 1 + tap, 0, static_cast<int>(source._height) - 1);
+                accumulate(output, source.at(x, static_cast<uint32_t>(sy)), weights[tap]);
+            }
+        }
+    }
+}
+
+uint32_t ImageMipmap::computeNbLevels(const uint32_t width, const uint32_t height)
+{
+    MouCa::preCondition(width > 0 && height > 0);
+
+    uint32_t levels = 1;
+    uint32_t size = std::max(width, height);
+    while (size > 1)
+    {
+        size >>= 1;
+        ++levels;
+    }
+    return levels;
+}
+
+uint32_t ImageMipmap::computeFormat(const Options::Compression compression, const bool sRGB)
+{
+    // VkFormat values (LibMedia doesn't depend on Vulkan)
+    enum VkFormat : uint32_t
+    {
+        R8G8B8A8_UNORM      = 37,
+        R8G8B8A8_SRGB       = 43,
+        B8G8R8A8_UNORM      = 44,
+        B8G8R8A8_SRGB       = 50,
+        BC1_RGBA_UNORM      = 133,
+        BC1_RGBA_SRGB       = 134,
+        BC3_UNORM           = 137,
+        BC3_SRGB            = 138,
+        BC5_UNORM           = 141,
+        BC7_UNORM           = 145,
+        BC7_SRGB            = 146
+    };
+
+    switch (compression)
+    {
+        case Options::Compression::None: // FreeImage memory order
+            if constexpr (FI_RGBA_RED == 0)
+                return sRGB ? R8G8B8A8_SRGB : R8G8B8A8_UNORM;
+            else
+                return sRGB ? B8G8R8A8_SRGB : B8G8R8A8_UNORM;
+        case Options::Compression::BC1: return sRGB ? BC1_RGBA_SRGB : BC1_RGBA_UNORM;
+        case Options::Compression::BC3: return sRGB ? BC3_SRGB      : BC3_UNORM;
+        case Options::Compression::BC5: return BC5_UNORM;
+        case Options::Compression::BC7: return sRGB ? BC7_SRGB      : BC7_UNORM;
+    }
+    MouCa::assertion(false); // DEV Issue: new compression ?
+    return 0;
+}
+
+void ImageMipmap::initialize(const RT::Image& source, const Options& options, const Channels& channels, Core::ThreadPools* threadPools)
+{
+    MouCa::preCondition(isNull());
+    MouCa::preCondition(!source.isNull());
+
+    const auto& colorSpace = ColorSpace::get();
+    const auto  extents    = source.getExtents(0);
+    const uint32_t nbLevels = options._mipmaps == Options::Filter::None ? 1 : computeNbLevels(extents.x, extents.y);
+
+    _compression = options._compression;
+    _sRGB        = options._sRGB;
+
+    // Describe all levels
+    size_t offset = 0;
+    _levels.resize(nbLevels);
+    for (uint32_t level = 0; level < nbLevels; ++level)
+    {
+        const RT::Array3ui size(std::max(1u, extents.x >> level), std::max(1u, extents.y >> level), 1);
+        _levels[level] = { size, offset, BlockCompression::getLevelSize(_compression, size.x, size.y) };
+        offset += _levels[level]._size;
+    }
+    _data.resize(offset);
+
+    // Convert level 0 to linear space (swizzle to RGBA only for block compression)
+    const Channels order = _compression == Options::Compression::None ? Channels({ 0, 1, 2, 3 }) : channels;
+    std::vector<LinearLevel> linears(nbLevels);
+    {
+        Core::ColorUC32 const* const pixels = source.getData<Core::ColorUC32>(0, 0);
+        linears[0].allocate(extents.x, extents.y);
+        parallelFor(extents.y, threadPools, [&](const size_t y)
+        {
+            for (uint32_t x = 0; x < extents.x; ++x)
+            {
+                const auto& pixel = pixels[y * extents.x + x];
+                float* output = linears[0].at(x, static_cast<uint32_t>(y));
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    const uint8_t value = pixel.m_color[order[c]];
+                    output[c] = options._sRGB ? colorSpace._toLinear[value] : static_cast<float>(value) / 255.0f;
+                }
+                output[3] = static_cast<float>(pixel.m_color[order[3]]) / 255.0f;
+            }
+        });
+    }
+
+    // Build chain: each level depends on previous but rows are independent
+    for (uint32_t level = 1; level < nbLevels; ++level)
+    {
+        const auto& previous = linears[level - 1];
+        auto& current = linears[level];
+        current.allocate(_levels[level]._extents.x, _levels[level]._extents.y);
+
+        if (options._mipmaps == Options::Filter::Box)
+        {
+            parallelFor(current._height, threadPools, [&](const size_t y) { boxRow(previous, current, static_cast<uint32_t>(y)); });
+        }
+        else
+        {
+            LinearLevel horizontal;
+            horizontal.allocate(current._width, previous._height);
+            parallelFor(horizontal._height, threadPools, [&](const size_t y) { kaiserRowX(previous, horizontal, static_cast<uint32_t>(y)); });
+            parallelFor(current._height,    threadPools, [&](const size_t y) { kaiserRowY(horizontal, current, static_cast<uint32_t>(y)); });
+        }
+    }
+
+    // Encode 8 bits: directly on final buffer when uncompressed
+    std::vector<std::vector<Core::ColorUC32>> encoded(_compression == Options::Compression::None ? 0 : nbLevels);
+    for (uint32_t level = 0; level < nbLevels; ++level)
+    {
+        const auto& linear = linears[level];
+        Core::ColorUC32* output = nullptr;
+        if (_compression == Options::Compression::None)
+        {
+            output = reinterpret_cast<Core::ColorUC32*>(&_data[_levels[level]._offset]);
+
+            // Level 0 is exact copy of source (avoid sRGB round trip)
+            if (level == 0)
+            {
+                memcpy(output, source.getData<Core::ColorUC32>(0, 0), _levels[0]._size);
+                continue;
+            }
+        }
+        else
+        {
+            encoded[level].resize(static_cast<size_t>(linear._width) * linear._height);
+            output = encoded[level].data();
+        }
+
+        parallelFor(linear._height, threadPools, [&](const size_t y)
+        {
+            for (uint32_t x = 0; x < linear._width; ++x)
+            {
+                const float* input = linear.at(x, static_cast<uint32_t>(y));
+                auto& pixel = output[y * linear._width + x];
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    pixel.m_color[c] = options._sRGB ? colorSpace.encode(input[c])
+                                                     : static_cast<uint8_t>(std::clamp(input[c] * 255.0f + 0.5f, 0.0f, 255.0f));
+                }
+                pixel.m_color[3] = static_cast<uint8_t>(std::clamp(input[3] * 255.0f + 0.5f, 0.0f, 255.0f));
+            }
+        });
+    }
+    linears.clear();
+
+    // Compress all rows of blocks of all levels in parallel
+    if (_compression != Options::Compression::None)
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> jobs; // Level, row of blocks
+        for (uint32_t level = 0; level < nbLevels; ++level)
+        {
+            const uint32_t blocksY = (_levels[level]._extents.y + 3) / 4;
+            for (uint32_t blockY = 0; blockY < blocksY; ++blockY)
+            {
+                jobs.emplace_back(level, blockY);
+            }
+        }
+
+        parallelFor(jobs.size(), threadPools, [&](const size_t id)
+        {
+            const auto& job   = jobs[id];
+            const auto& level = _levels[job.first];
+            BlockCompression::compressRow(_compression, encoded[job.first].data(), level._extents.x, level._extents.y,
+                                          job.second, &_data[level._offset]);
+        });
+    }
+
+    MouCa::postCondition(!isNull());
+}
+
+void ImageMipmap::createFill(const RT::BufferCPUBase& imageBuffer, const uint32_t width, const uint32_t height)
+{
+    MOUCA_UNUSED(imageBuffer);
+    MOUCA_UNUSED(width);
+    MOUCA_UNUSED(height);
+    throw Core::Exception(Core::ErrorData("BasicError", "ImageNoneImplemented"));
+}
+
+void ImageMipmap::release()
+{
+    MouCa::preCondition(!isNull());
+
+    _levels.clear();
+    _data.clear();
+    _data.shrink_to_fit();
+    _compression = Options::Compression::None;
+    _sRGB        = true;
+
+    MouCa::postCondition(isNull());
+}
+
+const RT::Image::HandlerMemory ImageMipmap::getRAWData(const uint32_t layer, const uint32_t level) const
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(layer < getLayers());
+    MouCa::preCondition(level < getLevels());
+    MOUCA_UNUSED(layer);
+
+    return const_cast<uint8_t*>(&_data[_levels[level]._offset]);
+}
+
+size_t ImageMipmap::getMemoryOffset(const uint32_t layer, const uint32_t level) const
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(layer < getLayers());
+    MouCa::preCondition(level < getLevels());
+    MOUCA_UNUSED(layer);
+
+    return _levels[level]._offset;
+}
+
+void ImageMipmap::saveImage(const Core::Path& filename)
+{
+    MouCa::preCondition(!isNull());
+
+    // Only RGBA level can be written by FreeImage
+    if (_compression != Options::Compression::None)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "ImageNoneImplemented"));
+    }
+
+    const auto& extents = _levels[0]._extents;
+    RT::BufferLinkedCPU buffer;
+    buffer.create(RT::BufferDescriptor(RT::ComponentDescriptor(4, RT::Type::UnsignedChar, RT::ComponentUsage::Color)),
+                  static_cast<size_t>(extents.x) * extents.y, getRAWData(0, 0));
+
+    ImageFI image;
+    image.createFill(buffer, extents.x, extents.y);
+    image.saveImage(filename);
+    image.release();
+}
+
+void ImageMipmap::export2D(const Core::Path& filename)
+{
+    saveImage(filename);
+}
+
+bool ImageMipmap::compare(const RT::Image& reference, const size_t nbMaxDefectPixels, const double maxDistance4D,
+                          size_t* nbDefectPixels, double* distance4D) const
+{
+    MouCa::preCondition(!isNull());
+
+    if (_compression != Options::Compression::None)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "ImageNoneImplemented"));
+    }
+
+    RT::ImageComparison::Settings settings;
+    settings._maxDistance4D     = maxDistance4D;
+    settings._nbMaxDefectPixels = nbMaxDefectPixels;
+
+    RT::ImageComparison comparison;
+    const bool result = comparison.compute(*this, reference, settings);
+    if (nbDefectPixels != nullptr)
+    {
+        *nbDefectPixels = comparison.getNbDefects();
+    }
+    if (distance4D != nullptr)
+    {
+        *distance4D = comparison.getMaxDistance();
+    }
+    return result;
+}
+
+}
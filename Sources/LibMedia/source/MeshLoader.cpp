@@ -3,6 +3,9 @@
 /// \license No license
 #include "Dependencies.h"
 
+#include "LibCore/include/CoreMemory.h"
+#include "LibCore/include/CoreProfiler.h"
+
 #include "LibRT/include/RTAnimationBones.h"
 #include "LibRT/include/RTMesh.h"
 
@@ -14,6 +17,8 @@ namespace Media
 
 void MeshLoader::createMesh(RT::MeshImport& mesh) const
 {
+    MOUCA_PROFILE_ZONE("MeshLoader::createMesh");
+
     MouCa::preCondition(Core::File::isExist( mesh.getFilename()));
     MouCa::preCondition(mesh.getDescriptor().getNbDescriptors() > 0);
     
@@ -100,64 +105,67 @@ void MeshLoader::computeVBOIBO(const struct aiScene* pScene, float* pCurrentVert
 
     RT::AnimationBones bones;
 
-    const auto zero2Copy = [](const struct aiMesh* , const uint32_t , float*& pCurrentVertex)
+    // Copiers without capture: stored as function pointers
+    using Copier = void (*)(const struct aiMesh*, const RT::AnimationBones&, const uint32_t, float*&);
+
+    const Copier zero2Copy = [](const struct aiMesh* , const RT::AnimationBones& , const uint32_t , float*& pCurrentVertex)
     {
         const float zero[] = {0.0f, 0.0f};
         memcpy(pCurrentVertex, zero, sizeof(float) * 2);
         pCurrentVertex = &pCurrentVertex[2];
     };
-    const auto zero3Copy = [](const struct aiMesh* , const uint32_t , float*& pCurrentVertex)
+    const Copier zero3Copy = [](const struct aiMesh* , const RT::AnimationBones& , const uint32_t , float*& pCurrentVertex)
     {
         const float zero[] = {0.0f, 0.0f, 0.0f};
         memcpy(pCurrentVertex, zero, sizeof(float) * 3);
         pCurrentVertex = &pCurrentVertex[3];
     };
-    const auto positionCopy = [](const struct aiMesh* pMesh, const uint32_t vertexIndex, float*& pCurrentVertex)
+    const Copier positionCopy = [](const struct aiMesh* pMesh, const RT::AnimationBones& , const uint32_t vertexIndex, float*& pCurrentVertex)
     {
         memcpy(pCurrentVertex, &pMesh->mVertices[vertexIndex].x, sizeof(float) * 3);
         pCurrentVertex = &pCurrentVertex[3];
     };
-    const auto positionYInvCopy = [](const struct aiMesh* pMesh, const uint32_t vertexIndex, float*& pCurrentVertex)
+    const Copier positionYInvCopy = [](const struct aiMesh* pMesh, const RT::AnimationBones& , const uint32_t vertexIndex, float*& pCurrentVertex)
     {
         memcpy(pCurrentVertex, &pMesh->mVertices[vertexIndex].x, sizeof(float) * 3);
         pCurrentVertex[1] = -pCurrentVertex[1];
         pCurrentVertex = &pCurrentVertex[3];
     };
-    const auto normalCopy = [](const struct aiMesh* pMesh, const uint32_t vertexIndex, float*& pCurrentVertex)
+    const Copier normalCopy = [](const struct aiMesh* pMesh, const RT::AnimationBones& , const uint32_t vertexIndex, float*& pCurrentVertex)
     {
         memcpy(pCurrentVertex, &pMesh->mNormals[vertexIndex].x, sizeof(float) * 3);
         pCurrentVertex = &pCurrentVertex[3];
     };
-    const auto normalYInvCopy = [](const struct aiMesh* pMesh, const uint32_t vertexIndex, float*& pCurrentVertex)
+    const Copier normalYInvCopy = [](const struct aiMesh* pMesh, const RT::AnimationBones& , const uint32_t vertexIndex, float*& pCurrentVertex)
     {
         memcpy(pCurrentVertex, &pMesh->mNormals[vertexIndex].x, sizeof(float) * 3);
         pCurrentVertex[1] = -pCurrentVertex[1];
         pCurrentVertex = &pCurrentVertex[3];
     };
-    const auto tangentCopy = [](const struct aiMesh* pMesh, const uint32_t vertexIndex, float*& pCurrentVertex)
+    const Copier tangentCopy = [](const struct aiMesh* pMesh, const RT::AnimationBones& , const uint32_t vertexIndex, float*& pCurrentVertex)
     {
         memcpy(pCurrentVertex, &pMesh->mTangents[vertexIndex].x, sizeof(float) * 3);
         pCurrentVertex = &pCurrentVertex[3];
     };
-    const auto texcoord0Copy = [](const struct aiMesh* pMesh, const uint32_t vertexIndex, float*& pCurrentVertex)
+    const Copier texcoord0Copy = [](const struct aiMesh* pMesh, const RT::AnimationBones& , const uint32_t vertexIndex, float*& pCurrentVertex)
     {
         memcpy(pCurrentVertex, &pMesh->mTextureCoords[0][vertexIndex].x, sizeof(float) * 2);
         pCurrentVertex = &pCurrentVertex[2];
     };
-    const auto colorCopy = [](const struct aiMesh* pMesh, const uint32_t vertexIndex, float*& pCurrentVertex)
+    const Copier colorCopy = [](const struct aiMesh* pMesh, const RT::AnimationBones& , const uint32_t vertexIndex, float*& pCurrentVertex)
     {
         memcpy(pCurrentVertex, &pMesh->mColors[0][vertexIndex].r, sizeof(float) * 3);
         pCurrentVertex = &pCurrentVertex[3];
     };
-    const auto boneWeightsCopy = [&](const struct aiMesh* pMesh, const uint32_t vertexIndex, float*& pCurrentVertex)
+    const Copier boneWeightsCopy = [](const struct aiMesh* , const RT::AnimationBones& animationBones, const uint32_t vertexIndex, float*& pCurrentVertex)
     {
-        auto& arrayWeights = bones._bones[vertexIndex]._weights;
+        auto& arrayWeights = animationBones._bones[vertexIndex]._weights;
         memcpy(pCurrentVertex, arrayWeights.data(), sizeof(float) * arrayWeights.size());
         pCurrentVertex = &pCurrentVertex[arrayWeights.size()];
     };
-    const auto boneIDsCopy = [&](const struct aiMesh* pMesh, const uint32_t vertexIndex, float*& pCurrentVertex)
+    const Copier boneIDsCopy = [](const struct aiMesh* , const RT::AnimationBones& animationBones, const uint32_t vertexIndex, float*& pCurrentVertex)
     {
-        auto& arrayIDs = bones._bones[vertexIndex]._IDs;
+        auto& arrayIDs = animationBones._bones[vertexIndex]._IDs;
         memcpy(pCurrentVertex, arrayIDs.data(), sizeof(int) * arrayIDs.size());
         pCurrentVertex = &pCurrentVertex[arrayIDs.size()];
     };
@@ -176,7 +184,10 @@ void MeshLoader::computeVBOIBO(const struct aiScene* pScene, float* pCurrentVert
             AnimationLoader::loadBones(pMesh, bones);
         }
 
-        std::vector< std::function<void(const struct aiMesh*, const uint32_t vertexIndex, float*& pCurrentVertex)> > copier;
+        // Temporary copiers: function pointers on arena, no heap
+        Core::ArenaScope scope;
+        std::pmr::vector<Copier> copier(&scope.getArena());
+        copier.reserve(description.getNbDescriptors());
 
         // Complete one time extractor
         for(size_t descriptionID=0; descriptionID < description.getNbDescriptors(); ++descriptionID)
@@ -248,7 +259,7 @@ void MeshLoader::computeVBOIBO(const struct aiScene* pScene, float* pCurrentVert
         {
             for(const auto& copy : copier)
             {
-                copy(pMesh, vertexIndex, pCurrentVertex);
+                copy(pMesh, bones, vertexIndex, pCurrentVertex);
             }
         }
 
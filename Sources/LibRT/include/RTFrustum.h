@@ -58,7 +58,7 @@ namespace RT
                 }
             }
 
-            bool checkSphere(const glm::vec3& pos, float radius)
+            bool checkSphere(const glm::vec3& pos, float radius) const
             {
                 for(auto i = 0; i < planes.size(); i++)
                 {
@@ -9,6 +9,7 @@ namespace RT
 {
     class BufferCPUBase;
     using BufferCPUBaseWPtr = std::weak_ptr<BufferCPUBase>;
+    class ComponentDescriptor;
 
     //----------------------------------------------------------------------------
     /// \brief Abstract image system to read/write data.
@@ -90,6 +91,35 @@ namespace RT
             /// \returns Specific extents for one mipmap level.
             virtual RT::Array3ui getExtents(const uint32_t level) const = 0;
 
+            //------------------------------------------------------------------------
+            /// \brief Get distance in bytes from row y to row y+1 of level (rows are bottom-up like FreeImage/OpenGL).
+            /// Negative stride expresses top-down memory (Vulkan, screenshot): row 0 is the last row of memory.
+            /// \param[in] level: mipmap level.
+            /// \returns Row stride in bytes (0: packed rows in memory order).
+            virtual int64_t getRowStride(const uint32_t level) const
+            {
+                MOUCA_UNUSED(level);
+                return 0;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief Get GPU format of memory as VkFormat value (RT doesn't depend on Vulkan).
+            /// Block compressed images (BCn) can't be uploaded without it.
+            /// \returns VkFormat value (0: undefined, format is given by user).
+            virtual uint32_t getFormat() const
+            {
+                return 0;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief Get mask of levels where all layers are available (bit N: level N).
+            /// Progressive images (see Media::ImageKTX) decode coarse levels first: renderer can upload them before the others.
+            /// \returns Mask of ready levels (all levels by default).
+            virtual uint64_t getReadyLevels() const
+            {
+                return getLevels() >= 64 ? ~0ull : (1ull << getLevels()) - 1;
+            }
+
             //------------------------------------------------------------------------
             /// \brief Get pointer to first data of texture based on layer/level.
             /// \param[in] layer: id of layer.
@@ -130,7 +160,14 @@ namespace RT
 
     //----------------------------------------------------------------------------
     /// \brief Image based on linkedCPU buffer. This class not manage memory of data BUT DEV must guaranty still valid !!!
-    ///
+    /// Zero-copy: pitch of buffer is kept, orientation is a negative stride and save/compare read directly linked memory.
+    /// \code{.cpp}
+    ///     auto buffer = std::make_shared<RT::BufferLinkedCPU>();
+    ///     buffer->create(descriptor, width * height, mappedMemory, rowPitch);
+    ///     RT::ImageLinkedCPU image;
+    ///     image.initialize(RT::Image::Target::Type2D, buffer, { width, height, 1 }, true);
+    ///     image.saveImage("screenshot.png");  // Each pixel is read once
+    /// \endcode
     class ImageLinkedCPU : public Image
     {
         public:
@@ -139,7 +176,14 @@ namespace RT
             /// Destructor
             ~ImageLinkedCPU() override = default;
 
-            void initialize(const Target target, const RT::BufferCPUBaseWPtr& imageBuffer, const RT::Array3ui& extents);
+            //------------------------------------------------------------------------
+            /// \brief Link buffer memory (pitch of buffer is used when defined).
+            /// \param[in] target: kind of texture.
+            /// \param[in] imageBuffer: memory to link (one descriptor per pixel).
+            /// \param[in] extents: size of image.
+            /// \param[in] topDown: first row of memory is top of image (Vulkan convention), otherwise bottom (FreeImage).
+            /// \param[in] format: VkFormat value of memory (0: undefined, channels are in RGBA order).
+            void initialize(const Target target, const RT::BufferCPUBaseWPtr& imageBuffer, const RT::Array3ui& extents, const bool topDown = false, const uint32_t format = 0);
 
             void release() override;
 
@@ -151,11 +195,13 @@ namespace RT
             void createFill(const RT::BufferCPUBase& imageBuffer, const uint32_t width, const uint32_t height) override;
 
             //------------------------------------------------------------------------
-            /// \brief Not implemented
-            /// \throw  Throw error.
-            void saveImage(const Core::Path& ) override;
+            /// \brief Save directly from linked memory with streaming encoder (PNG: 8/16 bits, EXR: float).
+            /// \param[in] filename: where save image on disk (extension defines format).
+            /// \throw  If format is not supported.
+            /// \see ImageEncoder
+            void saveImage(const Core::Path& filename) override;
 
-            void export2D(const Core::Path& ) override;
+            void export2D(const Core::Path& filename) override;
 
             //------------------------------------------------------------------------
             /// \brief Get target of texture.
@@ -168,9 +214,6 @@ namespace RT
             /// \returns True if not loaded and no link, otherwise false.
             bool isNull() const override;
 
-            //------------------------------------------------------------------------
-            /// \brief Not implemented
-            /// \throw  Throw error.
             bool compare(const Image& reference, const size_t nbMaxDefectPixels, const double maxDistance4D,
                          size_t* nbDefectPixels = nullptr, double* distance4D = nullptr) const override;
 
@@ -191,10 +234,22 @@ namespace RT
 
             size_t getMemorySize() const override;
 
+            int64_t getRowStride(const uint32_t level) const override;
+
+            uint32_t getFormat() const override { return _format; }
+
+            //------------------------------------------------------------------------
+            /// \brief Get pixel format of linked memory.
+            /// \returns Component descriptor of buffer.
+            const ComponentDescriptor& getComponent() const;
+
         private:
-            BufferCPUBaseWPtr _linkedBuffer;    ///< [LINK] Link to buffer CPU
-            RT::Array3ui      _extents;         ///< 3D sizes.
-            Target            _target;          ///< Target of texture.
+            BufferCPUBaseWPtr _linkedBuffer;        ///< [LINK] Link to buffer CPU
+            RT::Array3ui      _extents;             ///< 3D sizes.
+            Target            _target;              ///< Target of texture.
+            uint64_t          _pitch   = 0;         ///< Size of row in memory (with padding).
+            bool              _topDown = false;     ///< Memory starts by top row.
+            uint32_t          _format  = 0;         ///< VkFormat value of memory (swapchain copy can be BGRA).
     };
 
     //----------------------------------------------------------------------------
@@ -206,6 +261,38 @@ namespace RT
         MOUCA_NOCOPY_NOMOVE(ImageImport);
 
         public:
+            //------------------------------------------------------------------------
+            /// \brief Options applied by loader on non GPU formats (PNG, JPG, ...).
+            struct Options
+            {
+                enum class Filter : uint8_t
+                {
+                    None,       ///< Keep single level.
+                    Box,        ///< Full mipmap chain with 2x2 box filter.
+                    Kaiser      ///< Full mipmap chain with separable Kaiser-windowed sinc filter.
+                };
+
+                enum class Compression : uint8_t
+                {
+                    None,       ///< RGBA 8 bits.
+                    BC1,        ///< RGB + 1 bit alpha: 8 bytes per block.
+                    BC3,        ///< RGBA: 16 bytes per block.
+                    BC5,        ///< RG (normal maps): 16 bytes per block.
+                    BC7         ///< RGBA high quality: 16 bytes per block.
+                };
+
+                Filter      _mipmaps     = Filter::None;        ///< How to build mipmap chain.
+                Compression _compression = Compression::None;   ///< Block compression of each level.
+                bool        _sRGB        = true;                ///< Color is sRGB: filter into linear space.
+
+                bool isDefault() const
+                {
+                    return _mipmaps == Filter::None && _compression == Compression::None;
+                }
+
+                bool operator==(const Options&) const = default;
+            };
+
             ImageImport() = default;
             ~ImageImport() override = default;
 
@@ -244,8 +331,32 @@ namespace RT
             void setImage(ImageSPtr image)  { _image = image; }
             ImageWPtr getImage() const      { return _image; }
 
+            void setOptions(const Options& options)
+            {
+                MouCa::preCondition(_image == nullptr || _image->isNull()); // DEV Issue: Options are used only during loading.
+                _options = options;
+            }
+            const Options& getOptions() const { return _options; }
+
+            //------------------------------------------------------------------------
+            /// \brief  Define baked KTX2 file: loader reads it when exists, otherwise it writes it after decoding.
+            ///
+            /// \param[in] filename: path of KTX2 cache file (empty to disable).
+            /// \param[in] zstdLevel: Zstd supercompression level used when writing (0: no supercompression).
+            void setCache(const Core::Path& filename, const uint32_t zstdLevel)
+            {
+                MouCa::preCondition(_image == nullptr || _image->isNull()); // DEV Issue: Cache is used only during loading.
+                _cacheFilename  = filename;
+                _cacheZstdLevel = zstdLevel;
+            }
+            const Core::Path& getCacheFilename() const  { return _cacheFilename; }
+            uint32_t getCacheZstdLevel() const          { return _cacheZstdLevel; }
+
         protected:
-            ImageSPtr _image;
+            ImageSPtr  _image;
+            Options    _options;                ///< Loading options.
+            Core::Path _cacheFilename;          ///< Baked KTX2 file (empty: no cache).
+            uint32_t   _cacheZstdLevel = 0;     ///< Zstd level when baking.
     };
 
     using ImageImportSPtr = std::shared_ptr<ImageImport>;
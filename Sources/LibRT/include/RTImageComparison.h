@@ -0,0 +1,148 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+namespace Core
+{
+    class ThreadPools;
+}
+
+namespace RT
+{
+    class Image;
+
+    //----------------------------------------------------------------------------
+    /// \brief Statistics of one tile computed by ImageComparison.
+    struct ImageTileStatistics
+    {
+        RT::Array2ui _offset  = { 0, 0 };   ///< First pixel of tile.
+        RT::Array2ui _extents = { 0, 0 };   ///< Size of tile in pixels.
+        double       _maxDistance  = 0.0;   ///< Max distance 4D (RGBA) of defect pixels (0 when no defect).
+        double       _meanDistance = 0.0;   ///< Mean distance 4D (RGBA) of all pixels of tile.
+        size_t       _nbDefects    = 0;     ///< Number of pixels over distance threshold.
+        double       _ssim         = 1.0;   ///< Structural similarity of luminance (1.0 when not computed).
+        bool         _failed       = false; ///< Tile doesn't respect settings.
+    };
+
+    //----------------------------------------------------------------------------
+    /// \brief Compare two RGBA 8 bits images tile by tile.
+    /// Each tile is processed independently on workers of ThreadPools: memory usage is only tile statistics
+    /// (no copy of picture) so it can be used on any image size.
+    /// \code{.cpp}
+    ///     RT::ImageComparison comparison;
+    ///     comparison.compute(screenshot, reference, RT::ImageComparison::Settings());
+    ///     if(!comparison.isSuccess())
+    ///         Media::ImageLoader::exportHeatMap(comparison, "report.png");
+    /// \endcode
+    class ImageComparison final
+    {
+        MOUCA_NOCOPY_NOMOVE(ImageComparison);
+
+        public:
+            struct Settings
+            {
+                uint32_t _tileSize           = 64;      ///< Size of square tile in pixels.
+                double   _maxDistance4D      = 30.0;    ///< Tolerance of distance 4D to consider pixel as defect.
+                size_t   _nbMaxDefectPixels  = 500;     ///< Tolerance of defect pixels on whole image.
+                size_t   _nbMaxDefectPerTile = 0;       ///< Tolerance of defect pixels per tile to mark tile as failed.
+                bool     _computeSSIM        = false;   ///< Compute SSIM of each tile.
+                double   _minSSIM            = 0.95;    ///< Minimal SSIM to keep tile valid (when computed).
+                Core::ThreadPools* _threadPools = nullptr; ///< Workers of tiles (nullptr: current thread only).
+            };
+
+            /// Constructor
+            ImageComparison() = default;
+            /// Destructor
+            ~ImageComparison() = default;
+
+            //------------------------------------------------------------------------
+            /// \brief  Compute all tile statistics between two images (layer 0 / level 0).
+            ///
+            /// \param[in] source: image to check.
+            /// \param[in] reference: expected image.
+            /// \param[in] settings: tolerances and tiling.
+            /// \returns True if comparison succeeds, false otherwise.
+            /// \note When extents are different, comparison fails without any tile.
+            bool compute(const Image& source, const Image& reference, const Settings& settings);
+
+            //------------------------------------------------------------------------
+            /// \brief  Remove all results.
+            void release();
+
+            bool isSuccess() const                                  { return _success; }
+            bool isSameExtents() const                              { return _sameExtents; }
+
+            size_t getNbDefects() const                             { return _nbDefects; }
+            double getMaxDistance() const                           { return _maxDistance; }
+            double getMeanDistance() const                          { return _meanDistance; }
+            size_t getNbFailedTiles() const                         { return _nbFailedTiles; }
+
+            const Settings& getSettings() const                     { return _settings; }
+            const RT::Array3ui& getExtents() const                  { return _extents; }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get number of tiles in X/Y.
+            ///
+            /// \returns Grid size of tiles.
+            const RT::Array2ui& getGrid() const                     { return _grid; }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get all tiles statistics in row order (grid.x * grid.y items).
+            ///
+            /// \returns List of tile statistics.
+            const std::vector<ImageTileStatistics>& getTiles() const { return _tiles; }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get specific tile statistics.
+            ///
+            /// \param[in] x: tile column.
+            /// \param[in] y: tile row.
+            /// \returns Tile statistics.
+            const ImageTileStatistics& getTile(const uint32_t x, const uint32_t y) const
+            {
+                MouCa::preCondition(x < _grid.x && y < _grid.y);
+                return _tiles[static_cast<size_t>(y) * _grid.x + x];
+            }
+
+        private:
+            /// Access to rows of level 0 (bottom-up order, see Image::getRowStride()).
+            struct Rows
+            {
+                const uint8_t* _first  = nullptr;   ///< Row 0.
+                int64_t        _stride = 0;         ///< Bytes from one row to next one.
+
+                const Core::ColorUC32* get(const uint32_t y) const
+                {
+                    return reinterpret_cast<const Core::ColorUC32*>(_first + _stride * static_cast<int64_t>(y));
+                }
+            };
+
+            //------------------------------------------------------------------------
+            /// \brief  Build row access of image (RGBA 8 bits).
+            ///
+            /// \param[in] image: loaded image.
+            /// \returns Rows description.
+            static Rows getRows(const Image& image);
+
+            //------------------------------------------------------------------------
+            /// \brief  Compute statistics of one tile.
+            ///
+            /// \param[in] source: rows of source image.
+            /// \param[in] reference: rows of reference image.
+            /// \param[in,out] tile: tile to fill (offset/extents must be defined).
+            void computeTile(const Rows& source, const Rows& reference, ImageTileStatistics& tile) const;
+
+            Settings                         _settings;                 ///< Settings of latest computation.
+            RT::Array3ui                     _extents = { 0, 0, 0 };    ///< Size of compared images.
+            RT::Array2ui                     _grid    = { 0, 0 };       ///< Number of tiles in X/Y.
+            std::vector<ImageTileStatistics> _tiles;                    ///< All tiles (row order).
+
+            size_t _nbDefects     = 0;      ///< Total of defect pixels.
+            size_t _nbFailedTiles = 0;      ///< Total of failed tiles.
+            double _maxDistance   = 0.0;    ///< Max distance of defect pixels on image.
+            double _meanDistance  = 0.0;    ///< Mean distance of image.
+            bool   _sameExtents   = false;  ///< Images have same size.
+            bool   _success       = false;  ///< Final result.
+    };
+}
@@ -0,0 +1,48 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+namespace RT
+{
+    class ComponentDescriptor;
+    class Image;
+
+    //----------------------------------------------------------------------------
+    /// \brief Streaming encoders writing rows directly from image memory (no intermediate picture).
+    /// Rows are read with Image::getRowStride(): orientation is handled by reading order, never by a flip pass.
+    /// \note PNG uses stored deflate blocks: no compression but each pixel is touched once (fast screenshots).
+    ///       Use Media::ImageFI to produce small files.
+    class ImageEncoder final
+    {
+        public:
+            //------------------------------------------------------------------------
+            /// \brief  Write level 0 as PNG (gray, gray+alpha, RGB or RGBA of 8 or 16 bits).
+            /// BGR/BGRA memory (see Image::getFormat()) is written in RGB order.
+            ///
+            /// \param[in] image: 2D image.
+            /// \param[in] component: pixel format of image memory.
+            /// \param[in] filename: PNG file to write.
+            /// \throw  If format is not supported or on writing error.
+            static void savePNG(const Image& image, const ComponentDescriptor& component, const Core::Path& filename);
+
+            //------------------------------------------------------------------------
+            /// \brief  Write level 0 as uncompressed OpenEXR (Y, RGB or RGBA of 32 bits float).
+            ///
+            /// \param[in] image: 2D image.
+            /// \param[in] component: pixel format of image memory.
+            /// \param[in] filename: EXR file to write.
+            /// \throw  If format is not supported or on writing error.
+            static void saveEXR(const Image& image, const ComponentDescriptor& component, const Core::Path& filename);
+
+        private:
+            //------------------------------------------------------------------------
+            /// \brief  Get first byte of row in file order (top to bottom).
+            ///
+            /// \param[in] image: 2D image.
+            /// \param[in] pixelSize: size in bytes of one pixel.
+            /// \param[in] row: row of file (0 is top).
+            /// \returns Pointer to first pixel of row.
+            static const uint8_t* getFileRow(const Image& image, const size_t pixelSize, const uint32_t row);
+    };
+}
@@ -8,6 +8,7 @@
 
 namespace RT
 {
+    class Frustum;
     class Mesh;
     class MeshImport;
     using MeshImportWPtr = std::weak_ptr<MeshImport>;
@@ -92,6 +93,24 @@ namespace RT
             return _instances;
         }
 
+        //------------------------------------------------------------------------
+        /// \brief  Reference culling (CPU): keep instances whose bounding sphere is inside frustum.
+        /// Visible instances keep their order and stay grouped by indirect (like GPU culling output).
+        /// 
+        /// \param[in] frustum: frustum in same space than instances.
+        /// \param[in] boxes: local bounding box of mesh of each indirect.
+        /// \param[out] indirects: indirects with number of visible instances.
+        /// \param[out] instances: visible instances.
+        void cull(const Frustum& frustum, const std::vector<BoundingBox>& boxes, std::vector<Indirect>& indirects, std::vector<Instance>& instances) const;
+
+        //------------------------------------------------------------------------
+        /// \brief  Compute world bounding sphere of instance.
+        /// 
+        /// \param[in] instance: instance to place.
+        /// \param[in] box: local bounding box of mesh.
+        /// \returns Center (xyz) and radius (w).
+        static Point4 computeSphere(const Instance& instance, const BoundingBox& box);
+
     protected:
         /// Constructor
         BasicMassiveInstance( const Type type ):
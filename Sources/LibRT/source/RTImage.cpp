@@ -6,11 +6,14 @@
 #include <LibRT/include/RTImage.h>
 
 #include <LibRT/include/RTBufferCPU.h>
+#include <LibRT/include/RTBufferDescriptor.h>
+#include <LibRT/include/RTImageComparison.h>
+#include <LibRT/include/RTImageEncoder.h>
 
 namespace RT
 {
 
-void ImageLinkedCPU::initialize(const Target target, const RT::BufferCPUBaseWPtr& imageBuffer, const RT::Array3ui& extents)
+void ImageLinkedCPU::initialize(const Target target, const RT::BufferCPUBaseWPtr& imageBuffer, const RT::Array3ui& extents, const bool topDown, const uint32_t format)
 {
     MouCa::preCondition(isNull());                 //DEV Issue: Need none initialized image.
     MouCa::preCondition(!imageBuffer.expired());   //DEV Issue: Need valid data.
@@ -19,6 +22,16 @@ void ImageLinkedCPU::initialize(const Target target, const RT::BufferCPUBaseWPtr
     _target       = target;
     _linkedBuffer = imageBuffer;
     _extents      = extents;
+    _topDown      = topDown;
+    _format       = format;
+
+    // Use padding of buffer (GPU mapped memory) otherwise rows are packed
+    const auto buffer = imageBuffer.lock();
+    _pitch = buffer->getPitchRow();
+    if (_pitch == 0)
+    {
+        _pitch = buffer->getDescriptor().getByteSize() * extents.x;
+    }
 
     MouCa::postCondition(!isNull()); //DEV Issue: Ready to work.
 }
@@ -29,6 +42,9 @@ void ImageLinkedCPU::release()
 
     _linkedBuffer.reset();
     _extents = { 0,0,0 };
+    _pitch   = 0;
+    _topDown = false;
+    _format  = 0;
 
     MouCa::postCondition(isNull()); //DEV Issue: Ready to work.
 }
@@ -43,25 +59,71 @@ void ImageLinkedCPU::createFill(const RT::BufferCPUBase& imageBuffer, const uint
 
 void ImageLinkedCPU::saveImage(const Core::Path& filename)
 {
-    MOUCA_UNUSED(filename);
-    throw Core::Exception(Core::ErrorData("BasicError", "ImageNoneImplemented"));
+    MouCa::preCondition(!isNull()); //DEV Issue: Ready to work.
+
+    const auto extension = filename.extension().string();
+    if (extension == ".png")
+    {
+        ImageEncoder::savePNG(*this, getComponent(), filename);
+    }
+    else if (extension == ".exr")
+    {
+        ImageEncoder::saveEXR(*this, getComponent(), filename);
+    }
+    else
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "ImageNoneImplemented"));
+    }
 }
 
 void ImageLinkedCPU::export2D(const Core::Path& filename)
 {
-    MOUCA_UNUSED(filename);
-    throw Core::Exception(Core::ErrorData("BasicError", "ImageNoneImplemented"));
+    saveImage(filename);
 }
 
 bool ImageLinkedCPU::compare(const Image & reference, const size_t nbMaxDefectPixels, const double maxDistance4D,
                              size_t * nbDefectPixels, double* distance4D) const
 {
-    MOUCA_UNUSED(reference);
-    MOUCA_UNUSED(nbMaxDefectPixels);
-    MOUCA_UNUSED(maxDistance4D);
-    MOUCA_UNUSED(nbDefectPixels);
-    MOUCA_UNUSED(distance4D);
-    throw Core::Exception(Core::ErrorData("BasicError", "ImageNoneImplemented"));
+    MouCa::preCondition(!isNull()); //DEV Issue: Ready to work.
+
+    // Comparison works on RGBA 8 bits only
+    const auto& component = getComponent();
+    if (component.getFormatType() != Type::UnsignedChar || component.getNbComponents() != 4)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "ImageNoneImplemented"));
+    }
+
+    ImageComparison::Settings settings;
+    settings._maxDistance4D     = maxDistance4D;
+    settings._nbMaxDefectPixels = nbMaxDefectPixels;
+
+    ImageComparison comparison;
+    const bool result = comparison.compute(*this, reference, settings);
+    if (nbDefectPixels != nullptr)
+    {
+        *nbDefectPixels = comparison.getNbDefects();
+    }
+    if (distance4D != nullptr)
+    {
+        *distance4D = comparison.getMaxDistance();
+    }
+    return result;
+}
+
+int64_t ImageLinkedCPU::getRowStride(const uint32_t level) const
+{
+    MouCa::preCondition(!isNull()); //DEV Issue: Ready to work.
+    MouCa::preCondition(level < getLevels());
+    MOUCA_UNUSED(level);
+
+    return _topDown ? -static_cast<int64_t>(_pitch) : static_cast<int64_t>(_pitch);
+}
+
+const ComponentDescriptor& ImageLinkedCPU::getComponent() const
+{
+    MouCa::preCondition(!isNull()); //DEV Issue: Ready to work.
+
+    return _linkedBuffer.lock()->getDescriptor().getComponentDescriptor(0);
 }
 
 const RT::Image::HandlerMemory ImageLinkedCPU::getRAWData(const uint32_t layer, const uint32_t level) const
@@ -0,0 +1,176 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include <LibCore/include/CoreThreadPools.h>
+
+#include <LibRT/include/RTImage.h>
+#include <LibRT/include/RTImageComparison.h>
+
+namespace RT
+{
+
+bool ImageComparison::compute(const Image& source, const Image& reference, const Settings& settings)
+{
+    MouCa::preCondition(!source.isNull() && !reference.isNull());   // DEV Issue: Need loaded images.
+    MouCa::preCondition(settings._tileSize > 0);                     // DEV Issue: Need valid tile.
+
+    release();
+    _settings = settings;
+
+    const uint32_t level = 0;
+    _extents     = source.getExtents(level);
+    _sameExtents = _extents == reference.getExtents(level);
+    if (!_sameExtents)
+    {
+        return _success;
+    }
+
+    // Build tiles (last row/column can be smaller)
+    const uint32_t width  = _extents.x;
+    const uint32_t height = _extents.y * _extents.z;
+    _grid = { (width  + settings._tileSize - 1) / settings._tileSize,
+              (height + settings._tileSize - 1) / settings._tileSize };
+    _tiles.resize(static_cast<size_t>(_grid.x) * _grid.y);
+    for (uint32_t y = 0; y < _grid.y; ++y)
+    {
+        for (uint32_t x = 0; x < _grid.x; ++x)
+        {
+            auto& tile = _tiles[static_cast<size_t>(y) * _grid.x + x];
+            tile._offset  = { x * settings._tileSize, y * settings._tileSize };
+            tile._extents = { std::min(settings._tileSize, width  - tile._offset.x),
+                              std::min(settings._tileSize, height - tile._offset.y) };
+        }
+    }
+
+    const Rows src = getRows(source);
+    const Rows ref = getRows(reference);
+
+    // Dispatch tiles on workers
+    auto computeTiles = [&](const size_t begin, const size_t end)
+    {
+        for (size_t id = begin; id < end; ++id)
+        {
+            computeTile(src, ref, _tiles[id]);
+        }
+    };
+    if (settings._threadPools != nullptr)
+    {
+        auto& pools = *settings._threadPools;
+        pools.wait(pools.parallelFor(0, _tiles.size(), 1, computeTiles));
+    }
+    else
+    {
+        computeTiles(0, _tiles.size());
+    }
+
+    // Merge
+    double sumDistance = 0.0;
+    for (const auto& tile : _tiles)
+    {
+        _nbDefects    += tile._nbDefects;
+        _maxDistance   = std::max(_maxDistance, tile._maxDistance);
+        sumDistance   += tile._meanDistance * static_cast<double>(tile._extents.x) * static_cast<double>(tile._extents.y);
+        _nbFailedTiles += tile._failed ? 1 : 0;
+    }
+    _meanDistance = sumDistance / (static_cast<double>(width) * static_cast<double>(height));
+    _success      = _nbDefects <= settings._nbMaxDefectPixels;
+
+    return _success;
+}
+
+void ImageComparison::release()
+{
+    _tiles.clear();
+    _extents       = { 0, 0, 0 };
+    _grid          = { 0, 0 };
+    _nbDefects     = 0;
+    _nbFailedTiles = 0;
+    _maxDistance   = 0.0;
+    _meanDistance  = 0.0;
+    _sameExtents   = false;
+    _success       = false;
+}
+
+ImageComparison::Rows ImageComparison::getRows(const Image& image)
+{
+    const uint32_t layer = 0;
+    const uint32_t level = 0;
+    const auto extents = image.getExtents(level);
+
+    Rows rows;
+    rows._first  = image.getData<uint8_t>(layer, level);
+    rows._stride = image.getRowStride(level);
+    if (rows._stride == 0)
+    {
+        rows._stride = static_cast<int64_t>(extents.x) * static_cast<int64_t>(sizeof(Core::ColorUC32));
+    }
+    else if (rows._stride < 0)
+    {
+        // Top-down memory: row 0 is latest row of memory
+        rows._first += -rows._stride * (static_cast<int64_t>(extents.y) * extents.z - 1);
+    }
+    return rows;
+}
+
+void ImageComparison::computeTile(const Rows& source, const Rows& reference, ImageTileStatistics& tile) const
+{
+    // Luminance accumulators for SSIM
+    double sumS = 0.0, sumR = 0.0, sumSS = 0.0, sumRR = 0.0, sumSR = 0.0;
+    double sumDistance = 0.0;
+
+    for (uint32_t y = 0; y < tile._extents.y; ++y)
+    {
+        Core::ColorUC32 const* src = source.get(tile._offset.y + y) + tile._offset.x;
+        Core::ColorUC32 const* ref = reference.get(tile._offset.y + y) + tile._offset.x;
+        for (uint32_t x = 0; x < tile._extents.x; ++x, ++src, ++ref)
+        {
+            const int distance4D = std::abs(src->m_color[0] - ref->m_color[0])
+                                 + std::abs(src->m_color[1] - ref->m_color[1])
+                                 + std::abs(src->m_color[2] - ref->m_color[2])
+                                 + std::abs(src->m_color[3] - ref->m_color[3]);
+            sumDistance += distance4D;
+            if (distance4D > _settings._maxDistance4D)
+            {
+                ++tile._nbDefects;
+                tile._maxDistance = std::max(tile._maxDistance, static_cast<double>(distance4D));
+            }
+
+            if (_settings._computeSSIM)
+            {
+                const double lumS = 0.299 * src->m_color[0] + 0.587 * src->m_color[1] + 0.114 * src->m_color[2];
+                const double lumR = 0.299 * ref->m_color[0] + 0.587 * ref->m_color[1] + 0.114 * ref->m_color[2];
+                sumS  += lumS;
+                sumR  += lumR;
+                sumSS += lumS * lumS;
+                sumRR += lumR * lumR;
+                sumSR += lumS * lumR;
+            }
+        }
+    }
+
+    const double nbPixels = static_cast<double>(tile._extents.x) * static_cast<double>(tile._extents.y);
+    tile._meanDistance = sumDistance / nbPixels;
+
+    if (_settings._computeSSIM)
+    {
+        // Standard constants for 8 bits dynamic range
+        const double c1 = (0.01 * 255.0) * (0.01 * 255.0);
+        const double c2 = (0.03 * 255.0) * (0.03 * 255.0);
+
+        const double meanS = sumS / nbPixels;
+        const double meanR = sumR / nbPixels;
+        const double varS  = std::max(0.0, sumSS / nbPixels - meanS * meanS);
+        const double varR  = std::max(0.0, sumRR / nbPixels - meanR * meanR);
+        const double covar = sumSR / nbPixels - meanS * meanR;
+
+        tile._ssim = ((2.0 * meanS * meanR + c1) * (2.0 * covar + c2))
+                   / ((meanS * meanS + meanR * meanR + c1) * (varS + varR + c2));
+    }
+
+    tile._failed = tile._nbDefects > _settings._nbMaxDefectPerTile
+                || (_settings._computeSSIM && tile._ssim < _settings._minSSIM);
+}
+
+}
@@ -0,0 +1,347 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include <LibRT/include/RTBufferDescriptor.h>
+#include <LibRT/include/RTImage.h>
+#include <LibRT/include/RTImageEncoder.h>
+
+namespace RT
+{
+
+namespace
+{
+    // CRC of PNG chunks (ISO 3309)
+    const std::array<uint32_t, 256>& getCRCTable()
+    {
+        static const std::array<uint32_t, 256> table = []()
+        {
+            std::array<uint32_t, 256> crcs;
+            for (uint32_t id = 0; id < crcs.size(); ++id)
+            {
+                uint32_t crc = id;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+                }
+                crcs[id] = crc;
+            }
+            return crcs;
+        }();
+        return table;
+    }
+
+    //----------------------------------------------------------------------------
+    /// \brief Write zlib stream of stored blocks split into IDAT chunks.
+    class PNGStream
+    {
+        public:
+            explicit PNGStream(std::ofstream& file):
+            _file(file)
+            {
+                _block.reserve(_maxBlock);
+            }
+
+            void writeChunk(const char* type, const uint8_t* data, const size_t size)
+            {
+                writeBigEndian(static_cast<uint32_t>(size));
+
+                const auto& table = getCRCTable();
+                uint32_t crc = 0xFFFFFFFFu;
+                auto update = [&](const uint8_t* bytes, const size_t count)
+                {
+                    for (size_t id = 0; id < count; ++id)
+                    {
+                        crc = table[(crc ^ bytes[id]) & 0xFF] ^ (crc >> 8);
+                    }
+                };
+                update(reinterpret_cast<const uint8_t*>(type), 4);
+                update(data, size);
+
+                _file.write(type, 4);
+                _file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+                writeBigEndian(crc ^ 0xFFFFFFFFu);
+            }
+
+            void beginData()
+            {
+                // zlib header: deflate, 32K window, no dictionary
+                const std::array<uint8_t, 2> header = { 0x78, 0x01 };
+                writeChunk("IDAT", header.data(), header.size());
+            }
+
+            void push(const uint8_t* data, size_t size)
+            {
+                // Adler-32 of uncompressed data
+                for (size_t id = 0; id < size; ++id)
+                {
+                    _adlerA = (_adlerA + data[id]) % 65521u;
+                    _adlerB = (_adlerB + _adlerA)  % 65521u;
+                }
+
+                while (size > 0)
+                {
+                    const size_t copy = std::min(size, _maxBlock - _block.size());
+                    _block.insert(_block.end(), data, data + copy);
+                    data += copy;
+                    size -= copy;
+                    if (_block.size() == _maxBlock)
+                    {
+                        flushBlock(false);
+                    }
+                }
+            }
+
+            void endData()
+            {
+                flushBlock(true);
+
+                const std::array<uint8_t, 4> adler =
+                {
+                    static_cast<uint8_t>(_adlerB >> 8), static_cast<uint8_t>(_adlerB),
+                    static_cast<uint8_t>(_adlerA >> 8), static_cast<uint8_t>(_adlerA)
+                };
+                writeChunk("IDAT", adler.data(), adler.size());
+            }
+
+        private:
+            static const size_t _maxBlock = 65535;   ///< Max size of stored block.
+
+            void flushBlock(const bool last)
+            {
+                // Stored block: header + LEN + NLEN then raw data
+                const uint16_t length = static_cast<uint16_t>(_block.size());
+                const std::array<uint8_t, 5> header =
+                {
+                    static_cast<uint8_t>(last ? 1 : 0),
+                    static_cast<uint8_t>(length), static_cast<uint8_t>(length >> 8),
+                    static_cast<uint8_t>(~length), static_cast<uint8_t>(~length >> 8)
+                };
+                _block.insert(_block.begin(), header.cbegin(), header.cend());
+                writeChunk("IDAT", _block.data(), _block.size());
+                _block.clear();
+            }
+
+            void writeBigEndian(const uint32_t value)
+            {
+                const std::array<char, 4> bytes =
+                {
+                    static_cast<char>(value >> 24), static_cast<char>(value >> 16),
+                    static_cast<char>(value >> 8),  static_cast<char>(value)
+                };
+                _file.write(bytes.data(), bytes.size());
+            }
+
+            std::ofstream&       _file;
+            std::vector<uint8_t> _block;
+            uint32_t             _adlerA = 1;
+            uint32_t             _adlerB = 0;
+    };
+
+    // Red and blue are swapped into memory (VkFormat values: LibRT doesn't depend on Vulkan)
+    bool isBGR(const uint32_t format)
+    {
+        enum VkFormat : uint32_t
+        {
+            B8G8R8_UNORM    = 30,
+            B8G8R8_SRGB     = 36,
+            B8G8R8A8_UNORM  = 44,
+            B8G8R8A8_SRGB   = 50
+        };
+        return (B8G8R8_UNORM <= format && format <= B8G8R8_SRGB) || (B8G8R8A8_UNORM <= format && format <= B8G8R8A8_SRGB);
+    }
+
+    void checkFile(const std::ofstream& file, const Core::Path& filename)
+    {
+        if (!file.good())
+        {
+            throw Core::Exception(Core::ErrorData("BasicError", "ImageSaveError") << filename.string());
+        }
+    }
+}
+
+const uint8_t* ImageEncoder::getFileRow(const Image& image, const size_t pixelSize, const uint32_t row)
+{
+    const uint32_t level   = 0;
+    const auto     extents = image.getExtents(level);
+    const auto*    data    = image.getData<uint8_t>(0, level);
+
+    // Image rows are bottom-up: file row 0 is latest image row
+    const int64_t y      = static_cast<int64_t>(extents.y) - 1 - row;
+    const int64_t stride = image.getRowStride(level);
+    if (stride == 0)
+    {
+        return data + y * static_cast<int64_t>(extents.x * pixelSize);
+    }
+    return stride > 0 ? data + y * stride
+                      : data + (static_cast<int64_t>(extents.y) - 1 - y) * -stride;
+}
+
+void ImageEncoder::savePNG(const Image& image, const ComponentDescriptor& component, const Core::Path& filename)
+{
+    MouCa::preCondition(!image.isNull());
+    MouCa::preCondition(!filename.empty());
+
+    const uint64_t nbComponents = component.getNbComponents();
+    const bool     is16Bits     = component.getFormatType() == Type::UnsignedShort;
+    if ((component.getFormatType() != Type::UnsignedChar && !is16Bits) || nbComponents < 1 || nbComponents > 4)
+    {
+        throw Core::Exception(Core::ErrorData("BasicError", "ImageNoneImplemented"));
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    checkFile(file, filename);
+
+    const std::array<uint8_t, 8> signature = { 0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A };
+    file.write(reinterpret_cast<const char*>(signature.data()), signature.size());
+
+    // Header
+    const auto extents = image.getExtents(0);
+    const std::array<uint8_t, 5> colorTypes = { 0, 0, 4, 2, 6 }; // Gray, Gray+Alpha, RGB, RGBA
+    const std::array<uint8_t, 13> header =
+    {
+        static_cast<uint8_t>(extents.x >> 24), static_cast<uint8_t>(extents.x >> 16), static_cast<uint8_t>(extents.x >> 8), static_cast<uint8_t>(extents.x),
+        static_cast<uint8_t>(extents.y >> 24), static_cast<uint8_t>(extents.y >> 16), static_cast<uint8_t>(extents.y >> 8), static_cast<uint8_t>(extents.y),
+        static_cast<uint8_t>(is16Bits ? 16 : 8), colorTypes[nbComponents], 0, 0, 0
+    };
+
+    PNGStream stream(file);
+    stream.writeChunk("IHDR", header.data(), header.size());
+
+    // Rows: filter None + pixels (16 bits are big endian, BGR memory is swizzled to RGB)
+    const size_t pixelSize = static_cast<size_t>(component.getSizeInByte());
+    const size_t rowSize   = pixelSize * extents.x;
+    const bool   swizzle   = !is16Bits && nbComponents >= 3 && isBGR(image.getFormat());
+    std::vector<uint8_t> swapped(is16Bits || swizzle ? rowSize : 0);
+    stream.beginData();
+    for (uint32_t row = 0; row < extents.y; ++row)
+    {
+        const uint8_t filter = 0;
+        stream.push(&filter, 1);
+
+        const uint8_t* pixels = getFileRow(image, pixelSize, row);
+        if (is16Bits)
+        {
+            for (size_t id = 0; id < rowSize; id += 2)
+            {
+                swapped[id]     = pixels[id + 1];
+                swapped[id + 1] = pixels[id];
+            }
+            pixels = swapped.data();
+        }
+        else if (swizzle)
+        {
+            for (size_t id = 0; id < rowSize; id += pixelSize)
+            {
+                std::memcpy(&swapped[id], &pixels[id], pixelSize);
+                std::swap(swapped[id], swapped[id + 2]);
+            }
+            pixels = swapped.data();
+        }
+        stream.push(pixels, rowSize);
+    }
+    stream.endData();
+    stream.writeChunk("IEND", nullptr, 0);
+
+    checkFile(file, filename);
+}
+
+void ImageEncoder::saveEXR(const Image& image, const ComponentDescriptor& component, const Core::Path& filename)
+{
+    MouCa::preCondition(!image.isNull());
+    MouCa::preCondition(!filename.empty());
+
+    // Channels are sorted by name into file: memory index of each channel
+    using Channels = std::vector<std::pair<char, size_t>>;
+    Channels channels;
+    switch (component.getFormatType() == Type::Float ? component.getNbComponents() : 0)
+    {
+        case 1: channels = { { 'Y', 0 } };                                  break;
+        case 3: channels = { { 'B', 2 }, { 'G', 1 }, { 'R', 0 } };              break;
+        case 4: channels = { { 'A', 3 }, { 'B', 2 }, { 'G', 1 }, { 'R', 0 } };  break;
+        default:
+            throw Core::Exception(Core::ErrorData("BasicError", "ImageNoneImplemented"));
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    checkFile(file, filename);
+
+    std::vector<uint8_t> header;
+    auto write = [&](const void* data, const size_t size)
+    {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+        header.insert(header.end(), bytes, bytes + size);
+    };
+    auto writeAttribute = [&](const char* name, const char* type, const void* data, const int32_t size)
+    {
+        write(name, strlen(name) + 1);
+        write(type, strlen(type) + 1);
+        write(&size, sizeof(size));
+        write(data, static_cast<size_t>(size));
+    };
+
+    // Magic + version 2 (single part scanline)
+    const std::array<uint8_t, 8> magic = { 0x76, 0x2F, 0x31, 0x01, 0x02, 0x00, 0x00, 0x00 };
+    write(magic.data(), magic.size());
+
+    // Channel list: name, FLOAT, pLinear + reserved, sampling 1x1
+    std::vector<uint8_t> channelList;
+    for (const auto& channel : channels)
+    {
+        const std::array<uint8_t, 18> description = { static_cast<uint8_t>(channel.first), 0, 2, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0 };
+        channelList.insert(channelList.end(), description.cbegin(), description.cend());
+    }
+    channelList.push_back(0);
+    writeAttribute("channels", "chlist", channelList.data(), static_cast<int32_t>(channelList.size()));
+
+    const auto extents = image.getExtents(0);
+    const uint8_t noCompression = 0;
+    const uint8_t increasingY   = 0;
+    const std::array<int32_t, 4> window = { 0, 0, static_cast<int32_t>(extents.x) - 1, static_cast<int32_t>(extents.y) - 1 };
+    const float aspectRatio = 1.0f;
+    const std::array<float, 2> center = { 0.0f, 0.0f };
+    const float screenWidth = 1.0f;
+    writeAttribute("compression",        "compression", &noCompression,  1);
+    writeAttribute("dataWindow",         "box2i",       window.data(),   sizeof(window));
+    writeAttribute("displayWindow",      "box2i",       window.data(),   sizeof(window));
+    writeAttribute("lineOrder",          "lineOrder",   &increasingY,    1);
+    writeAttribute("pixelAspectRatio",   "float",       &aspectRatio,    sizeof(aspectRatio));
+    writeAttribute("screenWindowCenter", "v2f",         center.data(),   sizeof(center));
+    writeAttribute("screenWindowWidth",  "float",       &screenWidth,    sizeof(screenWidth));
+    header.push_back(0);
+
+    // Offset table: one scanline per block (y + size + data)
+    const size_t rowSize   = channels.size() * sizeof(float) * extents.x;
+    const size_t blockSize = 2 * sizeof(int32_t) + rowSize;
+    uint64_t offset = header.size() + sizeof(uint64_t) * extents.y;
+    for (uint32_t row = 0; row < extents.y; ++row, offset += blockSize)
+    {
+        write(&offset, sizeof(offset));
+    }
+    file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+    // Scanlines: planar channels (only one row in memory)
+    const size_t pixelSize = static_cast<size_t>(component.getSizeInByte());
+    std::vector<float> planar(channels.size() * extents.x);
+    for (uint32_t row = 0; row < extents.y; ++row)
+    {
+        const float* pixels = reinterpret_cast<const float*>(getFileRow(image, pixelSize, row));
+        for (size_t channel = 0; channel < channels.size(); ++channel)
+        {
+            float* output = &planar[channel * extents.x];
+            for (uint32_t x = 0; x < extents.x; ++x)
+            {
+                output[x] = pixels[x * component.getNbComponents() + channels[channel].second];
+            }
+        }
+
+        const std::array<int32_t, 2> block = { static_cast<int32_t>(row), static_cast<int32_t>(rowSize) };
+        file.write(reinterpret_cast<const char*>(block.data()), sizeof(block));
+        file.write(reinterpret_cast<const char*>(planar.data()), static_cast<std::streamsize>(rowSize));
+    }
+
+    checkFile(file, filename);
+}
+
+}
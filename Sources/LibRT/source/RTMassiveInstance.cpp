@@ -5,6 +5,8 @@
 
 #include <LibRT/include/RTMassiveInstance.h>
 
+#include <LibRT/include/RTFrustum.h>
+
 namespace RT
 {
 
@@ -14,6 +16,45 @@ void BasicMassiveInstance::release()
     _indirects.clear();
 }
 
+Point4 BasicMassiveInstance::computeSphere(const Instance& instance, const BoundingBox& box)
+{
+    const glm::quat rotation(instance._quaternion.w, instance._quaternion.x, instance._quaternion.y, instance._quaternion.z);
+    const Point3 center = instance._position + rotation * (box.getCenter() * instance._scale);
+    const GeoFloat scale = std::max(std::abs(instance._scale.x), std::max(std::abs(instance._scale.y), std::abs(instance._scale.z)));
+    return Point4(center, box.getRadius() * scale);
+}
+
+void BasicMassiveInstance::cull(const Frustum& frustum, const std::vector<BoundingBox>& boxes, std::vector<Indirect>& indirects, std::vector<Instance>& instances) const
+{
+    MouCa::preCondition(boxes.size() == _indirects.size()); // DEV Issue: one box by mesh !
+
+    indirects = _indirects;
+    for (auto& indirect : indirects)
+    {
+        indirect._count = 0;
+    }
+
+    // Group by indirect (stable order)
+    std::vector<std::vector<Instance>> visibles(indirects.size());
+    for (const auto& instance : _instances)
+    {
+        MouCa::assertion(instance._meshID < boxes.size());
+
+        const Point4 sphere = computeSphere(instance, boxes[instance._meshID]);
+        if (frustum.checkSphere(Point3(sphere), sphere.w))
+        {
+            visibles[instance._meshID].emplace_back(instance);
+            ++indirects[instance._meshID]._count;
+        }
+    }
+
+    instances.clear();
+    for (const auto& visible : visibles)
+    {
+        instances.insert(instances.end(), visible.cbegin(), visible.cend());
+    }
+}
+
 void MassiveInstance::addMesh( const MeshImportWPtr& mesh )
 {
     _meshes.emplace_back( mesh );
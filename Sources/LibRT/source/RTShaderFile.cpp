@@ -3,6 +3,7 @@
 /// \license No license
 #include "Dependencies.h"
 
+#include <LibCore/include/CoreLogger.h>
 #include <LibCore/include/CoreStandardOS.h>
 
 #include "LibRT/include/RTShaderFile.h"
@@ -44,7 +45,7 @@ void ShaderFile::compile()
     }
     else
     {
-        MouCa::logConsole(std::format("GLSL compilation Success: {}", _sourceFilepath.filename().string()));
+        MOUCA_LOG_INFO(Render, "GLSL compilation Success: {}", _sourceFilepath.filename().string());
     }
 }
 
@@ -12,8 +12,24 @@ namespace RT
 
 namespace Vulkan
 {
+    class Command;
+    using CommandUPtr = std::unique_ptr<Command>;
+    using Commands    = std::vector<CommandUPtr>;
+
     class Device;
 
+    //----------------------------------------------------------------------------
+    /// \brief Acceleration structure (bottom or top level) built from geometries.
+    /// Build flags select optional features:
+    ///  - VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR: bottom level is compacted after build (less memory).
+    ///  - VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR: structure can be refit with updateAccelerationStructure().
+    /// \code{.cpp}
+    ///     bottom->setBuildFlags(VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR);
+    ///     bottom->initialize(device);
+    ///     top->initialize(device);
+    ///     AccelerationStructure::createAccelerationStructure(device, structures);   // Batched builds + compaction
+    ///     AccelerationStructure::updateAccelerationStructure(device, dynamics);     // Refit after edition of vertices/instances
+    /// \endcode
     class AccelerationStructure
     {
         MOUCA_NOCOPY_NOMOVE(AccelerationStructure);
@@ -25,19 +41,42 @@ namespace Vulkan
             void addGeometry(AccelerationStructureGeometryUPtr&& geometry);
             void setCreateInfo(const VkAccelerationStructureCreateFlagsKHR createFlags, const VkAccelerationStructureTypeKHR type);
 
+            //------------------------------------------------------------------------
+            /// \brief  Set flags of build (default: VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR).
+            ///
+            /// \param[in] buildFlags: flags used by initialize() to compute sizes and by builds.
+            void setBuildFlags(const VkBuildAccelerationStructureFlagsKHR buildFlags);
+
             void initialize(const Device& device);
 
             void release(const Device& device);
 
             VkAccelerationStructureKHR getHandle() const       { return _handle; }
             uint64_t                   getDeviceAdress() const { return _deviceAddress; }
+            /// Size of structure (compacted size after compaction).
+            VkDeviceSize               getSize() const         { return _size; }
 
             bool isNull() const { return _handle == VK_NULL_HANDLE; }
 
-            /// Create acceleration structure into single command
+            //------------------------------------------------------------------------
+            /// \brief  Build initialized structures: all builds share one scratch buffer sized to max requirement.
+            /// Bottom levels are built first into one command buffer, compacted when allowed, then top levels read final addresses.
+            ///
+            /// \param[in] device: device of structures.
+            /// \param[in] accelerationStructures: initialized structures (bottom and top levels).
+            /// \throw Core::Exception when compacted sizes can't be read.
             static void createAccelerationStructure(const Device& device, std::vector<AccelerationStructureWPtr>& accelerationStructures);
 
+            //------------------------------------------------------------------------
+            /// \brief  Refit built structures with current data of geometries (same topology): faster than new build.
+            /// Structures need VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR.
+            ///
+            /// \param[in] device: device of structures.
+            /// \param[in] accelerationStructures: built structures (bottom and top levels).
+            static void updateAccelerationStructure(const Device& device, std::vector<AccelerationStructureWPtr>& accelerationStructures);
+
         private:
+            using AccelerationStructures = std::vector<std::shared_ptr<AccelerationStructure>>;
             struct BuildGeometry
             {
                 BuildGeometry();
@@ -51,13 +90,27 @@ namespace Vulkan
 
             void buildGeometry(const Device& device);
 
+            /// Create buffer and handle of structure.
+            void create(const Device& device, const VkDeviceSize size);
+
+            /// Sort structures by level: bottom levels are built before top levels which read their addresses.
+            static void sortLevels(const std::vector<AccelerationStructureWPtr>& accelerationStructures, AccelerationStructures& bottoms, AccelerationStructures& tops);
+
+            /// Add builds of structures sharing same scratch buffer (serialized by barriers).
+            static void recordBuilds(const Device& device, const AccelerationStructures& structures, const VkBuildAccelerationStructureModeKHR mode,
+                                     const VkDeviceAddress scratchAddress, Commands& commands);
+
+            /// Replace structures by compacted copies (compacted sizes are read from query pool).
+            static void compact(const Device& device, const AccelerationStructures& structures, const VkQueryPool queryPool);
 
-            Buffer                     _data;                               ///< Memory of buffer
+            BufferUPtr                 _data;                               ///< Memory of buffer
             VkAccelerationStructureKHR _handle        = VK_NULL_HANDLE;
             uint64_t                   _deviceAddress = 0;
+            VkDeviceSize               _size          = 0;
 
             VkAccelerationStructureCreateFlagsKHR   _createFlags = 0;
             VkAccelerationStructureTypeKHR          _type        = VK_ACCELERATION_STRUCTURE_TYPE_MAX_ENUM_KHR;
+            VkBuildAccelerationStructureFlagsKHR    _buildFlags  = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
             
             // Geometry info
             std::vector<AccelerationStructureGeometryUPtr> _geometries;
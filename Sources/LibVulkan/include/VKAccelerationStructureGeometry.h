@@ -32,6 +32,17 @@ namespace Vulkan
 
             virtual void create(const Device& device) = 0;
 
+            //------------------------------------------------------------------------
+            /// \brief  Refresh data of created geometry before update (refit) of acceleration structure.
+            /// By default, nothing to do: GPU reads buffers again (vertices edited in place).
+            virtual void update(const Device&)
+            {}
+
+            //------------------------------------------------------------------------
+            /// \brief  Release data owned by geometry (called by AccelerationStructure::release()).
+            virtual void release(const Device&)
+            {}
+
         protected:
             AccelerationStructureGeometry(const VkGeometryTypeKHR type);
 
@@ -66,8 +77,20 @@ namespace Vulkan
                 _instances.emplace_back(std::move(instance));
             }
 
+            std::vector<Instance>& getInstances()
+            {
+                return _instances;
+            }
+
             void create(const Device& device) override;
-       
+
+            //------------------------------------------------------------------------
+            /// \brief  Write instances again (transform, reference address of compacted structure, ...).
+            ///
+            /// \param[in] device: device of buffers.
+            void update(const Device& device) override;
+
+            void release(const Device& device) override;
 
         private:
             std::vector<Instance> _instances;
@@ -3,10 +3,13 @@
 /// \license No license
 #pragma once
 
+#include <LibCore/include/CoreSignal.h>
+
 #include "LibVulkan/include/VKMemory.h"
 
 namespace Vulkan
 {
+    class DeferredRelease;
     class Device;
 
     class Buffer
@@ -22,6 +25,9 @@ namespace Vulkan
             VkBufferUsageFlags      _usageFlags;
             VkBufferCreateFlags     _createFlags;
 
+            Core::Signal<Buffer&>   _signalHandleChanged;   ///< VkBuffer is replaced (resize/reserve).
+            Core::Signal<Buffer&>   _signalRelease;         ///< VkBuffer is destroyed (release).
+
             MOUCA_NOCOPY(Buffer);
 
         public:
@@ -30,8 +36,38 @@ namespace Vulkan
         
             void initialize(const Device& device, const VkBufferCreateFlags createFlag, const VkBufferUsageFlags usageFlags, VkDeviceSize size, const void *data = nullptr);
 
+            //------------------------------------------------------------------------
+            /// \brief  Reallocate buffer: content is lost (see reserve() to keep it). Emits handle changed signal.
+            ///
+            /// \param[in] device: device of buffer.
+            /// \param[in] size: new size.
             void resize(const Device& device, VkDeviceSize size);
 
+            //------------------------------------------------------------------------
+            /// \brief  Grow buffer keeping its content: new buffer is allocated and old content is copied by GPU.
+            /// Capacity grows geometrically (at least twice previous size) to avoid reallocation at each growth.
+            /// Buffer needs VK_BUFFER_USAGE_TRANSFER_SRC_BIT. Mapping is not kept.
+            /// Descriptor sets written with old handle are stale: handle changed signal is emitted (see DescriptorSet::isDirty()).
+            ///
+            /// \param[in] device: device of buffer.
+            /// \param[in] commandBuffer: command buffer in recording state where copy is recorded.
+            /// \param[in] size: minimal size needed.
+            /// \param[in,out] deferred: old buffer is released when GPU doesn't use it anymore.
+            /// \returns True when buffer handle changed.
+            bool reserve(const Device& device, const VkCommandBuffer commandBuffer, const VkDeviceSize size, DeferredRelease& deferred);
+
+            //------------------------------------------------------------------------
+            /// \brief  Copy data into part of buffer through staging buffer (other parts are not uploaded again).
+            /// Buffer needs VK_BUFFER_USAGE_TRANSFER_DST_BIT.
+            ///
+            /// \param[in] device: device of buffer.
+            /// \param[in] commandBuffer: command buffer in recording state where copy is recorded.
+            /// \param[in] offset: offset into buffer.
+            /// \param[in] size: size of data.
+            /// \param[in] data: data to copy.
+            /// \param[in,out] deferred: staging buffer is released when GPU doesn't use it anymore.
+            void updateRange(const Device& device, const VkCommandBuffer commandBuffer, const VkDeviceSize offset, const VkDeviceSize size, const void* data, DeferredRelease& deferred);
+
             virtual void release(const Device& device);
 
             virtual bool isNull() const
@@ -62,6 +98,24 @@ namespace Vulkan
 
             const VkDescriptorBufferInfo& getDescriptor() const;
 
+            //------------------------------------------------------------------------
+            /// \brief  Get signal emitted when VkBuffer is replaced (resize/reserve): objects which copied handle must be updated.
+            ///
+            /// \returns Signal with this buffer.
+            Core::Signal<Buffer&>& getSignalHandleChanged()
+            {
+                return _signalHandleChanged;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get signal emitted before VkBuffer is destroyed: objects which copied handle must forget it.
+            ///
+            /// \returns Signal with this buffer.
+            Core::Signal<Buffer&>& getSignalRelease()
+            {
+                return _signalRelease;
+            }
+
             const VkDeviceAddress getDeviceAddress(const Device& device) const;
 
             static VkDeviceSize alignedSize(const VkDeviceSize value, const VkDeviceSize alignment)
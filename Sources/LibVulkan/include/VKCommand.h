@@ -3,13 +3,20 @@
 /// \license No license
 #pragma once
 
+namespace Core
+{
+    class ThreadPools;
+}
+
 namespace Vulkan
 {
     // Forward declaration
     class Buffer;
     using BufferWPtr = std::weak_ptr<Buffer>;
 
+    class CommandStream;
     class Device;
+    class FrameRing;
 
     class DescriptorSet;
     class FrameBuffer;
@@ -41,6 +48,8 @@ namespace Vulkan
     };
 
     ///	\brief	Abstract command to make a command list for CommandBuffer.
+    /// Command has a version: CommandBuffer records again its commands only when one version changed since latest recording.
+    /// Versions are unique into application: new or modified command is always more recent than latest recording.
     class Command
     {
         MOUCA_NOCOPY(Command);
@@ -51,8 +60,63 @@ namespace Vulkan
             [[deprecated]] virtual void execute(const VkCommandBuffer& commandBuffer) = 0;
             virtual void execute(const ExecuteCommands& executer) = 0;
 
+            //------------------------------------------------------------------------
+            /// \brief  Append packets of command into flat stream: handles are resolved now.
+            /// By default, command is kept as Execute packet (recorded by virtual path).
+            ///
+            /// \param[in,out] stream: stream to fill.
+            /// \param[in] idSwap: id of swapchain image.
+            virtual void compile(CommandStream& stream, const uint32_t idSwap);
+
+            //------------------------------------------------------------------------
+            /// \brief  Get version of recorded data: it changes when parameters or handles of linked objects change.
+            ///
+            /// \returns Version (only increases).
+            virtual uint64_t getVersion() const
+            {
+                return isModified() ? _lastVersion.load() + 1 : _version;
+            }
+
         protected:
-            Command() = default;
+            Command():
+            _version(++_lastVersion)
+            {}
+
+            //------------------------------------------------------------------------
+            /// \brief  Check if linked objects changed since latest recording (rebuilt pipeline, resized framebuffer, ...).
+            ///
+            /// \returns True when command must be recorded again.
+            virtual bool isModified() const
+            {
+                return false;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Parameters changed: command buffers must record command again.
+            void markDirty()
+            {
+                _version = ++_lastVersion;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Replace handle used by recording: command is dirty when handle changes.
+            ///
+            /// \param[in,out] recorded: handle used by latest recording.
+            /// \param[in] current: handle of linked object.
+            template<typename Handle>
+            void updateHandle(Handle& recorded, const Handle& current)
+            {
+                if (recorded != current)
+                {
+                    recorded = current;
+                    markDirty();
+                }
+            }
+
+            uint64_t _version;                                  ///< Version of recorded data.
+
+        private:
+            static std::atomic<uint64_t> _lastVersion;          ///< Latest version given to a command.
     };
 
     using CommandUPtr = std::unique_ptr<Command>;
@@ -66,12 +130,19 @@ namespace Vulkan
             CommandBeginRenderPass(const RenderPass& renderPass, FrameBufferWPtr frameBuffer, const VkRect2D& renderArea, std::vector<VkClearValue>&& clearColor, const VkSubpassContents subpassContent);
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
 
         private:
+            bool isModified() const override;
+
+            //------------------------------------------------------------------------
+            /// \brief  Read framebuffer handle and area for next recording.
+            void refresh();
+
             FrameBufferWPtr           _frameBuffer;
 
             std::vector<VkClearValue> _clearColor;
-            VkRenderPassBeginInfo     _renderPassBeginInfo;
+            VkRenderPassBeginInfo     _renderPassBeginInfo;     ///< Framebuffer and area of latest recording.
             VkSubpassContents         _subpassContent;
     };
 
@@ -81,9 +152,20 @@ namespace Vulkan
         CommandBeginRenderPassSurface(const RenderPass& renderPass, std::vector<FrameBufferWPtr>&& frameBuffer, const VkRect2D& renderArea, std::vector<VkClearValue>&& clearColor, const VkSubpassContents subpassContent);
         void execute(const VkCommandBuffer& commandBuffer) override;
         void execute(const ExecuteCommands& executer) override;
+        void compile(CommandStream& stream, const uint32_t idSwap) override;
 
     private:
+        bool isModified() const override;
+
+        //------------------------------------------------------------------------
+        /// \brief  Read framebuffer handle and area of swap image for next recording.
+        ///
+        /// \param[in] idSwap: id of swapchain image.
+        void refresh(const uint32_t idSwap);
+
         std::vector<FrameBufferWPtr> _frameBuffer;
+        std::vector<VkFramebuffer>   _recordedFrameBuffers;   ///< Framebuffers of latest recording (by swap id).
+        std::vector<VkExtent2D>      _recordedExtents;        ///< Area of latest recording (by swap id).
 
         std::vector<VkClearValue> _clearColor;
         VkRenderPassBeginInfo     _renderPassBeginInfo;
@@ -95,6 +177,7 @@ namespace Vulkan
         public:
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
     };
 
     class CommandViewport final : public Command
@@ -108,6 +191,7 @@ namespace Vulkan
 
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
     };
 
     class CommandScissor final : public Command
@@ -121,32 +205,41 @@ namespace Vulkan
 
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
     };
 
     class CommandPipeline final : public Command
     {
         private:
+            bool isModified() const override;
+
             const GraphicsPipeline& _pipeline;
             VkPipelineBindPoint     _bindPoint;
+            VkPipeline              _recordedPipeline = VK_NULL_HANDLE;   ///< Pipeline of latest recording.
 
         public:
             CommandPipeline(const GraphicsPipeline& pipeline, const VkPipelineBindPoint bindPoint);
 
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
     };
 
     class CommandBindPipeline final : public Command
     {
         private:
+            bool isModified() const override;
+
             const PipelineWPtr        _pipeline;
             const VkPipelineBindPoint _bindPoint;
+            VkPipeline                _recordedPipeline = VK_NULL_HANDLE;   ///< Pipeline of latest recording.
 
         public:
             CommandBindPipeline(const PipelineWPtr pipeline, const VkPipelineBindPoint bindPoint);
 
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
     };
 
     class CommandDraw final : public Command
@@ -162,6 +255,7 @@ namespace Vulkan
 
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
     };
 
     class CommandDrawIndexed final : public Command
@@ -178,9 +272,50 @@ namespace Vulkan
 
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
     };
     using CommandDrawIndexedUPtr = std::unique_ptr<CommandDrawIndexed>;
 
+    //----------------------------------------------------------------------------
+    /// \brief Indexed draws read from buffer: number of draws is read from another buffer (GPU culling output).
+    /// \note Need VK_KHR_draw_indirect_count extension.
+    class CommandDrawIndexedIndirectCount final : public Command
+    {
+        public:
+            CommandDrawIndexedIndirectCount(const Device& device, const BufferWPtr buffer, const VkDeviceSize offset, const BufferWPtr countBuffer, const VkDeviceSize countOffset,
+                                            const uint32_t maxDrawCount, const uint32_t stride = sizeof(VkDrawIndexedIndirectCommand));
+
+            void execute(const VkCommandBuffer& commandBuffer) override;
+            void execute(const ExecuteCommands& executer) override;
+
+        private:
+            bool isModified() const override;
+
+            const Device&      _device;
+            const BufferWPtr   _buffer;
+            const BufferWPtr   _countBuffer;
+            VkBuffer           _bufferId;
+            VkBuffer           _countBufferId;
+            const VkDeviceSize _offset;
+            const VkDeviceSize _countOffset;
+            const uint32_t     _maxDrawCount;
+            const uint32_t     _stride;
+    };
+
+    class CommandDispatch final : public Command
+    {
+        private:
+            const uint32_t _groupCountX;
+            const uint32_t _groupCountY;
+            const uint32_t _groupCountZ;
+
+        public:
+            CommandDispatch(const uint32_t groupCountX, const uint32_t groupCountY = 1, const uint32_t groupCountZ = 1);
+
+            void execute(const VkCommandBuffer& commandBuffer) override;
+            void execute(const ExecuteCommands& executer) override;
+    };
+
     class CommandBindVertexBuffer : public Command
     {
         public:
@@ -189,8 +324,11 @@ namespace Vulkan
 
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
 
         private:
+            bool isModified() const override;
+
             std::vector<Vulkan::BufferWPtr> _buffers;
 
             uint32_t _firstBinding;
@@ -207,8 +345,11 @@ namespace Vulkan
 
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
 
         private:
+            bool isModified() const override;
+
             BufferWPtr _buffer;
 
             VkBuffer        _bufferId;
@@ -274,10 +415,13 @@ namespace Vulkan
     class CommandBindDescriptorSets final : public Command
     {
         private:
+            bool isModified() const override;
+
             VkPipelineLayout                    _pipelineLayoutID;
             VkPipelineBindPoint                 _bindPoint;
             const uint32_t                      _firstSet;
             const std::vector<VkDescriptorSet>& _descriptorsID;
+            std::vector<VkDescriptorSet>        _recordedDescriptors;   ///< Descriptor sets of latest recording.
             std::vector<uint32_t>               _dynamicOffsets;
 
         public:
@@ -289,6 +433,7 @@ namespace Vulkan
 
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
     };
 
     class CommandCopyImage final : public Command
@@ -375,16 +520,20 @@ namespace Vulkan
     class CommandPushConstants final : public Command
     {
         private:
+            bool isModified() const override;
+
             const VkPipelineLayout      _pipelineLayout;
             const VkShaderStageFlags    _stage;
             const uint32_t              _memorySize;
             const void*                 _buffer;        ///< Pointer to buffer: WARNING must be valid !!!
+            std::vector<uint8_t>        _recordedData;  ///< Copy of buffer at latest recording (recorded into command buffer).
 
         public:
             CommandPushConstants(const PipelineLayout& pipelineLayout, const VkShaderStageFlags stage, const uint32_t memorySize, const void* buffer);
 
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
     };
 
     /// Special Command to contain other command
@@ -397,6 +546,7 @@ namespace Vulkan
             void clear()
             {
                 _commands.clear();
+                markDirty();
             }
 
             void transfer(Commands&& commands)
@@ -408,18 +558,32 @@ namespace Vulkan
                 }
                 // Release old container
                 commands.clear();
+                markDirty();
             }
 
             void transfer(CommandUPtr&& command)
             {
                 MouCa::preCondition(command != nullptr);
                 _commands.emplace_back(std::move(command));
+                markDirty();
             }
 
-            Commands& getCommands() { return _commands; }
+            /// Caller can edit list: container is considered as modified.
+            Commands& getCommands()
+            {
+                markDirty();
+                return _commands;
+            }
 
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
+
+            //------------------------------------------------------------------------
+            /// \brief  Get most recent version of container and sub-commands.
+            ///
+            /// \returns Version.
+            uint64_t getVersion() const override;
 
         protected:
             Commands _commands;
@@ -435,16 +599,78 @@ namespace Vulkan
             void setIdNode(const size_t idNode)
             {
                 MouCa::preCondition(idNode < _commands.size());
-                _idNode = idNode;
+                if (_idNode != idNode)
+                {
+                    _idNode = idNode;
+                    markDirty();
+                }
             }
 
             void execute(const VkCommandBuffer& commandBuffer) override;
             void execute(const ExecuteCommands& executer) override;
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
+
+            //------------------------------------------------------------------------
+            /// \brief  Get most recent version of switch and active sub-command (others are not recorded).
+            ///
+            /// \returns Version.
+            uint64_t getVersion() const override;
 
         private:
             size_t  _idNode = 0;
     };
 
+    //----------------------------------------------------------------------------
+    /// \brief Record each sub-command into its own secondary command buffer on workers, then execute them from primary buffer.
+    /// Sub-commands are independent ranges (usually CommandContainer): no state is inherited between them (bind pipeline/descriptors into each range).
+    /// Each recording thread owns its CommandPool by frame slot and swap id: no lock is needed during recording.
+    /// Pools of (current frame slot, swap id) are reset at each execution: FrameRing::beginFrame() has waited the fence of this slot
+    /// and primary command buffer of swap id is recorded again (so it is not pending), then previous secondary buffers are not used anymore.
+    /// \code{.cpp}
+    ///     auto parallel = std::make_unique<Vulkan::CommandParallelContainer>(device, pools, renderPass, 0, &context.getFrameRing());
+    ///     parallel->transfer(std::move(ranges));   // One secondary command buffer by range
+    ///     // Render pass must be begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+    /// \endcode
+    /// \note Without worker, ranges are recorded by current thread (same secondary command buffers).
+    class CommandParallelContainer final : public CommandContainer
+    {
+        public:
+            //------------------------------------------------------------------------
+            /// \brief  Constructor
+            ///
+            /// \param[in] device: device where pools are created (must be alive until destruction).
+            /// \param[in] pools: workers used to record ranges.
+            /// \param[in] renderPass: render pass where secondary command buffers are executed (expired: outside render pass).
+            /// \param[in] subpass: id of subpass into render pass.
+            /// \param[in] frameRing: frames in flight of device (nullptr or not running: one slot, caller waits GPU before recording again).
+            CommandParallelContainer(const Device& device, Core::ThreadPools& pools, RenderPassWPtr renderPass, const uint32_t subpass, const FrameRing* frameRing = nullptr);
+            ~CommandParallelContainer() override;
+
+            void execute(const VkCommandBuffer& commandBuffer) override;
+            void execute(const ExecuteCommands& executer) override;
+
+            //------------------------------------------------------------------------
+            /// \brief  Ranges stay into secondary command buffers: container is kept as Execute packet.
+            void compile(CommandStream& stream, const uint32_t idSwap) override;
+
+        private:
+            struct ThreadRecorder;
+            using ThreadRecorderUPtr = std::unique_ptr<ThreadRecorder>;
+            using ThreadRecorders    = std::unordered_map<std::thread::id, ThreadRecorderUPtr>;
+
+            ThreadRecorder& getRecorder(ThreadRecorders& recorders);
+            VkCommandBuffer record(ThreadRecorders& recorders, Command& command, const uint32_t idSwap);
+
+            const Device&                   _device;        ///< [LINK] Device of pools.
+            Core::ThreadPools&              _pools;         ///< [LINK] Workers.
+            RenderPassWPtr                  _renderPass;    ///< [LINK] Render pass inherited by secondary command buffers.
+            uint32_t                        _subpass;       ///< Subpass inherited by secondary command buffers.
+            const FrameRing*                _frameRing;     ///< [LINK] Frames in flight (can be null).
+            std::vector<std::vector<ThreadRecorders>> _recorders; ///< Pools of each thread by frame slot then swap id (buffers of frames in flight stay valid).
+            std::vector<VkCommandBuffer>    _secondaries;   ///< Recorded buffers by range.
+            std::mutex                      _lock;          ///< Protect creation of recorders.
+    };
+
     class CommandBuildAccelerationStructures final : public Command
     {
         public:
@@ -462,6 +688,42 @@ namespace Vulkan
             const std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> _accelerationBuildStructureRangeInfos;
     };
 
+    //----------------------------------------------------------------------------
+    /// \brief Reset queries then write property (compacted size, ...) of each acceleration structure into query pool.
+    class CommandWriteAccelerationStructuresProperties final : public Command
+    {
+        public:
+            CommandWriteAccelerationStructuresProperties(const Device& device, std::vector<VkAccelerationStructureKHR>&& accelerationStructures,
+                                                         const VkQueryPool queryPool, const VkQueryType queryType);
+            ~CommandWriteAccelerationStructuresProperties() override = default;
+
+            void execute(const VkCommandBuffer& commandBuffer) override;
+            void execute(const ExecuteCommands& executer) override;
+
+        private:
+            const Device&                                   _device;
+            const std::vector<VkAccelerationStructureKHR>   _accelerationStructures;
+            const VkQueryPool                               _queryPool;
+            const VkQueryType                               _queryType;
+    };
+
+    //----------------------------------------------------------------------------
+    /// \brief Copy acceleration structure (clone or compaction).
+    class CommandCopyAccelerationStructure final : public Command
+    {
+        public:
+            CommandCopyAccelerationStructure(const Device& device, const VkAccelerationStructureKHR source, const VkAccelerationStructureKHR destination,
+                                             const VkCopyAccelerationStructureModeKHR mode);
+            ~CommandCopyAccelerationStructure() override = default;
+
+            void execute(const VkCommandBuffer& commandBuffer) override;
+            void execute(const ExecuteCommands& executer) override;
+
+        private:
+            const Device&                           _device;
+            const VkCopyAccelerationStructureInfoKHR _info;
+    };
+
     class CommandTraceRay final : public Command
     {
         public:
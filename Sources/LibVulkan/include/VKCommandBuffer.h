@@ -17,11 +17,22 @@ namespace Vulkan
     using CommandPoolWPtr = std::weak_ptr<CommandPool>;
     class Device;
 
+    //----------------------------------------------------------------------------
+    /// \brief Command buffer records its commands once: execute() records again only when a command version changed
+    /// (or after invalidate()), otherwise previous recording is kept and submitted.
     class ICommandBuffer
     {
         MOUCA_NOCOPY(ICommandBuffer);
 
         public:
+            /// Counters of all command buffers (check that static scene doesn't record).
+            struct Statistics
+            {
+                uint64_t _nbRecordings = 0;     ///< Number of recorded VkCommandBuffer.
+                uint64_t _nbResets     = 0;     ///< Number of vkResetCommandBuffer.
+                uint64_t _nbSkipped    = 0;     ///< Number of execute() without change.
+            };
+
             /// Destructor
             virtual ~ICommandBuffer() = default;
 
@@ -37,15 +48,46 @@ namespace Vulkan
 
             virtual VkCommandBuffer getActiveCommandBuffer() const = 0;
 
+            //------------------------------------------------------------------------
+            /// \brief  Check if commands changed since latest recording.
+            ///
+            /// \returns True if next execute() records.
+            bool isDirty() const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Force recording at next execute() (objects rebuilt: driver can reuse same handles).
+            void invalidate()
+            {
+                _recorded = false;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Force recording of all command buffers at next execute() (after rebuild of shaders, swapchain, ...).
+            static void invalidateAll();
+
+            static Statistics getStatistics();
+
         protected:
             void executeCommand(const ExecuteCommands& executer, const VkCommandBufferResetFlags reset) const;
 
+            //------------------------------------------------------------------------
+            /// \brief  Keep version of commands just recorded.
+            void validate() const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Count execute() without recording.
+            static void countSkipped();
+
             /// Constructor
             ICommandBuffer();
 
             CommandPoolWPtr             _pool;      ///< [LINK] Pool used to create CommandBuffer.
             VkCommandBufferUsageFlags   _usage;     ///< Usage when begin CommandBuffer.
             Commands                    _commands;  ///< [OWNERSHIP] All commands (Keep memory alive).
+
+            mutable bool                _recorded        = false;   ///< Command buffers contain commands.
+            mutable uint64_t            _recordedVersion = 0;       ///< Most recent version of commands at latest recording.
+            mutable uint64_t            _recordedEpoch   = 0;       ///< Global epoch at latest recording (see invalidateAll()).
     };
 
     using ICommandBufferWPtr = std::weak_ptr<ICommandBuffer>;
@@ -28,6 +28,13 @@ namespace Vulkan
 
             void release(const Device& device);
 
+            //------------------------------------------------------------------------
+            /// \brief  Reset all command buffers allocated by pool (buffers must not be in use by GPU).
+            ///
+            /// \param[in] device: device of pool.
+            /// \param[in] flags: reset flags.
+            void reset(const Device& device, const VkCommandPoolResetFlags flags = 0) const;
+
             const VkCommandPool& getInstance() const
             {
                 return _commandPool;
@@ -0,0 +1,214 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+namespace Vulkan
+{
+    class Command;
+    using CommandUPtr = std::unique_ptr<Command>;
+    using Commands    = std::vector<CommandUPtr>;
+
+    //----------------------------------------------------------------------------
+    /// \brief Linear stream of POD packets compiled from Commands.
+    /// Recording is one switch by packet into contiguous memory: no virtual call, no weak_ptr lock (handles are resolved by compile()).
+    /// Commands without packet are kept as Execute packet (virtual path).
+    /// \code{.cpp}
+    ///     Vulkan::CommandStream stream;
+    ///     stream.compile(commands, idSwap);       // Compile again when commands change (see Command::getVersion())
+    ///     stream.record(commandBuffer);           // Between vkBeginCommandBuffer/vkEndCommandBuffer
+    /// \endcode
+    class CommandStream final
+    {
+        MOUCA_NOCOPY_NOMOVE(CommandStream);
+
+        public:
+            enum class Opcode : uint32_t
+            {
+                BeginRenderPass,
+                EndRenderPass,
+                Viewport,
+                Scissor,
+                BindPipeline,
+                BindDescriptorSets,
+                BindVertexBuffers,
+                BindIndexBuffer,
+                Draw,
+                DrawIndexed,
+                PushConstants,
+                Execute
+            };
+
+            /// Beginning of each packet.
+            struct alignas(8) Header
+            {
+                Opcode      _opcode;
+                uint32_t    _size;          ///< Size of packet with header and trailing data (aligned on 8 bytes).
+            };
+
+            /// Followed by VkClearValue[_nbClearValues].
+            struct BeginRenderPass
+            {
+                VkRenderPass        _renderPass;
+                VkFramebuffer       _frameBuffer;
+                VkRect2D            _renderArea;
+                VkSubpassContents   _contents;
+                uint32_t            _nbClearValues;
+            };
+
+            struct EndRenderPass
+            {};
+
+            struct Viewport
+            {
+                VkViewport  _viewport;
+            };
+
+            struct Scissor
+            {
+                VkRect2D    _scissor;
+            };
+
+            struct BindPipeline
+            {
+                VkPipeline          _pipeline;
+                VkPipelineBindPoint _bindPoint;
+            };
+
+            /// Followed by VkDescriptorSet[_nbSets] then uint32_t[_nbDynamicOffsets].
+            struct BindDescriptorSets
+            {
+                VkPipelineLayout    _pipelineLayout;
+                VkPipelineBindPoint _bindPoint;
+                uint32_t            _firstSet;
+                uint32_t            _nbSets;
+                uint32_t            _nbDynamicOffsets;
+            };
+
+            /// Followed by VkBuffer[_nbBindings] then VkDeviceSize[_nbBindings].
+            struct BindVertexBuffers
+            {
+                uint32_t    _firstBinding;
+                uint32_t    _nbBindings;
+            };
+
+            struct BindIndexBuffer
+            {
+                VkBuffer        _buffer;
+                VkDeviceSize    _offset;
+                VkIndexType     _indexType;
+            };
+
+            struct Draw
+            {
+                uint32_t    _vertexCount;
+                uint32_t    _instanceCount;
+                uint32_t    _firstVertex;
+                uint32_t    _firstInstance;
+            };
+
+            struct DrawIndexed
+            {
+                uint32_t    _indexCount;
+                uint32_t    _instanceCount;
+                uint32_t    _firstIndex;
+                int32_t     _vertexOffset;
+                uint32_t    _firstInstance;
+            };
+
+            /// Followed by _size bytes of values.
+            struct PushConstants
+            {
+                VkPipelineLayout    _pipelineLayout;
+                VkShaderStageFlags  _stage;
+                uint32_t            _size;
+            };
+
+            /// Command recorded by virtual path.
+            struct Execute
+            {
+                Command*    _command;
+                uint32_t    _idSwap;
+            };
+
+            CommandStream() = default;
+            ~CommandStream() = default;
+
+            //------------------------------------------------------------------------
+            /// \brief  Remove all packets (memory is kept).
+            void clear()
+            {
+                _data.clear();
+                _nbPackets = 0;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Append commands to stream.
+            ///
+            /// \param[in] commands: commands to compile.
+            /// \param[in] idSwap: id of swapchain image (select part of surface commands).
+            void compile(const Commands& commands, const uint32_t idSwap = 0);
+
+            //------------------------------------------------------------------------
+            /// \brief  Record all packets into command buffer.
+            ///
+            /// \param[in] commandBuffer: command buffer in recording state.
+            void record(const VkCommandBuffer commandBuffer) const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Append packet followed by trailing data.
+            ///
+            /// \param[in] opcode: type of packet.
+            /// \param[in] trailingSize: size of trailing data in bytes (see getTrailing()).
+            /// \returns Packet to fill (valid until next push).
+            template<typename Packet>
+            Packet& push(const Opcode opcode, const size_t trailingSize = 0)
+            {
+                static_assert(std::is_trivially_copyable_v<Packet> && alignof(Packet) <= alignof(Header));
+
+                const size_t size   = alignSize(sizeof(Header) + sizeof(Packet) + trailingSize);
+                const size_t offset = _data.size();
+                _data.resize(offset + size);
+                new (_data.data() + offset) Header{ opcode, static_cast<uint32_t>(size) };
+                ++_nbPackets;
+                return *new (_data.data() + offset + sizeof(Header)) Packet();
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get trailing data of packet.
+            ///
+            /// \param[in] packet: packet given by push().
+            /// \param[in] offset: offset in bytes after packet.
+            /// \returns Pointer to trailing data.
+            template<typename Type, typename Packet>
+            static Type* getTrailing(Packet& packet, const size_t offset = 0)
+            {
+                return reinterpret_cast<Type*>(reinterpret_cast<std::byte*>(&packet + 1) + offset);
+            }
+
+            template<typename Type, typename Packet>
+            static const Type* getTrailing(const Packet& packet, const size_t offset = 0)
+            {
+                return reinterpret_cast<const Type*>(reinterpret_cast<const std::byte*>(&packet + 1) + offset);
+            }
+
+            size_t getNbPackets() const
+            {
+                return _nbPackets;
+            }
+
+            size_t getByteSize() const
+            {
+                return _data.size();
+            }
+
+        private:
+            static size_t alignSize(const size_t size)
+            {
+                return (size + alignof(Header) - 1) & ~(alignof(Header) - 1);
+            }
+
+            std::vector<std::byte>  _data;              ///< Packets (Header + packet + trailing data).
+            size_t                  _nbPackets = 0;     ///< Number of packets.
+    };
+}
@@ -0,0 +1,44 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+#include <LibVulkan/include/VKPipeline.h>
+#include <LibVulkan/include/VKPipelineStates.h>
+
+namespace Vulkan
+{
+    class Device;
+
+    class PipelineLayout;
+    using PipelineLayoutWPtr = std::weak_ptr<PipelineLayout>;
+
+    //----------------------------------------------------------------------------
+    /// \brief Pipeline for compute shader: only one shader stage (VK_SHADER_STAGE_COMPUTE_BIT).
+    class ComputePipeline final : public Pipeline
+    {
+        MOUCA_NOCOPY_NOMOVE(ComputePipeline);
+
+        public:
+            ComputePipeline() = default;
+            ~ComputePipeline() override = default;
+
+            //------------------------------------------------------------------------
+            /// \brief  Create pipeline: compute shader must be added into getShadersStage() before.
+            /// 
+            /// \param[in] device: device of pipeline.
+            /// \param[in] layout: layout of pipeline (descriptor sets, push constants).
+            /// \throw Core::Exception when pipeline can't be created.
+            void initialize(const Device& device, PipelineLayoutWPtr layout);
+            void release(const Device& device);
+
+            PipelineStageShaders& getShadersStage() { return _shaderStages; }
+
+        private:
+            PipelineLayoutWPtr   _layout;
+            PipelineStageShaders _shaderStages;
+    };
+
+    using ComputePipelineSPtr = std::shared_ptr<ComputePipeline>;
+    using ComputePipelineWPtr = std::weak_ptr<ComputePipeline>;
+}
@@ -3,9 +3,14 @@
 /// \license No license
 #pragma once
 
+#include <LibCore/include/CoreSignal.h>
+
 #include <LibVulkan/include/VKCommandPool.h>
 #include <LibVulkan/include/VKContextWindow.h>
+#include <LibVulkan/include/VKDeferredRelease.h>
+#include <LibVulkan/include/VKDescriptorAllocator.h>
 #include <LibVulkan/include/VKDevice.h>
+#include <LibVulkan/include/VKFrameRing.h>
 #include <LibVulkan/include/VKPipelineCache.h>
 
 namespace Vulkan
@@ -131,7 +136,31 @@ namespace Vulkan
             /// \returns True if each component is null, otherwise false.
             bool isNull() const
             {
-                return _device.isNull() && _pipelineCache.isNull();
+                return _device.isNull() && _pipelineCache.isNull() && _descriptorAllocator.isNull() && _frameRing.isNull();
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Start next frame in flight: wait GPU finished same frame slot then release its deferred objects/transient sets.
+            /// Descriptor sets linked to replaced buffers (Buffer::reserve()) are written again after all frames are finished:
+            /// descriptors refreshed signal is emitted and command buffers binding them must be recorded again.
+            ///
+            /// \param[in] timeout: maximum time to wait frame (in nanosecond).
+            /// \returns VK_SUCCESS or result of fence waiting (frame is not started).
+            VkResult beginFrame(const uint64_t timeout = Fence::infinityTimeout);
+
+            //------------------------------------------------------------------------
+            /// \brief  Wait GPU finished all work of frames in flight (waitIdle() when frames are not used).
+            ///
+            /// \throw Core::Exception when device is lost.
+            void synchronize() const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Get signal emitted by beginFrame() when dirty descriptor sets have been written again (GPU is idle).
+            ///
+            /// \returns Signal to record again command buffers.
+            Core::Signal<>& getSignalDescriptorsRefreshed()
+            {
+                return _signalDescriptorsRefreshed;
             }
 
             const QueueSequences&   getQueueSequences() const   { return _sequences; }
@@ -140,6 +169,18 @@ namespace Vulkan
             /// \brief  Return current device.
             const Device& getDevice() const { return _device; }
 
+            //------------------------------------------------------------------------
+            /// \brief  Return allocator of pooled/cached descriptor sets.
+            DescriptorAllocator& getDescriptorAllocator() { return _descriptorAllocator; }
+
+            //------------------------------------------------------------------------
+            /// \brief  Return list of objects released after frames in flight (old buffers, staging buffers, ...).
+            DeferredRelease& getDeferredRelease() { return _deferredRelease; }
+
+            //------------------------------------------------------------------------
+            /// \brief  Return fences/semaphores/command pool of frames in flight.
+            FrameRing& getFrameRing() { return _frameRing; }
+
             void insertImage(ImageSPtr data)
             {
                 MouCa::preCondition(data.get()); //DEV Issue: Need valid data
@@ -267,9 +308,24 @@ namespace Vulkan
 
             GraphicsPipelines& getGraphicsPipelines() { return _graphicsPipelines; }
 
+            //------------------------------------------------------------------------
+            /// \brief  Get graphics pipelines using shader module: reverse index is rebuilt when pipelines were added.
+            ///
+            /// \param[in] module: shader module owned by this context.
+            /// \returns Pipelines to rebuild when module changes (can be empty).
+            const GraphicsPipelines& getGraphicsPipelines(const ShaderModule& module);
+
         private:
+            //------------------------------------------------------------------------
+            /// \brief  Write again descriptor sets linked to replaced buffers (wait all frames in flight when needed).
+            /// All command buffers are invalidated: they are recorded again at their next execution.
+            void refreshDescriptorSets();
+
             Device              _device;                ///< Vulkan Device data.
             PipelineCache       _pipelineCache;         ///< Pipeline cache.
+            DescriptorAllocator _descriptorAllocator;   ///< Pooled/cached descriptor sets.
+            DeferredRelease     _deferredRelease;       ///< Objects still used by GPU.
+            FrameRing           _frameRing;             ///< Synchronization of frames in flight.
 
         // WARNING: Declaration in right creation order !
 
@@ -291,6 +347,11 @@ namespace Vulkan
             PipelineLayouts        _pipelineLayouts;       ///< [OWNERSHIP]
             GraphicsPipelines      _graphicsPipelines;     ///< [OWNERSHIP]
             RayTracingPipelines    _rayTracingPipelines;   ///< [OWNERSHIP]
+
+            Core::Signal<>         _signalDescriptorsRefreshed;   ///< Dirty sets have been written again.
+
+            std::map<const ShaderModule*, GraphicsPipelines> _shaderPipelines;          ///< [LINK] Reverse index: pipelines by shader module.
+            size_t                                           _nbIndexedPipelines = 0;   ///< Number of pipelines into reverse index.
         
         // RayTracing
             AccelerationStructures _accelerationStructures;///< [OWNERSHIP]
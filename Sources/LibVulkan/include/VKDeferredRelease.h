@@ -0,0 +1,95 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+namespace Vulkan
+{
+    class Buffer;
+    using BufferUPtr = std::unique_ptr<Buffer>;
+
+    class Device;
+
+    //----------------------------------------------------------------------------
+    /// \brief List of objects still used by GPU: they are released only when frames in flight are finished.
+    /// \code{.cpp}
+    ///     deferred.add(std::move(oldBuffer));     // Used by command buffers of current frame
+    ///     deferred.add([old = pipeline](const Device& device) { vkDestroyPipeline(device.getInstance(), old, nullptr); });
+    ///     deferred.nextFrame(device);             // Once by frame: release objects of frames done
+    /// \endcode
+    class DeferredRelease final
+    {
+        MOUCA_NOCOPY_NOMOVE(DeferredRelease);
+
+        public:
+            /// Function which destroys one Vulkan object.
+            using Releaser = std::function<void(const Device&)>;
+
+            //------------------------------------------------------------------------
+            /// \brief  Constructor
+            ///
+            /// \param[in] nbFramesInFlight: number of frames which can be executed by GPU at same time.
+            DeferredRelease(const uint32_t nbFramesInFlight = 2);
+
+            ~DeferredRelease()
+            {
+                MouCa::assertion(isNull()); // DEV Issue: call release()
+            }
+
+            bool isNull() const
+            {
+                return _objects.empty();
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Release buffer after frames in flight.
+            ///
+            /// \param[in] buffer: buffer used by GPU during current frame.
+            void add(BufferUPtr&& buffer);
+
+            //------------------------------------------------------------------------
+            /// \brief  Release any object after frames in flight (pipeline, shader module, ...).
+            ///
+            /// \param[in] releaser: function destroying object used by GPU during current frame.
+            void add(Releaser&& releaser);
+
+            //------------------------------------------------------------------------
+            /// \brief  Start new frame: release objects which are not used anymore by GPU.
+            ///
+            /// \param[in] device: device of objects.
+            void nextFrame(const Device& device);
+
+            //------------------------------------------------------------------------
+            /// \brief  Release all objects now (GPU must be idle).
+            ///
+            /// \param[in] device: device of objects.
+            void release(const Device& device);
+
+            size_t getNbPending() const
+            {
+                return _objects.size();
+            }
+
+            uint64_t getFrame() const
+            {
+                return _frame;
+            }
+
+            uint32_t getNbFramesInFlight() const
+            {
+                return _nbFramesInFlight;
+            }
+
+        private:
+            /// Object and frame where it was used for last time.
+            struct PendingObject
+            {
+                Releaser    _releaser;
+                uint64_t    _frame;
+            };
+
+            std::deque<PendingObject>   _objects;           ///< Pending objects by frame order.
+            uint64_t                    _frame;             ///< Current frame.
+            const uint32_t              _nbFramesInFlight;  ///< Frames before release.
+    };
+}
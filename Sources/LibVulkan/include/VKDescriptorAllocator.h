@@ -0,0 +1,178 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+namespace Vulkan
+{
+    class Buffer;
+    using BufferWPtr = std::weak_ptr<Buffer>;
+
+    class Device;
+
+    class DescriptorPool;
+    using DescriptorPoolUPtr = std::unique_ptr<DescriptorPool>;
+
+    class DescriptorSetLayout;
+    class WriteDescriptorSet;
+
+    //----------------------------------------------------------------------------
+    /// \brief Allocate descriptor sets from pools sized by layout: a new pool is added when all pools of layout are exhausted.
+    /// Persistent sets are cached by content (layout + resolved bindings): same content returns same set without vkUpdateDescriptorSets.
+    /// Cached sets are evicted when one written buffer changes its handle or is released: they are recycled after frames in flight.
+    /// Transient sets live into pools of current frame in flight until this frame slot is started again by beginFrame().
+    /// \code{.cpp}
+    ///     auto set = allocator.getCached(device, layout, writes);    // Allocate + update only at first call
+    ///     allocator.beginFrame(device, ring.getCurrent());            // Release transient sets of slot (GPU finished it)
+    ///     auto tmp = allocator.allocate(device, layout, true);        // Transient: update it yourself
+    /// \endcode
+    /// \note Cached sets keep raw handles of images: call clearCache() when linked images are destroyed.
+    /// \see DescriptorSet::initialize() allocates XML descriptor sets from persistent pools (ContextDevice::getDescriptorAllocator()).
+    class DescriptorAllocator final
+    {
+        MOUCA_NOCOPY_NOMOVE(DescriptorAllocator);
+
+        public:
+            struct Statistics
+            {
+                uint64_t _nbAllocations = 0;    ///< Allocated sets.
+                uint64_t _nbPools       = 0;    ///< Created pools.
+                uint64_t _nbUpdates     = 0;    ///< Calls of vkUpdateDescriptorSets.
+                uint64_t _nbCacheHits   = 0;    ///< getCached() returning existing set.
+                uint64_t _nbCacheMisses = 0;    ///< getCached() allocating new set.
+                uint64_t _nbEvictions   = 0;    ///< Cached sets removed because one written buffer changed.
+
+                double getHitRate() const
+                {
+                    const uint64_t nbRequests = _nbCacheHits + _nbCacheMisses;
+                    return nbRequests > 0 ? static_cast<double>(_nbCacheHits) / static_cast<double>(nbRequests) : 0.0;
+                }
+            };
+
+            DescriptorAllocator();
+
+            ~DescriptorAllocator()
+            {
+                MouCa::assertion(isNull());
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Prepare allocator (pools are created at first allocation).
+            ///
+            /// \param[in] device: device of pools.
+            /// \param[in] setsByPool: number of sets into first pool of each layout (next pools are twice bigger).
+            /// \param[in] nbFramesInFlight: number of transient pools lists (one by frame in flight).
+            void initialize(const Device& device, const uint32_t setsByPool = 32, const uint32_t nbFramesInFlight = 1);
+
+            void release(const Device& device);
+
+            bool isNull() const
+            {
+                return _setsByPool == 0;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Allocate one set (not updated).
+            ///
+            /// \param[in] device: device of pools.
+            /// \param[in] layout: layout of set.
+            /// \param[in] transient: set is released when current frame slot is started again (or by resetTransient()).
+            /// \returns Allocated set.
+            /// \throw Core::Exception when new pool can't be created or allocation fails.
+            VkDescriptorSet allocate(const Device& device, const DescriptorSetLayout& layout, const bool transient = false);
+
+            //------------------------------------------------------------------------
+            /// \brief  Get persistent set with this content: set is allocated and updated only when content is unknown.
+            /// Set is followed by written buffers: it is evicted when one of them changes its handle or is released.
+            ///
+            /// \param[in] device: device of pools.
+            /// \param[in] layout: layout of set.
+            /// \param[in] writes: content of set.
+            /// \returns Set with content.
+            /// \throw Core::Exception when allocation fails.
+            VkDescriptorSet getCached(const Device& device, const DescriptorSetLayout& layout, std::vector<WriteDescriptorSet>& writes);
+
+            //------------------------------------------------------------------------
+            /// \brief  Select transient pools of frame slot and release their sets (GPU must have finished this slot).
+            /// Evicted cached sets which are not used anymore by frames in flight can be reused by getCached().
+            ///
+            /// \param[in] device: device of pools.
+            /// \param[in] frameID: slot of frame in flight.
+            void beginFrame(const Device& device, const uint32_t frameID);
+
+            //------------------------------------------------------------------------
+            /// \brief  Release transient sets of all frames (GPU must be idle).
+            ///
+            /// \param[in] device: device of pools.
+            void resetTransient(const Device& device);
+
+            //------------------------------------------------------------------------
+            /// \brief  Release all persistent sets (cached sets and sets of allocate(), like DescriptorSet ones) and clear cache.
+            ///
+            /// \param[in] device: device of pools.
+            void clearCache(const Device& device);
+
+            const Statistics& getStatistics() const
+            {
+                return _statistics;
+            }
+
+        private:
+            /// Pools of one layout.
+            struct Pools
+            {
+                std::vector<DescriptorPoolUPtr> _pools;         ///< Pools by creation order (last one is biggest).
+                size_t                          _current = 0;   ///< First pool which can have free sets.
+            };
+
+            /// Pools by layout for each lifetime.
+            struct LayoutPools
+            {
+                Pools                        _persistent;
+                std::vector<Pools>           _transient;     ///< Pools by frame slot.
+                std::vector<VkDescriptorSet> _recycled;      ///< Evicted persistent sets not used anymore by GPU.
+            };
+
+            using CacheKey = std::vector<uint64_t>;
+
+            struct CacheKeyHasher
+            {
+                size_t operator()(const CacheKey& key) const;
+            };
+
+            /// Cached set and buffers written into it.
+            struct CacheEntry
+            {
+                VkDescriptorSet             _set;
+                VkDescriptorSetLayout       _layout;
+                std::vector<const Buffer*>  _buffers;
+            };
+
+            /// Cached set removed from cache: it can be used by frames in flight.
+            struct EvictedSet
+            {
+                VkDescriptorSet             _set;
+                VkDescriptorSetLayout       _layout;
+                uint64_t                    _frame;     ///< Frame of eviction.
+            };
+
+            VkDescriptorSet allocate(const Device& device, const DescriptorSetLayout& layout, Pools& pools);
+
+            void reset(const Device& device, Pools& pools);
+
+            void onBufferChanged(Buffer& buffer);
+
+            void disconnectBuffers();
+
+            std::unordered_map<VkDescriptorSetLayout, LayoutPools>                _layouts;       ///< Pools by layout.
+            std::unordered_map<CacheKey, CacheEntry, CacheKeyHasher>               _cache;         ///< Persistent sets by content.
+            std::vector<BufferWPtr>                                                 _buffers;       ///< Buffers of cached sets (connected to their signals).
+            std::deque<EvictedSet>                                                  _evicted;       ///< Evicted sets by frame order.
+            CacheKey                                                                _key;           ///< Buffer to build key (avoid allocation).
+            uint32_t                                                                _setsByPool;    ///< Size of first pool.
+            uint32_t                                                                _nbFrames;      ///< Frames in flight.
+            uint32_t                                                                _currentFrame;  ///< Slot of transient pools.
+            uint64_t                                                                _frame;         ///< Number of started frames.
+            Statistics                                                              _statistics;
+    };
+}
@@ -12,6 +12,7 @@ namespace Vulkan
     using BufferWPtr = std::weak_ptr<Buffer>;
 
     class Device;
+    class DescriptorAllocator;
 
     class Sampler;
     using SamplerWPtr = std::weak_ptr<Sampler>;
@@ -34,10 +35,17 @@ namespace Vulkan
                 MouCa::assertion(isNull());
             }
 
-            void initialize(const Device& device, const std::vector<VkDescriptorPoolSize>& poolSizes, const uint32_t maxSets);
+            void initialize(const Device& device, const std::vector<VkDescriptorPoolSize>& poolSizes, const uint32_t maxSets,
+                            const VkDescriptorPoolCreateFlags flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT);
 
             void release(const Device& device);
 
+            //------------------------------------------------------------------------
+            /// \brief  Return all descriptor sets to pool (sets allocated from pool become invalid).
+            ///
+            /// \param[in] device: device of pool.
+            void reset(const Device& device) const;
+
             const VkDescriptorPool& getInstance() const
             {
                 return _pool;
@@ -83,6 +91,11 @@ namespace Vulkan
                 return _layout;
             }
 
+            const std::vector<VkDescriptorSetLayoutBinding>& getBindings() const
+            {
+                return _bindings;
+            }
+
             bool isNull() const
             {
                 return _layout == VK_NULL_HANDLE;
@@ -126,6 +139,18 @@ namespace Vulkan
 
             VkWriteDescriptorSet compute(const DescriptorSet& set, const uint32_t setId);
 
+            //------------------------------------------------------------------------
+            /// \brief  Resolve linked objects and build write for one descriptor set.
+            ///
+            /// \param[in] dstSet: set to update (can be VK_NULL_HANDLE to read content only).
+            /// \returns Write structure (arrays are owned by this object until next compute).
+            VkWriteDescriptorSet compute(const VkDescriptorSet dstSet);
+
+            const DescriptorBufferInfos& getBufferInfos() const
+            {
+                return _bufferInfo;
+            }
+
         private:
             const uint32_t                         _dstBinding;
             const VkDescriptorType                 _type;
@@ -154,6 +179,15 @@ namespace Vulkan
 
             void initialize(const Device& device, const DescriptorPoolWPtr& descriptorPool, const std::vector<VkDescriptorSetLayout>& layouts);
 
+            //------------------------------------------------------------------------
+            /// \brief  Allocate persistent sets from pools of allocator (pools grow with needs).
+            ///
+            /// \param[in] device: device of pools.
+            /// \param[in] allocator: owner of sets (they are released with its pools).
+            /// \param[in] layouts: layout of each set.
+            /// \throw Core::Exception when allocation fails.
+            void initialize(const Device& device, DescriptorAllocator& allocator, const std::vector<const DescriptorSetLayout*>& layouts);
+
             void release(const Device& device);
 
             const std::vector<VkDescriptorSet>& getDescriptorSets() const
@@ -172,16 +206,45 @@ namespace Vulkan
                 return _descriptors.empty();
             }
 
+            //------------------------------------------------------------------------
+            /// \brief  Write content of set: set follows handle changes of written buffers (see isDirty()).
+            ///
+            /// \param[in] device: device of set.
+            /// \param[in] setId: index of set.
+            /// \param[in] writeDescriptor: content of set.
             void update(const Device& device, const uint32_t setId, std::vector<WriteDescriptorSet>&& writeDescriptor);
 
             void update(const Device& device);
 
+            //------------------------------------------------------------------------
+            /// \brief  Check if one written buffer changed its handle (Buffer::reserve()/resize()): set must be written again.
+            ///
+            /// \returns True when refresh() is needed.
+            bool isDirty() const
+            {
+                return _dirty;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Write again dirty set with current handles (GPU must not use set: command buffers binding it must be recorded again).
+            ///
+            /// \param[in] device: device of set.
+            /// \returns True when set was written.
+            bool refresh(const Device& device);
+
         private:
+            void onBufferChanged(Buffer& buffer);
+
+            void disconnectBuffers();
+
             uint32_t                        _setId;
             std::vector<WriteDescriptorSet> _writeDescriptor;
+            std::vector<BufferWPtr>         _buffers;           ///< Written buffers (connected to their handle changed signal).
+            bool                            _dirty = false;     ///< One written buffer changed its handle.
 
             std::vector<VkDescriptorSet> _descriptors;
             DescriptorPoolWPtr           _pool;
+            DescriptorAllocator*         _allocator = nullptr;   ///< [LINK] Owner of sets (otherwise _pool).
     };
 
     
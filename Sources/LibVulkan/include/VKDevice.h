@@ -30,6 +30,9 @@ namespace Vulkan
         }
     };
 
+    /// Accepted types of physical device by order of preference.
+    using PhysicalDeviceTypes = std::vector<VkPhysicalDeviceType>;
+
     //----------------------------------------------------------------------------
     /// \brief Allow to sort device candidate inside Device::initializeBestGPU.
     struct DeviceCandidate
@@ -41,11 +44,17 @@ namespace Vulkan
         // Criterion
         VkPhysicalDeviceProperties  properties;
         VkPhysicalDeviceFeatures    features;
+        size_t                      typeRank;       ///< Preference of device type (lower is better).
 
         struct Less
         {
             bool operator()(const DeviceCandidate& ref, const DeviceCandidate& compare) const
             {
+                if(ref.typeRank != compare.typeRank)
+                {
+                    return ref.typeRank < compare.typeRank;
+                }
+
                 int score = 0;
                 int scoreOther = 0;
 
@@ -82,8 +91,9 @@ namespace Vulkan
             VkPhysicalDevice                                 _physicalDevice;        ///< Physical device ID.
             VkPhysicalDeviceMemoryProperties                 _memoryProperties;      ///< Memory properties of physical device.
             VkPhysicalDeviceProperties                       _properties;            ///< Properties of physical device.
-            VkPhysicalDeviceRayTracingPipelinePropertiesKHR  _rayTracingPipelineProperties;
-            VkPhysicalDeviceAccelerationStructureFeaturesKHR _accelerationStructureFeatures;
+            VkPhysicalDeviceRayTracingPipelinePropertiesKHR    _rayTracingPipelineProperties;
+            VkPhysicalDeviceAccelerationStructurePropertiesKHR _accelerationStructureProperties;
+            VkPhysicalDeviceAccelerationStructureFeaturesKHR   _accelerationStructureFeatures;
 
             PhysicalDeviceFeatures                           _enabled;
 
@@ -91,6 +101,9 @@ namespace Vulkan
 
             VkDevice    _device;                                            ///< Device handle.
             VkQueue     _queueGraphic;                                      ///< Id of graphic queue (improve using list ?).
+            VkQueue     _queueCompute;                                      ///< Id of compute queue (can be graphic queue).
+            VkQueue     _queueTransfer;                                     ///< Id of transfer queue (can be graphic queue).
+            VkBool32    _timelineSemaphore;                                 ///< Timeline semaphores are enabled.
 
             VkFormat    _colorFormat;                                       ///< Best image color format of device.
             VkFormat    _depthFormat;                                       ///< Best depth buffer format of device.
@@ -113,6 +126,14 @@ namespace Vulkan
             void configureDevice(const VkPhysicalDevice physicalDevice, const VkDevice deviceID, const uint32_t queueFamilyID);
 
         public:
+            /// Queue to submit work.
+            enum class QueueType : uint8_t
+            {
+                Graphic,
+                Compute,
+                Transfer
+            };
+
             /// Constructor
             Device();
             /// Destructor
@@ -120,7 +141,17 @@ namespace Vulkan
 
             void initialize(const VkPhysicalDevice physicalDevice, const uint32_t queueFamilyID, const std::vector<const char*>& extensions = std::vector<const char*>());
 
-            void initializeBestGPU(const Environment& environment, const std::vector<const char*>& extensions = std::vector<const char*>(), const Surface* surface=nullptr, const PhysicalDeviceFeatures& enabled = PhysicalDeviceFeatures());
+            //------------------------------------------------------------------------
+            /// \brief  Create device on best physical device supporting extensions, surface and features.
+            ///
+            /// \param[in] environment: Vulkan instance.
+            /// \param[in] extensions: mandatory device extensions.
+            /// \param[in] surface: surface to present (can be nullptr).
+            /// \param[in] enabled: mandatory features.
+            /// \param[in] deviceTypes: accepted types by order of preference (add VK_PHYSICAL_DEVICE_TYPE_CPU to accept software driver like lavapipe).
+            /// \throw Core::Exception when no physical device matches.
+            void initializeBestGPU(const Environment& environment, const std::vector<const char*>& extensions = std::vector<const char*>(), const Surface* surface=nullptr, const PhysicalDeviceFeatures& enabled = PhysicalDeviceFeatures(),
+                                   const PhysicalDeviceTypes& deviceTypes = { VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU });
             
             void release();
 
@@ -151,6 +182,12 @@ namespace Vulkan
                 return _rayTracingPipelineProperties;
             }
 
+            const VkPhysicalDeviceAccelerationStructurePropertiesKHR& getPhysicalDeviceAccelerationStructureProperties() const
+            {
+                MouCa::preCondition(!isNull());
+                return _accelerationStructureProperties;
+            }
+
             const VkPhysicalDeviceAccelerationStructureFeaturesKHR& getPhysicalDeviceAccelerationStructureFeatures() const
             {
                 MouCa::preCondition(!isNull());
@@ -187,6 +224,23 @@ namespace Vulkan
                 return _queueGraphic;
             }
 
+            const VkQueue& getQueue(const QueueType type) const
+            {
+                switch (type)
+                {
+                    case QueueType::Compute:  return _queueCompute;
+                    case QueueType::Transfer: return _queueTransfer;
+                    default:                  return _queueGraphic;
+                }
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Check if timeline semaphores (VK_KHR_timeline_semaphore, core 1.2) are enabled.
+            bool isTimelineSemaphoreEnabled() const
+            {
+                return _timelineSemaphore == VK_TRUE;
+            }
+
             VkFormat getColorFormat() const
             {
                 return _colorFormat;
@@ -220,9 +274,12 @@ namespace Vulkan
             PFN_vkGetAccelerationStructureDeviceAddressKHR  vkGetAccelerationStructureDeviceAddressKHR;
             PFN_vkBuildAccelerationStructuresKHR            vkBuildAccelerationStructuresKHR;
             PFN_vkCmdBuildAccelerationStructuresKHR         vkCmdBuildAccelerationStructuresKHR;
+            PFN_vkCmdCopyAccelerationStructureKHR           vkCmdCopyAccelerationStructureKHR;
+            PFN_vkCmdWriteAccelerationStructuresPropertiesKHR vkCmdWriteAccelerationStructuresPropertiesKHR;
             PFN_vkCmdTraceRaysKHR                           vkCmdTraceRaysKHR;
             PFN_vkGetRayTracingShaderGroupHandlesKHR        vkGetRayTracingShaderGroupHandlesKHR;
             PFN_vkCreateRayTracingPipelinesKHR              vkCreateRayTracingPipelinesKHR;
+            PFN_vkCmdDrawIndexedIndirectCountKHR            vkCmdDrawIndexedIndirectCountKHR;
 
             void executeCommandSync(std::vector<ICommandBufferWPtr>&& commands) const;
     };
@@ -0,0 +1,158 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+#include <LibVulkan/include/VKCommandPool.h>
+#include <LibVulkan/include/VKFence.h>
+#include <LibVulkan/include/VKSemaphore.h>
+
+namespace Vulkan
+{
+    class Device;
+
+    //----------------------------------------------------------------------------
+    /// \brief Ring of frames in flight: each frame owns its fence, semaphores and command pool.
+    /// CPU waits only the fence of the frame which reuses the slot (N frames before), never the whole device.
+    /// \code{.cpp}
+    ///     ring.beginFrame(device);                            // Wait + reset fence/pool of slot (before acquire: semaphores of slot are free)
+    ///     vkAcquireNextImageKHR(..., ring.getAcquireSemaphore().getInstance(), ...);
+    ///     vkQueueSubmit(..., ring.getFence().getInstance());  // Last submit of frame signals slot fence (wait acquire, signal render)
+    ///     ring.setSubmitted();
+    ///     ring.wait(device);                                  // Replace waitIdle() (resize, screenshot, ...)
+    /// \endcode
+    /// \note When frame is not submitted (acquire failure, ...), its fence is signaled by an empty submit at next beginFrame()/wait().
+    class FrameRing final
+    {
+        MOUCA_NOCOPY_NOMOVE(FrameRing);
+
+        public:
+            /// Semaphores of frame.
+            enum class SemaphoreType : uint8_t
+            {
+                Acquire,    ///< Swapchain image is acquired.
+                Render      ///< Rendering is finished (wait by present).
+            };
+
+            FrameRing();
+
+            ~FrameRing()
+            {
+                MouCa::assertion(isNull()); // DEV Issue: call release()
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Create all objects of each frame (fences are signaled).
+            ///
+            /// \param[in] device: device of objects.
+            /// \param[in] nbFrames: number of frames which can be executed by GPU at same time.
+            /// \param[in] queueFamilyID: queue family of command pools.
+            /// \throw Core::Exception when one object can't be created.
+            void initialize(const Device& device, const uint32_t nbFrames, const uint32_t queueFamilyID);
+
+            void release(const Device& device);
+
+            bool isNull() const
+            {
+                return _frames.empty();
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Start next frame: wait GPU finished previous frame of same slot, then reset its fence and command pool.
+            ///
+            /// \param[in] device: device of objects.
+            /// \param[in] timeout: maximum time to wait fence (in nanosecond).
+            /// \returns VK_SUCCESS or result of vkWaitForFences (VK_TIMEOUT, ...): in this case, frame is not started.
+            VkResult beginFrame(const Device& device, const uint64_t timeout = Fence::infinityTimeout);
+
+            //------------------------------------------------------------------------
+            /// \brief  Wait all frames in flight.
+            ///
+            /// \param[in] device: device of objects.
+            /// \param[in] timeout: maximum time to wait fences (in nanosecond).
+            /// \returns Result of vkWaitForFences.
+            VkResult wait(const Device& device, const uint64_t timeout = Fence::infinityTimeout) const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Notify fence of current frame is submitted to queue.
+            void setSubmitted()
+            {
+                _submitted = true;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Check if at least one frame was started (so fences follow GPU work).
+            bool isRunning() const
+            {
+                return _frame > 0;
+            }
+
+            uint32_t getNbFrames() const
+            {
+                return static_cast<uint32_t>(_frames.size());
+            }
+
+            /// Slot of current frame.
+            uint32_t getCurrent() const
+            {
+                return _current;
+            }
+
+            /// Number of started frames.
+            uint64_t getFrame() const
+            {
+                return _frame;
+            }
+
+            const Fence& getFence() const
+            {
+                MouCa::preCondition(!isNull());
+                return _frames[_current]->_fence;
+            }
+
+            /// Semaphore to signal when swapchain image is acquired.
+            const Semaphore& getAcquireSemaphore() const
+            {
+                MouCa::preCondition(!isNull());
+                return _frames[_current]->_acquire;
+            }
+
+            /// Semaphore to signal when rendering is finished (wait by present).
+            const Semaphore& getRenderSemaphore() const
+            {
+                MouCa::preCondition(!isNull());
+                return _frames[_current]->_render;
+            }
+
+            const Semaphore& getSemaphore(const SemaphoreType type) const
+            {
+                return type == SemaphoreType::Acquire ? getAcquireSemaphore() : getRenderSemaphore();
+            }
+
+            /// Pool of command buffers recorded every frame: reset by beginFrame().
+            const CommandPool& getCommandPool() const
+            {
+                MouCa::preCondition(!isNull());
+                return _frames[_current]->_commandPool;
+            }
+
+        private:
+            /// Signal fence of current frame when nothing was submitted.
+            void close(const Device& device) const;
+
+            /// Objects used by one frame.
+            struct Frame
+            {
+                Fence       _fence;
+                Semaphore   _acquire;
+                Semaphore   _render;
+                CommandPool _commandPool;
+            };
+
+            std::vector<std::unique_ptr<Frame>> _frames;    ///< Frames by slot.
+            std::vector<VkFence>                _fences;    ///< Fences of all slots (wait all).
+            uint32_t                            _current;   ///< Slot of current frame.
+            uint64_t                            _frame;     ///< Number of started frames.
+            mutable bool                        _submitted; ///< Fence of current frame is submitted.
+    };
+}
@@ -9,6 +9,7 @@
 
 namespace Vulkan
 {
+    class DeferredRelease;
     class Device;
     class RenderPass;
     using RenderPassWPtr = std::weak_ptr<RenderPass>;
@@ -37,6 +38,15 @@ namespace Vulkan
             void initialize(const Device& device, RenderPassWPtr renderPass, PipelineLayoutWPtr layout, PipelineCacheWPtr pipelineCache);
             void release(const Device& device);
 
+            //------------------------------------------------------------------------
+            /// \brief  Create new pipeline with current shader modules alongside old one, then swap them.
+            /// Old pipeline is released when frames in flight are finished: commands binding pipeline detect new handle.
+            ///
+            /// \param[in] device: device of pipeline.
+            /// \param[in] deferred: list where old pipeline is released.
+            /// \throw Core::Exception when new pipeline can't be created (old pipeline is kept).
+            void rebuild(const Device& device, DeferredRelease& deferred);
+
             PipelineStateCreateInfo&        getInfo()       { return _infos; }
             const PipelineStateCreateInfo&  getInfo() const { return _infos; }
 
@@ -45,6 +55,8 @@ namespace Vulkan
             PipelineCacheWPtr    getPipelineCache() const   { return _pipelineCache; }
 
         private:
+            VkPipeline create(const Device& device) const;
+
             RenderPassWPtr          _renderPass;
             PipelineLayoutWPtr      _layout;
             PipelineCacheWPtr       _pipelineCache;
@@ -78,6 +78,15 @@ namespace Vulkan
             ~MemoryBuffer() override = default;
 
             void initialize(const Device& device, const VkBuffer& buffer);
+
+            //------------------------------------------------------------------------
+            /// \brief  Create empty memory with same properties (used to reallocate buffer).
+            ///
+            /// \returns New memory (not initialized).
+            virtual std::unique_ptr<MemoryBuffer> createEmpty() const
+            {
+                return std::make_unique<MemoryBuffer>(_memoryPropertyFlags);
+            }
     };
 
     using MemoryBufferUPtr = std::unique_ptr<MemoryBuffer>;
@@ -94,6 +103,11 @@ namespace Vulkan
 
             const void* getNext() const override { return &_flagInfo; }
 
+            std::unique_ptr<MemoryBuffer> createEmpty() const override
+            {
+                return std::make_unique<MemoryBufferAllocate>(_memoryPropertyFlags, _flagInfo.flags);
+            }
+
         private:
             VkMemoryAllocateFlagsInfo _flagInfo;
     };
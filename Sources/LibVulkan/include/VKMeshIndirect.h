@@ -0,0 +1,160 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#pragma once
+
+#include <LibVulkan/include/VKDescriptorSet.h>
+#include <LibVulkan/include/VKPipelineLayout.h>
+
+namespace RT
+{
+    class BasicMassiveInstance;
+    class BoundingBox;
+    class Frustum;
+}
+
+namespace Vulkan
+{
+    class Buffer;
+    using BufferSPtr = std::shared_ptr<Buffer>;
+
+    class Command;
+    using CommandUPtr = std::unique_ptr<Command>;
+    using Commands    = std::vector<CommandUPtr>;
+
+    class ComputePipeline;
+    using ComputePipelineSPtr = std::shared_ptr<ComputePipeline>;
+
+    class Device;
+
+    using PipelineLayoutSPtr = std::shared_ptr<PipelineLayout>;
+
+    class ShaderModule;
+    using ShaderModuleWPtr = std::weak_ptr<ShaderModule>;
+
+    //----------------------------------------------------------------------------
+    /// \brief GPU-driven draws of massive instances: compute pass culls instances (frustum) and writes
+    /// compacted visible instances + draw commands + draw count, consumed by vkCmdDrawIndexedIndirectCount.
+    /// CPU uploads instances only when they change: visibility changes don't need any CPU work.
+    /// \code{.cpp}
+    ///     meshIndirect.initialize(device, cullingShader, maxMeshes, maxInstances);  // culling.comp
+    ///     meshIndirect.update(device, massive, boxes);                              // When instances change
+    ///     meshIndirect.setFrustum(device, frustum);                                 // Each frame
+    ///     meshIndirect.makeCullingCommands(commands);                               // Outside render pass
+    ///     meshIndirect.makeDrawCommands(device, commands, 1);                       // Inside render pass (after bind of VBO/IBO)
+    /// \endcode
+    /// \note Device needs VK_KHR_draw_indirect_count extension. Meshes share same VBO/IBO (indirect index base).
+    /// \note Host buffers (parameters, instances) must not be updated while GPU uses them (see FrameRing).
+    class MeshIndirect final
+    {
+        MOUCA_NOCOPY_NOMOVE(MeshIndirect);
+
+        public:
+            /// Instance data read by culling and vertex shaders (std430).
+            struct Instance
+            {
+                RT::Point3  _position;
+                uint32_t    _meshID;
+                RT::Point4  _quaternion;
+                RT::Point3  _scale;
+                float       _padding;
+            };
+
+            /// Mesh data used by culling (std430).
+            struct Mesh
+            {
+                RT::Point4  _sphere;            ///< Local bounding sphere: center + radius.
+                uint32_t    _indexCount;
+                uint32_t    _firstIndex;
+                int32_t     _vertexOffset;
+                uint32_t    _firstInstance;     ///< First slot of mesh into visible instances.
+            };
+
+            /// Parameters of culling (std140).
+            struct Parameters
+            {
+                std::array<RT::Point4, 6> _planes;
+                uint32_t                  _nbInstances;
+                uint32_t                  _nbMeshes;
+                uint32_t                  _padding[2];
+            };
+
+            MeshIndirect();
+            ~MeshIndirect();
+
+            //------------------------------------------------------------------------
+            /// \brief  Create buffers and culling pipeline.
+            ///
+            /// \param[in] device: device of objects.
+            /// \param[in] culling: compute shader of culling (culling.comp).
+            /// \param[in] maxMeshes: maximum number of meshes (indirects).
+            /// \param[in] maxInstances: maximum number of instances.
+            /// \throw Core::Exception when one object can't be created.
+            void initialize(const Device& device, const ShaderModuleWPtr& culling, const uint32_t maxMeshes, const uint32_t maxInstances);
+
+            void release(const Device& device);
+
+            bool isNull() const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Upload instances and meshes of massive instance.
+            ///
+            /// \param[in] device: device of objects.
+            /// \param[in] massive: instances grouped by indirect (one indirect by mesh).
+            /// \param[in] boxes: local bounding box of mesh of each indirect.
+            void update(const Device& device, const RT::BasicMassiveInstance& massive, const std::vector<RT::BoundingBox>& boxes);
+
+            //------------------------------------------------------------------------
+            /// \brief  Upload frustum used by next culling: command buffers don't need to be recorded again.
+            ///
+            /// \param[in] device: device of objects.
+            /// \param[in] frustum: frustum in same space than instances.
+            void setFrustum(const Device& device, const RT::Frustum& frustum);
+
+            //------------------------------------------------------------------------
+            /// \brief  Append compute commands of culling (must be outside of render pass).
+            ///
+            /// \param[in,out] commands: list of commands to fill.
+            void makeCullingCommands(Commands& commands) const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Append draw commands of visible instances (VBO/IBO of meshes must be bound by caller).
+            ///
+            /// \param[in] device: device of objects.
+            /// \param[in,out] commands: list of commands to fill.
+            /// \param[in] instanceBinding: vertex binding of instance data (VK_VERTEX_INPUT_RATE_INSTANCE).
+            void makeDrawCommands(const Device& device, Commands& commands, const uint32_t instanceBinding) const;
+
+            /// Visible instances grouped by mesh (Instance).
+            const BufferSPtr& getVisibles() const { return _visibles; }
+
+            /// Compacted draw commands (VkDrawIndexedIndirectCommand).
+            const BufferSPtr& getDrawCommands() const { return _commands; }
+
+            /// Number of draw commands (uint32_t).
+            const BufferSPtr& getDrawCount() const { return _count; }
+
+            uint32_t getMaxMeshes() const { return _maxMeshes; }
+
+        private:
+            static constexpr uint32_t _groupSize = 64;                      ///< local_size_x of culling shader.
+            static constexpr std::array<uint32_t, 3> _passes = { 0, 1, 2 }; ///< Push constant of each pass.
+
+            PipelineLayoutSPtr  _pipelineLayout;
+            DescriptorSetLayout _descriptorSetLayout;
+            DescriptorPoolSPtr  _descriptorPool;
+            DescriptorSet       _descriptorSet;
+            ComputePipelineSPtr _pipeline;
+
+            BufferSPtr          _parameters;    ///< Parameters (host).
+            BufferSPtr          _instances;     ///< All instances (host).
+            BufferSPtr          _meshes;        ///< Mesh data (host).
+            BufferSPtr          _draws;         ///< Draw of each mesh (GPU only).
+            BufferSPtr          _visibles;      ///< Visible instances (GPU only).
+            BufferSPtr          _commands;      ///< Compacted draws (GPU only).
+            BufferSPtr          _count;         ///< Number of compacted draws (GPU only).
+
+            uint32_t            _maxMeshes;
+            uint32_t            _maxInstances;
+    };
+}
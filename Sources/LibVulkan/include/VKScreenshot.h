@@ -41,6 +41,14 @@ namespace Vulkan
         void extractTo(const VkImage& srcImage, const ContextDevice& context, const RT::Array3ui& positionSrc, const RT::Array3ui& positionDst, const RT::Array3ui& size, RT::BufferCPU& output);
         void extractTo(const VkImage& srcImage, const ContextWindow& context, const RT::Array3ui& positionSrc, const RT::Array3ui& positionDst, const RT::Array3ui& size, RT::Image& diskImage);
 
+        /// Extract image and encode directly from mapped memory (no CPU copy, no flip pass).
+        /// \param[in] filename: PNG or EXR file (see RT::ImageLinkedCPU::saveImage).
+        void saveTo(const VkImage& srcImage, const ContextWindow& context, const RT::Array3ui& positionSrc, const RT::Array3ui& size, const Core::Path& filename);
+
+        /// Encode latest extracted image directly from mapped memory (see saveTo).
+        /// \param[in] filename: PNG or EXR file (see RT::ImageLinkedCPU::saveImage).
+        void save(const ContextWindow& context, const RT::Array3ui& size, const Core::Path& filename);
+
     protected:
         void extractTo(const VkImage& srcImage, const ContextDevice& context, const RT::Array3ui& positionSrc, const RT::Array3ui& positionDst, const RT::Array3ui& sizes);
 
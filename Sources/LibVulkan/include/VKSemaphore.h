@@ -7,6 +7,15 @@ namespace Vulkan
 {
     class Device;
  
+    //----------------------------------------------------------------------------
+    /// \brief Binary or timeline semaphore.
+    /// Timeline semaphore keeps value of latest scheduled signal: submissions can signal next value and wait latest one
+    /// without host synchronization (see SubmitInfo).
+    /// \code{.cpp}
+    ///     semaphore.initialize(device, VK_SEMAPHORE_TYPE_TIMELINE, 0);
+    ///     const uint64_t value = semaphore.scheduleSignal();     // Value signaled by next submission
+    ///     semaphore.wait(device, value, timeout);                 // Host waits only this point
+    /// \endcode
     class Semaphore
     {
         MOUCA_NOCOPY(Semaphore);
@@ -16,8 +25,72 @@ namespace Vulkan
             ~Semaphore();
 
             void initialize(const Device& device);
+
+            //------------------------------------------------------------------------
+            /// \brief  Create semaphore.
+            ///
+            /// \param[in] device: device of semaphore (timeline semaphore must be enabled for timeline type).
+            /// \param[in] type: binary or timeline semaphore.
+            /// \param[in] initialValue: first value of timeline.
+            /// \throw Core::Exception when creation fails.
+            void initialize(const Device& device, const VkSemaphoreType type, const uint64_t initialValue);
+
             void release(const Device& device);
 
+            bool isTimeline() const
+            {
+                return _type == VK_SEMAPHORE_TYPE_TIMELINE;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Reserve next value of timeline: it must be signaled by next submission (or by host).
+            ///
+            /// \returns New value.
+            uint64_t scheduleSignal()
+            {
+                MouCa::preCondition(isTimeline());
+                return ++_scheduledValue;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Register value signaled explicitly (keep latest scheduled value).
+            ///
+            /// \param[in] value: value signaled by submission.
+            void scheduleSignal(const uint64_t value)
+            {
+                MouCa::preCondition(isTimeline());
+                _scheduledValue = std::max(_scheduledValue, value);
+            }
+
+            /// Latest value which is/will be signaled by scheduled submissions.
+            uint64_t getScheduledValue() const
+            {
+                return _scheduledValue;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Read current value of timeline on GPU.
+            ///
+            /// \param[in] device: device of semaphore.
+            /// \returns Current value.
+            uint64_t getValue(const Device& device) const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Wait on host until timeline reaches value.
+            ///
+            /// \param[in] device: device of semaphore.
+            /// \param[in] value: value to wait.
+            /// \param[in] timeout: maximum time to wait (in nanosecond).
+            /// \returns VK_SUCCESS or VK_TIMEOUT.
+            VkResult wait(const Device& device, const uint64_t value, const uint64_t timeout) const;
+
+            //------------------------------------------------------------------------
+            /// \brief  Signal value of timeline from host.
+            ///
+            /// \param[in] device: device of semaphore.
+            /// \param[in] value: new value (greater than current one).
+            void signal(const Device& device, const uint64_t value);
+
             const VkSemaphore& getInstance() const
             {
                 return _semaphore;
@@ -29,7 +102,9 @@ namespace Vulkan
             }
 
         private:
-            VkSemaphore _semaphore;
+            VkSemaphore     _semaphore;
+            VkSemaphoreType _type;
+            uint64_t        _scheduledValue;    ///< Latest value scheduled to signal (timeline only).
     };
 
     using SemaphoreSPtr = std::shared_ptr<Semaphore>;
@@ -3,9 +3,13 @@
 /// \license No license
 #pragma once
 
+#include <LibVulkan/include/VKDevice.h>
+
 namespace Vulkan
 {
-    class Device;
+
+    class ContextDevice;
+    using ContextDeviceWPtr = std::weak_ptr<ContextDevice>;
 
     class ContextWindow; 
     using ContextWindowWPtr = std::weak_ptr<ContextWindow>;
@@ -13,6 +17,8 @@ namespace Vulkan
     class Fence;
     using FenceWPtr = std::weak_ptr<Fence>;
 
+    class FrameRing;
+
     class Semaphore;
     using SemaphoreWPtr = std::weak_ptr<Semaphore>;
 
@@ -44,6 +50,15 @@ namespace Vulkan
     {
         public:
             SequenceAcquire(SwapChainWPtr swapChain, SemaphoreWPtr semaphore, FenceWPtr fence, const uint64_t timeout);
+
+            //------------------------------------------------------------------------
+            /// \brief  Constructor: acquire signals semaphore of current frame in flight (frame must be started before).
+            ///
+            /// \param[in] swapChain: swapchain where image is acquired.
+            /// \param[in] frameRing: frames in flight of device.
+            /// \param[in] fence: optional fence to signal.
+            /// \param[in] timeout: maximum time to wait image (in nanosecond).
+            SequenceAcquire(SwapChainWPtr swapChain, const FrameRing& frameRing, FenceWPtr fence, const uint64_t timeout);
             ~SequenceAcquire() override = default;
 
             VkResult execute(const Device& device) override;
@@ -51,11 +66,30 @@ namespace Vulkan
             void update() override {}
 
         private:
-            SwapChainWPtr _swapChain;
+            SwapChainWPtr    _swapChain;
+
+            VkFence          _fence;
+            VkSemaphore      _semaphore;
+            const FrameRing* _frameRing;    ///< [LINK] When defined, acquire semaphore of current frame is used.
+            uint64_t         _timeout;
+    };
+
+    //----------------------------------------------------------------------------
+    /// \brief Start next frame in flight of device: replace waitFence/resetFence pair of each frame.
+    /// \note Last submit of frame must use fence of frame (see SequenceSubmit).
+    class SequenceBeginFrame : public Sequence
+    {
+        public:
+            SequenceBeginFrame(ContextDeviceWPtr context, const uint64_t timeout);
+            ~SequenceBeginFrame() override = default;
+
+            VkResult execute(const Device& device) override;
+
+            void update() override {}
 
-            VkFence       _fence;
-            VkSemaphore   _semaphore;
-            uint64_t      _timeout;
+        private:
+            ContextDeviceWPtr _context;
+            uint64_t          _timeout;
     };
 
     class SequenceWaitFence : public Sequence
@@ -74,6 +108,32 @@ namespace Vulkan
             VkBool32             _all;
     };
 
+    //----------------------------------------------------------------------------
+    /// \brief Host waits timeline semaphores reach values (instead of waiting fences/device).
+    class SequenceWaitSemaphore : public Sequence
+    {
+        public:
+            //------------------------------------------------------------------------
+            /// \brief  Constructor
+            ///
+            /// \param[in] semaphores: timeline semaphores.
+            /// \param[in] values: value by semaphore (0: latest scheduled signal at execution).
+            /// \param[in] timeout: maximum time to wait (in nanosecond).
+            SequenceWaitSemaphore(const std::vector<SemaphoreWPtr>& semaphores, const std::vector<uint64_t>& values, const uint64_t timeout);
+            ~SequenceWaitSemaphore() override = default;
+
+            VkResult execute(const Device& device) override;
+
+            void update() override {}
+
+        private:
+            std::vector<SemaphoreWPtr>  _semaphores;
+            std::vector<VkSemaphore>    _vkSemaphores;
+            std::vector<uint64_t>       _fixedValues;
+            std::vector<uint64_t>       _values;
+            uint64_t                    _timeout;
+    };
+
     class SequenceResetFence : public Sequence
     {
         public:
@@ -92,7 +152,15 @@ namespace Vulkan
         MOUCA_NOCOPY(SequenceSubmit);
 
         public:
-            SequenceSubmit(SubmitInfos&& submitInfos, FenceWPtr fence);
+            SequenceSubmit(SubmitInfos&& submitInfos, FenceWPtr fence, const Device::QueueType queue = Device::QueueType::Graphic);
+
+            //------------------------------------------------------------------------
+            /// \brief  Constructor: submit signals fence of current frame in flight.
+            ///
+            /// \param[in] submitInfos: data to submit.
+            /// \param[in] frameRing: frames in flight of device.
+            /// \param[in] queue: queue where work is submitted (other queues run concurrently: synchronize them with timeline semaphores).
+            SequenceSubmit(SubmitInfos&& submitInfos, FrameRing& frameRing, const Device::QueueType queue = Device::QueueType::Graphic);
             ~SequenceSubmit() override = default;
 
             VkResult execute(const Device& device) override;
@@ -104,6 +172,8 @@ namespace Vulkan
 
             std::vector<VkSubmitInfo> _vkSubmitInfos;
             VkFence                   _fence;
+            FrameRing*                _frameRing;   ///< [LINK] When defined, fence of current frame is used.
+            Device::QueueType         _queue;
     };
 
     class SequencePresentKHR final : public Sequence
@@ -111,7 +181,13 @@ namespace Vulkan
         MOUCA_NOCOPY(SequencePresentKHR);
 
         public:
-            SequencePresentKHR(const std::vector<SemaphoreWPtr>& semaphores, const std::vector<SwapChainWPtr>& swapChains);
+            //------------------------------------------------------------------------
+            /// \brief  Constructor
+            ///
+            /// \param[in] semaphores: semaphores to wait.
+            /// \param[in] swapChains: swapchains to present.
+            /// \param[in] frameRing: when defined, render semaphore of current frame in flight is waited too.
+            SequencePresentKHR(const std::vector<SemaphoreWPtr>& semaphores, const std::vector<SwapChainWPtr>& swapChains, const FrameRing* frameRing = nullptr);
             ~SequencePresentKHR() override;
 
             void registerSwapChain();
@@ -130,6 +206,7 @@ namespace Vulkan
             std::vector<VkSemaphore>    _semaphores;
             std::vector<VkResult>       _result;
             std::vector<VkSwapchainKHR> _swapChainIDs;
+            const FrameRing*            _frameRing;     ///< [LINK] Owner of last wait semaphore (changes each frame).
     };
 
     using SequenceSPtr = std::shared_ptr<Sequence>;
@@ -10,6 +10,7 @@ namespace Core
 
 namespace Vulkan
 {
+    class DeferredRelease;
     class Device;
 
     class ShaderSpecialization
@@ -91,6 +92,15 @@ namespace Vulkan
             void initialize(const Device& device, const Core::String& shaderSourceFile, const std::string& name, const VkShaderStageFlagBits stage);
             void release(const Device& device);
 
+            //------------------------------------------------------------------------
+            /// \brief  Replace module by new SPIR-V code: old module stays valid until frames in flight are finished.
+            ///
+            /// \param[in] device: device of module.
+            /// \param[in] shaderSource: new SPIR-V code.
+            /// \param[in] deferred: list where old module is released.
+            /// \throw Core::Exception when new module can't be created (old module is kept).
+            void rebuild(const Device& device, const Core::String& shaderSource, DeferredRelease& deferred);
+
             bool isNull() const
             {
                 return _shaderModule == VK_NULL_HANDLE;
@@ -101,6 +111,8 @@ namespace Vulkan
             const std::string&    getName() const       { return _name;  }
 
         private:
+            static VkShaderModule create(const Device& device, const Core::String& shaderSource);
+
             VkShaderModule          _shaderModule;         ///< Vulkan Shader instance.
             std::string             _name;
             VkShaderStageFlagBits   _stage;
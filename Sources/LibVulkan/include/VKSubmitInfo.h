@@ -3,6 +3,8 @@
 /// \license No license
 #pragma once
 
+#include <LibVulkan/include/VKFrameRing.h>
+
 namespace Vulkan
 {
     // Forward declaration
@@ -18,7 +20,12 @@ namespace Vulkan
     using SwapChainWPtr = std::weak_ptr<SwapChain>;
 
     using WaitSemaphore = std::pair<SemaphoreWPtr, VkPipelineStageFlags>;
+    using WaitFrameSemaphore = std::pair<FrameRing::SemaphoreType, VkPipelineStageFlags>;
 
+    //----------------------------------------------------------------------------
+    /// \brief Command buffers to submit with their synchronization.
+    /// Timeline semaphores are resolved at each buildSubmitInfo(): value 0 means automatic value
+    /// (wait: latest scheduled signal, signal: next value of timeline).
     class SubmitInfo
     {
         MOUCA_NOCOPY(SubmitInfo);
@@ -28,7 +35,26 @@ namespace Vulkan
             ~SubmitInfo() = default;
 
             void addSynchronization(const std::vector<WaitSemaphore>& waitSemaphore, const std::vector<SemaphoreWPtr>& signalSemaphore);
+
+            //------------------------------------------------------------------------
+            /// \brief  Add semaphores to wait/signal with values of timeline semaphores.
+            ///
+            /// \param[in] waitSemaphore: semaphores to wait with stage.
+            /// \param[in] signalSemaphore: semaphores to signal.
+            /// \param[in] waitValues: value by wait semaphore (0 or empty: automatic, ignored for binary).
+            /// \param[in] signalValues: value by signal semaphore (0 or empty: automatic, ignored for binary).
+            ///                          Fixed value must be greater than scheduled one: submission using it is executed only once.
+            void addSynchronization(const std::vector<WaitSemaphore>& waitSemaphore, const std::vector<SemaphoreWPtr>& signalSemaphore,
+                                    const std::vector<uint64_t>& waitValues, const std::vector<uint64_t>& signalValues);
             
+            //------------------------------------------------------------------------
+            /// \brief  Add binary semaphores of current frame in flight: they change at each frame (call after addSynchronization()).
+            ///
+            /// \param[in] frameRing: frames in flight of device.
+            /// \param[in] waitSemaphore: semaphores of frame to wait with stage.
+            /// \param[in] signalSemaphore: semaphores of frame to signal.
+            void addFrameSynchronization(const FrameRing& frameRing, const std::vector<WaitFrameSemaphore>& waitSemaphore, const std::vector<FrameRing::SemaphoreType>& signalSemaphore);
+
             void initialize(std::vector<ICommandBufferWPtr>&& commandBuffers);
 
             VkSubmitInfo buildSubmitInfo();
@@ -36,10 +62,35 @@ namespace Vulkan
         private:
             std::vector<ICommandBufferWPtr>     _commandBuffers;      ///< [LINK] Automatic system to choose right commandBuffer used by SwapChain.
 
+            /// Timeline semaphore of wait/signal array.
+            struct TimelinePoint
+            {
+                size_t          _index;         ///< Position into semaphores array.
+                SemaphoreWPtr   _semaphore;
+                uint64_t        _value;         ///< Fixed value (0: automatic).
+            };
+
+            /// Semaphore of frame in flight into wait/signal array.
+            struct FramePoint
+            {
+                size_t                      _index;     ///< Position into semaphores array.
+                FrameRing::SemaphoreType    _type;
+            };
+
             std::vector<VkSemaphore>            _waitSemaphore;
             std::vector<VkPipelineStageFlags>   _waitStageFlag;
             std::vector<VkSemaphore>            _signalSemaphore;
             std::vector<VkCommandBuffer>        _commands;
+
+            std::vector<TimelinePoint>          _waitTimelines;
+            std::vector<TimelinePoint>          _signalTimelines;
+            std::vector<uint64_t>               _waitValues;        ///< Values by wait semaphore (0 for binary).
+            std::vector<uint64_t>               _signalValues;      ///< Values by signal semaphore (0 for binary).
+            VkTimelineSemaphoreSubmitInfo       _timelineInfo{};
+
+            const FrameRing*                    _frameRing = nullptr;   ///< [LINK] Owner of frame semaphores.
+            std::vector<FramePoint>             _waitFrames;
+            std::vector<FramePoint>             _signalFrames;
     };
 
     using SubmitInfoSPtr = std::shared_ptr<SubmitInfo>;
@@ -16,8 +16,47 @@
 namespace Vulkan
 {
 
+namespace
+{
+    BufferUPtr createStorage()
+    {
+        return std::make_unique<Buffer>(std::make_unique<MemoryBufferAllocate>(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT));
+    }
+
+    /// Execute commands into temporary command buffer and wait end of GPU execution.
+    void executeSync(const Device& device, Commands&& commands)
+    {
+        auto commandBuffer = std::make_shared<CommandBuffer>();
+        auto pool = std::make_shared<CommandPool>();
+        pool->initialize(device, device.getQueueFamilyGraphicId());
+        commandBuffer->initialize(device, pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 0);
+
+        commandBuffer->addCommands(std::move(commands));
+
+        commandBuffer->execute();
+
+        std::vector<ICommandBufferWPtr> commandBuffers
+        {
+            commandBuffer
+        };
+        device.executeCommandSync(std::move(commandBuffers));
+
+        commandBuffer->release(device);
+        pool->release(device);
+    }
+
+    /// Shared scratch buffer: address is aligned for acceleration structure builds.
+    VkDeviceAddress createScratch(const Device& device, Buffer& scratch, const VkDeviceSize size)
+    {
+        const VkDeviceSize alignment = std::max<VkDeviceSize>(1, device.getPhysicalDeviceAccelerationStructureProperties().minAccelerationStructureScratchOffsetAlignment);
+
+        scratch.initialize(device, 0, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, size + alignment);
+        return Buffer::alignedSize(scratch.getDeviceAddress(device), alignment);
+    }
+}
+
 AccelerationStructure::AccelerationStructure():
-_data(std::make_unique<MemoryBufferAllocate>(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT))
+_data(createStorage())
 {}
 
 void AccelerationStructure::addGeometry(AccelerationStructureGeometryUPtr&& geometry)
@@ -34,20 +73,33 @@ void AccelerationStructure::setCreateInfo(const VkAccelerationStructureCreateFla
     MouCa::postCondition(_type != VK_ACCELERATION_STRUCTURE_TYPE_MAX_ENUM_KHR);
 }
 
+void AccelerationStructure::setBuildFlags(const VkBuildAccelerationStructureFlagsKHR buildFlags)
+{
+    MouCa::preCondition(isNull()); // DEV Issue: sizes are computed with flags by initialize()
+
+    _buildFlags = buildFlags;
+}
+
 void AccelerationStructure::initialize(const Device& device)
 {
     MouCa::preCondition(!device.isNull());
-    MouCa::preCondition(_data.isNull());
+    MouCa::preCondition(_data->isNull());
     MouCa::preCondition(isNull());
     MouCa::preCondition(_type != VK_ACCELERATION_STRUCTURE_TYPE_MAX_ENUM_KHR); // DEV Issue: Missing call setCreateInfo
 
     // Prepare Build Geometry: need valid buffer with data
     buildGeometry(device);
 
-    VkAccelerationStructureBuildSizesInfoKHR buildSizeInfo = _buildGeometry._buildInfo;
+    create(device, _buildGeometry._buildInfo.accelerationStructureSize);
+
+    MouCa::postCondition(!isNull());
+}
+
+void AccelerationStructure::create(const Device& device, const VkDeviceSize size)
+{
     // Buffer and memory
-    _data.initialize(device, 0, VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                     buildSizeInfo.accelerationStructureSize);
+    _data->initialize(device, 0, VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, size);
+    _size = size;
 
     // Acceleration structure
     const VkAccelerationStructureCreateInfoKHR accelerationStructureCreate_info
@@ -55,9 +107,9 @@ void AccelerationStructure::initialize(const Device& device)
         VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR,   // VkStructureType                          sType;
         nullptr,                                                    // const void* pNext;
         _createFlags,                                               // VkAccelerationStructureCreateFlagsKHR    createFlags;
-        _data.getBuffer(),                                          // VkBuffer                                 buffer;
+        _data->getBuffer(),                                         // VkBuffer                                 buffer;
         0,                                                          // VkDeviceSize                             offset;
-        buildSizeInfo.accelerationStructureSize,                    // VkDeviceSize                             size;
+        size,                                                       // VkDeviceSize                             size;
         _type,                                                      // VkAccelerationStructureTypeKHR           type;
         0,                                                          // VkDeviceAddress                          deviceAddress;
     };
@@ -75,19 +127,22 @@ void AccelerationStructure::initialize(const Device& device)
         _handle,                                                          // VkAccelerationStructureKHR    accelerationStructure;
     };
     _deviceAddress = device.vkGetAccelerationStructureDeviceAddressKHR(device.getInstance(), &accelerationDeviceAddressInfo);
-
-    MouCa::postCondition(!isNull());
 }
 
 void AccelerationStructure::release(const Device& device)
 {
     MouCa::preCondition(!isNull());
 
-    _data.release(device);
+    _data->release(device);
+    for (auto& geometry : _geometries)
+    {
+        geometry->release(device);
+    }
 
     device.vkDestroyAccelerationStructureKHR(device.getInstance(), _handle, nullptr);
     _handle        = VK_NULL_HANDLE;
     _deviceAddress = 0;
+    _size          = 0;
     
     MouCa::postCondition(isNull());
 }
@@ -124,7 +179,7 @@ void AccelerationStructure::buildGeometry(const Device& device)
         VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR,   // sType
         nullptr,                                                            // pNext
         _type,                                                              // type
-        VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR,          // flag
+        _buildFlags,                                                        // flag
         VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR,                     // mode
         nullptr,                                                            // srcAccelerationStructure
         nullptr,                                                            // dstAccelerationStructure
@@ -147,76 +202,211 @@ void AccelerationStructure::buildGeometry(const Device& device)
     MouCa::postCondition(_buildGeometry._buildInfo.accelerationStructureSize > 0);
 }
 
-void AccelerationStructure::createAccelerationStructure(const Device& device, std::vector<AccelerationStructureWPtr>& accelerationStructures)
+void AccelerationStructure::sortLevels(const std::vector<AccelerationStructureWPtr>& accelerationStructures, AccelerationStructures& bottoms, AccelerationStructures& tops)
 {
-    MouCa::preCondition(!device.isNull());
-    MouCa::preCondition(!accelerationStructures.empty());
-
-    // Create a small scratch buffer used during build of the bottom level acceleration structure
-    const bool hostCommand = device.getPhysicalDeviceAccelerationStructureFeatures().accelerationStructureHostCommands;
-
-    std::vector<BufferUPtr> scratchBuffers;
-    std::vector<VkAccelerationStructureBuildGeometryInfoKHR> buildGeometries;
-    std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> accelerationBuildStructureRangeInfos;
-
-    scratchBuffers.reserve(accelerationStructures.size());
-    buildGeometries.reserve(accelerationStructures.size());
-    accelerationBuildStructureRangeInfos.reserve(accelerationStructures.size());
-
     for (const auto& weakAS : accelerationStructures)
     {
         auto as = weakAS.lock();
         MouCa::assertion(!as->isNull());
         MouCa::assertion(!as->_buildGeometry._ranges.empty()); //DEV Issue: no data range
 
-        BufferUPtr scratchBuffer = std::make_unique<Buffer>(std::make_unique<MemoryBufferAllocate>(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR));
-        scratchBuffer->initialize(device, 0, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, as->_buildGeometry._buildInfo.buildScratchSize);
-        
+        if (as->_type == VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR)
+        {
+            tops.emplace_back(as);
+        }
+        else
+        {
+            bottoms.emplace_back(as);
+        }
+    }
+}
+
+void AccelerationStructure::recordBuilds(const Device& device, const AccelerationStructures& structures, const VkBuildAccelerationStructureModeKHR mode,
+                                         const VkDeviceAddress scratchAddress, Commands& commands)
+{
+    for (const auto& as : structures)
+    {
         // Complete build info
         auto geometryInfo = as->_buildGeometry._geometryInfo;
+        geometryInfo.mode                      = mode;
+        geometryInfo.srcAccelerationStructure  = (mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR) ? as->getHandle() : VK_NULL_HANDLE;
         geometryInfo.dstAccelerationStructure  = as->getHandle();
-        geometryInfo.scratchData.deviceAddress = scratchBuffer->getDeviceAddress(device);
+        geometryInfo.scratchData.deviceAddress = scratchAddress;
+
+        std::vector<VkAccelerationStructureBuildGeometryInfoKHR>     buildGeometries{ geometryInfo };
+        std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> ranges{ as->_buildGeometry._ranges.data() };
+        commands.emplace_back(std::make_unique<CommandBuildAccelerationStructures>(device, std::move(buildGeometries), std::move(ranges)));
 
-        buildGeometries.emplace_back(std::move(geometryInfo));
-        accelerationBuildStructureRangeInfos.emplace_back(as->_buildGeometry._ranges.data());
-        scratchBuffers.emplace_back(std::move(scratchBuffer));
+        // Next build reuses scratch buffer and can read this structure (top level, compaction)
+        CommandPipelineBarrier::MemoryBarriers barriers
+        {
+            {
+                VK_STRUCTURE_TYPE_MEMORY_BARRIER,                                                           // VkStructureType    sType;
+                nullptr,                                                                                    // const void*        pNext;
+                VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,                                             // VkAccessFlags      srcAccessMask;
+                VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR // VkAccessFlags      dstAccessMask;
+            }
+        };
+        commands.emplace_back(std::make_unique<CommandPipelineBarrier>(VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0,
+                                                                       std::move(barriers), CommandPipelineBarrier::BufferMemoryBarriers(), CommandPipelineBarrier::ImageMemoryBarriers()));
+    }
+}
+
+void AccelerationStructure::compact(const Device& device, const AccelerationStructures& structures, const VkQueryPool queryPool)
+{
+    std::vector<VkDeviceSize> sizes(structures.size(), 0);
+    if (vkGetQueryPoolResults(device.getInstance(), queryPool, 0, static_cast<uint32_t>(sizes.size()), sizes.size() * sizeof(VkDeviceSize), sizes.data(),
+                              sizeof(VkDeviceSize), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT) != VK_SUCCESS)
+    {
+        throw Core::Exception(Core::ErrorData("Vulkan", "AccelerationStructureCompactedSizeError"));
     }
 
-    if (hostCommand)
+    // Create compacted structures alongside originals
+    std::vector<std::pair<BufferUPtr, VkAccelerationStructureKHR>> originals;
+    originals.reserve(structures.size());
+    Commands commands;
+    auto itSize = sizes.cbegin();
+    for (const auto& as : structures)
     {
-        // Implementation supports building acceleration structure building on host
-        if (device.vkBuildAccelerationStructuresKHR(device.getInstance(), VK_NULL_HANDLE,
-            static_cast<uint32_t>(buildGeometries.size()), buildGeometries.data(),
-            accelerationBuildStructureRangeInfos.data()) != VK_SUCCESS)
+        MouCa::assertion(*itSize > 0 && *itSize <= as->_size);
+
+        originals.emplace_back(std::move(as->_data), as->_handle);
+        as->_data = createStorage();
+        as->create(device, *itSize);
+
+        commands.emplace_back(std::make_unique<CommandCopyAccelerationStructure>(device, originals.back().second, as->_handle, VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR));
+        ++itSize;
+    }
+    executeSync(device, std::move(commands));
+
+    // Originals are not used anymore
+    for (auto& original : originals)
+    {
+        device.vkDestroyAccelerationStructureKHR(device.getInstance(), original.second, nullptr);
+        original.first->release(device);
+    }
+}
+
+void AccelerationStructure::createAccelerationStructure(const Device& device, std::vector<AccelerationStructureWPtr>& accelerationStructures)
+{
+    MouCa::preCondition(!device.isNull());
+    MouCa::preCondition(!accelerationStructures.empty());
+
+    AccelerationStructures bottoms;
+    AccelerationStructures tops;
+    sortLevels(accelerationStructures, bottoms, tops);
+
+    // One scratch buffer for all builds (they are serialized)
+    VkDeviceSize scratchSize = 0;
+    AccelerationStructures compactables;
+    for (const auto& as : bottoms)
+    {
+        scratchSize = std::max(scratchSize, as->_buildGeometry._buildInfo.buildScratchSize);
+        if ((as->_buildFlags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR) != 0)
         {
-            throw Core::Exception(Core::ErrorData("Vulkan", "BuildAccelerationStructureError"));
+            compactables.emplace_back(as);
         }
     }
-    else
+    for (const auto& as : tops)
     {
-        auto commandBuffer = std::make_shared<CommandBuffer>();
-        auto pool = std::make_shared<CommandPool>();
-        pool->initialize(device, device.getQueueFamilyGraphicId());
-        commandBuffer->initialize(device, pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 0);
+        scratchSize = std::max(scratchSize, as->_buildGeometry._buildInfo.buildScratchSize);
+    }
 
-        commandBuffer->addCommand(std::make_unique<CommandBuildAccelerationStructures>(device, std::move(buildGeometries), std::move(accelerationBuildStructureRangeInfos)));
+    Buffer scratch(std::make_unique<MemoryBufferAllocate>(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT));
+    const VkDeviceAddress scratchAddress = createScratch(device, scratch, scratchSize);
 
-        commandBuffer->execute();
+    Commands commands;
+    recordBuilds(device, bottoms, VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR, scratchAddress, commands);
 
-        std::vector<ICommandBufferWPtr> commandBuffers
+    if (compactables.empty())
+    {
+        // Top levels can be built into same command buffer
+        recordBuilds(device, tops, VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR, scratchAddress, commands);
+        executeSync(device, std::move(commands));
+    }
+    else
+    {
+        // Read compacted sizes after builds
+        const VkQueryPoolCreateInfo queryPoolInfo
         {
-            commandBuffer
+            VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,                       // VkStructureType                  sType;
+            nullptr,                                                        // const void*                      pNext;
+            0,                                                              // VkQueryPoolCreateFlags           flags;
+            VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,        // VkQueryType                      queryType;
+            static_cast<uint32_t>(compactables.size()),                     // uint32_t                         queryCount;
+            0                                                               // VkQueryPipelineStatisticFlags    pipelineStatistics;
         };
-        device.executeCommandSync(std::move(commandBuffers));
+        VkQueryPool queryPool = VK_NULL_HANDLE;
+        if (vkCreateQueryPool(device.getInstance(), &queryPoolInfo, nullptr, &queryPool) != VK_SUCCESS)
+        {
+            throw Core::Exception(Core::ErrorData("Vulkan", "QueryPoolCreationError"));
+        }
 
-        commandBuffer->release(device);
-        pool->release(device);
+        std::vector<VkAccelerationStructureKHR> handles;
+        handles.reserve(compactables.size());
+        for (const auto& as : compactables)
+        {
+            handles.emplace_back(as->getHandle());
+        }
+        commands.emplace_back(std::make_unique<CommandWriteAccelerationStructuresProperties>(device, std::move(handles), queryPool, VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR));
+        executeSync(device, std::move(commands));
+
+        compact(device, compactables, queryPool);
+        vkDestroyQueryPool(device.getInstance(), queryPool, nullptr);
+
+        // Top levels reference new addresses of bottom levels
+        if (!tops.empty())
+        {
+            Commands topCommands;
+            for (const auto& as : tops)
+            {
+                for (auto& geometry : as->_geometries)
+                {
+                    geometry->update(device);
+                }
+            }
+            recordBuilds(device, tops, VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR, scratchAddress, topCommands);
+            executeSync(device, std::move(topCommands));
+        }
     }
 
-    for (auto& scratchBuffer : scratchBuffers)
+    scratch.release(device);
+}
+
+void AccelerationStructure::updateAccelerationStructure(const Device& device, std::vector<AccelerationStructureWPtr>& accelerationStructures)
+{
+    MouCa::preCondition(!device.isNull());
+    MouCa::preCondition(!accelerationStructures.empty());
+
+    AccelerationStructures bottoms;
+    AccelerationStructures tops;
+    sortLevels(accelerationStructures, bottoms, tops);
+
+    // Refresh geometries (instances, ...) and compute shared scratch size
+    VkDeviceSize scratchSize = 0;
+    for (const auto* levels : { &bottoms, &tops })
     {
-        scratchBuffer->release(device);
+        for (const auto& as : *levels)
+        {
+            MouCa::assertion((as->_buildFlags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR) != 0); // DEV Issue: need setBuildFlags() with update support
+
+            scratchSize = std::max(scratchSize, as->_buildGeometry._buildInfo.updateScratchSize);
+            for (auto& geometry : as->_geometries)
+            {
+                geometry->update(device);
+            }
+        }
     }
+
+    Buffer scratch(std::make_unique<MemoryBufferAllocate>(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT));
+    const VkDeviceAddress scratchAddress = createScratch(device, scratch, scratchSize);
+
+    Commands commands;
+    recordBuilds(device, bottoms, VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR, scratchAddress, commands);
+    recordBuilds(device, tops,    VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR, scratchAddress, commands);
+    executeSync(device, std::move(commands));
+
+    scratch.release(device);
 }
 
 }
\ No newline at end of file
@@ -66,6 +66,31 @@ void AccelerationStructureGeometryInstance::create(const Device& device)
     _rangeInfos.emplace_back(std::move(info));
 }
 
+void AccelerationStructureGeometryInstance::update(const Device& device)
+{
+    MouCa::preCondition(!device.isNull());
+    MouCa::preCondition(!_data.isNull()); // DEV Issue: call create() before
+
+    auto& memory = _data.getMemory();
+    memory.map(device);
+    auto* instances = memory.getMappedMemory<VkAccelerationStructureInstanceKHR>();
+    for (auto& instance : _instances)
+    {
+        *instances = instance.compute();
+        ++instances;
+    }
+    memory.unmap(device);
+}
+
+void AccelerationStructureGeometryInstance::release(const Device& device)
+{
+    if (!_data.isNull())
+    {
+        _data.release(device);
+    }
+    _rangeInfos.clear();
+}
+
 void AccelerationStructureGeometryInstance::Instance::initialize(AccelerationStructureWPtr reference, const VkGeometryInstanceFlagsKHR flag, VkTransformMatrixKHR&& transform4x3,
                                                                  const uint32_t instanceCustomIndex, const uint32_t instanceShaderBinding, const uint32_t mask)
 {
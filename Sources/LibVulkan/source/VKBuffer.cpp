@@ -6,6 +6,7 @@
 #include "LibVulkan/include/VKBuffer.h"
 #include "LibVulkan/include/VKCommand.h"
 #include "LibVulkan/include/VKCommandBuffer.h"
+#include "LibVulkan/include/VKDeferredRelease.h"
 #include "LibVulkan/include/VKDevice.h"
 
 namespace Vulkan
@@ -76,6 +77,8 @@ void Buffer::release(const Device& device)
     MouCa::preCondition(!device.isNull()); 
     MouCa::preCondition(!_memory->isNull());
 
+    _signalRelease.emit(*this);
+
     vkDestroyBuffer(device.getInstance(), _buffer, nullptr);
     _buffer = VK_NULL_HANDLE;
 
@@ -91,9 +94,93 @@ void Buffer::resize(const Device& device, VkDeviceSize size)
     release(device);
     initialize(device, _createFlags, _usageFlags, size);
 
+    _signalHandleChanged.emit(*this);
+
     MouCa::postCondition(!isNull());
 }
 
+bool Buffer::reserve(const Device& device, const VkCommandBuffer commandBuffer, const VkDeviceSize size, DeferredRelease& deferred)
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(!device.isNull());
+    MouCa::preCondition(commandBuffer != VK_NULL_HANDLE);
+    MouCa::preCondition((_usageFlags & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) != 0); // DEV Issue: old content can't be copied !
+
+    if (size <= _currentSize)
+    {
+        return false;
+    }
+
+    // New buffer with same properties
+    auto buffer = std::make_unique<Buffer>(_memory->createEmpty());
+    buffer->initialize(device, _createFlags, _usageFlags | VK_BUFFER_USAGE_TRANSFER_DST_BIT, std::max(size, _currentSize * 2));
+
+    const VkBufferCopy copyRegion{ 0, 0, _currentSize };
+    vkCmdCopyBuffer(commandBuffer, _buffer, buffer->_buffer, 1, &copyRegion);
+
+    // This object uses new buffer: old buffer is read by GPU copy and lives into deferred list
+    std::swap(_buffer,      buffer->_buffer);
+    std::swap(_memory,      buffer->_memory);
+    std::swap(_descriptor,  buffer->_descriptor);
+    std::swap(_currentSize, buffer->_currentSize);
+    std::swap(_usageFlags,  buffer->_usageFlags);
+
+    // Next updates/reads wait copy
+    const VkBufferMemoryBarrier barrier
+    {
+        VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,                // VkStructureType    sType;
+        nullptr,                                                // const void*        pNext;
+        VK_ACCESS_TRANSFER_WRITE_BIT,                           // VkAccessFlags      srcAccessMask;
+        VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT, // VkAccessFlags      dstAccessMask;
+        VK_QUEUE_FAMILY_IGNORED,                                // uint32_t           srcQueueFamilyIndex;
+        VK_QUEUE_FAMILY_IGNORED,                                // uint32_t           dstQueueFamilyIndex;
+        _buffer,                                                // VkBuffer           buffer;
+        0,                                                      // VkDeviceSize       offset;
+        VK_WHOLE_SIZE                                           // VkDeviceSize       size;
+    };
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+    deferred.add(std::move(buffer));
+
+    // Descriptor sets still point to old buffer
+    _signalHandleChanged.emit(*this);
+
+    MouCa::postCondition(!isNull());
+    return true;
+}
+
+void Buffer::updateRange(const Device& device, const VkCommandBuffer commandBuffer, const VkDeviceSize offset, const VkDeviceSize size, const void* data, DeferredRelease& deferred)
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(!device.isNull());
+    MouCa::preCondition(commandBuffer != VK_NULL_HANDLE);
+    MouCa::preCondition(size > 0 && data != nullptr);
+    MouCa::preCondition(offset + size <= _currentSize);
+    MouCa::preCondition((_usageFlags & VK_BUFFER_USAGE_TRANSFER_DST_BIT) != 0); // DEV Issue: can't copy into buffer !
+
+    auto staging = std::make_unique<Buffer>(std::make_unique<MemoryBuffer>(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+    staging->initialize(device, 0, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, size, data);
+
+    const VkBufferCopy copyRegion{ 0, offset, size };
+    vkCmdCopyBuffer(commandBuffer, staging->getBuffer(), _buffer, 1, &copyRegion);
+
+    const VkBufferMemoryBarrier barrier
+    {
+        VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,                // VkStructureType    sType;
+        nullptr,                                                // const void*        pNext;
+        VK_ACCESS_TRANSFER_WRITE_BIT,                           // VkAccessFlags      srcAccessMask;
+        VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT, // VkAccessFlags      dstAccessMask;
+        VK_QUEUE_FAMILY_IGNORED,                                // uint32_t           srcQueueFamilyIndex;
+        VK_QUEUE_FAMILY_IGNORED,                                // uint32_t           dstQueueFamilyIndex;
+        _buffer,                                                // VkBuffer           buffer;
+        offset,                                                 // VkDeviceSize       offset;
+        size                                                    // VkDeviceSize       size;
+    };
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+    deferred.add(std::move(staging));
+}
+
 const VkDescriptorBufferInfo& Buffer::getDescriptor() const
 {
     return _descriptor;
@@ -5,10 +5,16 @@
 
 #include "LibVulkan/include/VKCommand.h"
 
+#include <LibCore/include/CoreProfiler.h>
+#include <LibCore/include/CoreThreadPools.h>
+
 #include "LibVulkan/include/VKBuffer.h"
+#include "LibVulkan/include/VKCommandPool.h"
+#include "LibVulkan/include/VKCommandStream.h"
 #include "LibVulkan/include/VKDevice.h"
 #include "LibVulkan/include/VKDescriptorSet.h"
 #include "LibVulkan/include/VKFrameBuffer.h"
+#include "LibVulkan/include/VKFrameRing.h"
 #include "LibVulkan/include/VKImage.h"
 #include "LibVulkan/include/VKMesh.h"
 #include "LibVulkan/include/VKGraphicsPipeline.h"
@@ -19,6 +25,23 @@
 namespace Vulkan
 {
 
+namespace
+{
+    bool isSameExtent(const VkExtent2D& extentA, const VkExtent2D& extentB)
+    {
+        return extentA.width == extentB.width && extentA.height == extentB.height;
+    }
+}
+
+std::atomic<uint64_t> Command::_lastVersion = 0;
+
+void Command::compile(CommandStream& stream, const uint32_t idSwap)
+{
+    auto& packet = stream.push<CommandStream::Execute>(CommandStream::Opcode::Execute);
+    packet._command = this;
+    packet._idSwap  = idSwap;
+}
+
 CommandBeginRenderPass::CommandBeginRenderPass(const RenderPass& renderPass, FrameBufferWPtr frameBuffer, const VkRect2D& renderArea, std::vector<VkClearValue>&& clearColor, const VkSubpassContents subpassContent):
 _clearColor(std::move(clearColor)), _subpassContent(subpassContent), _frameBuffer(frameBuffer),
 _renderPassBeginInfo(
@@ -36,30 +59,51 @@ _renderPassBeginInfo(
     MouCa::preCondition(!renderPass.isNull());
 }
 
-void CommandBeginRenderPass::execute(const VkCommandBuffer& commandBuffer)
+void CommandBeginRenderPass::refresh()
 {
-    MouCa::preCondition(!_frameBuffer.expired() ); //DEV Issue: Need a valid FrameBuffer
+    MouCa::preCondition(!_frameBuffer.expired()); //DEV Issue: Need a valid FrameBuffer
     const auto frameBuffer = _frameBuffer.lock();
     MouCa::preCondition(!frameBuffer->isNull());
 
     // Refresh frameBuffer info
-    _renderPassBeginInfo.renderArea.extent = frameBuffer->getResolution();
-    _renderPassBeginInfo.framebuffer       = frameBuffer->getInstance();
+    if (!isSameExtent(_renderPassBeginInfo.renderArea.extent, frameBuffer->getResolution()))
+    {
+        _renderPassBeginInfo.renderArea.extent = frameBuffer->getResolution();
+        markDirty();
+    }
+    updateHandle(_renderPassBeginInfo.framebuffer, frameBuffer->getInstance());
+}
 
+void CommandBeginRenderPass::execute(const VkCommandBuffer& commandBuffer)
+{
+    refresh();
     vkCmdBeginRenderPass(commandBuffer, &_renderPassBeginInfo, _subpassContent);
 }
 
 void CommandBeginRenderPass::execute(const ExecuteCommands& executer)
 {
-    MouCa::preCondition(!_frameBuffer.expired()); //DEV Issue: Need a valid FrameBuffer
-    const auto frameBuffer = _frameBuffer.lock();
-    MouCa::preCondition(!frameBuffer->isNull());
+    refresh();
+    vkCmdBeginRenderPass(executer.commandBuffer, &_renderPassBeginInfo, _subpassContent);
+}
 
-    // Refresh frameBuffer info
-    _renderPassBeginInfo.renderArea.extent = frameBuffer->getResolution();
-    _renderPassBeginInfo.framebuffer       = frameBuffer->getInstance();
+void CommandBeginRenderPass::compile(CommandStream& stream, const uint32_t)
+{
+    refresh();
 
-    vkCmdBeginRenderPass(executer.commandBuffer, &_renderPassBeginInfo, _subpassContent);
+    auto& packet = stream.push<CommandStream::BeginRenderPass>(CommandStream::Opcode::BeginRenderPass, _clearColor.size() * sizeof(VkClearValue));
+    packet._renderPass    = _renderPassBeginInfo.renderPass;
+    packet._frameBuffer   = _renderPassBeginInfo.framebuffer;
+    packet._renderArea    = _renderPassBeginInfo.renderArea;
+    packet._contents      = _subpassContent;
+    packet._nbClearValues = static_cast<uint32_t>(_clearColor.size());
+    std::copy(_clearColor.cbegin(), _clearColor.cend(), CommandStream::getTrailing<VkClearValue>(packet));
+}
+
+bool CommandBeginRenderPass::isModified() const
+{
+    const auto frameBuffer = _frameBuffer.lock();
+    return frameBuffer != nullptr
+        && (frameBuffer->getInstance() != _renderPassBeginInfo.framebuffer || !isSameExtent(frameBuffer->getResolution(), _renderPassBeginInfo.renderArea.extent));
 }
 
 CommandBeginRenderPassSurface::CommandBeginRenderPassSurface(const RenderPass& renderPass, std::vector<FrameBufferWPtr>&& frameBuffer, const VkRect2D& renderArea, std::vector<VkClearValue>&& clearColor, const VkSubpassContents subpassContent):
@@ -77,6 +121,9 @@ _renderPassBeginInfo(
 {
     MouCa::preCondition(!_frameBuffer.empty());
     MouCa::preCondition(!renderPass.isNull());
+
+    _recordedFrameBuffers.resize(_frameBuffer.size(), VK_NULL_HANDLE);
+    _recordedExtents.resize(_frameBuffer.size(), VkExtent2D{ 0, 0 });
 }
 
 void CommandBeginRenderPassSurface::execute(const VkCommandBuffer& commandBuffer)
@@ -84,19 +131,58 @@ void CommandBeginRenderPassSurface::execute(const VkCommandBuffer& commandBuffer
     MouCa::preCondition(false); //DEV Issue: Not callable API
 }
 
-void CommandBeginRenderPassSurface::execute(const ExecuteCommands& executer)
+void CommandBeginRenderPassSurface::refresh(const uint32_t idSwap)
 {
-    MouCa::preCondition(executer.idSwap < _frameBuffer.size()); //DEV Issue: Need a valid FrameBuffer
-    const auto frameBuffer = _frameBuffer[executer.idSwap].lock();
+    MouCa::preCondition(idSwap < _frameBuffer.size()); //DEV Issue: Need a valid FrameBuffer
+    const auto frameBuffer = _frameBuffer[idSwap].lock();
     MouCa::preCondition(!frameBuffer->isNull());
 
     // Refresh frameBuffer info
-    _renderPassBeginInfo.renderArea.extent = frameBuffer->getResolution();
-    _renderPassBeginInfo.framebuffer       = frameBuffer->getInstance();
+    auto& extent = _recordedExtents[idSwap];
+    if (!isSameExtent(extent, frameBuffer->getResolution()))
+    {
+        extent = frameBuffer->getResolution();
+        markDirty();
+    }
+    updateHandle(_recordedFrameBuffers[idSwap], frameBuffer->getInstance());
+
+    _renderPassBeginInfo.renderArea.extent = extent;
+    _renderPassBeginInfo.framebuffer       = _recordedFrameBuffers[idSwap];
+}
 
+void CommandBeginRenderPassSurface::execute(const ExecuteCommands& executer)
+{
+    refresh(executer.idSwap);
     vkCmdBeginRenderPass(executer.commandBuffer, &_renderPassBeginInfo, _subpassContent);
 }
 
+void CommandBeginRenderPassSurface::compile(CommandStream& stream, const uint32_t idSwap)
+{
+    refresh(idSwap);
+
+    auto& packet = stream.push<CommandStream::BeginRenderPass>(CommandStream::Opcode::BeginRenderPass, _clearColor.size() * sizeof(VkClearValue));
+    packet._renderPass    = _renderPassBeginInfo.renderPass;
+    packet._frameBuffer   = _renderPassBeginInfo.framebuffer;
+    packet._renderArea    = _renderPassBeginInfo.renderArea;
+    packet._contents      = _subpassContent;
+    packet._nbClearValues = static_cast<uint32_t>(_clearColor.size());
+    std::copy(_clearColor.cbegin(), _clearColor.cend(), CommandStream::getTrailing<VkClearValue>(packet));
+}
+
+bool CommandBeginRenderPassSurface::isModified() const
+{
+    for (size_t idSwap = 0; idSwap < _frameBuffer.size(); ++idSwap)
+    {
+        const auto frameBuffer = _frameBuffer[idSwap].lock();
+        if (frameBuffer != nullptr
+         && (frameBuffer->getInstance() != _recordedFrameBuffers[idSwap] || !isSameExtent(frameBuffer->getResolution(), _recordedExtents[idSwap])))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void CommandEndRenderPass::execute(const VkCommandBuffer& commandBuffer)
 {
     vkCmdEndRenderPass(commandBuffer);
@@ -107,6 +193,11 @@ void CommandEndRenderPass::execute(const ExecuteCommands& executer)
     vkCmdEndRenderPass(executer.commandBuffer);
 }
 
+void CommandEndRenderPass::compile(CommandStream& stream, const uint32_t)
+{
+    stream.push<CommandStream::EndRenderPass>(CommandStream::Opcode::EndRenderPass);
+}
+
 void CommandViewport::execute(const VkCommandBuffer& commandBuffer)
 {
     vkCmdSetViewport(commandBuffer, 0, 1, &_viewport);
@@ -117,6 +208,11 @@ void CommandViewport::execute(const ExecuteCommands& executer)
     vkCmdSetViewport(executer.commandBuffer, 0, 1, &_viewport);
 }
 
+void CommandViewport::compile(CommandStream& stream, const uint32_t)
+{
+    stream.push<CommandStream::Viewport>(CommandStream::Opcode::Viewport)._viewport = _viewport;
+}
+
 void CommandScissor::execute(const VkCommandBuffer& commandBuffer)
 {
     vkCmdSetScissor(commandBuffer, 0, 1, &_scissor);
@@ -127,6 +223,11 @@ void CommandScissor::execute(const ExecuteCommands& executer)
     vkCmdSetScissor(executer.commandBuffer, 0, 1, &_scissor);
 }
 
+void CommandScissor::compile(CommandStream& stream, const uint32_t)
+{
+    stream.push<CommandStream::Scissor>(CommandStream::Opcode::Scissor)._scissor = _scissor;
+}
+
 CommandPipeline::CommandPipeline(const GraphicsPipeline& pipeline, const VkPipelineBindPoint bindPoint):
 _pipeline(pipeline), _bindPoint(bindPoint)
 {
@@ -135,12 +236,28 @@ _pipeline(pipeline), _bindPoint(bindPoint)
 
 void CommandPipeline::execute(const VkCommandBuffer& commandBuffer)
 {
-    vkCmdBindPipeline(commandBuffer, _bindPoint, _pipeline.getInstance());
+    updateHandle(_recordedPipeline, _pipeline.getInstance());
+    vkCmdBindPipeline(commandBuffer, _bindPoint, _recordedPipeline);
 }
 
 void CommandPipeline::execute(const ExecuteCommands& executer)
 {
-    vkCmdBindPipeline(executer.commandBuffer, _bindPoint, _pipeline.getInstance());
+    updateHandle(_recordedPipeline, _pipeline.getInstance());
+    vkCmdBindPipeline(executer.commandBuffer, _bindPoint, _recordedPipeline);
+}
+
+void CommandPipeline::compile(CommandStream& stream, const uint32_t)
+{
+    updateHandle(_recordedPipeline, _pipeline.getInstance());
+
+    auto& packet = stream.push<CommandStream::BindPipeline>(CommandStream::Opcode::BindPipeline);
+    packet._pipeline  = _recordedPipeline;
+    packet._bindPoint = _bindPoint;
+}
+
+bool CommandPipeline::isModified() const
+{
+    return _pipeline.getInstance() != _recordedPipeline;
 }
 
 CommandBindPipeline::CommandBindPipeline(const PipelineWPtr pipeline, const VkPipelineBindPoint bindPoint) :
@@ -151,12 +268,29 @@ _pipeline(pipeline), _bindPoint(bindPoint)
 
 void CommandBindPipeline::execute(const VkCommandBuffer& commandBuffer)
 {
-    vkCmdBindPipeline(commandBuffer, _bindPoint, _pipeline.lock()->getInstance());
+    updateHandle(_recordedPipeline, _pipeline.lock()->getInstance());
+    vkCmdBindPipeline(commandBuffer, _bindPoint, _recordedPipeline);
 }
 
 void CommandBindPipeline::execute(const ExecuteCommands& executer)
 {
-    vkCmdBindPipeline(executer.commandBuffer, _bindPoint, _pipeline.lock()->getInstance());
+    updateHandle(_recordedPipeline, _pipeline.lock()->getInstance());
+    vkCmdBindPipeline(executer.commandBuffer, _bindPoint, _recordedPipeline);
+}
+
+void CommandBindPipeline::compile(CommandStream& stream, const uint32_t)
+{
+    updateHandle(_recordedPipeline, _pipeline.lock()->getInstance());
+
+    auto& packet = stream.push<CommandStream::BindPipeline>(CommandStream::Opcode::BindPipeline);
+    packet._pipeline  = _recordedPipeline;
+    packet._bindPoint = _bindPoint;
+}
+
+bool CommandBindPipeline::isModified() const
+{
+    const auto pipeline = _pipeline.lock();
+    return pipeline != nullptr && pipeline->getInstance() != _recordedPipeline;
 }
 
 CommandDraw::CommandDraw(const uint32_t vertexCount, const uint32_t instanceCount, const uint32_t firstVertex, const uint32_t firstInstance):
@@ -173,6 +307,11 @@ void CommandDraw::execute(const ExecuteCommands& executer)
     vkCmdDraw(executer.commandBuffer, _vertexCount, _instanceCount, _firstVertex, _firstInstance);
 }
 
+void CommandDraw::compile(CommandStream& stream, const uint32_t)
+{
+    stream.push<CommandStream::Draw>(CommandStream::Opcode::Draw) = { _vertexCount, _instanceCount, _firstVertex, _firstInstance };
+}
+
 CommandDrawIndexed::CommandDrawIndexed(const uint32_t indexCount, const uint32_t instanceCount, const uint32_t firstIndex, const int32_t vertexOffset, const uint32_t firstInstance) :
 _indexCount(indexCount), _instanceCount(instanceCount), _firstIndex(firstIndex), _vertexOffset(vertexOffset), _firstInstance(firstInstance)
 {}
@@ -187,6 +326,57 @@ void CommandDrawIndexed::execute(const ExecuteCommands& executer)
     vkCmdDrawIndexed(executer.commandBuffer, _indexCount, _instanceCount, _firstIndex, _vertexOffset, _firstInstance);
 }
 
+void CommandDrawIndexed::compile(CommandStream& stream, const uint32_t)
+{
+    stream.push<CommandStream::DrawIndexed>(CommandStream::Opcode::DrawIndexed) = { _indexCount, _instanceCount, _firstIndex, _vertexOffset, _firstInstance };
+}
+
+CommandDrawIndexedIndirectCount::CommandDrawIndexedIndirectCount(const Device& device, const BufferWPtr buffer, const VkDeviceSize offset, const BufferWPtr countBuffer, const VkDeviceSize countOffset,
+                                                                 const uint32_t maxDrawCount, const uint32_t stride):
+_device(device), _buffer(buffer), _countBuffer(countBuffer), _bufferId(buffer.lock()->getBuffer()), _countBufferId(countBuffer.lock()->getBuffer()),
+_offset(offset), _countOffset(countOffset), _maxDrawCount(maxDrawCount), _stride(stride)
+{
+    MouCa::preCondition(!_device.isNull());
+    MouCa::preCondition(_device.vkCmdDrawIndexedIndirectCountKHR != nullptr); // DEV Issue: Need VK_KHR_draw_indirect_count extension !
+    MouCa::preCondition(_maxDrawCount > 0);
+    MouCa::preCondition(_stride >= sizeof(VkDrawIndexedIndirectCommand));
+}
+
+void CommandDrawIndexedIndirectCount::execute(const VkCommandBuffer& commandBuffer)
+{
+    _device.vkCmdDrawIndexedIndirectCountKHR(commandBuffer, _bufferId, _offset, _countBufferId, _countOffset, _maxDrawCount, _stride);
+}
+
+void CommandDrawIndexedIndirectCount::execute(const ExecuteCommands& executer)
+{
+    updateHandle(_bufferId,      _buffer.lock()->getBuffer());
+    updateHandle(_countBufferId, _countBuffer.lock()->getBuffer());
+    MouCa::assertion(_bufferId != VK_NULL_HANDLE && _countBufferId != VK_NULL_HANDLE);
+
+    _device.vkCmdDrawIndexedIndirectCountKHR(executer.commandBuffer, _bufferId, _offset, _countBufferId, _countOffset, _maxDrawCount, _stride);
+}
+
+bool CommandDrawIndexedIndirectCount::isModified() const
+{
+    return _buffer.lock()->getBuffer() != _bufferId || _countBuffer.lock()->getBuffer() != _countBufferId;
+}
+
+CommandDispatch::CommandDispatch(const uint32_t groupCountX, const uint32_t groupCountY, const uint32_t groupCountZ):
+_groupCountX(groupCountX), _groupCountY(groupCountY), _groupCountZ(groupCountZ)
+{
+    MouCa::preCondition(_groupCountX > 0 && _groupCountY > 0 && _groupCountZ > 0);
+}
+
+void CommandDispatch::execute(const VkCommandBuffer& commandBuffer)
+{
+    vkCmdDispatch(commandBuffer, _groupCountX, _groupCountY, _groupCountZ);
+}
+
+void CommandDispatch::execute(const ExecuteCommands& executer)
+{
+    vkCmdDispatch(executer.commandBuffer, _groupCountX, _groupCountY, _groupCountZ);
+}
+
 CommandBindVertexBuffer::CommandBindVertexBuffer(const uint32_t firstBinding, const uint32_t bindingCount, std::vector<VkBuffer>&& buffers, std::vector<VkDeviceSize>&& offsets):
 _firstBinding(firstBinding), _bindingCount(bindingCount), _buffersId(std::move(buffers)), _offsets(std::move(offsets))
 {
@@ -211,13 +401,44 @@ void CommandBindVertexBuffer::execute(const ExecuteCommands& executer)
         auto itId = _buffersId.begin();
         for (auto& buffer : _buffers)
         {
-            *itId = buffer.lock()->getBuffer();
+            updateHandle(*itId, buffer.lock()->getBuffer());
             ++itId;
         }
     }
     vkCmdBindVertexBuffers(executer.commandBuffer, _firstBinding, _bindingCount, _buffersId.data(), _offsets.data());
 }
 
+void CommandBindVertexBuffer::compile(CommandStream& stream, const uint32_t)
+{
+    auto itId = _buffersId.begin();
+    for (auto& buffer : _buffers)
+    {
+        updateHandle(*itId, buffer.lock()->getBuffer());
+        ++itId;
+    }
+
+    auto& packet = stream.push<CommandStream::BindVertexBuffers>(CommandStream::Opcode::BindVertexBuffers, _bindingCount * (sizeof(VkBuffer) + sizeof(VkDeviceSize)));
+    packet._firstBinding = _firstBinding;
+    packet._nbBindings   = _bindingCount;
+    std::copy_n(_buffersId.cbegin(), _bindingCount, CommandStream::getTrailing<VkBuffer>(packet));
+    std::copy_n(_offsets.cbegin(),   _bindingCount, CommandStream::getTrailing<VkDeviceSize>(packet, _bindingCount * sizeof(VkBuffer)));
+}
+
+bool CommandBindVertexBuffer::isModified() const
+{
+    auto itId = _buffersId.cbegin();
+    for (const auto& buffer : _buffers)
+    {
+        const auto lockBuffer = buffer.lock();
+        if (lockBuffer != nullptr && lockBuffer->getBuffer() != *itId)
+        {
+            return true;
+        }
+        ++itId;
+    }
+    return false;
+}
+
 CommandBindIndexBuffer::CommandBindIndexBuffer(const BufferWPtr buffer, const VkDeviceSize offset, const VkIndexType indexType) :
 _buffer(buffer), _bufferId(buffer.lock()->getBuffer()), _offset(offset), _indexType(indexType)
 {}
@@ -235,12 +456,29 @@ void CommandBindIndexBuffer::execute(const ExecuteCommands& executer)
 {
     if (!_buffer.expired())
     {
-        _bufferId = _buffer.lock()->getBuffer();
+        updateHandle(_bufferId, _buffer.lock()->getBuffer());
         MouCa::assertion(_bufferId != VK_NULL_HANDLE);
     }
 
     vkCmdBindIndexBuffer(executer.commandBuffer, _bufferId, _offset, _indexType);
 }
+
+void CommandBindIndexBuffer::compile(CommandStream& stream, const uint32_t)
+{
+    if (!_buffer.expired())
+    {
+        updateHandle(_bufferId, _buffer.lock()->getBuffer());
+        MouCa::assertion(_bufferId != VK_NULL_HANDLE);
+    }
+
+    stream.push<CommandStream::BindIndexBuffer>(CommandStream::Opcode::BindIndexBuffer) = { _bufferId, _offset, _indexType };
+}
+
+bool CommandBindIndexBuffer::isModified() const
+{
+    const auto buffer = _buffer.lock();
+    return buffer != nullptr && buffer->getBuffer() != _bufferId;
+}
 /*
 CommandBindMesh::CommandBindMesh(const Mesh& mesh, const uint32_t bindID, const VkIndexType index):
 _index(index),
@@ -351,6 +589,7 @@ _pipelineLayoutID(pipelineLayout.getInstance()), _bindPoint(bindPoint), _firstSe
 
 void CommandBindDescriptorSets::execute(const VkCommandBuffer& commandBuffer)
 {
+    updateHandle(_recordedDescriptors, _descriptorsID);
     vkCmdBindDescriptorSets(commandBuffer, _bindPoint, _pipelineLayoutID, _firstSet,
                             static_cast<uint32_t>(_descriptorsID.size()), _descriptorsID.data(),
                             static_cast<uint32_t>(_dynamicOffsets.size()), _dynamicOffsets.empty() ? nullptr : _dynamicOffsets.data());
@@ -358,11 +597,33 @@ void CommandBindDescriptorSets::execute(const VkCommandBuffer& commandBuffer)
 
 void CommandBindDescriptorSets::execute(const ExecuteCommands& executer)
 {
+    updateHandle(_recordedDescriptors, _descriptorsID);
     vkCmdBindDescriptorSets(executer.commandBuffer, _bindPoint, _pipelineLayoutID, _firstSet,
                             static_cast<uint32_t>(_descriptorsID.size()), _descriptorsID.data(),
                             static_cast<uint32_t>(_dynamicOffsets.size()), _dynamicOffsets.empty() ? nullptr : _dynamicOffsets.data());
 }
 
+void CommandBindDescriptorSets::compile(CommandStream& stream, const uint32_t)
+{
+    updateHandle(_recordedDescriptors, _descriptorsID);
+
+    const size_t setsSize = _descriptorsID.size() * sizeof(VkDescriptorSet);
+    auto& packet = stream.push<CommandStream::BindDescriptorSets>(CommandStream::Opcode::BindDescriptorSets, setsSize + _dynamicOffsets.size() * sizeof(uint32_t));
+    packet._pipelineLayout   = _pipelineLayoutID;
+    packet._bindPoint        = _bindPoint;
+    packet._firstSet         = _firstSet;
+    packet._nbSets           = static_cast<uint32_t>(_descriptorsID.size());
+    packet._nbDynamicOffsets = static_cast<uint32_t>(_dynamicOffsets.size());
+    std::copy(_descriptorsID.cbegin(),  _descriptorsID.cend(),  CommandStream::getTrailing<VkDescriptorSet>(packet));
+    std::copy(_dynamicOffsets.cbegin(), _dynamicOffsets.cend(), CommandStream::getTrailing<uint32_t>(packet, setsSize));
+}
+
+bool CommandBindDescriptorSets::isModified() const
+{
+    // Descriptor sets can be reallocated (content update doesn't need recording)
+    return _recordedDescriptors != _descriptorsID;
+}
+
 CommandCopyImage::CommandCopyImage(const VkImage& source, const VkImage& destination, const VkImageCopy& copyRegion):
 _source(source),
 _destination(destination),
@@ -493,18 +754,53 @@ _pipelineLayout(pipelineLayout.getInstance()), _stage(stage), _memorySize(memory
 {
     MouCa::preCondition(!pipelineLayout.isNull());
     MouCa::preCondition(_memorySize > 0 && _buffer != nullptr);
+
+    _recordedData.resize(_memorySize);
+    std::memcpy(_recordedData.data(), _buffer, _memorySize);
 }
 
 void CommandPushConstants::execute(const VkCommandBuffer& commandBuffer)
 {
+    if (isModified())
+    {
+        std::memcpy(_recordedData.data(), _buffer, _memorySize);
+        markDirty();
+    }
     vkCmdPushConstants(commandBuffer, _pipelineLayout, _stage, 0, _memorySize, _buffer);
 }
 
 void CommandPushConstants::execute(const ExecuteCommands& executer)
 {
+    if (isModified())
+    {
+        std::memcpy(_recordedData.data(), _buffer, _memorySize);
+        markDirty();
+    }
     vkCmdPushConstants(executer.commandBuffer, _pipelineLayout, _stage, 0, _memorySize, _buffer);
 }
 
+void CommandPushConstants::compile(CommandStream& stream, const uint32_t)
+{
+    // Values are copied into stream: compile again when they change (like recording)
+    if (isModified())
+    {
+        std::memcpy(_recordedData.data(), _buffer, _memorySize);
+        markDirty();
+    }
+
+    auto& packet = stream.push<CommandStream::PushConstants>(CommandStream::Opcode::PushConstants, _memorySize);
+    packet._pipelineLayout = _pipelineLayout;
+    packet._stage          = _stage;
+    packet._size           = _memorySize;
+    std::memcpy(CommandStream::getTrailing<std::byte>(packet), _recordedData.data(), _memorySize);
+}
+
+bool CommandPushConstants::isModified() const
+{
+    // Values are copied into command buffer: new values need recording
+    return std::memcmp(_recordedData.data(), _buffer, _memorySize) != 0;
+}
+
 void CommandContainer::execute(const VkCommandBuffer& commandBuffer)
 {
     for (const auto& command : _commands)
@@ -521,6 +817,24 @@ void CommandContainer::execute(const ExecuteCommands& executer)
     }
 }
 
+void CommandContainer::compile(CommandStream& stream, const uint32_t idSwap)
+{
+    for (const auto& command : _commands)
+    {
+        command->compile(stream, idSwap);
+    }
+}
+
+uint64_t CommandContainer::getVersion() const
+{
+    uint64_t version = Command::getVersion();
+    for (const auto& command : _commands)
+    {
+        version = std::max(version, command->getVersion());
+    }
+    return version;
+}
+
 CommandSwitch::CommandSwitch():
 _idNode(0)
 {}
@@ -539,6 +853,180 @@ void CommandSwitch::execute(const ExecuteCommands& executer)
     _commands[_idNode]->execute(executer);
 }
 
+void CommandSwitch::compile(CommandStream& stream, const uint32_t idSwap)
+{
+    MouCa::preCondition(_idNode < _commands.size());
+
+    _commands[_idNode]->compile(stream, idSwap);
+}
+
+uint64_t CommandSwitch::getVersion() const
+{
+    const uint64_t version = Command::getVersion();
+    return _idNode < _commands.size() ? std::max(version, _commands[_idNode]->getVersion()) : version;
+}
+
+//----------------------------------------------------------------------------
+struct CommandParallelContainer::ThreadRecorder
+{
+    CommandPool                  _pool;         ///< Pool owned by one thread.
+    std::vector<VkCommandBuffer> _buffers;      ///< Secondary command buffers allocated by pool.
+    size_t                       _nbUsed = 0;   ///< Buffers recorded since last reset.
+};
+
+CommandParallelContainer::CommandParallelContainer(const Device& device, Core::ThreadPools& pools, RenderPassWPtr renderPass, const uint32_t subpass, const FrameRing* frameRing):
+_device(device), _pools(pools), _renderPass(renderPass), _subpass(subpass), _frameRing(frameRing)
+{
+    MouCa::preCondition(!_device.isNull());
+}
+
+CommandParallelContainer::~CommandParallelContainer()
+{
+    // Buffers are freed with their pool
+    for (auto& slot : _recorders)
+    {
+        for (auto& recorders : slot)
+        {
+            for (auto& recorder : recorders)
+            {
+                recorder.second->_pool.release(_device);
+            }
+        }
+    }
+}
+
+CommandParallelContainer::ThreadRecorder& CommandParallelContainer::getRecorder(ThreadRecorders& recorders)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto& recorder = recorders[std::this_thread::get_id()];
+    if (recorder == nullptr)
+    {
+        recorder = std::make_unique<ThreadRecorder>();
+        recorder->_pool.initialize(_device, _device.getQueueFamilyGraphicId(), VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+    }
+    return *recorder;
+}
+
+VkCommandBuffer CommandParallelContainer::record(ThreadRecorders& recorders, Command& command, const uint32_t idSwap)
+{
+    MOUCA_PROFILE_ZONE("CommandParallelContainer::record");
+
+    // Only current thread uses its recorder: no lock after search
+    auto& recorder = getRecorder(recorders);
+    if (recorder._nbUsed == recorder._buffers.size())
+    {
+        const VkCommandBufferAllocateInfo allocateInfo
+        {
+            VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, // VkStructureType              sType
+            nullptr,                                        // const void*                  pNext
+            recorder._pool.getInstance(),                   // VkCommandPool                commandPool
+            VK_COMMAND_BUFFER_LEVEL_SECONDARY,              // VkCommandBufferLevel         level
+            1                                               // uint32_t                     bufferCount
+        };
+
+        VkCommandBuffer buffer = VK_NULL_HANDLE;
+        if (vkAllocateCommandBuffers(_device.getInstance(), &allocateInfo, &buffer) != VK_SUCCESS)
+        {
+            throw Core::Exception(Core::ErrorData("Vulkan", "CommandBufferCreationError"));
+        }
+        recorder._buffers.emplace_back(buffer);
+    }
+    const VkCommandBuffer commandBuffer = recorder._buffers[recorder._nbUsed];
+    ++recorder._nbUsed;
+
+    const auto renderPass = _renderPass.lock();
+    const VkCommandBufferInheritanceInfo inheritanceInfo
+    {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,                      // VkStructureType                  sType
+        nullptr,                                                                // const void*                      pNext
+        renderPass != nullptr ? renderPass->getInstance() : VK_NULL_HANDLE,     // VkRenderPass                     renderPass
+        _subpass,                                                               // uint32_t                         subpass
+        VK_NULL_HANDLE,                                                         // VkFramebuffer                    framebuffer
+        VK_FALSE,                                                               // VkBool32                         occlusionQueryEnable
+        0,                                                                      // VkQueryControlFlags              queryFlags
+        0                                                                       // VkQueryPipelineStatisticFlags    pipelineStatistics
+    };
+
+    const VkCommandBufferBeginInfo beginInfo
+    {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,                                        // VkStructureType                        sType
+        nullptr,                                                                            // const void                            *pNext
+        renderPass != nullptr ? VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT : 0u,      // VkCommandBufferUsageFlags              flags
+        &inheritanceInfo                                                                    // const VkCommandBufferInheritanceInfo  *pInheritanceInfo
+    };
+
+    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
+    {
+        throw Core::Exception(Core::ErrorData("Vulkan", "CommandBufferBeginError"));
+    }
+
+    command.execute({ commandBuffer, idSwap });
+
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
+    {
+        throw Core::Exception(Core::ErrorData("Vulkan", "CommandBufferEndError"));
+    }
+    return commandBuffer;
+}
+
+void CommandParallelContainer::execute(const VkCommandBuffer& commandBuffer)
+{
+    execute({ commandBuffer, 0 });
+}
+
+void CommandParallelContainer::execute(const ExecuteCommands& executer)
+{
+    MouCa::preCondition(!_commands.empty()); // DEV Issue: no range to record !
+
+    // Buffers of previous recording of this swap image into this frame slot are not used anymore (fence of slot is waited)
+    const bool     running = _frameRing != nullptr && _frameRing->isRunning();
+    const uint32_t idSlot  = running ? _frameRing->getCurrent() : 0;
+    if (_recorders.size() <= idSlot)
+    {
+        _recorders.resize(running ? _frameRing->getNbFrames() : 1);
+    }
+    auto& slot = _recorders[idSlot];
+    if (slot.size() <= executer.idSwap)
+    {
+        slot.resize(executer.idSwap + 1);
+    }
+    auto& recorders = slot[executer.idSwap];
+    for (auto& recorder : recorders)
+    {
+        recorder.second->_pool.reset(_device);
+        recorder.second->_nbUsed = 0;
+    }
+
+    // Record all ranges
+    _secondaries.resize(_commands.size());
+    if (_pools.getNbWorkers() == 0 || _commands.size() == 1)
+    {
+        for (size_t id = 0; id < _commands.size(); ++id)
+        {
+            _secondaries[id] = record(recorders, *_commands[id], executer.idSwap);
+        }
+    }
+    else
+    {
+        auto task = _pools.parallelFor(0, _commands.size(), 1, [&](const size_t begin, const size_t end)
+        {
+            for (size_t id = begin; id < end; ++id)
+            {
+                _secondaries[id] = record(recorders, *_commands[id], executer.idSwap);
+            }
+        });
+        _pools.wait(task);
+    }
+
+    vkCmdExecuteCommands(executer.commandBuffer, static_cast<uint32_t>(_secondaries.size()), _secondaries.data());
+}
+
+void CommandParallelContainer::compile(CommandStream& stream, const uint32_t idSwap)
+{
+    Command::compile(stream, idSwap);
+}
+
 CommandBuildAccelerationStructures::CommandBuildAccelerationStructures(const Device& device, std::vector<VkAccelerationStructureBuildGeometryInfoKHR>&& buildGeometries,
                                                                        std::vector<const VkAccelerationStructureBuildRangeInfoKHR*>&& accelerationBuildStructureRangeInfos):
 _device(device), _buildGeometries(std::move(buildGeometries)), _accelerationBuildStructureRangeInfos(std::move(accelerationBuildStructureRangeInfos))
@@ -565,6 +1053,54 @@ void CommandBuildAccelerationStructures::execute(const ExecuteCommands& executer
         _accelerationBuildStructureRangeInfos.data());
 }
 
+CommandWriteAccelerationStructuresProperties::CommandWriteAccelerationStructuresProperties(const Device& device, std::vector<VkAccelerationStructureKHR>&& accelerationStructures,
+                                                                                           const VkQueryPool queryPool, const VkQueryType queryType):
+_device(device), _accelerationStructures(std::move(accelerationStructures)), _queryPool(queryPool), _queryType(queryType)
+{
+    MouCa::preCondition(!_accelerationStructures.empty());
+    MouCa::preCondition(_queryPool != VK_NULL_HANDLE);
+}
+
+void CommandWriteAccelerationStructuresProperties::execute(const VkCommandBuffer& commandBuffer)
+{
+    const uint32_t nbQueries = static_cast<uint32_t>(_accelerationStructures.size());
+    vkCmdResetQueryPool(commandBuffer, _queryPool, 0, nbQueries);
+    _device.vkCmdWriteAccelerationStructuresPropertiesKHR(commandBuffer, nbQueries, _accelerationStructures.data(), _queryType, _queryPool, 0);
+}
+
+void CommandWriteAccelerationStructuresProperties::execute(const ExecuteCommands& executer)
+{
+    const uint32_t nbQueries = static_cast<uint32_t>(_accelerationStructures.size());
+    vkCmdResetQueryPool(executer.commandBuffer, _queryPool, 0, nbQueries);
+    _device.vkCmdWriteAccelerationStructuresPropertiesKHR(executer.commandBuffer, nbQueries, _accelerationStructures.data(), _queryType, _queryPool, 0);
+}
+
+CommandCopyAccelerationStructure::CommandCopyAccelerationStructure(const Device& device, const VkAccelerationStructureKHR source, const VkAccelerationStructureKHR destination,
+                                                                   const VkCopyAccelerationStructureModeKHR mode):
+_device(device),
+_info(
+{
+    VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR, // VkStructureType                       sType;
+    nullptr,                                                // const void*                           pNext;
+    source,                                                 // VkAccelerationStructureKHR            src;
+    destination,                                            // VkAccelerationStructureKHR            dst;
+    mode                                                    // VkCopyAccelerationStructureModeKHR    mode;
+})
+{
+    MouCa::preCondition(source != VK_NULL_HANDLE);
+    MouCa::preCondition(destination != VK_NULL_HANDLE);
+}
+
+void CommandCopyAccelerationStructure::execute(const VkCommandBuffer& commandBuffer)
+{
+    _device.vkCmdCopyAccelerationStructureKHR(commandBuffer, &_info);
+}
+
+void CommandCopyAccelerationStructure::execute(const ExecuteCommands& executer)
+{
+    _device.vkCmdCopyAccelerationStructureKHR(executer.commandBuffer, &_info);
+}
+
 CommandTraceRay::CommandTraceRay(const Device& device, const TracingRayWPtr tracingRay, const uint32_t width, const uint32_t height, const uint32_t depth):
 _device(device), _tracingRay(tracingRay), _width(width), _height(height), _depth(depth)
 {
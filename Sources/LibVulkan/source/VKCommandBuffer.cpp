@@ -18,10 +18,65 @@
 namespace Vulkan
 {
 
+namespace
+{
+    std::atomic<uint64_t> epoch        = 0;     ///< Incremented by invalidateAll().
+    std::atomic<uint64_t> nbRecordings = 0;
+    std::atomic<uint64_t> nbResets     = 0;
+    std::atomic<uint64_t> nbSkipped    = 0;
+}
+
 ICommandBuffer::ICommandBuffer():
 _usage(0)
 {}
 
+bool ICommandBuffer::isDirty() const
+{
+    // One time submit can't be submitted again
+    if (!_recorded || _recordedEpoch != epoch.load() || (_usage & VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT) != 0)
+    {
+        return true;
+    }
+
+    uint64_t version = 0;
+    for (const auto& command : _commands)
+    {
+        version = std::max(version, command->getVersion());
+    }
+    return version != _recordedVersion;
+}
+
+void ICommandBuffer::validate() const
+{
+    // Read after recording: commands updated their handles
+    _recordedVersion = 0;
+    for (const auto& command : _commands)
+    {
+        _recordedVersion = std::max(_recordedVersion, command->getVersion());
+    }
+    _recordedEpoch = epoch.load();
+    _recorded      = true;
+}
+
+void ICommandBuffer::invalidateAll()
+{
+    ++epoch;
+}
+
+void ICommandBuffer::countSkipped()
+{
+    ++nbSkipped;
+}
+
+ICommandBuffer::Statistics ICommandBuffer::getStatistics()
+{
+    Statistics statistics;
+    statistics._nbRecordings = nbRecordings.load();
+    statistics._nbResets     = nbResets.load();
+    statistics._nbSkipped    = nbSkipped.load();
+    return statistics;
+}
+
 void ICommandBuffer::executeCommand(const ExecuteCommands& executer, const VkCommandBufferResetFlags reset) const
 {
     MouCa::preCondition(!isNull());            //DEV Issue: missing to call initialize;
@@ -32,6 +87,7 @@ void ICommandBuffer::executeCommand(const ExecuteCommands& executer, const VkCom
     {
         throw Core::Exception(Core::ErrorData("Vulkan", "CommandBufferResetError"));
     }
+    ++nbResets;
 
     const VkCommandBufferBeginInfo cmdBufferBeginInfo
     {
@@ -58,6 +114,7 @@ void ICommandBuffer::executeCommand(const ExecuteCommands& executer, const VkCom
     {
         throw Core::Exception(Core::ErrorData("Vulkan", "CommandBufferEndError"));
     }
+    ++nbRecordings;
 }
 
 CommandBuffer::CommandBuffer():
@@ -111,6 +168,7 @@ void CommandBuffer::release(const Device& device)
     // Remove memory about commands
     _commands.clear();
     _commandBuffer = VK_NULL_HANDLE;
+    _recorded      = false;
 
     _pool.reset();
 
@@ -121,6 +179,7 @@ void CommandBuffer::registerCommands(Commands&& commands)
 {
     MouCa::preCondition(!commands.empty());    //DEV Issue: insert no command ?
     _commands = std::move(commands);
+    invalidate();
 }
 
 void CommandBuffer::addCommands(Commands&& commands)
@@ -128,6 +187,7 @@ void CommandBuffer::addCommands(Commands&& commands)
     MouCa::preCondition(!commands.empty());    //DEV Issue: insert no command ?
 
     _commands.insert(_commands.end(), std::make_move_iterator(commands.begin()), std::make_move_iterator(commands.end()));
+    invalidate();
 }
 
 void CommandBuffer::addCommand(CommandUPtr&& command)
@@ -135,11 +195,20 @@ void CommandBuffer::addCommand(CommandUPtr&& command)
     MouCa::preCondition(command != nullptr);    //DEV Issue: insert no command ?
 
     _commands.emplace_back(std::move(command));
+    invalidate();
 }
 
 void CommandBuffer::execute(const VkCommandBufferResetFlags reset) const
 {
+    // Keep previous recording
+    if (!isDirty())
+    {
+        countSkipped();
+        return;
+    }
+
     executeCommand({ _commandBuffer, 0 }, reset);
+    validate();
 }
 
 }
\ No newline at end of file
@@ -70,6 +70,7 @@ void CommandBufferSurface::release(const Device& device)
     // Remove memory about commands
     _commands.clear();
     _pool.reset();
+    _recorded = false;
 
     MouCa::postCondition(isNull());       // DEV Issue: Something wrong ?
 }
@@ -83,16 +84,25 @@ void CommandBufferSurface::registerCommands(Commands&& commands)
 {
     // Register
     _commands = std::move(commands);
+    invalidate();
 }
 
 void CommandBufferSurface::execute(const VkCommandBufferResetFlags reset) const
 {
+    // Keep previous recording
+    if (!isDirty())
+    {
+        countSkipped();
+        return;
+    }
+
     uint32_t idFrameBuffer = 0;
     for(const auto& commandBuffer : _commandBuffers)
     {
         executeCommand({ commandBuffer, idFrameBuffer }, reset);
         ++idFrameBuffer;
     }
+    validate();
 }
 
 VkCommandBuffer CommandBufferSurface::getActiveCommandBuffer() const
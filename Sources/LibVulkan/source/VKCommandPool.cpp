@@ -53,4 +53,15 @@ void CommandPool::release(const Device& device)
     MouCa::postCondition(isNull());
 }
 
+void CommandPool::reset(const Device& device, const VkCommandPoolResetFlags flags) const
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(!device.isNull());
+
+    if (vkResetCommandPool(device.getInstance(), _commandPool, flags) != VK_SUCCESS)
+    {
+        throw Core::Exception(Core::ErrorData("Vulkan", "CommandPoolResetError"));
+    }
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibVulkan/include/VKCommandStream.h"
+
+#include <LibCore/include/CoreProfiler.h>
+
+#include "LibVulkan/include/VKCommand.h"
+
+namespace Vulkan
+{
+
+void CommandStream::compile(const Commands& commands, const uint32_t idSwap)
+{
+    MOUCA_PROFILE_ZONE("CommandStream::compile");
+
+    for (const auto& command : commands)
+    {
+        command->compile(*this, idSwap);
+    }
+}
+
+void CommandStream::record(const VkCommandBuffer commandBuffer) const
+{
+    MOUCA_PROFILE_ZONE("CommandStream::record");
+    MouCa::preCondition(commandBuffer != VK_NULL_HANDLE);
+
+    const std::byte* data = _data.data();
+    const std::byte* end  = data + _data.size();
+    while (data < end)
+    {
+        const auto& header = *reinterpret_cast<const Header*>(data);
+        const std::byte* packet = data + sizeof(Header);
+        MouCa::assertion(header._size >= sizeof(Header) && data + header._size <= end);
+
+        switch (header._opcode)
+        {
+            case Opcode::BeginRenderPass:
+            {
+                const auto& begin = *reinterpret_cast<const BeginRenderPass*>(packet);
+                const VkRenderPassBeginInfo beginInfo
+                {
+                    VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,                                       // VkStructureType        sType
+                    nullptr,                                                                        // const void*            pNext
+                    begin._renderPass,                                                              // VkRenderPass           renderPass
+                    begin._frameBuffer,                                                             // VkFramebuffer          framebuffer
+                    begin._renderArea,                                                              // VkRect2D               renderArea
+                    begin._nbClearValues,                                                           // uint32_t               clearValueCount
+                    begin._nbClearValues > 0 ? getTrailing<VkClearValue>(begin) : nullptr           // const VkClearValue*    pClearValues
+                };
+                vkCmdBeginRenderPass(commandBuffer, &beginInfo, begin._contents);
+                break;
+            }
+            case Opcode::EndRenderPass:
+            {
+                vkCmdEndRenderPass(commandBuffer);
+                break;
+            }
+            case Opcode::Viewport:
+            {
+                vkCmdSetViewport(commandBuffer, 0, 1, &reinterpret_cast<const Viewport*>(packet)->_viewport);
+                break;
+            }
+            case Opcode::Scissor:
+            {
+                vkCmdSetScissor(commandBuffer, 0, 1, &reinterpret_cast<const Scissor*>(packet)->_scissor);
+                break;
+            }
+            case Opcode::BindPipeline:
+            {
+                const auto& bind = *reinterpret_cast<const BindPipeline*>(packet);
+                vkCmdBindPipeline(commandBuffer, bind._bindPoint, bind._pipeline);
+                break;
+            }
+            case Opcode::BindDescriptorSets:
+            {
+                const auto& bind = *reinterpret_cast<const BindDescriptorSets*>(packet);
+                vkCmdBindDescriptorSets(commandBuffer, bind._bindPoint, bind._pipelineLayout, bind._firstSet,
+                                        bind._nbSets, getTrailing<VkDescriptorSet>(bind),
+                                        bind._nbDynamicOffsets, bind._nbDynamicOffsets > 0 ? getTrailing<uint32_t>(bind, bind._nbSets * sizeof(VkDescriptorSet)) : nullptr);
+                break;
+            }
+            case Opcode::BindVertexBuffers:
+            {
+                const auto& bind = *reinterpret_cast<const BindVertexBuffers*>(packet);
+                vkCmdBindVertexBuffers(commandBuffer, bind._firstBinding, bind._nbBindings,
+                                       getTrailing<VkBuffer>(bind), getTrailing<VkDeviceSize>(bind, bind._nbBindings * sizeof(VkBuffer)));
+                break;
+            }
+            case Opcode::BindIndexBuffer:
+            {
+                const auto& bind = *reinterpret_cast<const BindIndexBuffer*>(packet);
+                vkCmdBindIndexBuffer(commandBuffer, bind._buffer, bind._offset, bind._indexType);
+                break;
+            }
+            case Opcode::Draw:
+            {
+                const auto& draw = *reinterpret_cast<const Draw*>(packet);
+                vkCmdDraw(commandBuffer, draw._vertexCount, draw._instanceCount, draw._firstVertex, draw._firstInstance);
+                break;
+            }
+            case Opcode::DrawIndexed:
+            {
+                const auto& draw = *reinterpret_cast<const DrawIndexed*>(packet);
+                vkCmdDrawIndexed(commandBuffer, draw._indexCount, draw._instanceCount, draw._firstIndex, draw._vertexOffset, draw._firstInstance);
+                break;
+            }
+            case Opcode::PushConstants:
+            {
+                const auto& push = *reinterpret_cast<const PushConstants*>(packet);
+                vkCmdPushConstants(commandBuffer, push._pipelineLayout, push._stage, 0, push._size, getTrailing<std::byte>(push));
+                break;
+            }
+            case Opcode::Execute:
+            {
+                const auto& execute = *reinterpret_cast<const Execute*>(packet);
+                execute._command->execute({ commandBuffer, execute._idSwap });
+                break;
+            }
+            default:
+            {
+                MouCa::assertion(false); // DEV Issue: unknown opcode !
+                break;
+            }
+        }
+        data += header._size;
+    }
+}
+
+}
@@ -0,0 +1,55 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibVulkan/include/VKComputePipeline.h"
+
+#include "LibVulkan/include/VKDevice.h"
+#include "LibVulkan/include/VKPipelineLayout.h"
+
+namespace Vulkan
+{
+
+void ComputePipeline::initialize(const Device& device, PipelineLayoutWPtr layout)
+{
+    MouCa::preCondition(!device.isNull());
+    MouCa::preCondition(isNull());
+    MouCa::preCondition(!layout.expired());
+    MouCa::preCondition(_shaderStages.getNbShaders() == 1); // DEV Issue: need only compute shader !
+
+    _layout = layout;
+
+    const VkComputePipelineCreateInfo createInfo
+    {
+        VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,         // VkStructureType                    sType;
+        nullptr,                                                // const void*                        pNext;
+        0,                                                      // VkPipelineCreateFlags              flags;
+        *_shaderStages.getStage(),                              // VkPipelineShaderStageCreateInfo    stage;
+        _layout.lock()->getInstance(),                          // VkPipelineLayout                   layout;
+        VK_NULL_HANDLE,                                         // VkPipeline                         basePipelineHandle;
+        0                                                       // int32_t                            basePipelineIndex;
+    };
+    MouCa::assertion(createInfo.stage.stage == VK_SHADER_STAGE_COMPUTE_BIT);
+
+    if (vkCreateComputePipelines(device.getInstance(), VK_NULL_HANDLE, 1, &createInfo, nullptr, &_pipeline) != VK_SUCCESS)
+    {
+        throw Core::Exception(Core::ErrorData("Vulkan", "ComputePipelineCreationError"));
+    }
+
+    MouCa::postCondition(!isNull());
+}
+
+void ComputePipeline::release(const Device& device)
+{
+    MouCa::preCondition(!device.isNull());
+    MouCa::preCondition(!isNull());
+
+    vkDestroyPipeline(device.getInstance(), _pipeline, nullptr);
+
+    _pipeline = VK_NULL_HANDLE;
+
+    MouCa::postCondition(isNull());
+}
+
+}
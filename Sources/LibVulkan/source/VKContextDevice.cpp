@@ -38,6 +38,12 @@ void ContextDevice::initialize(const Vulkan::Environment& environment, const std
     // Create Pipeline Cache
     _pipelineCache.initialize(_device);
 
+    // Create descriptor pools on demand
+    _descriptorAllocator.initialize(_device, 32, _deferredRelease.getNbFramesInFlight());
+
+    // Synchronization of frames in flight
+    _frameRing.initialize(_device, _deferredRelease.getNbFramesInFlight(), _device.getQueueFamilyGraphicId());
+
     MouCa::preCondition(!isNull()); //DEV Issue: Something wrong ?
 }
 
@@ -49,6 +55,10 @@ void ContextDevice::release()
 
     _sequences.clear();
 
+    _deferredRelease.release(_device);
+
+    _frameRing.release(_device);
+
     for (auto& commandBuffer : _commandBuffers)
     {
         commandBuffer->release(_device);
@@ -66,6 +76,8 @@ void ContextDevice::release()
         graphicsPipeline->release(_device);
     }
     _graphicsPipelines.clear();
+    _shaderPipelines.clear();
+    _nbIndexedPipelines = 0;
     
     for (auto& pipelineLayout : _pipelineLayouts)
     {
@@ -85,6 +97,9 @@ void ContextDevice::release()
     }
     _descriptorSets.clear();
 
+    // After sets: pools own sets of DescriptorSet
+    _descriptorAllocator.release(_device);
+
     for (auto& descriptorPool : _descriptorPools)
     {
         descriptorPool->release(_device);
@@ -154,6 +169,56 @@ void ContextDevice::release()
     MouCa::preCondition(isNull()); //DEV Issue: Something wrong ?
 }
 
+VkResult ContextDevice::beginFrame(const uint64_t timeout)
+{
+    MouCa::preCondition(!isNull());
+
+    const VkResult result = _frameRing.beginFrame(_device, timeout);
+    if (result == VK_SUCCESS)
+    {
+        // GPU doesn't use anymore objects of this slot
+        _deferredRelease.nextFrame(_device);
+        _descriptorAllocator.beginFrame(_device, _frameRing.getCurrent());
+
+        refreshDescriptorSets();
+    }
+    return result;
+}
+
+void ContextDevice::refreshDescriptorSets()
+{
+    const bool isDirty = std::any_of(_descriptorSets.cbegin(), _descriptorSets.cend(), [](const auto& set) { return set->isDirty(); });
+    if (!isDirty)
+    {
+        return;
+    }
+
+    // Other frames in flight can still use old buffer into sets
+    synchronize();
+    for (auto& set : _descriptorSets)
+    {
+        set->refresh(_device);
+    }
+
+    // Sets keep their handles: commands binding them are not modified but must be recorded again
+    ICommandBuffer::invalidateAll();
+    _signalDescriptorsRefreshed.emit();
+}
+
+void ContextDevice::synchronize() const
+{
+    MouCa::preCondition(!isNull());
+
+    if (!_frameRing.isRunning())
+    {
+        _device.waitIdle();
+    }
+    else if (_frameRing.wait(_device) != VK_SUCCESS)
+    {
+        throw Core::Exception(Core::ErrorData("VulkanError", "LockedDevice"));
+    }
+}
+
 void ContextDevice::removeImage(ImageWPtr data)
 {
     MouCa::preCondition(!data.expired()); //DEV Issue: Need valid data
@@ -186,6 +251,33 @@ void ContextDevice::removeRenderPass(RenderPassWPtr renderpass)
     _renderPasses.erase(itErase);
 }
 
+const GraphicsPipelines& ContextDevice::getGraphicsPipelines(const ShaderModule& module)
+{
+    // Pipelines are never removed (except by release): count is enough to detect new ones
+    if (_nbIndexedPipelines != _graphicsPipelines.size())
+    {
+        _shaderPipelines.clear();
+        for (const auto& pipeline : _graphicsPipelines)
+        {
+            for (const auto& shader : pipeline->getInfo().getStages().getShadersData())
+            {
+                MouCa::assertion(!shader._module.expired());
+                auto& pipelines = _shaderPipelines[shader._module.lock().get()];
+                // Same module can be used by several stages
+                if (pipelines.empty() || pipelines.back() != pipeline)
+                {
+                    pipelines.emplace_back(pipeline);
+                }
+            }
+        }
+        _nbIndexedPipelines = _graphicsPipelines.size();
+    }
+
+    static const GraphicsPipelines noPipeline;
+    const auto itPipelines = _shaderPipelines.find(&module);
+    return itPipelines != _shaderPipelines.cend() ? itPipelines->second : noPipeline;
+}
+
 void ContextDevice::removeFence(FenceWPtr fence)
 {
     MouCa::preCondition(!fence.expired()); //DEV Issue: Need valid data
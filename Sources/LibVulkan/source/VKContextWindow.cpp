@@ -211,7 +211,8 @@ void ContextWindow::resize(const VkExtent2D& newSize)
         // Rebuild frame buffer
         fillFrameBuffer(renderPass);
 
-        // Refresh command buffer
+        // Refresh command buffer (new swapchain objects can reuse old handles)
+        _commandBuffer->invalidate();
         _commandBuffer->execute(VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
 //         for(auto& commandBuffer : _commandBuffers)
 //         {
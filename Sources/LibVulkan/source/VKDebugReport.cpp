@@ -2,6 +2,9 @@
 /// \author  Rominitch
 /// \license No license
 #include "Dependencies.h"
+
+#include <LibCore/include/CoreLogger.h>
+
 #include <LibVulkan/include/VKDebugReport.h>
 
 namespace Vulkan
@@ -73,19 +76,16 @@ VKAPI_ATTR VkBool32 VKAPI_CALL DebugReport::debugCallback(VkDebugReportFlagsEXT
     else if(flags & VK_DEBUG_REPORT_DEBUG_BIT_EXT)
         typeError = "Debug";
 
-    Core::String message(msg);
-
-    Core::String print;
-    if(flags & VK_DEBUG_REPORT_ERROR_BIT_EXT || flags & VK_DEBUG_REPORT_WARNING_BIT_EXT)
-    {
-        print = std::format("----------------------------------------------------------\r\nVulkan: {}:\r\n\t{}\r\n----------------------------------------------------------\r\n", typeError, message);
-    }
-    else
-    {
-        print = std::format("Vulkan: {}:\t{}\r\n", typeError, message);
-    }
+    Core::Logger::Severity severity = Core::Logger::Severity::Debug;
+    if(flags & VK_DEBUG_REPORT_ERROR_BIT_EXT)
+        severity = Core::Logger::Severity::Error;
+    else if(flags & (VK_DEBUG_REPORT_WARNING_BIT_EXT | VK_DEBUG_REPORT_PERFORMANCE_WARNING_BIT_EXT))
+        severity = Core::Logger::Severity::Warning;
+    else if(flags & VK_DEBUG_REPORT_INFORMATION_BIT_EXT)
+        severity = Core::Logger::Severity::Info;
 
-    MouCa::logConsole(print);
+    // Message is copied: driver releases it after callback
+    MOUCA_LOG(Vulkan, severity, "{}: {}", typeError, msg);
 
     return (flags & VK_DEBUG_REPORT_ERROR_BIT_EXT) ? VK_TRUE : VK_FALSE;
 }
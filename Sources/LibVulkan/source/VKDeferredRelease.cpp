@@ -0,0 +1,65 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibVulkan/include/VKDeferredRelease.h"
+
+#include "LibVulkan/include/VKBuffer.h"
+#include "LibVulkan/include/VKDevice.h"
+
+namespace Vulkan
+{
+
+DeferredRelease::DeferredRelease(const uint32_t nbFramesInFlight):
+_frame(0), _nbFramesInFlight(nbFramesInFlight)
+{
+    MouCa::preCondition(_nbFramesInFlight > 0);
+}
+
+void DeferredRelease::add(BufferUPtr&& buffer)
+{
+    MouCa::preCondition(buffer != nullptr && !buffer->isNull());
+
+    // Releaser must be copyable
+    add([shared = BufferSPtr(std::move(buffer))](const Device& device)
+    {
+        shared->release(device);
+    });
+}
+
+void DeferredRelease::add(Releaser&& releaser)
+{
+    MouCa::preCondition(releaser != nullptr);
+
+    _objects.emplace_back(PendingObject{ std::move(releaser), _frame });
+}
+
+void DeferredRelease::nextFrame(const Device& device)
+{
+    MouCa::preCondition(!device.isNull());
+
+    ++_frame;
+
+    // Frame N is done when frame N + nbFramesInFlight starts
+    while (!_objects.empty() && _objects.front()._frame + _nbFramesInFlight <= _frame)
+    {
+        _objects.front()._releaser(device);
+        _objects.pop_front();
+    }
+}
+
+void DeferredRelease::release(const Device& device)
+{
+    MouCa::preCondition(!device.isNull());
+
+    for (auto& pending : _objects)
+    {
+        pending._releaser(device);
+    }
+    _objects.clear();
+
+    MouCa::postCondition(isNull());
+}
+
+}
@@ -0,0 +1,340 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibVulkan/include/VKDescriptorAllocator.h"
+
+#include "LibVulkan/include/VKBuffer.h"
+#include "LibVulkan/include/VKDescriptorSet.h"
+#include "LibVulkan/include/VKDevice.h"
+
+namespace Vulkan
+{
+
+namespace
+{
+    template<typename Handle>
+    uint64_t toKey(const Handle handle)
+    {
+        if constexpr (std::is_pointer_v<Handle>)
+        {
+            return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(handle));
+        }
+        else
+        {
+            return static_cast<uint64_t>(handle);
+        }
+    }
+}
+
+size_t DescriptorAllocator::CacheKeyHasher::operator()(const CacheKey& key) const
+{
+    // FNV-1a on words
+    uint64_t hash = 14695981039346656037ull;
+    for (const uint64_t word : key)
+    {
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+}
+
+DescriptorAllocator::DescriptorAllocator():
+_setsByPool(0), _nbFrames(0), _currentFrame(0), _frame(0)
+{}
+
+void DescriptorAllocator::initialize(const Device& device, const uint32_t setsByPool, const uint32_t nbFramesInFlight)
+{
+    MouCa::preCondition(isNull());
+    MouCa::preCondition(!device.isNull());
+    MouCa::preCondition(setsByPool > 0);
+    MouCa::preCondition(nbFramesInFlight > 0);
+
+    _setsByPool   = setsByPool;
+    _nbFrames     = nbFramesInFlight;
+    _currentFrame = 0;
+    _frame        = 0;
+    _statistics = Statistics();
+
+    MouCa::postCondition(!isNull());
+}
+
+void DescriptorAllocator::release(const Device& device)
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(!device.isNull());
+
+    // Sets are released with their pool
+    const auto releasePools = [&](Pools& pools)
+    {
+        for (auto& pool : pools._pools)
+        {
+            pool->release(device);
+        }
+    };
+    for (auto& layout : _layouts)
+    {
+        releasePools(layout.second._persistent);
+        std::for_each(layout.second._transient.begin(), layout.second._transient.end(), releasePools);
+    }
+    disconnectBuffers();
+    _layouts.clear();
+    _cache.clear();
+    _evicted.clear();
+    _setsByPool = 0;
+    _nbFrames   = 0;
+
+    MouCa::postCondition(isNull());
+}
+
+VkDescriptorSet DescriptorAllocator::allocate(const Device& device, const DescriptorSetLayout& layout, const bool transient)
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(!layout.isNull());
+
+    auto& layoutPools = _layouts[layout.getInstance()];
+    if (!transient)
+    {
+        return allocate(device, layout, layoutPools._persistent);
+    }
+
+    layoutPools._transient.resize(_nbFrames);
+    return allocate(device, layout, layoutPools._transient[_currentFrame]);
+}
+
+VkDescriptorSet DescriptorAllocator::allocate(const Device& device, const DescriptorSetLayout& layout, Pools& pools)
+{
+    VkDescriptorSetAllocateInfo allocateInfo
+    {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,     // VkStructureType                 sType;
+        nullptr,                                            // const void*                     pNext;
+        VK_NULL_HANDLE,                                     // VkDescriptorPool                descriptorPool;
+        1,                                                  // uint32_t                        descriptorSetCount;
+        &layout.getInstance()                               // const VkDescriptorSetLayout*    pSetLayouts;
+    };
+
+    VkDescriptorSet set = VK_NULL_HANDLE;
+    for (; pools._current < pools._pools.size(); ++pools._current)
+    {
+        allocateInfo.descriptorPool = pools._pools[pools._current]->getInstance();
+        const VkResult result = vkAllocateDescriptorSets(device.getInstance(), &allocateInfo, &set);
+        if (result == VK_SUCCESS)
+        {
+            ++_statistics._nbAllocations;
+            return set;
+        }
+        if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL)
+        {
+            throw Core::Exception(Core::ErrorData("Vulkan", "DescriptorSetAllocateError"));
+        }
+    }
+
+    // All pools are exhausted: new pool is twice bigger than previous one
+    const uint32_t maxSets = _setsByPool << std::min<size_t>(pools._pools.size(), 8);
+    std::vector<VkDescriptorPoolSize> sizes;
+    sizes.reserve(layout.getBindings().size());
+    for (const auto& binding : layout.getBindings())
+    {
+        sizes.emplace_back(VkDescriptorPoolSize{ binding.descriptorType, binding.descriptorCount * maxSets });
+    }
+
+    auto pool = std::make_unique<DescriptorPool>();
+    pool->initialize(device, sizes, maxSets, 0);
+    allocateInfo.descriptorPool = pool->getInstance();
+    pools._pools.emplace_back(std::move(pool));
+    ++_statistics._nbPools;
+
+    if (vkAllocateDescriptorSets(device.getInstance(), &allocateInfo, &set) != VK_SUCCESS)
+    {
+        throw Core::Exception(Core::ErrorData("Vulkan", "DescriptorSetAllocateError"));
+    }
+    ++_statistics._nbAllocations;
+    return set;
+}
+
+VkDescriptorSet DescriptorAllocator::getCached(const Device& device, const DescriptorSetLayout& layout, std::vector<WriteDescriptorSet>& writes)
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(!layout.isNull());
+    MouCa::preCondition(!writes.empty());
+
+    // Build key with resolved handles
+    std::vector<VkWriteDescriptorSet> writeSets;
+    writeSets.reserve(writes.size());
+
+    _key.clear();
+    _key.emplace_back(toKey(layout.getInstance()));
+    for (auto& write : writes)
+    {
+        const auto& writeSet = writeSets.emplace_back(write.compute(VK_NULL_HANDLE));
+        _key.emplace_back((static_cast<uint64_t>(writeSet.dstBinding) << 32) | static_cast<uint64_t>(writeSet.descriptorType));
+        _key.emplace_back((static_cast<uint64_t>(writeSet.dstArrayElement) << 32) | static_cast<uint64_t>(writeSet.descriptorCount));
+        for (uint32_t id = 0; id < writeSet.descriptorCount; ++id)
+        {
+            if (writeSet.pImageInfo != nullptr)
+            {
+                _key.emplace_back(toKey(writeSet.pImageInfo[id].sampler));
+                _key.emplace_back(toKey(writeSet.pImageInfo[id].imageView));
+                _key.emplace_back(static_cast<uint64_t>(writeSet.pImageInfo[id].imageLayout));
+            }
+            else if (writeSet.pBufferInfo != nullptr)
+            {
+                _key.emplace_back(toKey(writeSet.pBufferInfo[id].buffer));
+                _key.emplace_back(writeSet.pBufferInfo[id].offset);
+                _key.emplace_back(writeSet.pBufferInfo[id].range);
+            }
+            else if (writeSet.pTexelBufferView != nullptr)
+            {
+                _key.emplace_back(toKey(writeSet.pTexelBufferView[id]));
+            }
+            else if (writeSet.pNext != nullptr)
+            {
+                const auto* acceleration = reinterpret_cast<const VkWriteDescriptorSetAccelerationStructureKHR*>(writeSet.pNext);
+                _key.emplace_back(toKey(acceleration->pAccelerationStructures[id]));
+            }
+        }
+    }
+
+    auto itCache = _cache.find(_key);
+    if (itCache != _cache.cend())
+    {
+        ++_statistics._nbCacheHits;
+        return itCache->second._set;
+    }
+    ++_statistics._nbCacheMisses;
+
+    // New content: reuse evicted set when GPU doesn't use it anymore
+    auto& recycled = _layouts[layout.getInstance()]._recycled;
+    VkDescriptorSet set = VK_NULL_HANDLE;
+    if (!recycled.empty())
+    {
+        set = recycled.back();
+        recycled.pop_back();
+    }
+    else
+    {
+        set = allocate(device, layout, false);
+    }
+    for (auto& writeSet : writeSets)
+    {
+        writeSet.dstSet = set;
+    }
+    vkUpdateDescriptorSets(device.getInstance(), static_cast<uint32_t>(writeSets.size()), writeSets.data(), 0, nullptr);
+    ++_statistics._nbUpdates;
+
+    // Evict set when one written buffer changes
+    std::vector<const Buffer*> buffers;
+    for (const auto& write : writes)
+    {
+        for (const auto& info : write.getBufferInfos())
+        {
+            auto buffer = info._buffer.lock();
+            if (buffer == nullptr)
+            {
+                continue;
+            }
+            buffers.emplace_back(buffer.get());
+            if (!buffer->getSignalHandleChanged().isConnected(this))
+            {
+                buffer->getSignalHandleChanged().connectMember(this, &DescriptorAllocator::onBufferChanged);
+                buffer->getSignalRelease().connectMember(this, &DescriptorAllocator::onBufferChanged);
+                _buffers.emplace_back(buffer);
+            }
+        }
+    }
+
+    _cache.emplace(_key, CacheEntry{ set, layout.getInstance(), std::move(buffers) });
+    return set;
+}
+
+void DescriptorAllocator::onBufferChanged(Buffer& buffer)
+{
+    for (auto itCache = _cache.begin(); itCache != _cache.end();)
+    {
+        const auto& buffers = itCache->second._buffers;
+        if (std::find(buffers.cbegin(), buffers.cend(), &buffer) != buffers.cend())
+        {
+            _evicted.emplace_back(EvictedSet{ itCache->second._set, itCache->second._layout, _frame });
+            itCache = _cache.erase(itCache);
+            ++_statistics._nbEvictions;
+        }
+        else
+        {
+            ++itCache;
+        }
+    }
+}
+
+void DescriptorAllocator::disconnectBuffers()
+{
+    for (const auto& weakBuffer : _buffers)
+    {
+        if (auto buffer = weakBuffer.lock())
+        {
+            buffer->getSignalHandleChanged().disconnect(this);
+            buffer->getSignalRelease().disconnect(this);
+        }
+    }
+    _buffers.clear();
+}
+
+void DescriptorAllocator::reset(const Device& device, Pools& pools)
+{
+    for (auto& pool : pools._pools)
+    {
+        pool->reset(device);
+    }
+    pools._current = 0;
+}
+
+void DescriptorAllocator::beginFrame(const Device& device, const uint32_t frameID)
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(frameID < _nbFrames);
+
+    _currentFrame = frameID;
+    ++_frame;
+    for (auto& layout : _layouts)
+    {
+        if (_currentFrame < layout.second._transient.size())
+        {
+            reset(device, layout.second._transient[_currentFrame]);
+        }
+    }
+
+    // Frames which could bind evicted sets are finished
+    while (!_evicted.empty() && _evicted.front()._frame + _nbFrames <= _frame)
+    {
+        _layouts[_evicted.front()._layout]._recycled.emplace_back(_evicted.front()._set);
+        _evicted.pop_front();
+    }
+}
+
+void DescriptorAllocator::resetTransient(const Device& device)
+{
+    MouCa::preCondition(!isNull());
+
+    for (auto& layout : _layouts)
+    {
+        for (auto& pools : layout.second._transient)
+        {
+            reset(device, pools);
+        }
+    }
+}
+
+void DescriptorAllocator::clearCache(const Device& device)
+{
+    MouCa::preCondition(!isNull());
+
+    for (auto& layout : _layouts)
+    {
+        reset(device, layout.second._persistent);
+        layout.second._recycled.clear();
+    }
+    disconnectBuffers();
+    _cache.clear();
+    _evicted.clear();
+}
+
+}
@@ -4,6 +4,8 @@
 #include "Dependencies.h"
 
 #include "LibVulkan/include/VKAccelerationStructure.h"
+#include "LibVulkan/include/VKBuffer.h"
+#include "LibVulkan/include/VKDescriptorAllocator.h"
 #include "LibVulkan/include/VKDescriptorSet.h"
 #include "LibVulkan/include/VKDevice.h"
 #include "LibVulkan/include/VKImage.h"
@@ -17,7 +19,7 @@ DescriptorPool::DescriptorPool():
 _pool(VK_NULL_HANDLE)
 {}
 
-void DescriptorPool::initialize(const Device& device, const std::vector<VkDescriptorPoolSize>& poolSizes, const uint32_t maxSets)
+void DescriptorPool::initialize(const Device& device, const std::vector<VkDescriptorPoolSize>& poolSizes, const uint32_t maxSets, const VkDescriptorPoolCreateFlags flags)
 {
     MouCa::preCondition(isNull());
     MouCa::preCondition(!device.isNull());
@@ -26,7 +28,7 @@ void DescriptorPool::initialize(const Device& device, const std::vector<VkDescri
     {
         VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,      // VkStructureType                sType;
         nullptr,                                            // const void*                    pNext;
-        VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,  // VkDescriptorPoolCreateFlags    flags;
+        flags,                                              // VkDescriptorPoolCreateFlags    flags;
         maxSets,                                            // uint32_t                       maxSets;
         static_cast<uint32_t>(poolSizes.size()),            // uint32_t                       poolSizeCount;
         poolSizes.data()                                    // const VkDescriptorPoolSize*    pPoolSizes;
@@ -48,6 +50,17 @@ void DescriptorPool::release(const Device& device)
     _pool = VK_NULL_HANDLE;
 }
 
+void DescriptorPool::reset(const Device& device) const
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(!device.isNull());
+
+    if (vkResetDescriptorPool(device.getInstance(), _pool, 0) != VK_SUCCESS)
+    {
+        throw Core::Exception(Core::ErrorData("Vulkan", "DescriptorPoolResetError"));
+    }
+}
+
 DescriptorSetLayout::DescriptorSetLayout():
 _layout(VK_NULL_HANDLE)
 {
@@ -165,6 +178,11 @@ VkWriteDescriptorSet WriteDescriptorSet::compute(const DescriptorSet& set, const
     MouCa::preCondition(!set.isNull());
     MouCa::preCondition(setId < set.getDescriptorSets().size());
 
+    return compute(set.getDescriptorSets()[setId]);
+}
+
+VkWriteDescriptorSet WriteDescriptorSet::compute(const VkDescriptorSet dstSet)
+{
     if(_type != VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR)
     {
         // Compute local vulkan array
@@ -195,7 +213,7 @@ VkWriteDescriptorSet WriteDescriptorSet::compute(const DescriptorSet& set, const
         {
             VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,   // VkStructureType                  sType;
             nullptr,                                  // const void*                      pNext;
-            set.getDescriptorSets()[setId],           // VkDescriptorSet                  dstSet;
+            dstSet,                                   // VkDescriptorSet                  dstSet;
             _dstBinding,                              // uint32_t                         dstBinding;
             0,                                        // uint32_t                         dstArrayElement;
             static_cast<uint32_t>(_vkImageInfo.size() + _vkBufferInfo.size() + _vkBufferView.size()),    // uint32_t                         descriptorCount;
@@ -226,7 +244,7 @@ VkWriteDescriptorSet WriteDescriptorSet::compute(const DescriptorSet& set, const
         {
             VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,   // VkStructureType                  sType;
             &_accelerationStructure,                  // const void*                      pNext;
-            set.getDescriptorSets()[setId],           // VkDescriptorSet                  dstSet;
+            dstSet,                                   // VkDescriptorSet                  dstSet;
             _dstBinding,                              // uint32_t                         dstBinding;
             0,                                        // uint32_t                         dstArrayElement;
             static_cast<uint32_t>(_vkAccelerationStruct.size()),    // uint32_t                         descriptorCount;
@@ -283,6 +301,24 @@ void DescriptorSet::initialize(const Device& device, const DescriptorPoolWPtr& d
 #endif
 }
 
+void DescriptorSet::initialize(const Device& device, DescriptorAllocator& allocator, const std::vector<const DescriptorSetLayout*>& layouts)
+{
+    MouCa::preCondition(isNull());
+    MouCa::preCondition(!device.isNull());
+    MouCa::preCondition(!allocator.isNull());
+    MouCa::preCondition(!layouts.empty());
+
+    _descriptors.reserve(layouts.size());
+    for (const auto* layout : layouts)
+    {
+        MouCa::assertion(layout != nullptr);
+        _descriptors.emplace_back(allocator.allocate(device, *layout));
+    }
+    _allocator = &allocator;
+
+    MouCa::postCondition(!isNull());
+}
+
 void DescriptorSet::update(const Device& device, const uint32_t setId, std::vector<WriteDescriptorSet>&& writeDescriptor)
 {
     MouCa::preCondition(!isNull());
@@ -291,6 +327,21 @@ void DescriptorSet::update(const Device& device, const uint32_t setId, std::vect
     _writeDescriptor = std::move(writeDescriptor);
     _setId           = setId;
 
+    // Follow new handle of buffers
+    disconnectBuffers();
+    for (const auto& write : _writeDescriptor)
+    {
+        for (const auto& info : write.getBufferInfos())
+        {
+            auto buffer = info._buffer.lock();
+            if (buffer != nullptr && !buffer->getSignalHandleChanged().isConnected(this))
+            {
+                buffer->getSignalHandleChanged().connectMember(this, &DescriptorSet::onBufferChanged);
+                _buffers.emplace_back(buffer);
+            }
+        }
+    }
+
     update(device);
 }
 
@@ -316,12 +367,54 @@ void DescriptorSet::update(const Device& device)
 //         });
 
     vkUpdateDescriptorSets(device.getInstance(), static_cast<uint32_t>(writeSets.size()), writeSets.data(), 0, nullptr);
+    _dirty = false;
+}
+
+bool DescriptorSet::refresh(const Device& device)
+{
+    MouCa::preCondition(!isNull());
+
+    if (!_dirty)
+    {
+        return false;
+    }
+    update(device);
+    return true;
+}
+
+void DescriptorSet::onBufferChanged(Buffer&)
+{
+    _dirty = true;
+}
+
+void DescriptorSet::disconnectBuffers()
+{
+    for (const auto& weakBuffer : _buffers)
+    {
+        if (auto buffer = weakBuffer.lock())
+        {
+            buffer->getSignalHandleChanged().disconnect(this);
+        }
+    }
+    _buffers.clear();
 }
 
 void DescriptorSet::release(const Device& device)
 {
     MouCa::preCondition(!isNull());
     MouCa::preCondition(!device.isNull());
+
+    disconnectBuffers();
+    _dirty = false;
+
+    // Sets of allocator are released with its pools
+    if (_allocator != nullptr)
+    {
+        _descriptors.clear();
+        _allocator = nullptr;
+        return;
+    }
+
     MouCa::preCondition(!_pool.expired());
 
     if(vkFreeDescriptorSets(device.getInstance(), _pool.lock()->getInstance(), static_cast<uint32_t>(_descriptors.size()), _descriptors.data()) != VK_SUCCESS)
@@ -20,9 +20,13 @@ namespace Vulkan
 Device::Device() :
     _device(VK_NULL_HANDLE),
     _queueGraphic(VK_NULL_HANDLE),
+    _queueCompute(VK_NULL_HANDLE),
+    _queueTransfer(VK_NULL_HANDLE),
+    _timelineSemaphore(VK_FALSE),
     _colorFormat(VK_FORMAT_UNDEFINED),
     _depthFormat(VK_FORMAT_UNDEFINED),
     _rayTracingPipelineProperties({VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_PROPERTIES_KHR}),
+    _accelerationStructureProperties({VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR}),
     _accelerationStructureFeatures({VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR})
 {
     MouCa::preCondition(isNull());			                //Dev Issue: Bad constructor !
@@ -50,6 +54,7 @@ void Device::initialize(const VkPhysicalDevice physicalDevice, const uint32_t qu
     // Get physical device properties
     vkGetPhysicalDeviceProperties(physicalDevice, &_properties);
 
+    _rayTracingPipelineProperties.pNext = &_accelerationStructureProperties;
     VkPhysicalDeviceProperties2 properties
     {
         VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
@@ -69,6 +74,22 @@ void Device::initialize(const VkPhysicalDevice physicalDevice, const uint32_t qu
     VkPhysicalDeviceFeatures features;
     vkGetPhysicalDeviceFeatures(physicalDevice, &features);
 
+    // Timeline semaphore support (core 1.2: stay disabled on older device)
+    VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures
+    {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES,
+        nullptr,
+        VK_FALSE
+    };
+    VkPhysicalDeviceFeatures2 timelineFeatures2
+    {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        &timelineFeatures,
+        {}
+    };
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &timelineFeatures2);
+    _timelineSemaphore = timelineFeatures.timelineSemaphore;
+
     _queueFamilyIndices._graphics = getQueueFamiliyIndex(VK_QUEUE_GRAPHICS_BIT);
 
     _queueFamilyIndices._compute  = getQueueFamiliyIndex(VK_QUEUE_COMPUTE_BIT);
@@ -140,20 +161,29 @@ void Device::initialize(const VkPhysicalDevice physicalDevice, const uint32_t qu
     };
 
     //Build feature v2 (support of raytracing)
-    const VkPhysicalDeviceFeatures2 physicalDeviceFeatures2
+    VkPhysicalDeviceFeatures2 physicalDeviceFeatures2
     {
         VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
         _enabled.getNext(),
         _enabled._features,
     };
+    void* nextFeatures = nullptr;
     
     // Enable raytracing
     if(std::find(extensions.cbegin(), extensions.cend(), VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME) != extensions.cend())
     {
-        deviceCreateInfo.pNext            = &physicalDeviceFeatures2;
+        nextFeatures                      = &physicalDeviceFeatures2;
         deviceCreateInfo.pEnabledFeatures = nullptr;
     }
 
+    // Enable timeline semaphore
+    if(_timelineSemaphore == VK_TRUE)
+    {
+        timelineFeatures.pNext = nextFeatures;
+        nextFeatures           = &timelineFeatures;
+    }
+    deviceCreateInfo.pNext = nextFeatures;
+
     // Build Device
     VkDevice deviceID;
     if(vkCreateDevice(physicalDevice, &deviceCreateInfo, nullptr, &deviceID) != VK_SUCCESS)
@@ -185,6 +215,8 @@ void Device::initialize(const VkPhysicalDevice physicalDevice, const uint32_t qu
     // Load Extensions
     vkGetBufferDeviceAddressKHR                 = reinterpret_cast<PFN_vkGetBufferDeviceAddressKHR>(vkGetDeviceProcAddr(deviceID, "vkGetBufferDeviceAddressKHR"));
     vkCmdBuildAccelerationStructuresKHR         = reinterpret_cast<PFN_vkCmdBuildAccelerationStructuresKHR>(vkGetDeviceProcAddr(deviceID, "vkCmdBuildAccelerationStructuresKHR"));
+    vkCmdCopyAccelerationStructureKHR           = reinterpret_cast<PFN_vkCmdCopyAccelerationStructureKHR>(vkGetDeviceProcAddr(deviceID, "vkCmdCopyAccelerationStructureKHR"));
+    vkCmdWriteAccelerationStructuresPropertiesKHR = reinterpret_cast<PFN_vkCmdWriteAccelerationStructuresPropertiesKHR>(vkGetDeviceProcAddr(deviceID, "vkCmdWriteAccelerationStructuresPropertiesKHR"));
     vkBuildAccelerationStructuresKHR            = reinterpret_cast<PFN_vkBuildAccelerationStructuresKHR>(vkGetDeviceProcAddr(deviceID, "vkBuildAccelerationStructuresKHR"));
     vkCreateAccelerationStructureKHR            = reinterpret_cast<PFN_vkCreateAccelerationStructureKHR>(vkGetDeviceProcAddr(deviceID, "vkCreateAccelerationStructureKHR"));
     vkDestroyAccelerationStructureKHR           = reinterpret_cast<PFN_vkDestroyAccelerationStructureKHR>(vkGetDeviceProcAddr(deviceID, "vkDestroyAccelerationStructureKHR"));
@@ -193,6 +225,7 @@ void Device::initialize(const VkPhysicalDevice physicalDevice, const uint32_t qu
     vkCmdTraceRaysKHR                           = reinterpret_cast<PFN_vkCmdTraceRaysKHR>(vkGetDeviceProcAddr(deviceID, "vkCmdTraceRaysKHR"));
     vkGetRayTracingShaderGroupHandlesKHR        = reinterpret_cast<PFN_vkGetRayTracingShaderGroupHandlesKHR>(vkGetDeviceProcAddr(deviceID, "vkGetRayTracingShaderGroupHandlesKHR"));
     vkCreateRayTracingPipelinesKHR              = reinterpret_cast<PFN_vkCreateRayTracingPipelinesKHR>(vkGetDeviceProcAddr(deviceID, "vkCreateRayTracingPipelinesKHR"));
+    vkCmdDrawIndexedIndirectCountKHR            = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(vkGetDeviceProcAddr(deviceID, "vkCmdDrawIndexedIndirectCountKHR"));
 
     MouCa::postCondition(!isNull());
 }
@@ -208,6 +241,8 @@ void Device::configureDevice(const VkPhysicalDevice physicalDevice, const VkDevi
     _device         = deviceID;
 
     vkGetDeviceQueue(_device, _queueFamilyIndices._graphics, 0, &_queueGraphic);
+    vkGetDeviceQueue(_device, _queueFamilyIndices._compute,  0, &_queueCompute);
+    vkGetDeviceQueue(_device, _queueFamilyIndices._transfer, 0, &_queueTransfer);
 
     vkGetPhysicalDeviceMemoryProperties(physicalDevice, &_memoryProperties);
     //vkGetPhysicalDeviceFeatures(physicalDevice, &_enabledFeatures);
@@ -240,11 +275,12 @@ void Device::configureDevice(const VkPhysicalDevice physicalDevice, const VkDevi
     MouCa::postCondition(!isNull());
 }
 
-void Device::initializeBestGPU(const Environment& environment, const std::vector<const char*>& extensions, const Surface* surface, const PhysicalDeviceFeatures& enabled)
+void Device::initializeBestGPU(const Environment& environment, const std::vector<const char*>& extensions, const Surface* surface, const PhysicalDeviceFeatures& enabled, const PhysicalDeviceTypes& deviceTypes)
 {
     MouCa::preCondition(!environment.isNull());
     MouCa::preCondition(isNull());
     MouCa::preCondition(surface == nullptr || !surface->isNull());
+    MouCa::preCondition(!deviceTypes.empty());
 
     _enabled = enabled;
 
@@ -260,10 +296,12 @@ void Device::initializeBestGPU(const Environment& environment, const std::vector
         vkGetPhysicalDeviceProperties(physicalDevice, &candidate.properties);
         vkGetPhysicalDeviceFeatures(physicalDevice, &candidate.features);
 
-        if(candidate.properties.deviceType != VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
+        const auto itType = std::find(deviceTypes.cbegin(), deviceTypes.cend(), candidate.properties.deviceType);
+        if(itType == deviceTypes.cend())
         {
             continue;
         }
+        candidate.typeRank = static_cast<size_t>(std::distance(deviceTypes.cbegin(), itType));
 
         // Check extensions are fully supported
         if(!extensions.empty())
@@ -357,8 +395,11 @@ void Device::release()
     //Release device
     vkDestroyDevice(_device, nullptr);
         
-    _device       = VK_NULL_HANDLE;
-    _queueGraphic = VK_NULL_HANDLE;
+    _device            = VK_NULL_HANDLE;
+    _queueGraphic      = VK_NULL_HANDLE;
+    _queueCompute      = VK_NULL_HANDLE;
+    _queueTransfer     = VK_NULL_HANDLE;
+    _timelineSemaphore = VK_FALSE;
 
     MouCa::postCondition(isNull());
 }
@@ -0,0 +1,114 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibVulkan/include/VKFrameRing.h"
+
+#include "LibVulkan/include/VKDevice.h"
+
+namespace Vulkan
+{
+
+FrameRing::FrameRing():
+_current(0), _frame(0), _submitted(true)
+{}
+
+void FrameRing::initialize(const Device& device, const uint32_t nbFrames, const uint32_t queueFamilyID)
+{
+    MouCa::preCondition(isNull());
+    MouCa::preCondition(!device.isNull());
+    MouCa::preCondition(nbFrames > 0);
+
+    _frames.reserve(nbFrames);
+    _fences.reserve(nbFrames);
+    for (uint32_t id = 0; id < nbFrames; ++id)
+    {
+        auto& frame = _frames.emplace_back(std::make_unique<Frame>());
+
+        // Signaled: first use of slot doesn't wait
+        frame->_fence.initialize(device, VK_FENCE_CREATE_SIGNALED_BIT);
+        frame->_acquire.initialize(device);
+        frame->_render.initialize(device);
+        frame->_commandPool.initialize(device, queueFamilyID, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+
+        _fences.emplace_back(frame->_fence.getInstance());
+    }
+    _current   = 0;
+    _frame     = 0;
+    _submitted = true;
+
+    MouCa::postCondition(!isNull());
+}
+
+void FrameRing::release(const Device& device)
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(!device.isNull());
+
+    for (auto& frame : _frames)
+    {
+        frame->_commandPool.release(device);
+        frame->_render.release(device);
+        frame->_acquire.release(device);
+        frame->_fence.release(device);
+    }
+    _frames.clear();
+    _fences.clear();
+
+    MouCa::postCondition(isNull());
+}
+
+VkResult FrameRing::beginFrame(const Device& device, const uint64_t timeout)
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(!device.isNull());
+
+    close(device);
+
+    const uint32_t next = static_cast<uint32_t>(_frame % _frames.size());
+    const auto& frame = *_frames[next];
+
+    // Wait only frame which used this slot
+    const VkResult result = vkWaitForFences(device.getInstance(), 1, &frame._fence.getInstance(), VK_TRUE, timeout);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    if (vkResetFences(device.getInstance(), 1, &frame._fence.getInstance()) != VK_SUCCESS)
+    {
+        throw Core::Exception(Core::ErrorData("Vulkan", "FenceResetError"));
+    }
+    frame._commandPool.reset(device);
+
+    _current   = next;
+    _submitted = false;
+    ++_frame;
+    return VK_SUCCESS;
+}
+
+VkResult FrameRing::wait(const Device& device, const uint64_t timeout) const
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(!device.isNull());
+
+    close(device);
+
+    return vkWaitForFences(device.getInstance(), static_cast<uint32_t>(_fences.size()), _fences.data(), VK_TRUE, timeout);
+}
+
+void FrameRing::close(const Device& device) const
+{
+    if (!_submitted)
+    {
+        // Empty submit: fence is signaled when previous work of queue is done
+        if (vkQueueSubmit(device.getQueue(), 0, nullptr, _frames[_current]->_fence.getInstance()) != VK_SUCCESS)
+        {
+            throw Core::Exception(Core::ErrorData("Vulkan", "QueueSubmitError"));
+        }
+        _submitted = true;
+    }
+}
+
+}
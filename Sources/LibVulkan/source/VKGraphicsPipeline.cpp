@@ -5,6 +5,7 @@
 
 #include "LibVulkan/include/VKGraphicsPipeline.h"
 
+#include "LibVulkan/include/VKDeferredRelease.h"
 #include "LibVulkan/include/VKDevice.h"
 #include <LibVulkan/include/VKPipelineCache.h>
 #include "LibVulkan/include/VKPipelineLayout.h"
@@ -55,14 +56,43 @@ void GraphicsPipeline::initialize(const Device& device, RenderPassWPtr renderPas
     _layout         = layout;
     _pipelineCache  = pipelineCache;
 
-    const std::array<VkGraphicsPipelineCreateInfo, 1> infos { _infos.buildInfo(*renderPass.lock(), *layout.lock()) };
-    const VkPipelineCache cache = pipelineCache.expired() ? VK_NULL_HANDLE : pipelineCache.lock()->getInstance();
+    _pipeline = create(device);
 
-    if(vkCreateGraphicsPipelines(device.getInstance(), cache, static_cast<uint32_t>(infos.size()), infos.data(), nullptr, &_pipeline) != VK_SUCCESS)
+    MouCa::postCondition(!isNull()); //Dev Issue: Must be initialize !
+}
+
+void GraphicsPipeline::rebuild(const Device& device, DeferredRelease& deferred)
+{
+    MouCa::preCondition(!isNull());                                 // DEV Issue: Must be initialize !
+    MouCa::preCondition(!device.isNull());                          // DEV Issue: 
+    MouCa::preCondition(!_renderPass.expired());                    // DEV Issue: Need initialize() with weak pointers
+    MouCa::preCondition(!_layout.expired());                        // DEV Issue: Need initialize() with weak pointers
+
+    // Read current handles of shader modules
+    _infos.getStages().update();
+
+    // Frames in flight can still use old pipeline
+    const VkPipeline newPipeline = create(device);
+    deferred.add([oldPipeline = _pipeline](const Device& currentDevice)
+    {
+        vkDestroyPipeline(currentDevice.getInstance(), oldPipeline, nullptr);
+    });
+    _pipeline = newPipeline;
+
+    MouCa::postCondition(!isNull()); //Dev Issue: Must be initialize !
+}
+
+VkPipeline GraphicsPipeline::create(const Device& device) const
+{
+    const std::array<VkGraphicsPipelineCreateInfo, 1> infos { _infos.buildInfo(*_renderPass.lock(), *_layout.lock()) };
+    const VkPipelineCache cache = _pipelineCache.expired() ? VK_NULL_HANDLE : _pipelineCache.lock()->getInstance();
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    if(vkCreateGraphicsPipelines(device.getInstance(), cache, static_cast<uint32_t>(infos.size()), infos.data(), nullptr, &pipeline) != VK_SUCCESS)
     {
         throw Core::Exception(Core::ErrorData("Vulkan", "PipelineGraphicCreationError"));
     }
-    MouCa::postCondition(!isNull()); //Dev Issue: Must be initialize !
+    return pipeline;
 }
 
 void GraphicsPipeline::release(const Device& device)
@@ -0,0 +1,236 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#include "Dependencies.h"
+
+#include "LibVulkan/include/VKMeshIndirect.h"
+
+#include <LibRT/include/RTFrustum.h>
+#include <LibRT/include/RTMassiveInstance.h>
+
+#include "LibVulkan/include/VKBuffer.h"
+#include "LibVulkan/include/VKCommand.h"
+#include "LibVulkan/include/VKComputePipeline.h"
+#include "LibVulkan/include/VKDevice.h"
+#include "LibVulkan/include/VKShaderProgram.h"
+
+namespace Vulkan
+{
+
+namespace
+{
+    BufferSPtr createBuffer(const Device& device, const VkMemoryPropertyFlags memoryFlags, const VkBufferUsageFlags usage, const VkDeviceSize size)
+    {
+        auto buffer = std::make_shared<Buffer>(std::make_unique<MemoryBuffer>(memoryFlags));
+        buffer->initialize(device, 0, usage, size);
+        return buffer;
+    }
+
+    /// Compute writes must be visible to next stages.
+    CommandUPtr makeBarrier(const VkPipelineStageFlags dstStage, const VkAccessFlags dstAccess)
+    {
+        CommandPipelineBarrier::MemoryBarriers barriers
+        {
+            {
+                VK_STRUCTURE_TYPE_MEMORY_BARRIER,   // VkStructureType    sType;
+                nullptr,                            // const void*        pNext;
+                VK_ACCESS_SHADER_WRITE_BIT,         // VkAccessFlags      srcAccessMask;
+                dstAccess                           // VkAccessFlags      dstAccessMask;
+            }
+        };
+        return std::make_unique<CommandPipelineBarrier>(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dstStage, 0,
+                                                        std::move(barriers), CommandPipelineBarrier::BufferMemoryBarriers(), CommandPipelineBarrier::ImageMemoryBarriers());
+    }
+}
+
+MeshIndirect::MeshIndirect():
+_pipelineLayout(std::make_shared<PipelineLayout>()), _descriptorPool(std::make_shared<DescriptorPool>()), _pipeline(std::make_shared<ComputePipeline>()),
+_maxMeshes(0), _maxInstances(0)
+{}
+
+MeshIndirect::~MeshIndirect()
+{
+    MouCa::assertion(isNull()); // DEV Issue: call release()
+}
+
+bool MeshIndirect::isNull() const
+{
+    return _pipeline->isNull() && _parameters == nullptr;
+}
+
+void MeshIndirect::initialize(const Device& device, const ShaderModuleWPtr& culling, const uint32_t maxMeshes, const uint32_t maxInstances)
+{
+    MouCa::preCondition(!device.isNull());
+    MouCa::preCondition(isNull());
+    MouCa::preCondition(!culling.expired() && culling.lock()->getStage() == VK_SHADER_STAGE_COMPUTE_BIT);
+    MouCa::preCondition(maxMeshes > 0 && maxInstances > 0);
+
+    _maxMeshes    = maxMeshes;
+    _maxInstances = maxInstances;
+
+    // Buffers
+    const VkMemoryPropertyFlags host = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    _parameters = createBuffer(device, host, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(Parameters));
+    _instances  = createBuffer(device, host, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, sizeof(Instance) * maxInstances);
+    _meshes     = createBuffer(device, host, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, sizeof(Mesh) * maxMeshes);
+    _draws      = createBuffer(device, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, sizeof(VkDrawIndexedIndirectCommand) * maxMeshes);
+    _visibles   = createBuffer(device, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                               sizeof(Instance) * maxInstances);
+    _commands   = createBuffer(device, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                               sizeof(VkDrawIndexedIndirectCommand) * maxMeshes);
+    _count      = createBuffer(device, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                               sizeof(uint32_t));
+
+    // Nothing to draw until first update
+    auto& memory = _parameters->getMemory();
+    memory.map(device);
+    *memory.getMappedMemory<Parameters>() = {};
+    memory.unmap(device);
+
+    // Descriptors: same order than culling.comp
+    _descriptorSetLayout.addBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+    for (uint32_t binding = 1; binding <= 6; ++binding)
+    {
+        _descriptorSetLayout.addBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+    }
+    _descriptorSetLayout.initialize(device);
+
+    const std::vector<VkDescriptorPoolSize> poolSizes
+    {
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1 },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 6 }
+    };
+    _descriptorPool->initialize(device, poolSizes, 1);
+
+    _descriptorSet.initialize(device, _descriptorPool, { _descriptorSetLayout.getInstance() });
+
+    std::vector<WriteDescriptorSet> writes;
+    writes.emplace_back(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, DescriptorBufferInfos{ { _parameters, 0, VK_WHOLE_SIZE } });
+    uint32_t binding = 1;
+    for (const auto& buffer : { _instances, _meshes, _draws, _visibles, _commands, _count })
+    {
+        writes.emplace_back(binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, DescriptorBufferInfos{ { buffer, 0, VK_WHOLE_SIZE } });
+        ++binding;
+    }
+    _descriptorSet.update(device, 0, std::move(writes));
+
+    // Pipeline
+    _pipelineLayout->addPushConstant({ VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(uint32_t) });
+    _pipelineLayout->initialize(device, { _descriptorSetLayout.getInstance() });
+
+    _pipeline->getShadersStage().addShaderModule(culling, ShaderSpecialization());
+    _pipeline->initialize(device, _pipelineLayout);
+
+    MouCa::postCondition(!isNull());
+}
+
+void MeshIndirect::release(const Device& device)
+{
+    MouCa::preCondition(!device.isNull());
+    MouCa::preCondition(!isNull());
+
+    _pipeline->release(device);
+    _pipelineLayout->release(device);
+    _descriptorSet.release(device);
+    _descriptorPool->release(device);
+    _descriptorSetLayout.release(device);
+
+    for (auto* buffer : { &_parameters, &_instances, &_meshes, &_draws, &_visibles, &_commands, &_count })
+    {
+        (*buffer)->release(device);
+        buffer->reset();
+    }
+
+    MouCa::postCondition(isNull());
+}
+
+void MeshIndirect::update(const Device& device, const RT::BasicMassiveInstance& massive, const std::vector<RT::BoundingBox>& boxes)
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(massive.getIndirects().size() == boxes.size());   // DEV Issue: one box by mesh !
+    MouCa::preCondition(massive.getIndirects().size() <= _maxMeshes);
+    MouCa::preCondition(massive.getInstances().size() <= _maxInstances);
+
+    // Meshes: each one owns a range of visible instances (size = all its instances)
+    auto& meshMemory = _meshes->getMemory();
+    meshMemory.map(device);
+    auto* mesh = meshMemory.getMappedMemory<Mesh>();
+    uint32_t firstInstance = 0;
+    auto itBox = boxes.cbegin();
+    for (const auto& indirect : massive.getIndirects())
+    {
+        *mesh = { RT::Point4(itBox->getCenter(), itBox->getRadius()), indirect._indexCount, indirect._indexBase, 0, firstInstance };
+        firstInstance += indirect._count;
+        ++mesh;
+        ++itBox;
+    }
+    meshMemory.unmap(device);
+    MouCa::assertion(firstInstance == massive.getInstances().size()); // DEV Issue: indirect count doesn't match instances !
+
+    auto& instanceMemory = _instances->getMemory();
+    instanceMemory.map(device);
+    auto* instance = instanceMemory.getMappedMemory<Instance>();
+    for (const auto& source : massive.getInstances())
+    {
+        *instance = { source._position, source._meshID, source._quaternion, source._scale, 0.0f };
+        ++instance;
+    }
+    instanceMemory.unmap(device);
+
+    auto& memory = _parameters->getMemory();
+    memory.map(device);
+    auto* parameters = memory.getMappedMemory<Parameters>();
+    parameters->_nbInstances = static_cast<uint32_t>(massive.getInstances().size());
+    parameters->_nbMeshes    = static_cast<uint32_t>(massive.getIndirects().size());
+    memory.unmap(device);
+}
+
+void MeshIndirect::setFrustum(const Device& device, const RT::Frustum& frustum)
+{
+    MouCa::preCondition(!isNull());
+
+    auto& memory = _parameters->getMemory();
+    memory.map(device);
+    memory.getMappedMemory<Parameters>()->_planes = frustum.planes;
+    memory.unmap(device);
+}
+
+void MeshIndirect::makeCullingCommands(Commands& commands) const
+{
+    MouCa::preCondition(!isNull());
+
+    // Previous draws must be finished before overwriting their data (no memory dependency: write after read)
+    commands.emplace_back(std::make_unique<CommandPipelineBarrier>(VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                                                                   CommandPipelineBarrier::MemoryBarriers(), CommandPipelineBarrier::BufferMemoryBarriers(), CommandPipelineBarrier::ImageMemoryBarriers()));
+
+    commands.emplace_back(std::make_unique<CommandBindPipeline>(_pipeline, VK_PIPELINE_BIND_POINT_COMPUTE));
+    commands.emplace_back(std::make_unique<CommandBindDescriptorSets>(*_pipelineLayout, VK_PIPELINE_BIND_POINT_COMPUTE, 0, _descriptorSet.getDescriptorSets(), std::vector<uint32_t>()));
+
+    // Dispatch maximum: shader ignores threads after current counts (no recording when counts change)
+    const uint32_t meshGroups     = (_maxMeshes    + _groupSize - 1) / _groupSize;
+    const uint32_t instanceGroups = (_maxInstances + _groupSize - 1) / _groupSize;
+    const std::array<uint32_t, 3> groups = { meshGroups, instanceGroups, meshGroups };
+    for (size_t pass = 0; pass < _passes.size(); ++pass)
+    {
+        if (pass > 0)
+        {
+            commands.emplace_back(makeBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT));
+        }
+        commands.emplace_back(std::make_unique<CommandPushConstants>(*_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, static_cast<uint32_t>(sizeof(uint32_t)), &_passes[pass]));
+        commands.emplace_back(std::make_unique<CommandDispatch>(groups[pass]));
+    }
+
+    // Results are read by draws (or copied)
+    commands.emplace_back(makeBarrier(VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                      VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT));
+}
+
+void MeshIndirect::makeDrawCommands(const Device& device, Commands& commands, const uint32_t instanceBinding) const
+{
+    MouCa::preCondition(!isNull());
+
+    commands.emplace_back(std::make_unique<CommandBindVertexBuffer>(instanceBinding, 1, std::vector<BufferWPtr>{ _visibles }, std::vector<VkDeviceSize>{ 0 }));
+    commands.emplace_back(std::make_unique<CommandDrawIndexedIndirectCount>(device, _commands, 0, _count, 0, _maxMeshes));
+}
+
+}
@@ -270,6 +270,61 @@ void GPUImageReader::extractTo(const VkImage& srcImage, const ContextWindow& con
     _image.getMemory().unmap(device);
 }
 
+void GPUImageReader::saveTo(const VkImage& srcImage, const ContextWindow& context, const RT::Array3ui& positionSrc, const RT::Array3ui& sizes, const Core::Path& filename)
+{
+    const auto& contextDevice = context.getContextDevice();
+    MouCa::preCondition(!contextDevice.isNull());          //DEV Issue: Need a valid context.
+    MouCa::preCondition(!filename.empty());
+
+    extractTo(srcImage, contextDevice, positionSrc, RT::Array3ui(0, 0, 0), sizes);
+
+    save(context, sizes, filename);
+}
+
+void GPUImageReader::save(const ContextWindow& context, const RT::Array3ui& sizes, const Core::Path& filename)
+{
+    const auto& contextDevice = context.getContextDevice();
+    MouCa::preCondition(!contextDevice.isNull());          //DEV Issue: Need a valid context.
+    MouCa::preCondition(!filename.empty());
+
+    const auto& device = contextDevice.getDevice();
+    // Get layout of the image (including row pitch)
+    const VkImageSubresource subResource
+    { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0 };
+    VkSubresourceLayout subResourceLayout;
+    _image.readSubresourceLayout(device, subResource, subResourceLayout);
+
+    // Map image memory so we can encode from it
+    _image.getMemory().map(device);
+    uint8_t* data = _image.getMemory().getMappedMemory<uint8_t>();
+    MouCa::assertion(data != nullptr);
+    data += subResourceLayout.offset;
+
+    // Link mapped memory: Vulkan rows are top-down so image is read with negative stride
+    auto buffer = std::make_shared<RT::BufferLinkedCPU>("linkedScreenshot");
+    const size_t memorySize = static_cast<size_t>(sizes.x) * static_cast<size_t>(sizes.y);
+    buffer->create(_descriptor, memorySize, data, subResourceLayout.rowPitch);
+
+    // Image copy keeps bytes of swapchain format (BGRA is swizzled by encoder)
+    const uint32_t format = static_cast<uint32_t>(context.getFormat().getConfiguration()._format.format);
+
+    RT::ImageLinkedCPU linkedImage;
+    linkedImage.initialize(RT::Image::Target::Type2D, buffer, { sizes.x, sizes.y, 1 }, true, format);
+    try
+    {
+        linkedImage.saveImage(filename);
+    }
+    catch (...)
+    {
+        linkedImage.release();
+        _image.getMemory().unmap(device);
+        throw;
+    }
+
+    linkedImage.release();
+    _image.getMemory().unmap(device);
+}
+
 void GPUImageReader::extractTo(const VkImage& srcImage, const ContextDevice& contextDevice, const RT::Array3ui& positionSrc, const RT::Array3ui& positionDst, const RT::Array3ui& sizes, RT::BufferCPU& output)
 {
     MouCa::preCondition(!contextDevice.isNull());          //DEV Issue: Need a valid context.
@@ -10,7 +10,7 @@ namespace Vulkan
 {
 
 Semaphore::Semaphore():
-_semaphore(VK_NULL_HANDLE)
+_semaphore(VK_NULL_HANDLE), _type(VK_SEMAPHORE_TYPE_BINARY), _scheduledValue(0)
 {
     MouCa::assertion(isNull());
 }
@@ -21,26 +21,99 @@ Semaphore::~Semaphore()
 }
 
 void Semaphore::initialize(const Device& device)
+{
+    initialize(device, VK_SEMAPHORE_TYPE_BINARY, 0);
+}
+
+void Semaphore::initialize(const Device& device, const VkSemaphoreType type, const uint64_t initialValue)
 {
     MouCa::assertion(isNull());
+    MouCa::preCondition(type == VK_SEMAPHORE_TYPE_BINARY || device.isTimelineSemaphoreEnabled()); //DEV Issue: Timeline not supported by device !
+
+    const VkSemaphoreTypeCreateInfo semaphore_type_create_info =
+    {
+        VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO, // VkStructureType          sType
+        nullptr,                                      // const void*              pNext
+        type,                                         // VkSemaphoreType          semaphoreType
+        initialValue                                  // uint64_t                 initialValue
+    };
+
     VkSemaphoreCreateInfo semaphore_create_info =
     {
         VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,      // VkStructureType          sType
         nullptr,                                      // const void*              pNext
         0                                             // VkSemaphoreCreateFlags   flags
     };
+    // Keep default creation for binary semaphore
+    if (type == VK_SEMAPHORE_TYPE_TIMELINE)
+    {
+        semaphore_create_info.pNext = &semaphore_type_create_info;
+    }
 
     if (vkCreateSemaphore(device.getInstance(), &semaphore_create_info, nullptr, &_semaphore) != VK_SUCCESS)
     {
         throw Core::Exception(Core::ErrorData("Vulkan", "SemaphoreCreationError"));
     }
+    _type           = type;
+    _scheduledValue = initialValue;
 }
 
 void Semaphore::release(const Device& device)
 {
     MouCa::assertion(!isNull());
     vkDestroySemaphore(device.getInstance(), _semaphore, nullptr);
-    _semaphore = VK_NULL_HANDLE;
+    _semaphore      = VK_NULL_HANDLE;
+    _type           = VK_SEMAPHORE_TYPE_BINARY;
+    _scheduledValue = 0;
+}
+
+uint64_t Semaphore::getValue(const Device& device) const
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(isTimeline());
+
+    uint64_t value = 0;
+    if (vkGetSemaphoreCounterValue(device.getInstance(), _semaphore, &value) != VK_SUCCESS)
+    {
+        throw Core::Exception(Core::ErrorData("Vulkan", "SemaphoreValueError"));
+    }
+    return value;
+}
+
+VkResult Semaphore::wait(const Device& device, const uint64_t value, const uint64_t timeout) const
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(isTimeline());
+
+    const VkSemaphoreWaitInfo waitInfo =
+    {
+        VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,        // VkStructureType          sType
+        nullptr,                                      // const void*              pNext
+        0,                                            // VkSemaphoreWaitFlags     flags
+        1,                                            // uint32_t                 semaphoreCount
+        &_semaphore,                                  // const VkSemaphore*       pSemaphores
+        &value                                        // const uint64_t*          pValues
+    };
+    return vkWaitSemaphores(device.getInstance(), &waitInfo, timeout);
+}
+
+void Semaphore::signal(const Device& device, const uint64_t value)
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(isTimeline());
+
+    const VkSemaphoreSignalInfo signalInfo =
+    {
+        VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO,      // VkStructureType          sType
+        nullptr,                                      // const void*              pNext
+        _semaphore,                                   // VkSemaphore              semaphore
+        value                                         // uint64_t                 value
+    };
+    if (vkSignalSemaphore(device.getInstance(), &signalInfo) != VK_SUCCESS)
+    {
+        throw Core::Exception(Core::ErrorData("Vulkan", "SemaphoreSignalError"));
+    }
+    scheduleSignal(value);
 }
 
 }
\ No newline at end of file
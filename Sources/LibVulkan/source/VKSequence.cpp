@@ -6,8 +6,10 @@
 #include "LibVulkan/include/VKSequence.h"
 
 #include "LibVulkan/include/VKCommandBuffer.h"
+#include "LibVulkan/include/VKContextDevice.h"
 #include "LibVulkan/include/VKDevice.h"
 #include "LibVulkan/include/VKFence.h"
+#include "LibVulkan/include/VKFrameRing.h"
 #include "LibVulkan/include/VKSemaphore.h"
 #include "LibVulkan/include/VKSubmitInfo.h"
 #include "LibVulkan/include/VKSwapChain.h"
@@ -19,11 +21,20 @@ SequenceAcquire::SequenceAcquire(SwapChainWPtr swapChain, SemaphoreWPtr semaphor
 _swapChain(swapChain),
 _semaphore(semaphore.expired() ? VK_NULL_HANDLE : semaphore.lock()->getInstance()),
 _fence(fence.expired() ? VK_NULL_HANDLE : fence.lock()->getInstance()),
+_frameRing(nullptr),
 _timeout(timeout)
 {
     MouCa::preCondition(!_swapChain.expired()); //DEV Issue: Bad swapchain !
 }
 
+SequenceAcquire::SequenceAcquire(SwapChainWPtr swapChain, const FrameRing& frameRing, FenceWPtr fence, const uint64_t timeout):
+SequenceAcquire(swapChain, SemaphoreWPtr(), fence, timeout)
+{
+    MouCa::preCondition(!frameRing.isNull()); //DEV Issue: Need valid data !
+
+    _frameRing = &frameRing;
+}
+
 VkResult SequenceAcquire::execute(const Device& device)
 {
     MouCa::preCondition(!_swapChain.expired()); //DEV Issue: Never call initialized !
@@ -32,8 +43,11 @@ VkResult SequenceAcquire::execute(const Device& device)
     if (!sw->isReady())
         return VK_ERROR_OUT_OF_DATE_KHR;
 
+    // Semaphore of frame changes each frame
+    const VkSemaphore semaphore = (_frameRing != nullptr) ? _frameRing->getAcquireSemaphore().getInstance() : _semaphore;
+
     uint32_t currentImageIndex;
-    const VkResult result = vkAcquireNextImageKHR(device.getInstance(), sw->getInstance(), _timeout, _semaphore, _fence, &currentImageIndex);
+    const VkResult result = vkAcquireNextImageKHR(device.getInstance(), sw->getInstance(), _timeout, semaphore, _fence, &currentImageIndex);
     if(result == VK_SUCCESS)
     {
         sw->setCurrentImage(currentImageIndex);
@@ -41,6 +55,21 @@ VkResult SequenceAcquire::execute(const Device& device)
     return result;
 }
 
+SequenceBeginFrame::SequenceBeginFrame(ContextDeviceWPtr context, const uint64_t timeout):
+_context(context), _timeout(timeout)
+{
+    MouCa::preCondition(!_context.expired()); //DEV Issue: Bad context !
+}
+
+VkResult SequenceBeginFrame::execute(const Device& device)
+{
+    MouCa::preCondition(!_context.expired());
+    MouCa::preCondition(&_context.lock()->getDevice() == &device); //DEV Issue: Sequence of another device ?
+    MOUCA_UNUSED(device);
+
+    return _context.lock()->beginFrame(_timeout);
+}
+
 SequenceWaitFence::SequenceWaitFence(const std::vector<FenceWPtr>& fences, const uint64_t timeout, const VkBool32 waitAll):
 _timeout(timeout), _all(waitAll)
 {
@@ -59,6 +88,50 @@ VkResult SequenceWaitFence::execute(const Device& device)
     return vkWaitForFences(device.getInstance(), static_cast<uint32_t>(_fences.size()), _fences.data(), _all, _timeout);
 }
 
+SequenceWaitSemaphore::SequenceWaitSemaphore(const std::vector<SemaphoreWPtr>& semaphores, const std::vector<uint64_t>& values, const uint64_t timeout):
+_semaphores(semaphores), _fixedValues(values), _timeout(timeout)
+{
+    MouCa::preCondition(!semaphores.empty());
+    MouCa::preCondition(values.empty() || values.size() == semaphores.size());
+
+    if (_fixedValues.empty())
+    {
+        _fixedValues.resize(_semaphores.size(), 0);
+    }
+    _values.resize(_semaphores.size());
+
+    _vkSemaphores.reserve(semaphores.size());
+    for (auto& semaphore : semaphores)
+    {
+        MouCa::assertion(semaphore.lock()->isTimeline()); //DEV Issue: Binary semaphore can't be waited by host !
+        _vkSemaphores.emplace_back(semaphore.lock()->getInstance());
+    }
+}
+
+VkResult SequenceWaitSemaphore::execute(const Device& device)
+{
+    // Resolve automatic values
+    auto itValue = _values.begin();
+    auto itFixed = _fixedValues.cbegin();
+    for (const auto& semaphore : _semaphores)
+    {
+        *itValue = (*itFixed != 0) ? *itFixed : semaphore.lock()->getScheduledValue();
+        ++itValue;
+        ++itFixed;
+    }
+
+    const VkSemaphoreWaitInfo waitInfo =
+    {
+        VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,              // VkStructureType          sType
+        nullptr,                                            // const void*              pNext
+        0,                                                  // VkSemaphoreWaitFlags     flags
+        static_cast<uint32_t>(_vkSemaphores.size()),        // uint32_t                 semaphoreCount
+        _vkSemaphores.data(),                               // const VkSemaphore*       pSemaphores
+        _values.data()                                      // const uint64_t*          pValues
+    };
+    return vkWaitSemaphores(device.getInstance(), &waitInfo, _timeout);
+}
+
 SequenceResetFence::SequenceResetFence(const std::vector<FenceWPtr>& fences)
 {
     MouCa::preCondition(!fences.empty());
@@ -76,21 +149,26 @@ VkResult SequenceResetFence::execute(const Device& device)
     return vkResetFences(device.getInstance(), static_cast<uint32_t>(_fences.size()), _fences.data());
 }
 
-SequenceSubmit::SequenceSubmit(SubmitInfos&& submitInfos, FenceWPtr fence):
-_fence(fence.expired() ? VK_NULL_HANDLE : fence.lock()->getInstance())
+SequenceSubmit::SequenceSubmit(SubmitInfos&& submitInfos, FenceWPtr fence, const Device::QueueType queue):
+_fence(fence.expired() ? VK_NULL_HANDLE : fence.lock()->getInstance()), _frameRing(nullptr), _queue(queue)
 {
     MouCa::preCondition(!submitInfos.empty()); //DEV Issue: Need valid data !
     
+    // VkSubmitInfo are built at each execution (timeline values must not be scheduled now)
     _submitInfos = std::move(submitInfos);
-    _vkSubmitInfos.reserve(submitInfos.size());
-    for(const auto& submitInfo : _submitInfos)
-    {
-        _vkSubmitInfos.emplace_back(submitInfo->buildSubmitInfo());
-    }
+    _vkSubmitInfos.resize(_submitInfos.size());
 
     MouCa::postCondition(!_vkSubmitInfos.empty()); //DEV Issue: Not ready ?
 }
 
+SequenceSubmit::SequenceSubmit(SubmitInfos&& submitInfos, FrameRing& frameRing, const Device::QueueType queue):
+SequenceSubmit(std::move(submitInfos), FenceWPtr(), queue)
+{
+    MouCa::preCondition(!frameRing.isNull()); //DEV Issue: Need valid data !
+
+    _frameRing = &frameRing;
+}
+
 VkResult SequenceSubmit::execute(const Device& device)
 {
     MouCa::preCondition(!_vkSubmitInfos.empty()); //DEV Issue: nothing to submit ?
@@ -104,19 +182,36 @@ VkResult SequenceSubmit::execute(const Device& device)
     }
     MouCa::assertion(itSubmitInfo == _vkSubmitInfos.end());
 
-    return vkQueueSubmit(device.getQueue(), static_cast<uint32_t>(_vkSubmitInfos.size()), _vkSubmitInfos.data(), _fence);
+    if (_frameRing == nullptr)
+    {
+        return vkQueueSubmit(device.getQueue(_queue), static_cast<uint32_t>(_vkSubmitInfos.size()), _vkSubmitInfos.data(), _fence);
+    }
+
+    // Fence of frame changes each frame
+    const VkResult result = vkQueueSubmit(device.getQueue(_queue), static_cast<uint32_t>(_vkSubmitInfos.size()), _vkSubmitInfos.data(), _frameRing->getFence().getInstance());
+    if (result == VK_SUCCESS)
+    {
+        _frameRing->setSubmitted();
+    }
+    return result;
 }
 
-SequencePresentKHR::SequencePresentKHR(const std::vector<SemaphoreWPtr>& semaphores, const std::vector<SwapChainWPtr>& swapChains):
-_swapChains(swapChains)
+SequencePresentKHR::SequencePresentKHR(const std::vector<SemaphoreWPtr>& semaphores, const std::vector<SwapChainWPtr>& swapChains, const FrameRing* frameRing):
+_swapChains(swapChains), _frameRing(frameRing)
 {
     MouCa::preCondition(!swapChains.empty());
+    MouCa::preCondition(_frameRing == nullptr || !_frameRing->isNull());
 
-    _semaphores.reserve(semaphores.size());
+    _semaphores.reserve(semaphores.size() + 1);
     for (const auto& semaphore : semaphores)
     {
         _semaphores.emplace_back(semaphore.lock()->getInstance());
     }
+    // Render semaphore of frame: resolved at each execution
+    if (_frameRing != nullptr)
+    {
+        _semaphores.emplace_back(VK_NULL_HANDLE);
+    }
 
     _swapChains = swapChains;
     _swapChainIDs.resize(swapChains.size());
@@ -187,6 +282,10 @@ VkResult SequencePresentKHR::execute(const Device& device)
         *itImageID = swapChain->getCurrentImage();
         ++itImageID;
     }
+    if (_frameRing != nullptr)
+    {
+        _semaphores.back() = _frameRing->getRenderSemaphore().getInstance();
+    }
     
     // Ready to queue
     return vkQueuePresentKHR(device.getQueue(), &_presentInfo);
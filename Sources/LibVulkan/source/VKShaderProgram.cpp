@@ -3,6 +3,7 @@
 /// \license No license
 #include "Dependencies.h"
 
+#include "LibVulkan/include/VKDeferredRelease.h"
 #include "LibVulkan/include/VKDevice.h"
 #include "LibVulkan/include/VKShaderProgram.h"
 
@@ -38,7 +39,30 @@ void ShaderModule::initialize(const Device& device, const Core::String& shaderSo
 
     _name  = name;
     _stage = stage;
+    _shaderModule = create(device, shaderSource);
 
+    MouCa::postCondition(!isNull());
+}
+
+void ShaderModule::rebuild(const Device& device, const Core::String& shaderSource, DeferredRelease& deferred)
+{
+    MouCa::preCondition(!isNull());
+    MouCa::preCondition(!device.isNull());
+    MouCa::preCondition(!shaderSource.empty());
+
+    // Pipelines of frames in flight can still reference old module
+    const VkShaderModule newModule = create(device, shaderSource);
+    deferred.add([oldModule = _shaderModule](const Device& currentDevice)
+    {
+        vkDestroyShaderModule(currentDevice.getInstance(), oldModule, nullptr);
+    });
+    _shaderModule = newModule;
+
+    MouCa::postCondition(!isNull());
+}
+
+VkShaderModule ShaderModule::create(const Device& device, const Core::String& shaderSource)
+{
     //Build info
     const VkShaderModuleCreateInfo shaderModuleCreateInfo =
     {
@@ -50,12 +74,12 @@ void ShaderModule::initialize(const Device& device, const Core::String& shaderSo
     };
 
     //Create shader
-    if (vkCreateShaderModule(device.getInstance(), &shaderModuleCreateInfo, nullptr, &_shaderModule) != VK_SUCCESS)
+    VkShaderModule shaderModule = VK_NULL_HANDLE;
+    if (vkCreateShaderModule(device.getInstance(), &shaderModuleCreateInfo, nullptr, &shaderModule) != VK_SUCCESS)
     {
         throw Core::Exception(Core::ErrorData("Vulkan", "ShaderCreationError"));
     }
-
-    MouCa::postCondition(!isNull());
+    return shaderModule;
 }
 
 void ShaderModule::release(const Device& device)
@@ -13,23 +13,70 @@ namespace Vulkan
 {
 
 void SubmitInfo::addSynchronization(const std::vector<WaitSemaphore>& waitSemaphores, const std::vector<SemaphoreWPtr>& signalSemaphores)
+{
+    addSynchronization(waitSemaphores, signalSemaphores, {}, {});
+}
+
+void SubmitInfo::addSynchronization(const std::vector<WaitSemaphore>& waitSemaphores, const std::vector<SemaphoreWPtr>& signalSemaphores,
+                                    const std::vector<uint64_t>& waitValues, const std::vector<uint64_t>& signalValues)
 {
     MouCa::preCondition(_waitSemaphore.empty() && _waitStageFlag.empty()); //DEV Issue: Already call initialize !
+    MouCa::preCondition(waitValues.empty()   || waitValues.size()   == waitSemaphores.size());
+    MouCa::preCondition(signalValues.empty() || signalValues.size() == signalSemaphores.size());
 
     // Build array (keep memory alive)
     _waitSemaphore.reserve(waitSemaphores.size());
     _waitStageFlag.reserve(waitSemaphores.size());
     for (const auto& waitSemaphore : waitSemaphores)
     {
-        MouCa::assertion(!waitSemaphore.first.lock()->isNull()); //DEV Issue: Bad semaphore: plesae call intialize() !
-        _waitSemaphore.emplace_back(waitSemaphore.first.lock()->getInstance());
+        const auto semaphore = waitSemaphore.first.lock();
+        MouCa::assertion(!semaphore->isNull()); //DEV Issue: Bad semaphore: plesae call intialize() !
+        if (semaphore->isTimeline())
+        {
+            const uint64_t value = waitValues.empty() ? 0 : waitValues[_waitSemaphore.size()];
+            _waitTimelines.emplace_back(TimelinePoint{ _waitSemaphore.size(), semaphore, value });
+        }
+        _waitSemaphore.emplace_back(semaphore->getInstance());
         _waitStageFlag.emplace_back(waitSemaphore.second);
     }
     _signalSemaphore.reserve(signalSemaphores.size());
     for (const auto& signalSemaphore : signalSemaphores)
     {
-        MouCa::assertion(!signalSemaphore.lock()->isNull()); //DEV Issue: Bad semaphore: plesae call intialize() !
-        _signalSemaphore.emplace_back(signalSemaphore.lock()->getInstance());
+        const auto semaphore = signalSemaphore.lock();
+        MouCa::assertion(!semaphore->isNull()); //DEV Issue: Bad semaphore: plesae call intialize() !
+        if (semaphore->isTimeline())
+        {
+            const uint64_t value = signalValues.empty() ? 0 : signalValues[_signalSemaphore.size()];
+            _signalTimelines.emplace_back(TimelinePoint{ _signalSemaphore.size(), semaphore, value });
+        }
+        _signalSemaphore.emplace_back(semaphore->getInstance());
+    }
+
+    // Binary semaphores keep value 0
+    _waitValues.assign(_waitSemaphore.size(), 0);
+    _signalValues.assign(_signalSemaphore.size(), 0);
+}
+
+void SubmitInfo::addFrameSynchronization(const FrameRing& frameRing, const std::vector<WaitFrameSemaphore>& waitSemaphores, const std::vector<FrameRing::SemaphoreType>& signalSemaphores)
+{
+    MouCa::preCondition(!frameRing.isNull());
+    MouCa::preCondition(_frameRing == nullptr || _frameRing == &frameRing); //DEV Issue: Only one ring by submit !
+
+    _frameRing = &frameRing;
+
+    // Handles are resolved at each build
+    for (const auto& waitSemaphore : waitSemaphores)
+    {
+        _waitFrames.emplace_back(FramePoint{ _waitSemaphore.size(), waitSemaphore.first });
+        _waitSemaphore.emplace_back(VK_NULL_HANDLE);
+        _waitStageFlag.emplace_back(waitSemaphore.second);
+        _waitValues.emplace_back(0);
+    }
+    for (const auto& signalSemaphore : signalSemaphores)
+    {
+        _signalFrames.emplace_back(FramePoint{ _signalSemaphore.size(), signalSemaphore });
+        _signalSemaphore.emplace_back(VK_NULL_HANDLE);
+        _signalValues.emplace_back(0);
     }
 }
 
@@ -56,10 +103,55 @@ VkSubmitInfo SubmitInfo::buildSubmitInfo()
         ++itCommand;
     }
 
+    // Semaphores of current frame in flight
+    for (const auto& point : _waitFrames)
+    {
+        _waitSemaphore[point._index] = _frameRing->getSemaphore(point._type).getInstance();
+    }
+    for (const auto& point : _signalFrames)
+    {
+        _signalSemaphore[point._index] = _frameRing->getSemaphore(point._type).getInstance();
+    }
+
+    // Compute values of timelines: wait before signal (same timeline can be waited then signaled)
+    const void* next = nullptr;
+    if (!_waitTimelines.empty() || !_signalTimelines.empty())
+    {
+        for (const auto& point : _waitTimelines)
+        {
+            _waitValues[point._index] = point._value != 0 ? point._value : point._semaphore.lock()->getScheduledValue();
+        }
+        for (const auto& point : _signalTimelines)
+        {
+            auto semaphore = point._semaphore.lock();
+            if (point._value != 0)
+            {
+                MouCa::assertion(point._value > semaphore->getScheduledValue()); //DEV Issue: Fixed value already signaled: repeated submission needs automatic value !
+                semaphore->scheduleSignal(point._value);
+                _signalValues[point._index] = point._value;
+            }
+            else
+            {
+                _signalValues[point._index] = semaphore->scheduleSignal();
+            }
+        }
+
+        _timelineInfo =
+        {
+            VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,   // VkStructureType    sType
+            nullptr,                                            // const void*        pNext
+            static_cast<uint32_t>(_waitValues.size()),          // uint32_t           waitSemaphoreValueCount
+            _waitValues.data(),                                 // const uint64_t*    pWaitSemaphoreValues
+            static_cast<uint32_t>(_signalValues.size()),        // uint32_t           signalSemaphoreValueCount
+            _signalValues.data()                                // const uint64_t*    pSignalSemaphoreValues
+        };
+        next = &_timelineInfo;
+    }
+
     return
     {
         VK_STRUCTURE_TYPE_SUBMIT_INFO,                  // VkStructureType              sType
-        nullptr,                                        // const void                  *pNext
+        next,                                           // const void                  *pNext
         static_cast<uint32_t>(_waitSemaphore.size()),   // uint32_t                     waitSemaphoreCount
         _waitSemaphore.data(),                          // const VkSemaphore           *pWaitSemaphores
         _waitStageFlag.data(),                          // const VkPipelineStageFlags  *pWaitDstStageMask
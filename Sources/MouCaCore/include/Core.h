@@ -91,9 +91,10 @@ namespace MouCaCore
         /// Destructor
         ~LoadingItem() = default;
 
-        Core::ResourceSPtr  _resource;      ///< Data pointer.
-        State               _state;         ///< State of loading.
-        Order               _order;         ///< Priority of loading.
+        Core::ResourceSPtr    _resource;      ///< Data pointer.
+        State                 _state;         ///< State of loading.
+        Order                 _order;         ///< Priority of loading.
+        std::function<void()> _task;          ///< Part of resource loading (replace loader of resource when defined).
 
         bool operator<(const LoadingItem& item) const
         {
@@ -31,7 +31,7 @@ namespace MouCaCore
 
         public:
             CoreSystem();
-            ~CoreSystem() override = default;
+            ~CoreSystem() override;
 
             Core::PlugInManager& getPlugInManager() override
             {
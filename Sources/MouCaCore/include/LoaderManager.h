@@ -2,10 +2,13 @@
 
 #include <MouCaCore/include/Core.h>
 
+#include <LibCore/include/CoreAsyncFileReader.h>
 #include <LibCore/include/CoreThread.h>
 
 namespace Core
 {
+    class ThreadPools;
+
     class Resource;
     using ResourceSPtr = std::shared_ptr<Resource>;
 }
@@ -64,10 +67,29 @@ namespace MouCaCore
             }
 
         private:
+            /// File read in advance for next job.
+            struct Prefetch
+            {
+                Core::ResourceSPtr                          _resource;  ///< Resource of next job.
+                std::vector<uint8_t>                        _data;      ///< Content of file.
+                std::future<Core::AsyncFileReader::Batch>   _pending;   ///< Reading in progress.
+            };
+
             void run() override;
 
             void doAction( LoadingItem& item);
 
+            //------------------------------------------------------------------------
+            /// \brief  Submit reading of file of next job when it is decoded from source: I/O overlaps decoding of current job.
+            void prefetch();
+
+            //------------------------------------------------------------------------
+            /// \brief  Get file content read in advance for resource of current job.
+            ///
+            /// \param[in] resource: resource of current job.
+            /// \returns Content of file (empty when not read in advance or when reading failed).
+            std::vector<uint8_t> takePrefetch(const Core::ResourceSPtr& resource);
+
             size_t                   _iD;
             bool                     _run;        ///< State of run loop.
             State                    _state;      ///< State of thread.
@@ -78,6 +100,9 @@ namespace MouCaCore
             
             std::mutex               _waitJobMutex;
             std::condition_variable  _waitJob;
+
+            Prefetch                 _current;    ///< File of current job (only used by thread).
+            Prefetch                 _prefetch;   ///< File of next job (only used by thread).
     };
 
     //----------------------------------------------------------------------------
@@ -124,6 +149,12 @@ namespace MouCaCore
 
             void loadResources(LoadingItems& queue) override;
 
+            //------------------------------------------------------------------------
+            /// \brief  Share items between all queues without waiting (can be called by loading thread to split its job).
+            ///
+            /// \param[in,out] items: items to load (empty at the end).
+            void dispatchJobs(LoadingItems& items);
+
             void synchronize() override;
 
             SynchonizeData& getSynchronizeDirect()
@@ -136,10 +167,39 @@ namespace MouCaCore
                 return _syncDeferred;
             }
 
+            //------------------------------------------------------------------------
+            /// \brief  Get I/O threads shared by loading jobs: submit next reads then decode previous data.
+            ///
+            /// \returns Asynchronous reader (valid between initialize() and release()).
+            Core::AsyncFileReader& getFileReader()
+            {
+                return _fileReader;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Share workers with CPU heavy loading (mipmap filtering, block compression).
+            ///
+            /// \param[in] threadPools: workers (must live longer than manager).
+            void setThreadPools(Core::ThreadPools& threadPools)
+            {
+                _threadPools = &threadPools;
+            }
+
+            //------------------------------------------------------------------------
+            /// \brief  Get workers shared with CPU heavy loading.
+            ///
+            /// \returns Workers (nullptr: loading jobs run on their queue thread only).
+            Core::ThreadPools* getThreadPools() const
+            {
+                return _threadPools;
+            }
+
         private:
             std::deque<LoadingQueue> _queues;       ///< List of working threads.
 
             SynchonizeData           _syncDirect;   ///< Synchronization system for direct job.
             SynchonizeData           _syncDeferred; ///< Synchronization system for indirect job.
+            Core::AsyncFileReader    _fileReader;   ///< I/O threads overlapping reading with decoding.
+            Core::ThreadPools*       _threadPools = nullptr; ///< [LINK] Workers of CPU heavy loading.
     };
 }
\ No newline at end of file
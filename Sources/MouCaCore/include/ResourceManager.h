@@ -4,6 +4,8 @@
 
 #include <LibCore/include/CoreFileTracker.h>
 
+#include <LibRT/include/RTImage.h>
+
 namespace MouCaCore
 {
     class ResourceManager final : public IResourceManager, public std::enable_shared_from_this<ResourceManager>
@@ -100,7 +102,23 @@ namespace MouCaCore
 
             XML::ParserSPtr openXML(const Core::Path& filename);
 
-            RT::ImageImportSPtr openImage(const Core::Path& filename);
+            //------------------------------------------------------------------------
+            /// \brief  Open image resource (loaded later by LoaderManager).
+            ///
+            /// \param[in] filename: path to image.
+            /// \param[in] options: import options (mipmap/compression).
+            /// \returns Image resource (shared with previous call using same file and same options).
+            RT::ImageImportSPtr openImage(const Core::Path& filename, const RT::ImageImport::Options& options = RT::ImageImport::Options());
+
+            //------------------------------------------------------------------------
+            /// \brief  Enable baked texture cache: images opened after this call are decoded once then read from KTX2 file.
+            /// Cache file is keyed by source path, modification time and import options (stale files are never read).
+            ///
+            /// \param[in] folder: where write KTX2 files (empty to disable cache).
+            /// \param[in] zstdLevel: Zstd supercompression level (0: none, 1-22: smaller files but slower load).
+            void setImageCache(const Core::Path& folder, const uint32_t zstdLevel = 0);
+
+            const Core::Path& getImageCacheFolder() const { return _imageCacheFolder; }
 
             RT::MeshImportSPtr openMeshImport(const Core::Path& filename, const RT::BufferDescriptor& descriptor = RT::BufferDescriptor(), const RT::MeshImport::Flag flag = RT::MeshImport::ComputeAll);
 
@@ -113,10 +131,15 @@ namespace MouCaCore
             template<typename BuildClass>
             std::shared_ptr<BuildClass> genericOpen( const Core::Path& filename );
 
+            Core::Path computeImageCacheFilename(const Core::Path& filename, const RT::ImageImport::Options& options) const;
+
             std::map<size_t, Core::Path>	_mapFolders;	///< Contains all inputs/outputs folders by category
 
             std::set<Core::ResourceSPtr>	_resources;	    ///< [OWNERSHIP] Contains all usable resources.
             Core::FileTracker               _tracker;       ///< [OWNERSHIP] Contains manager of tracking.
+
+            Core::Path                      _imageCacheFolder;      ///< Folder of baked KTX2 images (empty: disabled).
+            uint32_t                        _imageCacheZstdLevel = 0; ///< Zstd level of baked images.
     };
 
     using ResourceManagerSPtr = std::shared_ptr<ResourceManager>;
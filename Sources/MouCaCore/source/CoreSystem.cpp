@@ -1,6 +1,7 @@
 #include "Dependencies.h"
 
 #include <LibCore/include/CoreLocale.h>
+#include <LibCore/include/CoreLogger.h>
 
 #include <LibXML/include/XMLParser.h>
 
@@ -15,6 +16,23 @@ _xmlPlatform(std::make_unique<XML::XercesPlatform>())
 {
 	// Configure
     _errorManager.setConfiguration(_locale);
+
+    // Asynchronous logs (console + rotating file)
+    Core::Logger::Configuration logger;
+    logger._filename = "MouCaLab.log";
+    Core::Logger::initialize(logger);
+
+    // Shared workers of task graph (also used by loading jobs)
+    _threadPool.initializeWorkers();
+    _loaderManager.setThreadPools(_threadPool);
+}
+
+CoreSystem::~CoreSystem()
+{
+    _threadPool.releaseWorkers();
+
+    // Write last records
+    Core::Logger::release();
 }
 
 void CoreSystem::printException(const Core::Exception& exception) const
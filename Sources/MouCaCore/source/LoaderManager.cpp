@@ -1,6 +1,9 @@
 #include "Dependencies.h"
 
 #include "LibCore/include/CoreFile.h"
+#include "LibCore/include/CoreLogger.h"
+#include "LibCore/include/CoreMemory.h"
+#include "LibCore/include/CoreProfiler.h"
 
 #include "LibRT/include/RTAnimationBones.h"
 #include "LibRT/include/RTImage.h"
@@ -8,6 +11,7 @@
 #include "LibRT/include/RTMesh.h"
 
 #include "LibMedia/include/AnimationLoader.h"
+#include "LibMedia/include/ImageKTX.h"
 #include "LibMedia/include/ImageLoader.h"
 #include "LibMedia/include/MeshLoader.h"
 
@@ -29,10 +33,7 @@ void LoaderManager::SynchonizeData::initialize(const uint32_t countThreadReady)
     _countThreadReady = _maskThread;
 
 #ifdef LOADING_DEBUG
-    std::bitset<8> mask(_maskThread);
-    std::stringstream ss;
-    ss << "Initialize SyncData: " << countThreadReady << " with mask " << mask << std::endl;
-    MouCa::logConsole(ss.str());
+    MOUCA_LOG_TRACE(Loader, "Initialize SyncData: {} with mask {}", countThreadReady, std::bitset<8>(_maskThread).to_string());
 #endif
 
     MouCa::postCondition(_maskThread > 0);
@@ -46,11 +47,7 @@ void LoaderManager::SynchonizeData::synchronize()
     _wait.wait_for(lock, std::chrono::milliseconds(10000),
         [this]
         {
-
-            std::bitset<8> mask(_countThreadReady);
-            std::stringstream ss;
-            ss << "  Synchronize: " << mask << " " << ((_countThreadReady & _maskThread) == _maskThread ? "SYNC" : "WAIT") << std::endl;
-            MouCa::logConsole(ss.str());
+            MOUCA_LOG_TRACE(Loader, "  Synchronize: {} {}", std::bitset<8>(_countThreadReady).to_string(), ((_countThreadReady & _maskThread) == _maskThread ? "SYNC" : "WAIT"));
             return (_countThreadReady & _maskThread) == _maskThread;
         });
 #else
@@ -64,10 +61,7 @@ void LoaderManager::SynchonizeData::threadWorking(const size_t idThread)
     std::unique_lock<std::mutex> lock(_waitSync);
     _countThreadReady &= ~(1 << idThread);
 #ifdef LOADING_DEBUG
-    std::bitset<8> mask(_countThreadReady);
-    std::stringstream ss;
-    ss << "  Working: " << idThread << " with mask " << mask << std::endl;
-    MouCa::logConsole(ss.str());
+    MOUCA_LOG_TRACE(Loader, "  Working: {} with mask {}", idThread, std::bitset<8>(_countThreadReady).to_string());
 #endif
 }
 
@@ -79,10 +73,7 @@ void LoaderManager::SynchonizeData::threadReady(const size_t idThread)
         const uint32_t countThreadReady = _countThreadReady | (1 << idThread);
         if (countThreadReady != _countThreadReady)
         {
-            std::bitset<8> mask(countThreadReady);
-            std::stringstream ss;
-            ss << "  Done: " << idThread << " with mask " << mask << std::endl;
-            MouCa::logConsole(ss.str());
+            MOUCA_LOG_TRACE(Loader, "  Done: {} with mask {}", idThread, std::bitset<8>(countThreadReady).to_string());
         }
 #endif
         _countThreadReady |= (1 << idThread);
@@ -98,7 +89,12 @@ void LoadingQueue::initialize(LoaderManager* manager, const size_t iD)
 
 void LoadingQueue::release()
 {
-
+    // Reader writes into memory of prefetch
+    if (_prefetch._pending.valid())
+    {
+        _prefetch._pending.wait();
+    }
+    _prefetch = Prefetch();
 }
 
 void LoadingQueue::demandToFinish()
@@ -121,7 +117,7 @@ void LoadingQueue::addJob(const LoadingItems& items)
             _resources.push_back( item );
         }
         // Reorder
-        std::sort(_resources.begin(), _resources.end());
+        std::stable_sort(_resources.begin(), _resources.end());
 
         // Take job in direct
         if(_resources.front()._state == LoadingItem::Direct)
@@ -138,6 +134,18 @@ void LoadingQueue::addJob(const LoadingItems& items)
 
 void LoadingQueue::doAction( LoadingItem& item )
 {
+    MOUCA_PROFILE_ZONE("LoadingQueue::doAction");
+
+    // Temporaries of job are released at end of job
+    Core::ArenaScope scope;
+
+    // Part of resource
+    if( item._task )
+    {
+        item._task();
+        return;
+    }
+
     // Todo: read resource + prepare ?
     RT::ShaderFile* file = dynamic_cast<RT::ShaderFile*>(item._resource.get());
     if( file != nullptr )
@@ -155,7 +163,28 @@ void LoadingQueue::doAction( LoadingItem& item )
         MouCa::assertion( !image->getFilename().empty() );
         MouCa::assertion( std::filesystem::exists( image->getFilename() ) );
         Media::ImageLoader loader;
-        image->setImage(loader.openImage(image->getFilename()));
+
+        // Always consumed: cache can be baked since reading
+        const auto fileData = takePrefetch(item._resource);
+
+        // KTX: split decoding by level/layer on all queues (coarse levels first)
+        auto ktx = loader.prepareImage(*image);
+        if( ktx != nullptr )
+        {
+            image->setImage(ktx);
+
+            LoadingItems tasks;
+            for( size_t task = 0; task < ktx->getNbDecodeTasks(); ++task )
+            {
+                LoadingItem subItem( item._resource, item._state, item._order );
+                subItem._task = [ktx, task]() { ktx->decode(task); };
+                tasks.emplace_back( std::move(subItem) );
+            }
+            _manager->dispatchJobs( tasks );
+            return;
+        }
+
+        image->setImage(loader.openImage(*image, fileData, _manager->getThreadPools()));
         return;
     }
     
@@ -178,8 +207,56 @@ void LoadingQueue::doAction( LoadingItem& item )
     throw Core::Exception(Core::ErrorData( "MouCaCore", "InvalidLoader" ));
 }
 
+void LoadingQueue::prefetch()
+{
+    MouCa::preCondition(!_prefetch._pending.valid());
+
+    Core::ResourceSPtr next;
+    {
+        std::unique_lock<std::mutex> locker( _jobMutex );
+        if( _resources.empty() || _resources.front()._task )
+            return;
+        next = _resources.front()._resource;
+    }
+
+    const RT::ImageImport* image = dynamic_cast<const RT::ImageImport*>(next.get());
+    if( image == nullptr || !Media::ImageLoader::isDecodedFromSource(*image) )
+        return;
+
+    std::error_code error;
+    const auto size = std::filesystem::file_size(image->getFilename(), error);
+    if( error || size == 0 )
+        return;
+
+    _prefetch._resource = next;
+    _prefetch._data.resize(static_cast<size_t>(size));
+    _prefetch._pending  = _manager->getFileReader().read(image->getFilename(), { { 0, _prefetch._data.size(), _prefetch._data.data() } });
+}
+
+std::vector<uint8_t> LoadingQueue::takePrefetch(const Core::ResourceSPtr& resource)
+{
+    if( _current._resource == nullptr || _current._resource != resource )
+        return {};
+
+    std::vector<uint8_t> data;
+    try
+    {
+        const auto batch = _current._pending.get();
+        data = std::move(_current._data);
+        data.resize(batch.front()._read);
+    }
+    catch( const Core::Exception& )
+    {
+        // Decoder reads file itself and reports error
+    }
+    _current = Prefetch();
+    return data;
+}
+
 void LoadingQueue::run()
 {
+    Core::Profiler::setThreadName("Loading queue " + std::to_string(_iD));
+
     while(_run)
     {
         // Check resource state
@@ -213,16 +290,37 @@ void LoadingQueue::run()
                 item = std::move(_resources.front());
                 _resources.pop_front();
             }
-            
+
+            // Read file of next job during this job (vector keeps memory when moved)
+            _current  = std::move(_prefetch);
+            _prefetch = Prefetch();
+            prefetch();
+
             try
             {
                 doAction( item );
             }
-            catch(...)
+            catch( const Core::Exception& e )
             {
-            	// When resource can't be read/extract !
+                // When resource can't be read/extract: resource stays not loaded
+                const auto& error = e.read(0);
+                MOUCA_LOG_ERROR(Loader, "Loading failure of {} with {} {}",
+                                item._resource != nullptr ? item._resource->getFilename().string() : std::string(),
+                                error.getErrorLabel(), (error.getParameters().empty() ? "" : error.getParameters().front()));
+            }
+            catch( const std::exception& e )
+            {
+                MOUCA_LOG_ERROR(Loader, "Loading failure of {}: {}",
+                                item._resource != nullptr ? item._resource->getFilename().string() : std::string(), e.what());
             }
 
+            // Reader can't write into released memory
+            if( _current._pending.valid() )
+            {
+                _current._pending.wait();
+            }
+            _current = Prefetch();
+
             // Signal no direct job left
             {
                 std::unique_lock<std::mutex> locker( _jobMutex );
@@ -248,6 +346,9 @@ void LoaderManager::initialize(const uint32_t nbQueues)
     _syncDirect.initialize( nbQueues );
     _syncDeferred.initialize( nbQueues );
 
+    // I/O threads
+    _fileReader.initialize();
+
     // Create queue
     _queues.resize(nbQueues);
 
@@ -287,6 +388,9 @@ void LoaderManager::release()
     // Remove all
     _queues.clear();
 
+    // Pending reads are finished after last job
+    _fileReader.release();
+
     MouCa::postCondition(_queues.empty()); /// Operation Failed ?
 }
 
@@ -295,8 +399,18 @@ void LoaderManager::loadResources(LoadingItems& items)
     MouCa::preCondition(!_queues.empty()); // DEV Issue: Missing call initialize() !
     MouCa::preCondition(!items.empty());   // DEV Issue: No job ?
 
-    // Sort queue to have priority job first !
-    std::sort(items.begin(), items.end());
+    dispatchJobs(items);
+
+    // Wait "direct" resource before leave
+    _syncDirect.synchronize();
+}
+
+void LoaderManager::dispatchJobs(LoadingItems& items)
+{
+    MouCa::preCondition(!_queues.empty()); // DEV Issue: Missing call initialize() !
+
+    // Sort queue to have priority job first (keep order of same priority) !
+    std::stable_sort(items.begin(), items.end());
 
     // Algo 1: Job for all
     //  We add to each queue an item until we finish
@@ -315,9 +429,6 @@ void LoaderManager::loadResources(LoadingItems& items)
         if(itQueue == _queues.end())
             itQueue = _queues.begin();
     }
-
-    // Wait "direct" resource before leave
-    _syncDirect.synchronize();
 }
 
 void LoaderManager::synchronize()
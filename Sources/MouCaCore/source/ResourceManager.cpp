@@ -137,9 +137,76 @@ XML::ParserSPtr ResourceManager::openXML(const Core::Path& filename)
     return genericOpen<XML::XercesParser>( filename );
 }
 
-RT::ImageImportSPtr ResourceManager::openImage(const Core::Path& filename)
+RT::ImageImportSPtr ResourceManager::openImage(const Core::Path& filename, const RT::ImageImport::Options& options)
 {
-    return genericOpen<RT::ImageImport>( filename );
+    MouCa::preCondition(!filename.empty());
+    MouCa::preCondition(std::filesystem::exists(filename));
+
+    // Same file with other options is another image (levels/format differ)
+    const auto itResource = std::find_if(_resources.cbegin(), _resources.cend(),
+                                         [&](const auto& resource)
+                                         {
+                                             const auto image = std::dynamic_pointer_cast<RT::ImageImport>(resource);
+                                             return image != nullptr && image->getFilename() == filename && image->getOptions() == options;
+                                         });
+    if (itResource != _resources.cend())
+    {
+        return std::static_pointer_cast<RT::ImageImport>(*itResource);
+    }
+
+    auto image = std::make_shared<RT::ImageImport>();
+    _resources.insert(image);
+    image->setFileInfo(filename);
+    image->setOptions(options);
+
+    // GPU formats are already fast to read
+    const auto ext = filename.extension().u8string();
+    if (!_imageCacheFolder.empty() && ext != u8".ktx" && ext != u8".ktx2" && ext != u8".dds" && ext != u8".kmg")
+    {
+        image->setCache(computeImageCacheFilename(filename, options), _imageCacheZstdLevel);
+    }
+    return image;
+}
+
+void ResourceManager::setImageCache(const Core::Path& folder, const uint32_t zstdLevel)
+{
+    MouCa::preCondition(zstdLevel <= 22);
+
+    if (!folder.empty() && !std::filesystem::exists(folder))
+    {
+        std::filesystem::create_directories(folder);
+    }
+    _imageCacheFolder    = folder;
+    _imageCacheZstdLevel = zstdLevel;
+}
+
+Core::Path ResourceManager::computeImageCacheFilename(const Core::Path& filename, const RT::ImageImport::Options& options) const
+{
+    MouCa::preCondition(!_imageCacheFolder.empty());
+
+    // FNV-1a: stable between runs/builds (std::hash is not)
+    uint64_t key = 14695981039346656037ull;
+    auto hash = [&](const void* data, const size_t size)
+    {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+        for (size_t id = 0; id < size; ++id)
+        {
+            key = (key ^ bytes[id]) * 1099511628211ull;
+        }
+    };
+
+    const auto path  = std::filesystem::absolute(filename).lexically_normal().u8string();
+    const auto mtime = std::filesystem::last_write_time(filename).time_since_epoch().count();
+    const std::array<uint32_t, 4> settings =
+    {
+        static_cast<uint32_t>(options._mipmaps), static_cast<uint32_t>(options._compression),
+        options._sRGB ? 1u : 0u, _imageCacheZstdLevel
+    };
+    hash(path.data(), path.size());
+    hash(&mtime, sizeof(mtime));
+    hash(settings.data(), sizeof(settings));
+
+    return _imageCacheFolder / std::format(L"{}_{:016x}.ktx2", filename.stem().wstring(), key);
 }
 
 RT::MeshImportSPtr ResourceManager::openMeshImport(const Core::Path& filename, const RT::BufferDescriptor& descriptor, const RT::MeshImport::Flag flag)
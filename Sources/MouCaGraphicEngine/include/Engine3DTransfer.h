@@ -38,15 +38,21 @@ namespace MouCaGraphic
             /// Prepare all buffers (need more memory)
             void indirectCopyCPUToGPU(Vulkan::CommandBufferWPtr commandBuffer, const RT::BufferCPUBase& from, Vulkan::Buffer& to);
 
+            /// Copy all levels of image (image must be fully decoded)
             void indirectCopyCPUToGPU(Vulkan::CommandBufferWPtr commandBuffer, const RT::Image& from, Vulkan::Image& to);
 
+            /// Copy levels ready on CPU (see RT::Image::getReadyLevels()) which are not into uploadedLevels.
+            /// Progressive images (coarse levels first) can be uploaded by several transfers:
+            /// levels not uploaded stay undefined, renderer must clamp LOD until all levels are uploaded.
+            /// \returns Mask of uploaded levels (input of next call).
+            uint64_t indirectCopyReadyLevelsCPUToGPU(Vulkan::CommandBufferWPtr commandBuffer, const RT::Image& from, Vulkan::Image& to, const uint64_t uploadedLevels);
+
             /// Execute all transfers
             void transfer(Vulkan::CommandBufferWPtr commandBuffer) const;
 
         private:
 
-            void image2DArrayCPUToGPU(Vulkan::CommandBuffer& commandBuffer, const RT::Image& from, Vulkan::Image& to);
-            void image2DCPUToGPU(Vulkan::CommandBuffer& commandBuffer, const RT::Image& from, Vulkan::Image& to);
+            void imageCPUToGPU(Vulkan::CommandBuffer& commandBuffer, const RT::Image& from, Vulkan::Image& to, const uint64_t levels);
 
             const Vulkan::ContextDevice& _context;
 
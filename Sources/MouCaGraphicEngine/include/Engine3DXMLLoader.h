@@ -22,6 +22,11 @@ namespace RT
     class Window;
 }
 
+namespace Core
+{
+    class ThreadPools;
+}
+
 namespace MouCaCore
 {
     class ResourceManager;
@@ -185,6 +190,7 @@ namespace MouCaGraphic
                     GraphicEngine&              _engine;
                     XML::Parser&                _parser;
                     MouCaCore::ResourceManager& _resources;
+                    Core::ThreadPools*          _workers = nullptr; ///< [LINK] Workers recording "parallel" commands (mandatory only for them).
 
                     XML::NodeUPtr       _globalData;    ///< Saved node
                     RT::ApplicationInfo _info;
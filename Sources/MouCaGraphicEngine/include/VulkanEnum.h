@@ -115,6 +115,8 @@ namespace MouCaGraphic
 
     extern std::map<Core::String, VkRayTracingShaderGroupTypeKHR> rayTracingGroupTypes;
 
+    extern std::map<Core::String, VkBuildAccelerationStructureFlagsKHR> buildAccelerationStructureFlags;
+
     extern std::map<Core::String, VkGeometryFlagsKHR> geometryFlags;
 
     extern std::map<Core::String, VkGeometryInstanceFlagsKHR> geometryInstanceFlags;
@@ -14,6 +14,14 @@ namespace BT
     class Resource;
 }
 
+namespace Core
+{
+    class Task;
+    using TaskSPtr = std::shared_ptr<Task>;
+
+    class ThreadPools;
+}
+
 namespace RT
 {
     class ImageImport;
@@ -94,14 +102,39 @@ namespace MouCaGraphic
 
             void takeScreenshot(const Core::Path& imageFilePath, RT::ImageImportSPtr diskImage, const uint32_t contextWindowID) const;
 
+            /// Save current swapchain image directly from GPU mapped memory (PNG or EXR, no CPU image).
+            void saveScreenshot(const Core::Path& imageFilePath, const uint32_t contextWindowID) const;
+
             //Vulkan::WindowSurface& getSurface(const uint32_t id) { return _surfaces.at(id); }
 
         //-----------------------------------------------------------------------------------------
         //                                   Shader live programming
         //-----------------------------------------------------------------------------------------
             void registerShader(RT::ShaderFileWPtr file, const ShaderRegistration& shader);
+
+            //------------------------------------------------------------------------
+            /// \brief  Compile edited shader on workers: getShaderCompiled() is emitted by worker when SPIR-V is ready.
+            /// Files of one shader are used by one thread at a time: edition during compilation/reading is compiled after.
+            /// Without workers, shader is compiled and rebuilt immediately.
+            ///
+            /// \param[in] shaderFile: tracked resource (ignored when not registered).
             void afterShaderEdition(Core::Resource& shaderFile);
 
+            //------------------------------------------------------------------------
+            /// \brief  Rebuild compiled module and only pipelines using it: call at frame boundary (queued event).
+            /// New objects are created alongside old ones which are released after frames in flight.
+            /// Frames of device are waited before getAfterShaderChanged(): listeners can record again command buffers.
+            /// Ignored when shader is compiled again (latest compilation notifies).
+            ///
+            /// \param[in] shaderFile: tracked resource (ignored when not registered).
+            void afterShaderCompilation(Core::Resource& shaderFile);
+
+            //------------------------------------------------------------------------
+            /// \brief  Set workers which compile edited shaders: pending compilations are finished before change.
+            ///
+            /// \param[in] workers: shared workers (nullptr: compile on thread which notifies edition).
+            void setShaderWorkers(Core::ThreadPools* workers);
+
         //-----------------------------------------------------------------------------------------
         //                                  Environment extensions
         //-----------------------------------------------------------------------------------------
@@ -166,8 +199,12 @@ namespace MouCaGraphic
         //-----------------------------------------------------------------------------------------
             Core::Signal<>&       getAfterResize()        { return _afterResize; }
             Core::Signal<>&       getAfterClose()         { return _afterClose; }
+            /// Emitted when pipelines of edited shader are rebuilt and frames of device are finished: command buffers can be recorded again.
             Core::Signal<>&       getAfterShaderChanged() { return _afterShaderChanged; }
 
+            /// Emitted by worker when shader is compiled: connect it queued to frame events (see afterShaderCompilation()).
+            Core::Signal<Core::Resource&>& getShaderCompiled() { return _shaderCompiled; }
+
         private:
             void buildSurface(Vulkan::WindowSurface& surface) const;
             void releaseSurface(Vulkan::WindowSurface& surface);
@@ -179,6 +216,10 @@ namespace MouCaGraphic
             void afterResizeWindow(RT::Window* window, const RT::Array2ui& size);
             void afterStateSizeWindow(RT::Window* window, RT::Window::StateSize state);
 
+            /// Compile shader (called by worker): compile again when shader is edited during compilation.
+            /// \returns True when latest compilation succeeded.
+            bool compileShader(RT::ShaderFileWPtr file);
+
         //-----------------------------------------------------------------------------------------
         //                                      DATA
         //-----------------------------------------------------------------------------------------
@@ -191,10 +232,17 @@ namespace MouCaGraphic
             ShadersDictionary       _shaders;           ///< [LINK] Dictionary linking Resource and Shader module.
             std::mutex              _locked;
 
+            Core::ThreadPools*                  _shaderWorkers = nullptr;   ///< [LINK] Workers compiling shaders.
+            std::vector<Core::TaskSPtr>         _compilationTasks;          ///< Submitted compilations (main thread only).
+            std::set<const Core::Resource*>     _compilingShaders;          ///< Shaders into compilation.
+            std::set<const Core::Resource*>     _editedShaders;             ///< Shaders edited during their compilation.
+            std::mutex                          _compilationLock;           ///< Protect compilation sets.
+
             // Event
             Core::Signal<>            _afterResize;
             Core::Signal<>            _afterClose;
-            Core::Signal<>            _afterShaderChanged;
+            Core::Signal<>                  _afterShaderChanged;
+            Core::Signal<Core::Resource&>   _shaderCompiled;
     };
 
 }
\ No newline at end of file
@@ -97,42 +97,95 @@ void Engine3DTransfer::transfer(Vulkan::CommandBufferWPtr commandBuffer) const
 
 void Engine3DTransfer::indirectCopyCPUToGPU(Vulkan::CommandBufferWPtr commandBuffer, const RT::Image& from, Vulkan::Image& to)
 {
-    if (from.getLayers() > 1)
+    const uint64_t allLevels = from.RT::Image::getReadyLevels();
+    MouCa::preCondition(from.getReadyLevels() == allLevels); // DEV Issue: Image is still decoding: use indirectCopyReadyLevelsCPUToGPU() !
+
+    imageCPUToGPU(*commandBuffer.lock(), from, to, allLevels);
+}
+
+uint64_t Engine3DTransfer::indirectCopyReadyLevelsCPUToGPU(Vulkan::CommandBufferWPtr commandBuffer, const RT::Image& from, Vulkan::Image& to, const uint64_t uploadedLevels)
+{
+    // Snapshot: levels becoming ready during copy are uploaded by next call
+    const uint64_t readyLevels = from.getReadyLevels();
+    const uint64_t newLevels   = readyLevels & ~uploadedLevels;
+    if (newLevels != 0)
     {
-        image2DArrayCPUToGPU(*commandBuffer.lock(), from, to);
+        imageCPUToGPU(*commandBuffer.lock(), from, to, newLevels);
     }
-    else
+    return uploadedLevels | newLevels;
+}
+
+namespace
+{
+    // Size of each layer/level into image memory (layout is defined by image: use distance to next sub-resource)
+    std::vector<size_t> computeSubresourceSizes(const RT::Image& image)
     {
-        image2DCPUToGPU(*commandBuffer.lock(), from, to);
+        std::vector<size_t> offsets;
+        offsets.reserve(image.getLevels() * image.getLayers() + 1);
+        for (uint32_t layer = 0; layer < image.getLayers(); ++layer)
+        {
+            for (uint32_t mipLevel = 0; mipLevel < image.getLevels(); ++mipLevel)
+            {
+                offsets.emplace_back(image.getMemoryOffset(layer, mipLevel));
+            }
+        }
+        std::vector<size_t> sorted(offsets);
+        sorted.emplace_back(image.getMemorySize());
+        std::sort(sorted.begin(), sorted.end());
+
+        std::vector<size_t> sizes;
+        sizes.reserve(offsets.size());
+        for (const size_t offset : offsets)
+        {
+            const auto next = std::upper_bound(sorted.cbegin(), sorted.cend(), offset);
+            sizes.emplace_back(next != sorted.cend() ? *next - offset : 0);
+        }
+        return sizes;
     }
 }
 
-void Engine3DTransfer::image2DArrayCPUToGPU(Vulkan::CommandBuffer& commandBuffer, const RT::Image& from, Vulkan::Image& to)
+void Engine3DTransfer::imageCPUToGPU(Vulkan::CommandBuffer& commandBuffer, const RT::Image& from, Vulkan::Image& to, const uint64_t levels)
 {
     MouCa::preCondition(!commandBuffer.isNull());
+    MouCa::preCondition(levels != 0);
 
     const auto& device = _context.getDevice();
 
     const auto& size = to.getExtent();
-    MouCa::preCondition(size.width        == static_cast<uint32_t>(from.getExtents(0).x));
-    MouCa::preCondition(size.height       == static_cast<uint32_t>(from.getExtents(0).y));
-    MouCa::preCondition(to.getArraySize() == static_cast<uint32_t>(from.getLayers()));
+    MouCa::preCondition(size.width  == static_cast<uint32_t>(from.getExtents(0).x));
+    MouCa::preCondition(size.height == static_cast<uint32_t>(from.getExtents(0).y));
+    MouCa::preCondition(from.getLayers() == 1 || to.getArraySize() == static_cast<uint32_t>(from.getLayers()));
 
-    //Create a buffer with data
-    auto stagingBuffer = std::make_unique<Vulkan::Buffer>(std::make_unique<Vulkan::MemoryBuffer>(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
-    stagingBuffer->initialize(device, 0, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, from.getMemorySize(), from.getRAWData(0, 0));
+    // Copy only selected levels: others can still be written by decoding tasks
+    const bool allLevels = levels == from.RT::Image::getReadyLevels();
+    const std::vector<size_t> subresourceSizes = allLevels ? std::vector<size_t>() : computeSubresourceSizes(from);
 
-    // Setup buffer copy regions for each mip level
+    std::vector<uint8_t> gathered;
     std::vector<VkBufferImageCopy> bufferCopyRegions;
     bufferCopyRegions.reserve(from.getLevels() * from.getLayers());
 
+    // Setup buffer copy regions for each mip level
     for (uint32_t layer = 0; layer < from.getLayers(); layer++)
     {
         for (uint32_t mipLevel = 0; mipLevel < from.getLevels(); mipLevel++)
         {
+            if ((levels & (1ull << mipLevel)) == 0)
+            {
+                continue;
+            }
+
+            VkDeviceSize bufferOffset = from.getMemoryOffset(layer, mipLevel);
+            if (!allLevels)
+            {
+                const size_t subresourceSize = subresourceSizes[layer * from.getLevels() + mipLevel];
+                const auto*  data            = static_cast<const uint8_t*>(from.getRAWData(layer, mipLevel));
+                bufferOffset = gathered.size();
+                gathered.insert(gathered.end(), data, data + subresourceSize);
+            }
+
             const VkBufferImageCopy bufferCopyRegion =
             {
-                from.getMemoryOffset(layer, mipLevel),  // VkDeviceSize                bufferOffset;
+                bufferOffset,                           // VkDeviceSize                bufferOffset;
                 0,                                      // uint32_t                    bufferRowLength;
                 0,                                      // uint32_t                    bufferImageHeight;
                 {
@@ -142,7 +195,7 @@ void Engine3DTransfer::image2DArrayCPUToGPU(Vulkan::CommandBuffer& commandBuffer
                     1                                   // uint32_t                    layerCount;
                 },                                      // VkImageSubresourceLayers    imageSubresource;
                 { 0, 0, 0 },                            // VkOffset3D                  imageOffset;
-                {                                                                      
+                {
                     from.getExtents(mipLevel).x,
                     from.getExtents(mipLevel).y,
                     1
@@ -152,131 +205,64 @@ void Engine3DTransfer::image2DArrayCPUToGPU(Vulkan::CommandBuffer& commandBuffer
         }
     }
 
-    VkImageSubresourceRange subresourceRange =
+    //Create a buffer with data
+    auto stagingBuffer = std::make_unique<Vulkan::Buffer>(std::make_unique<Vulkan::MemoryBuffer>(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+    if (allLevels)
     {
-        VK_IMAGE_ASPECT_COLOR_BIT,                  //VkImageAspectFlags    aspectMask;
-        0,                                          //uint32_t              baseMipLevel;
-        static_cast<uint32_t>(from.getLevels()),    //uint32_t              levelCount;
-        0,                                          //uint32_t              baseArrayLayer;
-        static_cast<uint32_t>(from.getLayers())     //uint32_t              layerCount;
-    };
-
-    // Image barrier for optimal image (target)
-    // Optimal image will be used as destination for the copy
-    Vulkan::CommandPipelineBarrier::ImageMemoryBarriers barrierCopy
+        stagingBuffer->initialize(device, 0, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, from.getMemorySize(), from.getRAWData(0, 0));
+    }
+    else
     {
-        {
-            VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER, nullptr,
-            0, VK_ACCESS_TRANSFER_WRITE_BIT,
-            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
-            to.getImage(), subresourceRange
-        }
-    };
-    commandBuffer.addCommand(std::make_unique<Vulkan::CommandPipelineBarrier>(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_DEPENDENCY_BY_REGION_BIT,
-                                                                               Vulkan::CommandPipelineBarrier::MemoryBarriers(), Vulkan::CommandPipelineBarrier::BufferMemoryBarriers(), std::move(barrierCopy)));
-
-    // Copy mip levels from staging buffer
-    commandBuffer.addCommand(std::make_unique<Vulkan::CommandCopyBufferToImage>(*stagingBuffer, to, std::move(bufferCopyRegions)));
+        stagingBuffer->initialize(device, 0, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, gathered.size(), gathered.data());
+    }
 
-    // Change texture image layout to shader read after all mip levels have been copied
-    Vulkan::CommandPipelineBarrier::ImageMemoryBarriers barrierSync
+    // One barrier by uploaded level: other levels keep their layout
+    Vulkan::CommandPipelineBarrier::ImageMemoryBarriers barrierCopy;
+    Vulkan::CommandPipelineBarrier::ImageMemoryBarriers barrierSync;
+    for (uint32_t mipLevel = 0; mipLevel < from.getLevels(); mipLevel++)
     {
+        if ((levels & (1ull << mipLevel)) == 0)
         {
-            VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER, nullptr,
-            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-            VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
-            to.getImage(), subresourceRange
+            continue;
         }
-    };
-    commandBuffer.addCommand(std::make_unique<Vulkan::CommandPipelineBarrier>(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_DEPENDENCY_BY_REGION_BIT,
-                                                      Vulkan::CommandPipelineBarrier::MemoryBarriers(), Vulkan::CommandPipelineBarrier::BufferMemoryBarriers(), std::move(barrierSync)));
-
-    // Keep buffer until done/clean
-    _indirectCopyBuffers.emplace_back(std::move(stagingBuffer));
-}
-
-void Engine3DTransfer::image2DCPUToGPU(Vulkan::CommandBuffer& commandBuffer, const RT::Image& from, Vulkan::Image& to)
-{
-    MouCa::preCondition(!commandBuffer.isNull());
-
-    const auto& device = _context.getDevice();
 
-    MouCa::preCondition(to.getExtent().width  == from.getExtents(0).x);
-    MouCa::preCondition(to.getExtent().height == from.getExtents(0).y);
-
-    //Create a buffer with data
-    auto stagingBuffer = std::make_unique<Vulkan::Buffer>(std::make_unique<Vulkan::MemoryBuffer>(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
-    stagingBuffer->initialize(device, 0, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, from.getMemorySize(), from.getRAWData(0, 0));
-
-    // Setup buffer copy regions for each mip level
-    std::vector<VkBufferImageCopy> bufferCopyRegions;
-    bufferCopyRegions.reserve(from.getLevels() * from.getLayers());
-
-    const uint32_t layer = 0;
-    for (uint32_t mipLevel = 0; mipLevel < from.getLevels(); mipLevel++)
-    {
-        const VkBufferImageCopy bufferCopyRegion =
+        const VkImageSubresourceRange subresourceRange =
         {
-            from.getMemoryOffset(layer, mipLevel),  // VkDeviceSize                bufferOffset;
-            0,                                      // uint32_t                    bufferRowLength;
-            0,                                      // uint32_t                    bufferImageHeight;
-            {
-                VK_IMAGE_ASPECT_COLOR_BIT,          // VkImageAspectFlags          aspectMask;
-                mipLevel,                           // uint32_t                    mipLevel;
-                layer,                              // uint32_t                    baseArrayLayer;
-                1                                   // uint32_t                    layerCount;
-            },                                      // VkImageSubresourceLayers    imageSubresource;
-            { 0, 0, 0 },                            // VkOffset3D                  imageOffset;
-            {
-                from.getExtents(mipLevel).x,
-                from.getExtents(mipLevel).y,
-                1
-            }                                       // VkExtent3D                  imageExtent;
+            VK_IMAGE_ASPECT_COLOR_BIT,                  //VkImageAspectFlags    aspectMask;
+            mipLevel,                                   //uint32_t              baseMipLevel;
+            1,                                          //uint32_t              levelCount;
+            0,                                          //uint32_t              baseArrayLayer;
+            static_cast<uint32_t>(from.getLayers())     //uint32_t              layerCount;
         };
-        bufferCopyRegions.emplace_back(bufferCopyRegion);
-    }
-
-    VkImageSubresourceRange subresourceRange =
-    {
-        VK_IMAGE_ASPECT_COLOR_BIT,                  //VkImageAspectFlags    aspectMask;
-        0,                                          //uint32_t              baseMipLevel;
-        static_cast<uint32_t>(from.getLevels()),    //uint32_t              levelCount;
-        0,                                          //uint32_t              baseArrayLayer;
-        static_cast<uint32_t>(from.getLayers())     //uint32_t              layerCount;
-    };
 
-    // Image barrier for optimal image (target)
-    // Optimal image will be used as destination for the copy
-    Vulkan::CommandPipelineBarrier::ImageMemoryBarriers barrierCopy
-    {
+        // Image barrier for optimal image (target)
+        // Optimal image will be used as destination for the copy
+        barrierCopy.emplace_back(VkImageMemoryBarrier
         {
             VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER, nullptr,
             0, VK_ACCESS_TRANSFER_WRITE_BIT,
             VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
             VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
             to.getImage(), subresourceRange
-        }
-    };
-
-    commandBuffer.addCommand(std::make_unique<Vulkan::CommandPipelineBarrier>(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_DEPENDENCY_BY_REGION_BIT,
-                                                      Vulkan::CommandPipelineBarrier::MemoryBarriers(), Vulkan::CommandPipelineBarrier::BufferMemoryBarriers(), std::move(barrierCopy)));
+        });
 
-    // Copy mip levels from staging buffer
-    commandBuffer.addCommand(std::make_unique<Vulkan::CommandCopyBufferToImage>(*stagingBuffer, to, std::move(bufferCopyRegions)));
-
-    // Change texture image layout to shader read after all mip levels have been copied
-    Vulkan::CommandPipelineBarrier::ImageMemoryBarriers barrierSync
-    {
+        // Change texture image layout to shader read after all mip levels have been copied
+        barrierSync.emplace_back(VkImageMemoryBarrier
         {
             VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER, nullptr,
             VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
             VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
             to.getImage(), subresourceRange
-        }
-    };
+        });
+    }
+
+    commandBuffer.addCommand(std::make_unique<Vulkan::CommandPipelineBarrier>(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_DEPENDENCY_BY_REGION_BIT,
+                                                                              Vulkan::CommandPipelineBarrier::MemoryBarriers(), Vulkan::CommandPipelineBarrier::BufferMemoryBarriers(), std::move(barrierCopy)));
+
+    // Copy mip levels from staging buffer
+    commandBuffer.addCommand(std::make_unique<Vulkan::CommandCopyBufferToImage>(*stagingBuffer, to, std::move(bufferCopyRegions)));
+
     commandBuffer.addCommand(std::make_unique<Vulkan::CommandPipelineBarrier>(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_DEPENDENCY_BY_REGION_BIT,
                                                                               Vulkan::CommandPipelineBarrier::MemoryBarriers(), Vulkan::CommandPipelineBarrier::BufferMemoryBarriers(), std::move(barrierSync)));
 
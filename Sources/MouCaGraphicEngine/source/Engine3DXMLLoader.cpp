@@ -4,6 +4,8 @@
 #include "MouCaGraphicEngine/include/Engine3DXMLHelper.h"
 
 #include <LibCore/include/CoreFileTracker.h>
+#include <LibCore/include/CoreLogger.h>
+#include <LibCore/include/CoreProfiler.h>
 
 #include <LibRT/include/RTImage.h>
 #include <LibRT/include/RTMonitor.h>
@@ -50,6 +52,16 @@ Core::ErrorData Engine3DXMLLoader::makeLoaderError(const ContextLoading& context
     return Core::ErrorData("Engine3D", idError) << context.getFileName().string();
 }
 
+/// Read frameSemaphore attribute: semaphore of current frame in flight ("acquire" or "render").
+static Vulkan::FrameRing::SemaphoreType readFrameSemaphore(const XML::NodeUPtr& node, const Engine3DXMLLoader::ContextLoading& context)
+{
+    Core::String name;
+    node->getAttribute("frameSemaphore", name);
+    if (name == "acquire") { return Vulkan::FrameRing::SemaphoreType::Acquire; }
+    if (name == "render")  { return Vulkan::FrameRing::SemaphoreType::Render; }
+    throw Core::Exception(Core::ErrorData("Engine3D", "XMLUnknownFrameSemaphoreError") << context.getFileName().string() << name);
+}
+
 template<>
 static void LoaderHelper::readData(const XML::NodeUPtr& node, VkExtent3D& extent)
 {
@@ -71,6 +83,8 @@ Engine3DXMLLoader::~Engine3DXMLLoader()
 
 void Engine3DXMLLoader::load(ContextLoading& context)
 {
+    MOUCA_PROFILE_ZONE("Engine3DXMLLoader::load");
+
     MouCa::preCondition(context._parser.isLoaded()); //DEV Issue: Need a valid xml.
 
     //Read Engine part
@@ -320,8 +334,29 @@ void Engine3DXMLLoader::loadSemaphores(ContextLoading& context, Vulkan::ContextD
             bool existing;
             const uint32_t id = LoaderHelper::getIdentifiant(semaphoreNode, "Semaphore", _semaphores, context, existing);
 
+            // Optional timeline
+            Core::String type("binary");
+            if (semaphoreNode->hasAttribute("type")) { semaphoreNode->getAttribute("type", type); }
+            uint64_t initialValue = 0;
+            if (semaphoreNode->hasAttribute("initialValue")) { semaphoreNode->getAttribute("initialValue", initialValue); }
+
             auto semaphore = std::make_shared<Vulkan::Semaphore>();
-            semaphore->initialize(device->getDevice());
+            if (type == "timeline")
+            {
+                if (!device->getDevice().isTimelineSemaphoreEnabled())
+                {
+                    throw Core::Exception(makeLoaderError(context, "TimelineSemaphoreNotSupportedError") << "Semaphore");
+                }
+                semaphore->initialize(device->getDevice(), VK_SEMAPHORE_TYPE_TIMELINE, initialValue);
+            }
+            else if (type == "binary")
+            {
+                semaphore->initialize(device->getDevice());
+            }
+            else
+            {
+                throw Core::Exception(makeLoaderError(context, "XMLUnknownSemaphoreTypeError") << type);
+            }
 
             // Register + ownership
             device->insertSemaphore(semaphore);
@@ -543,6 +578,8 @@ void Engine3DXMLLoader::loadImagesAndView(ContextLoading& context, Vulkan::Conte
                 };
                 size._arrayLayers = image->getLayers();
                 size._mipLevels   = image->getLevels();
+                // Compressed data (BCn) needs format of image (XML format overrides it)
+                format = static_cast<VkFormat>(image->getFormat());
                 switch (image->getTarget())
                 {
                     case RT::Image::Target::Type1D:
@@ -603,7 +640,7 @@ void Engine3DXMLLoader::loadImagesAndView(ContextLoading& context, Vulkan::Conte
             // Register + ownership
             device->insertImage(image);
             _images[id] = image;
-            MouCa::logConsole(std::format("Image: id={}, handle={:#08x}", id, reinterpret_cast<size_t>(image->getImage())));
+            MOUCA_LOG_DEBUG(Vulkan, "Image: id={}, handle={:#08x}", id, reinterpret_cast<size_t>(image->getImage()));
 
             // Build view
             auto aPush = context._parser.autoPushNode(*imageNode);
@@ -638,7 +675,7 @@ void Engine3DXMLLoader::loadImagesAndView(ContextLoading& context, Vulkan::Conte
                 auto view = image->createView(device->getDevice(), typeV, formatV, mapping, subRessourceRange);
                 _view[idV] = view;
 
-                MouCa::logConsole(std::format("View: id={}, handle={:#08x}", idV, reinterpret_cast<size_t>(view.lock()->getInstance())));
+                MOUCA_LOG_DEBUG(Vulkan, "View: id={}, handle={:#08x}", idV, reinterpret_cast<size_t>(view.lock()->getInstance()));
             }
         }
     }
@@ -945,7 +982,29 @@ void Engine3DXMLLoader::loadSequences(ContextLoading& context, Vulkan::ContextDe
 
             // Build Sequence
             const uint32_t idS = LoaderHelper::getLinkedIdentifiant(sequenceNode, "surfaceId", _surfaces, context);
-            queueSequence->emplace_back(std::make_shared<Vulkan::SequenceAcquire>(_surfaces[idS].lock()->getEditSwapChain(), semaphore, fence, timeout));
+            if (sequenceNode->hasAttribute("frameSemaphore"))
+            {
+                // Semaphore of frame in flight (started by beginFrame)
+                if (readFrameSemaphore(sequenceNode, context) != Vulkan::FrameRing::SemaphoreType::Acquire || !semaphore.expired())
+                {
+                    throw Core::Exception(makeLoaderError(context, "XMLFrameSemaphoreError") << "Sequence type=acquire");
+                }
+                queueSequence->emplace_back(std::make_shared<Vulkan::SequenceAcquire>(_surfaces[idS].lock()->getEditSwapChain(), deviceWeak.lock()->getFrameRing(), fence, timeout));
+            }
+            else
+            {
+                queueSequence->emplace_back(std::make_shared<Vulkan::SequenceAcquire>(_surfaces[idS].lock()->getEditSwapChain(), semaphore, fence, timeout));
+            }
+        }
+        else if (type == "beginFrame")
+        {
+            uint64_t timeout = std::numeric_limits<uint64_t>::max();
+
+            // Read optional data
+            if(sequenceNode->hasAttribute("timeout")) { sequenceNode->getAttribute("timeout", timeout); }
+
+            // Build Sequence
+            queueSequence->emplace_back(std::make_shared<Vulkan::SequenceBeginFrame>(deviceWeak, timeout));
         }
         else if (type == "waitFence")
         {
@@ -975,6 +1034,41 @@ void Engine3DXMLLoader::loadSequences(ContextLoading& context, Vulkan::ContextDe
             // Build Sequence
             queueSequence->emplace_back(std::make_shared<Vulkan::SequenceWaitFence>(fences, timeout, (waitAll ? VK_TRUE : VK_FALSE)));
         }
+        else if (type == "waitSemaphore")
+        {
+            uint64_t timeout = std::numeric_limits<uint64_t>::max();
+
+            // Read optional data
+            if(sequenceNode->hasAttribute("timeout")) { sequenceNode->getAttribute("timeout", timeout); }
+
+            // Read all timeline semaphores associated (value 0: latest scheduled signal)
+            std::vector<Vulkan::SemaphoreWPtr> semaphores;
+            std::vector<uint64_t>              values;
+            auto aPush         = context._parser.autoPushNode(*sequenceNode);
+            auto allSemaphores = context._parser.getNode("Semaphore");
+            for (size_t idSemaphore = 0; idSemaphore < allSemaphores->getNbElements(); ++idSemaphore)
+            {
+                auto semaphoreNode = allSemaphores->getNode(idSemaphore);
+                const uint32_t idSem = LoaderHelper::getLinkedIdentifiant(semaphoreNode, "semaphoreId", _semaphores, context);
+                if (!_semaphores[idSem].lock()->isTimeline())
+                {
+                    throw Core::Exception(makeLoaderError(context, "XMLTimelineSemaphoreError") << "Sequence type=waitSemaphore");
+                }
+
+                uint64_t value = 0;
+                if (semaphoreNode->hasAttribute("value")) { semaphoreNode->getAttribute("value", value); }
+
+                semaphores.emplace_back(_semaphores[idSem]);
+                values.emplace_back(value);
+            }
+            if (semaphores.empty())
+            {
+                throw Core::Exception(makeLoaderError(context, "XMLMissingNodeError") << "Sequence type=waitSemaphore" << "Semaphore");
+            }
+
+            // Build Sequence
+            queueSequence->emplace_back(std::make_shared<Vulkan::SequenceWaitSemaphore>(semaphores, values, timeout));
+        }
         else if (type == "resetFence")
         {
             // Read all fences associated
@@ -1004,13 +1098,38 @@ void Engine3DXMLLoader::loadSequences(ContextLoading& context, Vulkan::ContextDe
                 fence = _fences[idF];
             }
 
+            // Signal fence of frame in flight (started by beginFrame)
+            bool frameFence = false;
+            if (sequenceNode->hasAttribute("frameFence")) { sequenceNode->getAttribute("frameFence", frameFence); }
+
+            // Queue where work is executed
+            Vulkan::Device::QueueType queue = Vulkan::Device::QueueType::Graphic;
+            if (sequenceNode->hasAttribute("queue"))
+            {
+                Core::String queueName;
+                sequenceNode->getAttribute("queue", queueName);
+                if (queueName == "compute")       { queue = Vulkan::Device::QueueType::Compute; }
+                else if (queueName == "transfer") { queue = Vulkan::Device::QueueType::Transfer; }
+                else if (queueName != "graphic")
+                {
+                    throw Core::Exception(makeLoaderError(context, "XMLUnknownQueueError") << queueName);
+                }
+            }
+
             // Build SubmitInfo
             Vulkan::SubmitInfos submitInfos;
             auto aPush = context._parser.autoPushNode(*sequenceNode);
             loadSubmitInfo(context, deviceWeak, submitInfos);
 
             // Build Sequence
-            queueSequence->emplace_back(std::make_shared<Vulkan::SequenceSubmit>(std::move(submitInfos), fence));
+            if (frameFence)
+            {
+                queueSequence->emplace_back(std::make_shared<Vulkan::SequenceSubmit>(std::move(submitInfos), deviceWeak.lock()->getFrameRing(), queue));
+            }
+            else
+            {
+                queueSequence->emplace_back(std::make_shared<Vulkan::SequenceSubmit>(std::move(submitInfos), fence, queue));
+            }
         }
         else if (type == "submitVR")
         {
@@ -1062,17 +1181,28 @@ void Engine3DXMLLoader::loadSequences(ContextLoading& context, Vulkan::ContextDe
             }
 
             // Parsing all Signal Semaphore
+            const Vulkan::FrameRing* frameRing = nullptr;
             auto allSemaphores = context._parser.getNode("Semaphore");
             for (size_t idSemaphore = 0; idSemaphore < allSemaphores->getNbElements(); ++idSemaphore)
             {
                 auto semaphoreNode = allSemaphores->getNode(idSemaphore);
+                // Render semaphore of frame in flight
+                if (semaphoreNode->hasAttribute("frameSemaphore"))
+                {
+                    if (readFrameSemaphore(semaphoreNode, context) != Vulkan::FrameRing::SemaphoreType::Render || frameRing != nullptr)
+                    {
+                        throw Core::Exception(makeLoaderError(context, "XMLFrameSemaphoreError") << "Sequence type=presentKHR");
+                    }
+                    frameRing = &deviceWeak.lock()->getFrameRing();
+                    continue;
+                }
                 // Read info
                 const uint32_t idSem = LoaderHelper::getLinkedIdentifiant(semaphoreNode, "semaphoreId", _semaphores, context);
                 // Store
                 semaphores.emplace_back(_semaphores[idSem]);
             }
             // Build Sequence
-            auto sequence = std::make_shared<Vulkan::SequencePresentKHR>(semaphores, swapChains);
+            auto sequence = std::make_shared<Vulkan::SequencePresentKHR>(semaphores, swapChains, frameRing);
             sequence->registerSwapChain(); //Sniff: best into constructor
             queueSequence->emplace_back(sequence);
         }
@@ -1087,9 +1217,12 @@ void Engine3DXMLLoader::loadSubmitInfo(ContextLoading& context, Vulkan::ContextD
 {
     MouCa::preCondition(!deviceWeak.expired());        //DEV Issue: Bad device !
 
-    std::vector<Vulkan::WaitSemaphore>      waitSemaphores;
-    std::vector<Vulkan::SemaphoreWPtr>      signalSemaphores;
-    std::vector<Vulkan::ICommandBufferWPtr> commandBuffers;
+    std::vector<Vulkan::WaitSemaphore>              waitSemaphores;
+    std::vector<Vulkan::SemaphoreWPtr>              signalSemaphores;
+    std::vector<uint64_t>                           waitValues;
+    std::vector<Vulkan::WaitFrameSemaphore>         waitFrameSemaphores;
+    std::vector<Vulkan::FrameRing::SemaphoreType>   signalFrameSemaphores;
+    std::vector<Vulkan::ICommandBufferWPtr>         commandBuffers;
 
     // Parsing all WaitSync
     auto allWaitSyncs = context._parser.getNode("WaitSync");
@@ -1097,11 +1230,22 @@ void Engine3DXMLLoader::loadSubmitInfo(ContextLoading& context, Vulkan::ContextD
     {
         auto waitSyncNode = allWaitSyncs->getNode(idWaitSync);
 
+        const auto pipelineFlag = LoaderHelper::readValue(waitSyncNode, "pipelineFlag", pipelineStageFlags, true, context);
+        // Semaphore of frame in flight (changes each frame)
+        if (waitSyncNode->hasAttribute("frameSemaphore"))
+        {
+            waitFrameSemaphores.emplace_back(Vulkan::WaitFrameSemaphore(readFrameSemaphore(waitSyncNode, context), pipelineFlag));
+            continue;
+        }
+
         // Read info
         const uint32_t idSem  = LoaderHelper::getLinkedIdentifiant(waitSyncNode, "semaphoreId", _semaphores, context);
-        const auto pipelineFlag = LoaderHelper::readValue(waitSyncNode, "pipelineFlag", pipelineStageFlags, true, context);
+        // Timeline value (0: latest scheduled signal)
+        uint64_t value = 0;
+        if (waitSyncNode->hasAttribute("value")) { waitSyncNode->getAttribute("value", value); }
         // Store
         waitSemaphores.emplace_back(Vulkan::WaitSemaphore(_semaphores[idSem], pipelineFlag));
+        waitValues.emplace_back(value);
     }
 
     // Parsing all Signal Semaphore
@@ -1110,8 +1254,20 @@ void Engine3DXMLLoader::loadSubmitInfo(ContextLoading& context, Vulkan::ContextD
     {
         auto signalSyncNode = allSignalSyncs->getNode(idSignalSync);
 
+        // Semaphore of frame in flight (changes each frame)
+        if (signalSyncNode->hasAttribute("frameSemaphore"))
+        {
+            signalFrameSemaphores.emplace_back(readFrameSemaphore(signalSyncNode, context));
+            continue;
+        }
+
         // Read info
         const uint32_t idSem  = LoaderHelper::getLinkedIdentifiant(signalSyncNode, "semaphoreId", _semaphores, context);
+        // Sequences are executed each frame: timeline must signal next value (fixed value is signaled only once)
+        if (signalSyncNode->hasAttribute("value"))
+        {
+            throw Core::Exception(makeLoaderError(context, "XMLTimelineSignalValueError") << "SignalSync");
+        }
         // Store
         signalSemaphores.emplace_back(_semaphores[idSem]);
     }
@@ -1140,7 +1296,11 @@ void Engine3DXMLLoader::loadSubmitInfo(ContextLoading& context, Vulkan::ContextD
     }
 
     auto submitInfo = std::make_unique<Vulkan::SubmitInfo>();
-    submitInfo->addSynchronization(waitSemaphores, signalSemaphores);
+    submitInfo->addSynchronization(waitSemaphores, signalSemaphores, waitValues, {});
+    if (!waitFrameSemaphores.empty() || !signalFrameSemaphores.empty())
+    {
+        submitInfo->addFrameSynchronization(deviceWeak.lock()->getFrameRing(), waitFrameSemaphores, signalFrameSemaphores);
+    }
     submitInfo->initialize(std::move(commandBuffers));
     //submitInfo->buildSubmitInfo();
 
@@ -1278,19 +1438,23 @@ void Engine3DXMLLoader::loadDescriptorSets(ContextLoading& context, Vulkan::Cont
                 continue;
             }
 
-            const uint32_t idPool = LoaderHelper::getLinkedIdentifiant(descriptorSetNode, "descriptorPoolId", _descriptorPools, context);
-            
+            // Without fixed pool: sets are allocated by pools of device (growing with needs)
+            const bool     hasPool = descriptorSetNode->hasAttribute("descriptorPoolId");
+            const uint32_t idPool  = hasPool ? LoaderHelper::getLinkedIdentifiant(descriptorSetNode, "descriptorPoolId", _descriptorPools, context) : 0;
+
             // Parse SetLayout
             auto aPushS = context._parser.autoPushNode(*descriptorSetNode);
             auto allSetLayouts = context._parser.getNode("SetLayout");
 
             // Allocate array
             std::vector<VkDescriptorSetLayout> dSetLayouts;
+            std::vector<const Vulkan::DescriptorSetLayout*> setLayouts;
             std::vector<std::vector<Vulkan::WriteDescriptorSet>> writeDescriptors;
             writeDescriptors.resize(allSetLayouts->getNbElements());
             auto itWriteDescriptor = writeDescriptors.begin();
 
             dSetLayouts.reserve(allSetLayouts->getNbElements());
+            setLayouts.reserve(allSetLayouts->getNbElements());
             // Fill
             for (size_t idDSetLayout = 0; idDSetLayout < allSetLayouts->getNbElements(); ++idDSetLayout)
             {
@@ -1298,6 +1462,7 @@ void Engine3DXMLLoader::loadDescriptorSets(ContextLoading& context, Vulkan::Cont
 
                 const uint32_t idS = LoaderHelper::getLinkedIdentifiant(dSetLayoutNode, "descriptorSetLayoutId", _descriptorSetLayouts, context);
                 dSetLayouts.emplace_back(_descriptorSetLayouts[idS].lock()->getInstance());
+                setLayouts.emplace_back(_descriptorSetLayouts[idS].lock().get());
 
                 // Parse WriteDescriptor
                 auto aPushSL = context._parser.autoPushNode(*dSetLayoutNode);
@@ -1377,7 +1542,14 @@ void Engine3DXMLLoader::loadDescriptorSets(ContextLoading& context, Vulkan::Cont
             }
 
             auto descriptorSet = std::make_shared<Vulkan::DescriptorSet>();
-            descriptorSet->initialize(device->getDevice(), _descriptorPools[idPool], dSetLayouts);
+            if (hasPool)
+            {
+                descriptorSet->initialize(device->getDevice(), _descriptorPools[idPool], dSetLayouts);
+            }
+            else
+            {
+                descriptorSet->initialize(device->getDevice(), device->getDescriptorAllocator(), setLayouts);
+            }
 
             // Update descriptor set
             uint32_t set = 0;
@@ -1699,6 +1871,10 @@ void Engine3DXMLLoader::loadAccelerationStructures(ContextLoading& context, Vulk
 
             // Prepare AS
             as->setCreateInfo(0, type);
+            if (accelerationStructureNode->hasAttribute("buildFlags"))
+            {
+                as->setBuildFlags(LoaderHelper::readValue(accelerationStructureNode, "buildFlags", buildAccelerationStructureFlags, true, context));
+            }
 
             // Need to update as when data ready: not here !
             
@@ -567,6 +567,62 @@ void Engine3DXMLLoader::loadCommands(ContextLoading& context, Vulkan::ContextDev
 
             command = std::move(commandSwitch);
         }
+        else if (type == "parallel")
+        {
+            if (context._workers == nullptr)
+            {
+                throw Core::Exception(Core::ErrorData("Engine3D", "XMLMissingWorkersError") << context.getFileName().string() << type);
+            }
+
+            bool existing;
+            const uint32_t id = LoaderHelper::getIdentifiant(commandNode, nodeName, _commandLinks, context, existing);
+            if (existing)
+            {
+                continue;
+            }
+
+            // Secondary command buffers continue render pass (or are executed outside render pass)
+            Vulkan::RenderPassWPtr renderPass;
+            uint32_t subpass = 0;
+            if (commandNode->hasAttribute("renderPassId"))
+            {
+                const uint32_t renderPassId = LoaderHelper::getLinkedIdentifiant(commandNode, "renderPassId", _renderPasses, context);
+                renderPass = _renderPasses[renderPassId];
+                commandNode->getAttribute("subpass", subpass);
+            }
+
+            const auto device = deviceWeak.lock();
+            auto commandParallel = std::make_unique<Vulkan::CommandParallelContainer>(device->getDevice(), *context._workers, renderPass, subpass, &device->getFrameRing());
+            _commandLinks[id] = commandParallel.get(); // Keep pointer (badly because can be delete -> shared/weak ?)
+
+            // Load ranges: sub-commands of each range are recorded into their own secondary command buffer
+            {
+                auto aPush = context._parser.autoPushNode(*commandNode);
+
+                auto allRanges = context._parser.getNode("Range");
+                std::vector<Vulkan::CommandUPtr> ranges;
+                ranges.reserve(allRanges->getNbElements());
+                for (size_t idRange = 0; idRange < allRanges->getNbElements(); ++idRange)
+                {
+                    auto aPushR = context._parser.autoPushNode(*allRanges->getNode(idRange));
+
+                    std::vector<Vulkan::CommandUPtr> subCommands;
+                    loadCommands(context, deviceWeak, resolution, subCommands, Core::String("Sub"+nodeName));
+
+                    auto range = std::make_unique<Vulkan::CommandContainer>();
+                    range->transfer(std::move(subCommands));
+                    ranges.emplace_back(std::move(range));
+                }
+
+                if (ranges.empty())
+                {
+                    throw Core::Exception(Core::ErrorData("Engine3D", "XMLMissingRangeError") << context.getFileName().string() << type);
+                }
+                commandParallel->transfer(std::move(ranges));
+            }
+
+            command = std::move(commandParallel);
+        }
         else if (type == "traceRays")
         {
             uint32_t width;
@@ -909,6 +909,15 @@ std::map<Core::String, VkAccelerationStructureTypeKHR> accelerationStructureType
     { "VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_NV",   VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_NV },
 };
 
+std::map<Core::String, VkBuildAccelerationStructureFlagsKHR> buildAccelerationStructureFlags
+{
+    { "VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR",       VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR },
+    { "VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR",   VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR },
+    { "VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR",  VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR },
+    { "VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR",  VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR },
+    { "VK_BUILD_ACCELERATION_STRUCTURE_LOW_MEMORY_BIT_KHR",         VK_BUILD_ACCELERATION_STRUCTURE_LOW_MEMORY_BIT_KHR },
+};
+
 std::map<Core::String, VkGeometryFlagsKHR> geometryFlags
 {
     { "VK_GEOMETRY_OPAQUE_BIT_KHR",                           VK_GEOMETRY_OPAQUE_BIT_KHR },
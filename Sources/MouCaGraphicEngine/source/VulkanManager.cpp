@@ -2,6 +2,10 @@
 
 #include "MouCaGraphicEngine/include/VulkanManager.h"
 
+#include <LibCore/include/CoreLogger.h>
+#include <LibCore/include/CoreProfiler.h>
+#include <LibCore/include/CoreThreadPools.h>
+
 #include <LibRT/include/RTImage.h>
 #include <LibRT/include/RTRenderDialog.h>
 #include <LibRT/include/RTShaderFile.h>
@@ -62,6 +66,7 @@ void VulkanManager::initialize(const RT::ApplicationInfo& info, const std::vecto
 
 void VulkanManager::release()
 {
+    setShaderWorkers(nullptr);
     _shaders.clear();
 
     // Clean context window
@@ -242,7 +247,7 @@ void VulkanManager::afterResizeWindow(RT::Window* window, const RT::Array2ui& si
     (*itContext)->setReady(false);
     
     // Synchronize: after this line we can create/release properly each memory/buffer/command/...
-    (*itContext)->getContextDevice().getDevice().waitIdle();
+    (*itContext)->getContextDevice().synchronize();
     
     // Avoid minimized case: leave buffer/image in state
     if(size != RT::Array2ui(0, 0))
@@ -268,7 +273,7 @@ void VulkanManager::afterStateSizeWindow(RT::Window* window, RT::Window::StateSi
     (*itContext)->setReady(false);
     
     // Synchronize
-    (*itContext)->getContextDevice().getDevice().waitIdle();
+    (*itContext)->getContextDevice().synchronize();
 
     // Send event
     _afterResize.emit();
@@ -276,6 +281,8 @@ void VulkanManager::afterStateSizeWindow(RT::Window* window, RT::Window::StateSi
 
 void VulkanManager::execute(const uint32_t deviceID, const uint32_t sequenceID, bool sync) const
 {
+    MOUCA_PROFILE_ZONE("VulkanManager::execute");
+
     MouCa::assertion(deviceID < _devices.size());
     auto context = _devices.at(deviceID);
 
@@ -292,10 +299,10 @@ void VulkanManager::execute(const uint32_t deviceID, const uint32_t sequenceID,
         }
     }
 
-    // Synchronize after operation
+    // Synchronize after operation: frames in flight don't need it (each frame waits its own fence)
     if (sync)
     {
-        context->getDevice().waitIdle();
+        context->synchronize();
     }
 
     const_cast<VulkanManager*>(this)->_locked.unlock();
@@ -305,8 +312,8 @@ void VulkanManager::takeScreenshot(const Core::Path& imageFilePath, RT::ImageImp
 {
     auto surfaceContext = _windows.at(contextWindowID);
 
-    // Stop rendering and synchronize
-    surfaceContext->getContextDevice().getDevice().waitIdle();
+    // Stop rendering and synchronize (wait frames in flight only)
+    surfaceContext->getContextDevice().synchronize();
 
     // Make rendering into buffer
     const uint32_t latestImage = surfaceContext->getEditSwapChain().lock()->getCurrentImage();
@@ -329,11 +336,39 @@ void VulkanManager::takeScreenshot(const Core::Path& imageFilePath, RT::ImageImp
         };
 
         screenshot.extractTo(srcImage, *surfaceContext, RT::Array3ui(0,0,0), RT::Array3ui(0,0,0), sizes, *cpuImage);
+
+        // Save on disk from mapped memory (same extraction, channel order of swapchain is handled by encoder)
+        screenshot.save(*surfaceContext, sizes, imageFilePath);
     }
 
-    // Save on disk
-    cpuImage->saveImage(imageFilePath);
+    screenshot.release(*surfaceContext);
+}
+
+void VulkanManager::saveScreenshot(const Core::Path& imageFilePath, const uint32_t contextWindowID) const
+{
+    auto surfaceContext = _windows.at(contextWindowID);
+
+    // Stop rendering and synchronize (wait frames in flight only)
+    surfaceContext->getContextDevice().synchronize();
+
+    const uint32_t latestImage = surfaceContext->getEditSwapChain().lock()->getCurrentImage();
+
+    const RT::ComponentDescriptor component(4, RT::Type::UnsignedChar, RT::ComponentUsage::Color);
+
+    Vulkan::GPUImageReader screenshot;
+    screenshot.initialize(*surfaceContext, component);
+    {
+        const VkImage srcImage = surfaceContext->getEditSwapChain().lock()->getImages()[latestImage].getImage();
+
+        const RT::Array3ui sizes =
+        {
+            surfaceContext->getFormat().getConfiguration()._extent.width,
+            surfaceContext->getFormat().getConfiguration()._extent.height,
+            1
+        };
 
+        screenshot.saveTo(srcImage, *surfaceContext, RT::Array3ui(0, 0, 0), sizes, imageFilePath);
+    }
     screenshot.release(*surfaceContext);
 }
 
@@ -352,75 +387,190 @@ void VulkanManager::afterShaderEdition(Core::Resource& resource)
 {
     auto itShader = std::find_if(_shaders.cbegin(), _shaders.cend(), 
                                  [&](auto& current) {return current.first.lock().get() == &resource; });
-    if (itShader != _shaders.cend())
+    if (itShader == _shaders.cend())
     {
-        bool compilation = true;
-        auto shaderFile = itShader->first.lock();
+        return;
+    }
 
-        try
+    MOUCA_LOG_INFO(Vulkan, "Reload shader {}", itShader->first.lock()->getTrackedFilename().string());
+
+    if (_shaderWorkers == nullptr)
+    {
+        if (compileShader(itShader->first))
         {
-            MouCa::logConsole(std::format("Vulkan: Reload shader {}", shaderFile->getTrackedFilename().string()));
+            afterShaderCompilation(resource);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_compilationLock);
+        // Running compilation will compile again latest source
+        if (!_compilingShaders.insert(&resource).second)
+        {
+            _editedShaders.insert(&resource);
+            return;
+        }
+    }
+
+    // Forget finished compilations
+    _compilationTasks.erase(std::remove_if(_compilationTasks.begin(), _compilationTasks.end(), [](const auto& task) { return task->isFinished(); }),
+                            _compilationTasks.end());
 
+    auto task = _shaderWorkers->createTask([this, file = itShader->first, &resource]()
+    {
+        if (compileShader(file))
+        {
+            _shaderCompiled.emit(resource);
+        }
+    }, Core::Task::Priority::Low);
+    _compilationTasks.emplace_back(task);
+    _shaderWorkers->submit(task);
+}
+
+bool VulkanManager::compileShader(RT::ShaderFileWPtr file)
+{
+    auto shaderFile = file.lock();
+    MouCa::assertion(shaderFile != nullptr);
+
+    bool compilation = false;
+    bool again       = true;
+    while (again)
+    {
+        try
+        {
             // Compile new version
             shaderFile->compile();
+            compilation = true;
         }
         catch (const Core::Exception& e)
         {
             MOUCA_UNUSED(e);
             // Keep old shader
-            MouCa::logConsole(std::format("Vulkan: Reload shader failure with {} {}", e.read(0).getErrorLabel(), (e.read(0).getParameters().empty() ? "" : e.read(0).getParameters().front())));
+            MOUCA_LOG_ERROR(Vulkan, "Reload shader failure with {} {}", e.read(0).getErrorLabel(), (e.read(0).getParameters().empty() ? "" : e.read(0).getParameters().front()));
+            compilation = false;
+        }
+        catch (...)
+        {
             compilation = false;
         }
-        catch(...)
-        {}
 
-        if(compilation)
+        std::lock_guard<std::mutex> lock(_compilationLock);
+        again = _editedShaders.erase(shaderFile.get()) > 0;
+        if (!again)
         {
-            _locked.lock();
+            _compilingShaders.erase(shaderFile.get());
+        }
+    }
 
-            // ------ Brutal algo ------------------
-            // Step1 : disable all
-            const auto& context = itShader->second.first.lock();
-            for (auto& window : _windows)
-            {
-                window->setReady(false);
-            }
+    return compilation;
+}
 
-            context->getDevice().waitIdle();
-            
-            // Step2 : Rebuild module ...
-            auto module = itShader->second.second.lock();
-            module->release(context->getDevice());
-            shaderFile->open();
-            module->initialize(context->getDevice(), shaderFile->extractString(), module->getName(), module->getStage());
-            shaderFile->close();
-
-            // Step3 : Update all graphics pipeline
-            for (auto& pipeline : context->getGraphicsPipelines())
-            {
-                pipeline->release(context->getDevice());
+void VulkanManager::afterShaderCompilation(Core::Resource& resource)
+{
+    auto itShader = std::find_if(_shaders.cbegin(), _shaders.cend(), 
+                                 [&](auto& current) {return current.first.lock().get() == &resource; });
+    if (itShader == _shaders.cend())
+    {
+        return;
+    }
 
-                pipeline->getInfo().getStages().update();     
+    auto shaderFile    = itShader->first.lock();
+    const auto context = itShader->second.first.lock();
+    auto module        = itShader->second.second.lock();
+    const auto& device = context->getDevice();
+    auto& deferred     = context->getDeferredRelease();
 
-                pipeline->initialize(context->getDevice(), pipeline->getRenderPass(), pipeline->getPipelineLayout(), pipeline->getPipelineCache());
-            }
-            /*
-            // Step4 : Restart all commands
-            for (auto& window : _windows)
-            {
-                window->getCommandBuffer().execute(VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
-                window->setReady(true);
-            }
-            */
+    // Worker writes files of shader during compilation: latest compilation will notify again
+    if (_shaderWorkers != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(_compilationLock);
+        if (!_compilingShaders.insert(&resource).second)
+        {
+            return;
+        }
+    }
+
+    // Step1 : Read compiled shader (edition during reading is compiled after)
+    Core::String source;
+    bool         isRead = true;
+    try
+    {
+        shaderFile->open();
+        source = shaderFile->extractString();
+        shaderFile->close();
+    }
+    catch (const Core::Exception& e)
+    {
+        MOUCA_UNUSED(e);
+        MOUCA_LOG_ERROR(Vulkan, "Read shader failure with {} {}", e.read(0).getErrorLabel(), (e.read(0).getParameters().empty() ? "" : e.read(0).getParameters().front()));
+        isRead = false;
+    }
+
+    if (_shaderWorkers != nullptr)
+    {
+        bool edited = false;
+        {
+            std::lock_guard<std::mutex> lock(_compilationLock);
+            _compilingShaders.erase(&resource);
+            edited = _editedShaders.erase(&resource) > 0;
+        }
+        if (edited)
+        {
+            afterShaderEdition(resource);
+        }
+    }
 
-            context->getDevice().waitIdle();
+    if (!isRead)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_locked);
+    try
+    {
+        // Step2 : Build new module alongside old one
+        module->rebuild(device, source, deferred);
+
+        // Step3 : Rebuild only pipelines using module: commands binding them detect new handle and record again
+        for (auto& pipeline : context->getGraphicsPipelines(*module))
+        {
+            pipeline->rebuild(device, deferred);
+        }
 
-            // Send event
-            _afterShaderChanged.emit();
+        // Step4 : Listeners record again command buffers: GPU must not execute them anymore
+        context->synchronize();
 
-            _locked.unlock();
+        // Without frame ring, beginFrame() never releases old objects: GPU is idle, release them now
+        if (!context->getFrameRing().isRunning())
+        {
+            deferred.release(device);
+        }
+    }
+    catch (const Core::Exception& e)
+    {
+        MOUCA_UNUSED(e);
+        // Old objects are still valid
+        MOUCA_LOG_ERROR(Vulkan, "Rebuild shader failure with {} {}", e.read(0).getErrorLabel(), (e.read(0).getParameters().empty() ? "" : e.read(0).getParameters().front()));
+        return;
+    }
+
+    // Send event
+    _afterShaderChanged.emit();
+}
+
+void VulkanManager::setShaderWorkers(Core::ThreadPools* workers)
+{
+    // Finish pending compilations
+    if (_shaderWorkers != nullptr)
+    {
+        for (const auto& task : _compilationTasks)
+        {
+            _shaderWorkers->wait(task);
         }
+        _compilationTasks.clear();
     }
+    _shaderWorkers = workers;
 }
 
 }
\ No newline at end of file
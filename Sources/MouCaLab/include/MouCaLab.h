@@ -3,6 +3,8 @@
 /// \license No license
 #pragma once
 
+#include <LibCore/include/CoreSignalQueue.h>
+
 #include <LibRT/include/RTImage.h>
 #include <LibRT/include/RTRenderDialog.h>
 
@@ -58,4 +60,5 @@ class MouCaLabTest : public ::testing::Test
         MouCaGraphic::GraphicEngine _graphic;   ///< [OWNERSHIP] Graphic engine: Vulkan + VR + GLFW + imGui;
 
         RT::EventManagerSPtr     _eventManager;
+        Core::SignalQueue        _mainEvents;   ///< Events of other threads executed at beginning of frame.
 };
\ No newline at end of file
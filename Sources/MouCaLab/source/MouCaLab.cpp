@@ -5,14 +5,47 @@
 
 #include "include/MouCaLab.h"
 
+#include <LibCore/include/CoreMemory.h>
+#include <LibCore/include/CoreProfiler.h>
+
 #include <LibGLFW/include/GLFWWindow.h>
 
 #include <LibVulkan/include/VKCommandBuffer.h>
 #include <LibVulkan/include/VKContextWindow.h>
 
 #include <LibRT/include/RTImage.h>
+#include <LibRT/include/RTImageComparison.h>
 #include <LibRT/include/RTRenderDialog.h>
 
+#include <LibMedia/include/ImageLoader.h>
+
+namespace
+{
+    // Heap traffic of whole application (all libraries, STL containers, std::function, ...)
+    std::atomic<uint64_t> g_nbGlobalAllocations = 0;
+}
+
+// Replace global allocation to count it (array and nothrow versions use these ones)
+void* operator new(size_t size)
+{
+    g_nbGlobalAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
 MouCaLabTest::MouCaLabTest()
 {
     _core.getResourceManager().addResourceFolder(MouCaEnvironment::getWorkingPath(), MouCaCore::ResourceManager::Executable);
@@ -64,6 +97,7 @@ void MouCaLabTest::loadEngine(MouCaGraphic::VulkanManager& manager, const Core::
     // Let go !!
     MouCaGraphic::Engine3DXMLLoader loader(manager);
     MouCaGraphic::Engine3DXMLLoader::ContextLoading context(_graphic, *xmlFile, _core.getResourceManager());
+    context._workers = &_core.getThreadPools();
     ASSERT_NO_THROW(loader.load(context));
 
     // Release resource (no needed anymore)
@@ -83,6 +117,7 @@ void MouCaLabTest::loadEngine(MouCaGraphic::Engine3DXMLLoader& loader, const Cor
 
     // Let go !!
     MouCaGraphic::Engine3DXMLLoader::ContextLoading context(_graphic, *xmlFile, _core.getResourceManager());
+    context._workers = &_core.getThreadPools();
     try
     {
         loader.load(context);
@@ -130,10 +165,24 @@ void MouCaLabTest::mainLoop(MouCaGraphic::VulkanManager& manager, const Core::St
     }
 
     double timer = 0.0;
+    uint64_t previousAllocations = g_nbGlobalAllocations.load(std::memory_order_relaxed);
     // Execute main event loop
     while (_graphic.getRTPlatform().isWindowsActive())
     {
         const auto tStart = std::chrono::high_resolution_clock::now();
+
+        Core::Profiler::markFrame();
+        // Expected 0 in steady state (except FPS title refresh): sequences and command buffers are built before loop
+        const uint64_t nbAllocations = g_nbGlobalAllocations.load(std::memory_order_relaxed);
+        Core::Profiler::addCounter("Global operator new (frame)", static_cast<int64_t>(nbAllocations - previousAllocations));
+        previousAllocations = nbAllocations;
+        // Only chunks taken by arenas and pools of Core
+        Core::Profiler::addCounter("Arena/pool chunk allocations (Core)", static_cast<int64_t>(Core::Memory::getStatistics()._nbAllocations));
+        Core::Profiler::addCounter("Command buffer recordings", static_cast<int64_t>(Vulkan::ICommandBuffer::getStatistics()._nbRecordings));
+
+        // Execute events of other threads (shader reloading, ...)
+        _mainEvents.dispatch();
+
         // Draw Frame
         {
             manager.execute(0, 0, false);
@@ -197,9 +246,13 @@ void MouCaLabTest::takeScreenshot(MouCaGraphic::VulkanManager& manager, const Co
     }
 
     // Compare images
-    size_t nbDefect;
-    double maxFoundDistance;
-    const bool compare = diskImage->getImage().lock()->compare(*refImage->getImage().lock(), nbMaxDefectPixels, maxDistance4D, &nbDefect, &maxFoundDistance);
+    RT::ImageComparison::Settings settings;
+    settings._nbMaxDefectPixels = nbMaxDefectPixels;
+    settings._maxDistance4D     = maxDistance4D;
+    settings._threadPools       = &_core.getThreadPools();
+
+    RT::ImageComparison comparison;
+    const bool compare = comparison.compute(*diskImage->getImage().lock(), *refImage->getImage().lock(), settings);
     if (!compare) // Have you update the reference ? Or bug ?
     {
         const Core::Path sourceFile(MouCaEnvironment::getOutputPath() / imageFile);
@@ -211,9 +264,18 @@ void MouCaLabTest::takeScreenshot(MouCaGraphic::VulkanManager& manager, const Co
             ASSERT_NO_THROW(std::filesystem::create_directories(targetParent)); // Recursively create target directory if not existing.
         ASSERT_NO_THROW(std::filesystem::copy_file(sourceFile, targetFile, std::filesystem::copy_options::overwrite_existing));
 
+        // Save failed tiles next to result
+        if (comparison.isSameExtents())
+        {
+            Core::Path heatMapFile(targetFile);
+            heatMapFile.replace_filename(targetFile.stem().wstring() + L"_heatmap.png");
+            ASSERT_NO_THROW(Media::ImageLoader::exportHeatMap(comparison, heatMapFile));
+        }
+
         EXPECT_TRUE(compare) << "Image comparison failed: " << imageFile << "\n"
-            << "Defect pixel: " << nbDefect << " > " << nbMaxDefectPixels << "\n"
-            << "With tolerance of " << maxDistance4D << "(max found: " << maxFoundDistance << ")";
+            << "Defect pixel: " << comparison.getNbDefects() << " > " << nbMaxDefectPixels << "\n"
+            << "With tolerance of " << maxDistance4D << "(max found: " << comparison.getMaxDistance() << ")\n"
+            << "Failed tiles: " << comparison.getNbFailedTiles() << " / " << comparison.getTiles().size();
     }
 
     _core.getResourceManager().releaseResource(std::move(diskImage));
@@ -225,7 +287,10 @@ void MouCaLabTest::enableFileTracking(MouCaGraphic::VulkanManager& manager)
     auto& fileTracker = _core.getResourceManager().getTracker();
     MouCa::preCondition(!fileTracker.signalFileChanged().isConnected(&manager));
 
-    fileTracker.signalFileChanged().connectMember(&manager, &MouCaGraphic::VulkanManager::afterShaderEdition);
+    // Shaders are compiled by workers then rebuilt by main loop at beginning of frame
+    manager.setShaderWorkers(&_core.getThreadPools());
+    manager.getShaderCompiled().connectQueued(_mainEvents, &manager, &MouCaGraphic::VulkanManager::afterShaderCompilation);
+    fileTracker.signalFileChanged().connectQueued(_mainEvents, &manager, &MouCaGraphic::VulkanManager::afterShaderEdition);
 
     fileTracker.startTracking();
 }
@@ -238,6 +303,10 @@ void MouCaLabTest::disableFileTracking(MouCaGraphic::VulkanManager& manager)
     fileTracker.stopTracking();
 
     fileTracker.signalFileChanged().disconnect(&manager);
+
+    // Finish pending compilations before disconnection
+    manager.setShaderWorkers(nullptr);
+    manager.getShaderCompiled().disconnect(&manager);
 }
 
 void MouCaLabTest::clearDialog(MouCaGraphic::VulkanManager& manager)
@@ -5,6 +5,8 @@
 
 #include "include/MouCaLab.h"
 
+#include <LibCore/include/CoreLogger.h>
+
 #include <LibRT/include/RTBufferCPU.h>
 #include <LibRT/include/RTCamera.h>
 #include <LibRT/include/RTCameraComportement.h>
@@ -710,7 +712,7 @@ Core::Path FontSVGTest::_fontSeguiEmoji(u8"seguiemj.ttf");
 
 void RefreshSystem::afterShaderRefresh()
 {
-    MouCa::logConsole("DEMO: Shader");
+    MOUCA_LOG_INFO(General, "DEMO: Shader");
 
     testManager->updateCommandBuffers(*loader);
     testManager->updateCommandBuffersSurface(*loader);
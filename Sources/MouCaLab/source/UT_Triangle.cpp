@@ -5,12 +5,21 @@
 
 #include "include/MouCaLab.h"
 
+#include <LibCore/include/CoreElapser.h>
+#include <LibCore/include/CoreThreadPools.h>
+
 #include <LibRT/include/RTRenderDialog.h>
 
 #include <LibVulkan/include/VKBuffer.h>
 #include <LibVulkan/include/VKContextDevice.h>
+#include <LibVulkan/include/VKContextWindow.h>
 #include <LibVulkan/include/VKCommand.h>
 #include <LibVulkan/include/VKCommandBuffer.h>
+#include <LibVulkan/include/VKCommandStream.h>
+#include <LibVulkan/include/VKDescriptorSet.h>
+#include <LibVulkan/include/VKGraphicsPipeline.h>
+#include <LibVulkan/include/VKPipelineLayout.h>
+#include <LibVulkan/include/VKRenderPass.h>
 #include <LibVulkan/include/VKSequence.h>
 #include <LibVulkan/include/VKWindowSurface.h>
 
@@ -200,4 +209,223 @@ TEST_F(TriangleTest, run)
 
     // Clean allocate dialog
     ASSERT_NO_THROW(clearDialog(manager));
-}
\ No newline at end of file
+}
+
+// Same triangle drawn by one range recorded into secondary command buffer
+TEST_F(TriangleTest, parallel)
+{
+    MouCaGraphic::VulkanManager manager;
+
+    MouCaGraphic::Engine3DXMLLoader loader(manager);
+    ASSERT_NO_FATAL_FAILURE(loadEngine(loader, "TriangleParallel.xml"));
+    ASSERT_NE(nullptr, dynamic_cast<Vulkan::CommandParallelContainer*>(loader._commandLinks.at(0)));
+
+    auto context = manager.getDevices().at(0);
+    transferData(context, loader._buffers[1], loader._buffers[2]);
+    updateUBO(manager.getSurfaces().at(0)->_linkWindow, context, loader._buffers[0]);
+
+    // Each swap image has its own secondary command buffers
+    const auto start = Vulkan::ICommandBuffer::getStatistics();
+    updateCommandBuffersSurface(loader);
+    EXPECT_LT(start._nbRecordings, Vulkan::ICommandBuffer::getStatistics()._nbRecordings);
+
+    context->getDevice().waitIdle();
+    auto queueSequences = context->getQueueSequences();
+    ASSERT_EQ(1, queueSequences.size());
+
+    // Run one frame
+    for (const auto& sequence : *queueSequences.at(0))
+    {
+        ASSERT_EQ(VK_SUCCESS, sequence->execute(context->getDevice()));
+    }
+
+    // Same result as inline recording
+    takeScreenshot(manager, "triangle.png");
+
+    ASSERT_NO_THROW(manager.release());
+    ASSERT_NO_THROW(clearDialog(manager));
+}
+
+// Benchmark: recording time of draw-heavy ranges inside render pass by 1 to N threads
+TEST_F(TriangleTest, parallelRecording)
+{
+    const size_t nbRanges       = 64;
+    const size_t nbDrawsByRange = 500;
+
+    MouCaGraphic::VulkanManager manager;
+
+    MouCaGraphic::Engine3DXMLLoader loader(manager);
+    ASSERT_NO_FATAL_FAILURE(loadEngine(loader, "TriangleParallel.xml"));
+
+    auto context = manager.getDevices().at(0);
+    const auto& device = context->getDevice();
+    const auto surface = loader._surfaces[0].lock();
+    const VkRect2D renderArea{ { 0, 0 }, surface->getFormat().getConfiguration()._extent };
+    const auto& layout = *loader._pipelineLayouts[0].lock();
+    const auto& descriptorSets = loader._descriptorSets[0].lock()->getDescriptorSets();
+    const glm::vec4 pushData(1.0f, 0.0f, 0.0f, 1.0f);
+
+    auto pool = std::make_shared<Vulkan::CommandPool>();
+    ASSERT_NO_THROW(pool->initialize(device, device.getQueueFamilyGraphicId()));
+
+    const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (uint32_t nbThreads = 1; nbThreads <= maxThreads; nbThreads *= 2)
+    {
+        Core::ThreadPools pools;
+        if (nbThreads > 1)
+        {
+            pools.initializeWorkers(nbThreads - 1);
+        }
+
+        // No state is inherited by secondary command buffers: each range binds its own states
+        auto parallel = std::make_unique<Vulkan::CommandParallelContainer>(device, pools, loader._renderPasses[0], 0, &context->getFrameRing());
+        for (size_t idRange = 0; idRange < nbRanges; ++idRange)
+        {
+            auto range = std::make_unique<Vulkan::CommandContainer>();
+            range->transfer(std::make_unique<Vulkan::CommandViewport>(VkViewport{ 0.0f, 0.0f, static_cast<float>(renderArea.extent.width), static_cast<float>(renderArea.extent.height), 0.0f, 1.0f }));
+            range->transfer(std::make_unique<Vulkan::CommandScissor>(renderArea));
+            range->transfer(std::make_unique<Vulkan::CommandBindPipeline>(loader._graphicsPipelines[0], VK_PIPELINE_BIND_POINT_GRAPHICS));
+            range->transfer(std::make_unique<Vulkan::CommandBindDescriptorSets>(layout, VK_PIPELINE_BIND_POINT_GRAPHICS, 0, descriptorSets, std::vector<uint32_t>()));
+            range->transfer(std::make_unique<Vulkan::CommandBindVertexBuffer>(0, 1, std::vector<Vulkan::BufferWPtr>{ loader._buffers[1] }, std::vector<VkDeviceSize>{ 0 }));
+            for (size_t idDraw = 0; idDraw < nbDrawsByRange; ++idDraw)
+            {
+                range->transfer(std::make_unique<Vulkan::CommandPushConstants>(layout, VK_SHADER_STAGE_VERTEX_BIT, static_cast<uint32_t>(sizeof(pushData)), &pushData));
+                range->transfer(std::make_unique<Vulkan::CommandDraw>(3, 1, 0, 0));
+            }
+            parallel->transfer(std::move(range));
+        }
+
+        Vulkan::CommandBuffer commandBuffer;
+        ASSERT_NO_THROW(commandBuffer.initialize(device, pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 0));
+        commandBuffer.addCommand(std::make_unique<Vulkan::CommandBeginRenderPass>(*loader._renderPasses[0].lock(), surface->getFrameBuffer().front(), renderArea,
+                                                                                  std::vector<VkClearValue>(2), VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS));
+        commandBuffer.addCommand(std::move(parallel));
+        commandBuffer.addCommand(std::make_unique<Vulkan::CommandEndRenderPass>());
+
+        // First recording allocates pools and buffers
+        const auto start = Vulkan::ICommandBuffer::getStatistics();
+        ASSERT_NO_THROW(commandBuffer.execute());
+
+        // Pools of same frame slot are reused
+        const size_t nbLoops = 10;
+        Core::Elapser<std::chrono::microseconds> elapser;
+        for (size_t loop = 0; loop < nbLoops; ++loop)
+        {
+            commandBuffer.invalidate();
+            ASSERT_NO_THROW(commandBuffer.execute());
+        }
+        const int64_t time = elapser.tick();
+        EXPECT_EQ(start._nbRecordings + nbLoops + 1, Vulkan::ICommandBuffer::getStatistics()._nbRecordings);
+
+        std::cout << "Recording " << nbRanges << " ranges of " << nbDrawsByRange << " draws with " << nbThreads << " thread(s): "
+                  << static_cast<double>(time) / nbLoops / 1000.0 << " ms" << std::endl;
+
+        ASSERT_NO_THROW(commandBuffer.release(device));
+    }
+
+    ASSERT_NO_THROW(pool->release(device));
+    ASSERT_NO_THROW(manager.release());
+    ASSERT_NO_THROW(clearDialog(manager));
+}
+
+// Benchmark: same draw-heavy render pass recorded by virtual path and by flat stream
+TEST_F(TriangleTest, commandStream)
+{
+    const size_t nbDraws = 50000;
+
+    MouCaGraphic::VulkanManager manager;
+
+    MouCaGraphic::Engine3DXMLLoader loader(manager);
+    ASSERT_NO_FATAL_FAILURE(loadEngine(loader, "TriangleParallel.xml"));
+
+    auto context = manager.getDevices().at(0);
+    const auto& device = context->getDevice();
+    const auto surface = loader._surfaces[0].lock();
+    const VkRect2D renderArea{ { 0, 0 }, surface->getFormat().getConfiguration()._extent };
+    const auto& layout = *loader._pipelineLayouts[0].lock();
+    const glm::vec4 pushData(1.0f, 0.0f, 0.0f, 1.0f);
+
+    // Bind once then push/draw: usual mix of scene rendering
+    auto container = std::make_unique<Vulkan::CommandContainer>();
+    container->transfer(std::make_unique<Vulkan::CommandBeginRenderPass>(*loader._renderPasses[0].lock(), surface->getFrameBuffer().front(), renderArea,
+                                                                         std::vector<VkClearValue>(2), VK_SUBPASS_CONTENTS_INLINE));
+    container->transfer(std::make_unique<Vulkan::CommandViewport>(VkViewport{ 0.0f, 0.0f, static_cast<float>(renderArea.extent.width), static_cast<float>(renderArea.extent.height), 0.0f, 1.0f }));
+    container->transfer(std::make_unique<Vulkan::CommandScissor>(renderArea));
+    container->transfer(std::make_unique<Vulkan::CommandBindPipeline>(loader._graphicsPipelines[0], VK_PIPELINE_BIND_POINT_GRAPHICS));
+    container->transfer(std::make_unique<Vulkan::CommandBindDescriptorSets>(layout, VK_PIPELINE_BIND_POINT_GRAPHICS, 0, loader._descriptorSets[0].lock()->getDescriptorSets(), std::vector<uint32_t>()));
+    container->transfer(std::make_unique<Vulkan::CommandBindVertexBuffer>(0, 1, std::vector<Vulkan::BufferWPtr>{ loader._buffers[1] }, std::vector<VkDeviceSize>{ 0 }));
+    for (size_t idDraw = 0; idDraw < nbDraws; ++idDraw)
+    {
+        container->transfer(std::make_unique<Vulkan::CommandPushConstants>(layout, VK_SHADER_STAGE_VERTEX_BIT, static_cast<uint32_t>(sizeof(pushData)), &pushData));
+        container->transfer(std::make_unique<Vulkan::CommandDraw>(3, 1, 0, 0));
+    }
+    container->transfer(std::make_unique<Vulkan::CommandEndRenderPass>());
+    const size_t nbCommands = 7 + nbDraws * 2;
+
+    // Flat stream
+    Vulkan::CommandStream stream;
+    Vulkan::Commands commands;
+    commands.emplace_back(std::move(container));
+    Core::Elapser<std::chrono::microseconds> elapserCompile;
+    ASSERT_NO_THROW(stream.compile(commands));
+    const int64_t timeCompile = elapserCompile.tick();
+    EXPECT_EQ(nbCommands, stream.getNbPackets());
+
+    auto pool = std::make_shared<Vulkan::CommandPool>();
+    ASSERT_NO_THROW(pool->initialize(device, device.getQueueFamilyGraphicId()));
+
+    const VkCommandBufferAllocateInfo allocateInfo
+    {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, // VkStructureType              sType
+        nullptr,                                        // const void*                  pNext
+        pool->getInstance(),                            // VkCommandPool                commandPool
+        VK_COMMAND_BUFFER_LEVEL_PRIMARY,                // VkCommandBufferLevel         level
+        1                                               // uint32_t                     bufferCount
+    };
+    VkCommandBuffer rawBuffer = VK_NULL_HANDLE;
+    ASSERT_EQ(VK_SUCCESS, vkAllocateCommandBuffers(device.getInstance(), &allocateInfo, &rawBuffer));
+
+    const VkCommandBufferBeginInfo beginInfo
+    {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,    // VkStructureType                        sType
+        nullptr,                                        // const void                            *pNext
+        0,                                              // VkCommandBufferUsageFlags              flags
+        nullptr                                         // const VkCommandBufferInheritanceInfo  *pInheritanceInfo
+    };
+
+    // Virtual path
+    Vulkan::CommandBuffer commandBuffer;
+    ASSERT_NO_THROW(commandBuffer.initialize(device, pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 0));
+    commandBuffer.addCommands(std::move(commands));
+    const auto start = Vulkan::ICommandBuffer::getStatistics();
+    ASSERT_NO_THROW(commandBuffer.execute());
+
+    const size_t nbLoops = 10;
+    Core::Elapser<std::chrono::microseconds> elapser;
+    for (size_t loop = 0; loop < nbLoops; ++loop)
+    {
+        commandBuffer.invalidate();
+        ASSERT_NO_THROW(commandBuffer.execute());
+    }
+    const int64_t timeVirtual = elapser.tick();
+    EXPECT_EQ(start._nbRecordings + nbLoops + 1, Vulkan::ICommandBuffer::getStatistics()._nbRecordings);
+
+    elapser.reset();
+    for (size_t loop = 0; loop < nbLoops; ++loop)
+    {
+        ASSERT_EQ(VK_SUCCESS, vkBeginCommandBuffer(rawBuffer, &beginInfo));
+        ASSERT_NO_THROW(stream.record(rawBuffer));
+        ASSERT_EQ(VK_SUCCESS, vkEndCommandBuffer(rawBuffer));
+    }
+    const int64_t timeStream = elapser.tick();
+
+    std::cout << "Recording " << nbCommands << " commands (" << nbDraws << " draws): virtual " << static_cast<double>(timeVirtual) / nbLoops / 1000.0 << " ms"
+              << ", stream " << static_cast<double>(timeStream) / nbLoops / 1000.0 << " ms"
+              << " (compile " << static_cast<double>(timeCompile) / 1000.0 << " ms, " << stream.getByteSize() / 1024 << " KB)" << std::endl;
+
+    vkFreeCommandBuffers(device.getInstance(), pool->getInstance(), 1, &rawBuffer);
+    ASSERT_NO_THROW(commandBuffer.release(device));
+    ASSERT_NO_THROW(pool->release(device));
+    ASSERT_NO_THROW(manager.release());
+    ASSERT_NO_THROW(clearDialog(manager));
+}
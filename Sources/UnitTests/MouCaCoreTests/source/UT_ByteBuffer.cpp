@@ -0,0 +1,100 @@
+#include "Dependencies.h"
+
+#include <LibCore/include/CoreByteBuffer.h>
+#include <LibCore/include/CoreElapser.h>
+
+namespace Core
+{
+
+// Compare bulk paths against per-element serialization (current append and previous std::vector insert)
+TEST(ByteBuffer, benchmark)
+{
+    struct Vertex
+    {
+        float _position[3];
+        float _normal[3];
+        float _uv[2];
+    };
+
+    const size_t nbVertices = 1000000;
+    std::vector<Vertex> vertices(nbVertices);
+    for (size_t id = 0; id < nbVertices; ++id)
+    {
+        const float value = static_cast<float>(id);
+        vertices[id] = { { value, value + 1.0f, value + 2.0f }, { 0.0f, 1.0f, 0.0f }, { value * 0.5f, value * 0.25f } };
+    }
+    const size_t expectedSize = sizeof(size_t) + nbVertices * sizeof(Vertex);
+
+    // Write
+    std::vector<uint8_t> legacy;
+    ByteBuffer perElement;
+    ByteBuffer bulk;
+    ByteBuffer writer;
+    int64_t timeLegacy, timePerElement, timeBulk, timeWriter;
+    {
+        Elapser<std::chrono::microseconds> elapser;
+        // Copy of previous operator<<: std::vector::insert for each element
+        auto insert = [&](const auto& data)
+        {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&data);
+            legacy.insert(legacy.end(), bytes, &bytes[sizeof(data)]);
+        };
+        insert(vertices.size());
+        for (const auto& vertex : vertices)
+        {
+            insert(vertex);
+        }
+        timeLegacy = elapser.tick();
+
+        perElement << vertices.size();
+        for (const auto& vertex : vertices)
+        {
+            perElement << vertex;
+        }
+        timePerElement = elapser.tick();
+
+        bulk << vertices;
+        timeBulk = elapser.tick();
+
+        {
+            ByteBuffer::Writer cursor(writer, expectedSize);
+            cursor << vertices;
+        }
+        timeWriter = elapser.tick();
+    }
+    ASSERT_EQ(expectedSize, legacy.size());
+    ASSERT_EQ(expectedSize, perElement.size());
+    ASSERT_EQ(expectedSize, bulk.size());
+    ASSERT_EQ(expectedSize, writer.size());
+    EXPECT_EQ(0, memcmp(legacy.data(), perElement.getData(), expectedSize));
+    EXPECT_EQ(0, memcmp(perElement.getData(), bulk.getData(), expectedSize));
+    EXPECT_EQ(0, memcmp(perElement.getData(), writer.getData(), expectedSize));
+
+    std::cout << "Write " << nbVertices << " vertices: vector insert " << timeLegacy << " us, per element " << timePerElement << " us, bulk " << timeBulk << " us, writer " << timeWriter << " us" << std::endl;
+
+    // Read
+    std::vector<Vertex> readPerElement;
+    std::vector<Vertex> readBulk;
+    int64_t timeReadPerElement, timeReadBulk;
+    {
+        Elapser<std::chrono::microseconds> elapser;
+        size_t size = 0;
+        perElement >> size;
+        readPerElement.resize(size);
+        for (auto& vertex : readPerElement)
+        {
+            perElement >> vertex;
+        }
+        timeReadPerElement = elapser.tick();
+
+        bulk >> readBulk;
+        timeReadBulk = elapser.tick();
+    }
+    ASSERT_EQ(nbVertices, readBulk.size());
+    EXPECT_EQ(0, memcmp(readPerElement.data(), readBulk.data(), nbVertices * sizeof(Vertex)));
+    EXPECT_EQ(0, memcmp(vertices.data(), readBulk.data(), nbVertices * sizeof(Vertex)));
+
+    std::cout << "Read  " << nbVertices << " vertices: per element " << timeReadPerElement << " us, bulk " << timeReadBulk << " us" << std::endl;
+}
+
+}
@@ -1,6 +1,14 @@
 #include "Dependencies.h"
 
+#include <LibRT/include/RTBufferCPU.h>
 #include <LibRT/include/RTImage.h>
+#include <LibRT/include/RTImageComparison.h>
+
+#include <LibMedia/include/ImageBlockCompression.h>
+#include <LibMedia/include/ImageFI.h>
+#include <LibMedia/include/ImageKTX.h>
+#include <LibMedia/include/ImageLoader.h>
+#include <LibMedia/include/ImageMipmap.h>
 
 #include <MouCaCore/include/CoreSystem.h>
 #include <MouCaCore/include/LoaderManager.h>
@@ -50,6 +58,518 @@ TEST(Image, compare)
     ASSERT_NO_THROW(resources.releaseResource(std::move(imageDefault)));
 }
 
+TEST(Image, compareTiles)
+{
+    auto core = std::make_shared<MouCaCore::CoreSystem>();
+
+    auto& resources = core->getResourceManager();
+
+    const auto texturePath = MouCaEnvironment::getInputPath() / L"textures";
+
+    auto imageRef       = resources.openImage(texturePath / L"image.png");
+    auto imageDefault   = resources.openImage(texturePath / L"imageDefaut.png");
+
+    // Load
+    {
+        auto& loader = core->getLoaderManager();
+        loader.initialize();
+        MouCaCore::LoadingItems items =
+        {
+            MouCaCore::LoadingItem(imageRef,        MouCaCore::LoadingItem::Deferred),
+            MouCaCore::LoadingItem(imageDefault,    MouCaCore::LoadingItem::Deferred)
+        };
+        ASSERT_NO_THROW(loader.loadResources(items));
+
+        ASSERT_NO_THROW(loader.synchronize());
+        ASSERT_NO_THROW(loader.release());
+    }
+
+    RT::ImageComparison::Settings settings;
+    settings._tileSize          = 16;
+    settings._maxDistance4D     = 0.0;
+    settings._nbMaxDefectPixels = 474;
+    settings._computeSSIM       = true;
+
+    // Same image: all tiles are perfect
+    {
+        RT::ImageComparison comparison;
+        EXPECT_TRUE(comparison.compute(*imageRef->getImage().lock(), *imageRef->getImage().lock(), settings));
+        EXPECT_EQ(0, comparison.getNbDefects());
+        EXPECT_EQ(0, comparison.getNbFailedTiles());
+        for (const auto& tile : comparison.getTiles())
+        {
+            EXPECT_DOUBLE_EQ(1.0, tile._ssim);
+        }
+    }
+
+    // Same result as standard comparison
+    {
+        RT::ImageComparison comparison;
+        EXPECT_TRUE(comparison.compute(*imageRef->getImage().lock(), *imageDefault->getImage().lock(), settings));
+        EXPECT_EQ(474, comparison.getNbDefects());
+        EXPECT_LT(0, comparison.getNbFailedTiles());
+
+        const auto extents = comparison.getExtents();
+        EXPECT_EQ((extents.x + 15) / 16, comparison.getGrid().x);
+        EXPECT_EQ((extents.y + 15) / 16, comparison.getGrid().y);
+
+        size_t nbDefects = 0;
+        for (const auto& tile : comparison.getTiles())
+        {
+            nbDefects += tile._nbDefects;
+            EXPECT_EQ(tile._nbDefects > 0, tile._failed || tile._ssim < settings._minSSIM);
+        }
+        EXPECT_EQ(comparison.getNbDefects(), nbDefects);
+
+        // Multi-thread must be deterministic
+        settings._threadPools = &core->getThreadPools();
+        RT::ImageComparison parallel;
+        EXPECT_TRUE(parallel.compute(*imageRef->getImage().lock(), *imageDefault->getImage().lock(), settings));
+        EXPECT_EQ(comparison.getNbDefects(),     parallel.getNbDefects());
+        EXPECT_EQ(comparison.getNbFailedTiles(), parallel.getNbFailedTiles());
+        EXPECT_DOUBLE_EQ(comparison.getMaxDistance(), parallel.getMaxDistance());
+
+        ASSERT_NO_THROW(Media::ImageLoader::exportHeatMap(comparison, MouCaEnvironment::getOutputPath() / L"compareTilesHeatMap.png"));
+        EXPECT_TRUE(std::filesystem::exists(MouCaEnvironment::getOutputPath() / L"compareTilesHeatMap.png"));
+    }
+
+    ASSERT_NO_THROW(resources.releaseResource(std::move(imageRef)));
+    ASSERT_NO_THROW(resources.releaseResource(std::move(imageDefault)));
+}
+
+TEST(Image, mipmaps)
+{
+    auto core = std::make_shared<MouCaCore::CoreSystem>();
+
+    auto& resources = core->getResourceManager();
+
+    const auto texturePath = MouCaEnvironment::getInputPath() / L"textures";
+
+    RT::ImageImport::Options optionsBox;
+    optionsBox._mipmaps     = RT::ImageImport::Options::Filter::Box;
+
+    RT::ImageImport::Options optionsBC1;
+    optionsBC1._mipmaps     = RT::ImageImport::Options::Filter::Kaiser;
+    optionsBC1._compression = RT::ImageImport::Options::Compression::BC1;
+
+    RT::ImageImport::Options optionsBC7;
+    optionsBC7._mipmaps     = RT::ImageImport::Options::Filter::Box;
+    optionsBC7._compression = RT::ImageImport::Options::Compression::BC7;
+
+    auto imageRef = resources.openImage(texturePath / L"image.png");
+    auto imageBox = resources.openImage(texturePath / L"image.png", optionsBox);
+    auto imageBC1 = resources.openImage(texturePath / L"spir.png",  optionsBC1);
+    auto imageBC7 = resources.openImage(texturePath / L"spir.png",  optionsBC7);
+
+    // Same file with other options is another resource
+    ASSERT_NE(imageRef, imageBox);
+    ASSERT_NE(imageBC1, imageBC7);
+    EXPECT_EQ(imageBox, resources.openImage(texturePath / L"image.png", optionsBox));
+
+    // Load
+    {
+        auto& loader = core->getLoaderManager();
+        loader.initialize();
+        MouCaCore::LoadingItems items =
+        {
+            MouCaCore::LoadingItem(imageRef, MouCaCore::LoadingItem::Deferred),
+            MouCaCore::LoadingItem(imageBox, MouCaCore::LoadingItem::Deferred),
+            MouCaCore::LoadingItem(imageBC1, MouCaCore::LoadingItem::Deferred),
+            MouCaCore::LoadingItem(imageBC7, MouCaCore::LoadingItem::Deferred)
+        };
+        ASSERT_NO_THROW(loader.loadResources(items));
+
+        ASSERT_NO_THROW(loader.synchronize());
+        ASSERT_NO_THROW(loader.release());
+    }
+
+    for (const auto& image : { imageBox, imageBC1, imageBC7 })
+    {
+        auto mipmap = std::dynamic_pointer_cast<ImageMipmap>(image->getImage().lock());
+        ASSERT_TRUE(mipmap != nullptr);
+
+        const auto extents = mipmap->getExtents(0);
+        EXPECT_EQ(ImageMipmap::computeNbLevels(extents.x, extents.y), mipmap->getLevels());
+        EXPECT_EQ(RT::Array3ui(1, 1, 1), mipmap->getExtents(mipmap->getLevels() - 1));
+
+        size_t memorySize = 0;
+        for (uint32_t level = 0; level < mipmap->getLevels(); ++level)
+        {
+            const auto size = mipmap->getExtents(level);
+            if (level > 0)
+            {
+                const auto previous = mipmap->getExtents(level - 1);
+                EXPECT_EQ(std::max(previous.x / 2, 1u), size.x);
+                EXPECT_EQ(std::max(previous.y / 2, 1u), size.y);
+            }
+            EXPECT_EQ(memorySize, mipmap->getMemoryOffset(0, level));
+            memorySize += BlockCompression::getLevelSize(mipmap->getCompression(), size.x, size.y);
+        }
+        EXPECT_EQ(memorySize, mipmap->getMemorySize());
+    }
+
+    // Level 0 is not modified by mipmap generation (reference is loaded without options)
+    ASSERT_TRUE(std::dynamic_pointer_cast<ImageFI>(imageRef->getImage().lock()) != nullptr);
+    EXPECT_TRUE(imageBox->getImage().lock()->compare(*imageRef->getImage().lock(), 0, 0.0));
+
+    // Known size of blocks: BC1 is 8 bytes by 4x4 block, BC7 is 16 bytes
+    auto mipmapBC1 = std::dynamic_pointer_cast<ImageMipmap>(imageBC1->getImage().lock());
+    auto mipmapBC7 = std::dynamic_pointer_cast<ImageMipmap>(imageBC7->getImage().lock());
+    EXPECT_EQ(RT::ImageImport::Options::Compression::BC1, mipmapBC1->getCompression());
+    EXPECT_EQ(RT::ImageImport::Options::Compression::BC7, mipmapBC7->getCompression());
+    ASSERT_EQ(mipmapBC1->getLevels(), mipmapBC7->getLevels());
+    for (uint32_t level = 0; level < mipmapBC1->getLevels(); ++level)
+    {
+        const auto   size     = mipmapBC1->getExtents(level);
+        const size_t nbBlocks = static_cast<size_t>((size.x + 3) / 4) * ((size.y + 3) / 4);
+        EXPECT_EQ(size, mipmapBC7->getExtents(level));
+        EXPECT_EQ(nbBlocks * 8,  BlockCompression::getLevelSize(mipmapBC1->getCompression(), size.x, size.y));
+        EXPECT_EQ(nbBlocks * 16, BlockCompression::getLevelSize(mipmapBC7->getCompression(), size.x, size.y));
+    }
+    EXPECT_EQ(mipmapBC1->getMemorySize() * 2, mipmapBC7->getMemorySize());
+
+    // GPU format follows compression (VK_FORMAT_BC1_RGBA_SRGB_BLOCK / VK_FORMAT_BC7_SRGB_BLOCK)
+    EXPECT_EQ(134u, mipmapBC1->getFormat());
+    EXPECT_EQ(146u, mipmapBC7->getFormat());
+    EXPECT_EQ(0u,   imageRef->getImage().lock()->getFormat());
+
+    for (auto& image : { imageRef, imageBox, imageBC1, imageBC7 })
+    {
+        EXPECT_NO_THROW(image->release());
+    }
+    ASSERT_NO_THROW(resources.releaseResource(std::move(imageRef)));
+    ASSERT_NO_THROW(resources.releaseResource(std::move(imageBox)));
+    ASSERT_NO_THROW(resources.releaseResource(std::move(imageBC1)));
+    ASSERT_NO_THROW(resources.releaseResource(std::move(imageBC7)));
+}
+
+TEST(Image, bakedCache)
+{
+    auto core = std::make_shared<MouCaCore::CoreSystem>();
+
+    auto& resources = core->getResourceManager();
+    auto& loader    = core->getLoaderManager();
+    loader.initialize();
+
+    const auto texturePath = MouCaEnvironment::getInputPath() / L"textures";
+    const auto cachePath   = MouCaEnvironment::getOutputPath() / L"ImageCache";
+    std::filesystem::remove_all(cachePath);
+    ASSERT_NO_THROW(resources.setImageCache(cachePath, 3));
+
+    RT::ImageImport::Options options;
+    options._mipmaps     = RT::ImageImport::Options::Filter::Box;
+    options._compression = RT::ImageImport::Options::Compression::BC7;
+
+    Core::Path cacheFile;
+    uint32_t   nbLevels   = 0;
+    size_t     memorySize = 0;
+    // First run: decode with FreeImage and bake
+    {
+        auto image = resources.openImage(texturePath / L"spir.png", options);
+        cacheFile = image->getCacheFilename();
+        EXPECT_EQ(cachePath, cacheFile.parent_path());
+        EXPECT_FALSE(std::filesystem::exists(cacheFile));
+
+        MouCaCore::LoadingItems items =
+        {
+            MouCaCore::LoadingItem(image, MouCaCore::LoadingItem::Direct)
+        };
+        ASSERT_NO_THROW(loader.loadResources(items));
+        EXPECT_TRUE(std::filesystem::exists(cacheFile));
+
+        auto mipmap = std::dynamic_pointer_cast<ImageMipmap>(image->getImage().lock());
+        ASSERT_TRUE(mipmap != nullptr);
+        nbLevels   = mipmap->getLevels();
+        memorySize = mipmap->getMemorySize();
+
+        EXPECT_NO_THROW(image->release());
+        ASSERT_NO_THROW(resources.releaseResource(std::move(image)));
+    }
+
+    // Other options have their own cache file
+    {
+        auto image = resources.openImage(texturePath / L"spir.png");
+        EXPECT_NE(cacheFile, image->getCacheFilename());
+        ASSERT_NO_THROW(resources.releaseResource(std::move(image)));
+    }
+
+    // Second run: read KTX2 directly
+    {
+        auto image = resources.openImage(texturePath / L"spir.png", options);
+        EXPECT_EQ(cacheFile, image->getCacheFilename());
+
+        MouCaCore::LoadingItems items =
+        {
+            MouCaCore::LoadingItem(image, MouCaCore::LoadingItem::Direct)
+        };
+        ASSERT_NO_THROW(loader.loadResources(items));
+
+        auto ktx = std::dynamic_pointer_cast<ImageKTX>(image->getImage().lock());
+        ASSERT_TRUE(ktx != nullptr);
+        EXPECT_EQ(nbLevels,   ktx->getLevels());
+        EXPECT_EQ(memorySize, ktx->getMemorySize());
+
+        EXPECT_NO_THROW(image->release());
+        ASSERT_NO_THROW(resources.releaseResource(std::move(image)));
+    }
+
+    ASSERT_NO_THROW(resources.setImageCache(Core::Path()));
+    ASSERT_NO_THROW(loader.release());
+}
+
+TEST(Image, bakedCacheFreeImage)
+{
+    auto core = std::make_shared<MouCaCore::CoreSystem>();
+
+    auto& resources = core->getResourceManager();
+    auto& loader    = core->getLoaderManager();
+    loader.initialize();
+
+    const auto texturePath = MouCaEnvironment::getInputPath() / L"textures";
+    const auto cachePath   = MouCaEnvironment::getOutputPath() / L"ImageCacheFI";
+    std::filesystem::remove_all(cachePath);
+    ASSERT_NO_THROW(resources.setImageCache(cachePath));
+
+    // First run: PNG without options is baked as single RGBA level
+    Core::Path           cacheFile;
+    RT::Array3ui         extents;
+    std::vector<uint8_t> pixels;
+    {
+        auto image = resources.openImage(texturePath / L"image.png");
+        cacheFile = image->getCacheFilename();
+        EXPECT_FALSE(std::filesystem::exists(cacheFile));
+
+        MouCaCore::LoadingItems items =
+        {
+            MouCaCore::LoadingItem(image, MouCaCore::LoadingItem::Direct)
+        };
+        ASSERT_NO_THROW(loader.loadResources(items));
+        ASSERT_TRUE(std::filesystem::exists(cacheFile));
+
+        auto imageFI = image->getImage().lock();
+        ASSERT_TRUE(std::dynamic_pointer_cast<ImageFI>(imageFI) != nullptr);
+        extents = imageFI->getExtents(0);
+        const auto* data = reinterpret_cast<const uint8_t*>(imageFI->getRAWData(0, 0));
+        pixels.assign(data, data + static_cast<size_t>(extents.x) * extents.y * sizeof(Core::ColorUC32));
+
+        EXPECT_NO_THROW(image->release());
+        ASSERT_NO_THROW(resources.releaseResource(std::move(image)));
+    }
+
+    // Second run: same pixels from KTX2
+    {
+        auto image = resources.openImage(texturePath / L"image.png");
+        EXPECT_EQ(cacheFile, image->getCacheFilename());
+
+        MouCaCore::LoadingItems items =
+        {
+            MouCaCore::LoadingItem(image, MouCaCore::LoadingItem::Direct)
+        };
+        ASSERT_NO_THROW(loader.loadResources(items));
+
+        auto ktx = std::dynamic_pointer_cast<ImageKTX>(image->getImage().lock());
+        ASSERT_TRUE(ktx != nullptr);
+        ASSERT_EQ(1u, ktx->getLevels());
+        ASSERT_EQ(extents, ktx->getExtents(0));
+        ASSERT_EQ(pixels.size(), ktx->getMemorySize());
+        EXPECT_EQ(0, memcmp(pixels.data(), ktx->getRAWData(0, 0), pixels.size()));
+
+        EXPECT_NO_THROW(image->release());
+        ASSERT_NO_THROW(resources.releaseResource(std::move(image)));
+    }
+
+    ASSERT_NO_THROW(resources.setImageCache(Core::Path()));
+    ASSERT_NO_THROW(loader.release());
+}
+
+TEST(Image, progressiveKTX)
+{
+    auto core = std::make_shared<MouCaCore::CoreSystem>();
+
+    auto& resources = core->getResourceManager();
+    auto& loader    = core->getLoaderManager();
+    loader.initialize(4);
+
+    const auto texturePath = MouCaEnvironment::getInputPath() / L"textures";
+    const auto cachePath   = MouCaEnvironment::getOutputPath() / L"ImageCacheProgressive";
+    std::filesystem::remove_all(cachePath);
+    ASSERT_NO_THROW(resources.setImageCache(cachePath));
+
+    RT::ImageImport::Options options;
+    options._mipmaps     = RT::ImageImport::Options::Filter::Kaiser;
+    options._compression = RT::ImageImport::Options::Compression::BC1;
+
+    // Build KTX2 with all levels
+    auto imageMipmap = resources.openImage(texturePath / L"spir.png", options);
+    {
+        MouCaCore::LoadingItems items =
+        {
+            MouCaCore::LoadingItem(imageMipmap, MouCaCore::LoadingItem::Direct)
+        };
+        ASSERT_NO_THROW(loader.loadResources(items));
+    }
+    ASSERT_NO_THROW(resources.setImageCache(Core::Path()));
+
+    // Read by level/layer on all queues
+    auto imageKTX2 = resources.openImage(imageMipmap->getCacheFilename());
+    auto imageKTX1 = resources.openImage(texturePath / L"spir.ktx");
+    {
+        MouCaCore::LoadingItems items =
+        {
+            MouCaCore::LoadingItem(imageKTX2, MouCaCore::LoadingItem::Deferred),
+            MouCaCore::LoadingItem(imageKTX1, MouCaCore::LoadingItem::Deferred)
+        };
+        ASSERT_NO_THROW(loader.loadResources(items));
+        ASSERT_NO_THROW(loader.synchronize());
+    }
+
+    {
+        auto mipmap = imageMipmap->getImage().lock();
+        auto ktx    = std::dynamic_pointer_cast<ImageKTX>(imageKTX2->getImage().lock());
+        ASSERT_TRUE(ktx != nullptr);
+        EXPECT_EQ(mipmap->getLevels(), ktx->getNbDecodeTasks());   // One task by level (single layer)
+        EXPECT_EQ((1ull << ktx->getLevels()) - 1, ktx->getReadyLevels());
+        EXPECT_FALSE(ktx->isMapped());                              // Mapping released by latest level
+        ASSERT_EQ(mipmap->getLevels(), ktx->getLevels());
+        ASSERT_EQ(mipmap->getMemorySize(), ktx->getMemorySize());
+
+        for (uint32_t level = 0; level < ktx->getLevels(); ++level)
+        {
+            const size_t size = BlockCompression::getLevelSize(options._compression, ktx->getExtents(level).x, ktx->getExtents(level).y);
+            EXPECT_EQ(0, memcmp(mipmap->getRAWData(0, level), ktx->getRAWData(0, level), size));
+        }
+    }
+
+    // Not by level: only one task
+    {
+        auto ktx = std::dynamic_pointer_cast<ImageKTX>(imageKTX1->getImage().lock());
+        ASSERT_TRUE(ktx != nullptr);
+        EXPECT_EQ(1, ktx->getNbDecodeTasks());
+        EXPECT_EQ((1ull << ktx->getLevels()) - 1, ktx->getReadyLevels());
+    }
+
+    ASSERT_NO_THROW(loader.release());
+
+    for (auto& image : { imageMipmap, imageKTX2, imageKTX1 })
+    {
+        EXPECT_NO_THROW(image->release());
+    }
+    ASSERT_NO_THROW(resources.releaseResource(std::move(imageMipmap)));
+    ASSERT_NO_THROW(resources.releaseResource(std::move(imageKTX2)));
+    ASSERT_NO_THROW(resources.releaseResource(std::move(imageKTX1)));
+}
+
+TEST(Image, linkedEncoders)
+{
+    // Top-down RGBA memory with padding (like GPU mapped image): R == B so FreeImage BGRA order is identical
+    const uint32_t width  = 5;
+    const uint32_t height = 3;
+    const size_t   pitch  = (width + 1) * 4;
+    std::vector<uint8_t> memory(pitch * height, 0);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            uint8_t* pixel = &memory[y * pitch + x * 4];
+            pixel[0] = static_cast<uint8_t>(x * 50);
+            pixel[1] = static_cast<uint8_t>(y * 100);
+            pixel[2] = pixel[0];
+            pixel[3] = 255;
+        }
+    }
+
+    RT::BufferDescriptor descriptor;
+    descriptor.addDescriptor(RT::ComponentDescriptor(4, RT::Type::UnsignedChar, RT::ComponentUsage::Color));
+    auto buffer = std::make_shared<RT::BufferLinkedCPU>();
+    buffer->create(descriptor, width * height, memory.data(), pitch);
+
+    RT::ImageLinkedCPU linked;
+    ASSERT_NO_THROW(linked.initialize(RT::Image::Target::Type2D, buffer, { width, height, 1 }, true));
+    EXPECT_EQ(-static_cast<int64_t>(pitch), linked.getRowStride(0));
+
+    // Negative stride is same picture as flipped copy
+    ImageFI flipped;
+    ASSERT_NO_THROW(flipped.createFill(*buffer, width, height));
+    EXPECT_TRUE(linked.compare(flipped, 0, 0.0));
+
+    // Streaming encoders
+    const auto pngFile = MouCaEnvironment::getOutputPath() / L"linkedEncoder.png";
+    ASSERT_NO_THROW(linked.saveImage(pngFile));
+    {
+        ImageFI reload;
+        ASSERT_NO_THROW(reload.initialize(pngFile));
+        EXPECT_TRUE(linked.compare(reload, 0, 0.0));
+        reload.release();
+    }
+    EXPECT_ANY_THROW(linked.saveImage(MouCaEnvironment::getOutputPath() / L"linkedEncoder.bmp"));
+    EXPECT_ANY_THROW(linked.saveImage(MouCaEnvironment::getOutputPath() / L"linkedEncoder.exr")); // Need float
+
+    std::vector<float> memoryFloat(width * height * 4, 0.5f);
+    RT::BufferDescriptor descriptorFloat;
+    descriptorFloat.addDescriptor(RT::ComponentDescriptor(4, RT::Type::Float, RT::ComponentUsage::Color));
+    auto bufferFloat = std::make_shared<RT::BufferLinkedCPU>();
+    bufferFloat->create(descriptorFloat, width * height, memoryFloat.data());
+
+    RT::ImageLinkedCPU linkedFloat;
+    ASSERT_NO_THROW(linkedFloat.initialize(RT::Image::Target::Type2D, bufferFloat, { width, height, 1 }));
+    const auto exrFile = MouCaEnvironment::getOutputPath() / L"linkedEncoder.exr";
+    ASSERT_NO_THROW(linkedFloat.export2D(exrFile));
+    EXPECT_TRUE(std::filesystem::exists(exrFile));
+
+    linkedFloat.release();
+    linked.release();
+    flipped.release();
+}
+
+TEST(Image, linkedEncoderChannelOrder)
+{
+    // One pixel: red is first into PNG whatever memory order
+    auto readFirstPixel = [](const Core::Path& file)
+    {
+        std::ifstream stream(file, std::ios::binary);
+        const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+        // Second IDAT is first stored block: type + block header (5) + filter (1)
+        const std::array<uint8_t, 4> idat = { 'I', 'D', 'A', 'T' };
+        auto itChunk = std::search(bytes.cbegin(), bytes.cend(), idat.cbegin(), idat.cend());
+        itChunk      = std::search(itChunk + 1, bytes.cend(), idat.cbegin(), idat.cend());
+        const auto pixel = itChunk + idat.size() + 5 + 1;
+        return std::array<uint8_t, 4>{ pixel[0], pixel[1], pixel[2], pixel[3] };
+    };
+
+    RT::BufferDescriptor descriptor;
+    descriptor.addDescriptor(RT::ComponentDescriptor(4, RT::Type::UnsignedChar, RT::ComponentUsage::Color));
+
+    const std::array<uint8_t, 4> rgba = { 200, 100, 10, 255 };
+    const std::array<uint8_t, 4> bgra = { 10, 100, 200, 255 };
+
+    // VkFormat values: R8G8B8A8_UNORM (37), B8G8R8A8_UNORM (44), B8G8R8A8_SRGB (50)
+    const std::vector<std::pair<uint32_t, std::array<uint8_t, 4>>> memories =
+    {
+        { 0,  rgba },
+        { 37, rgba },
+        { 44, bgra },
+        { 50, bgra }
+    };
+    for (const auto& memory : memories)
+    {
+        auto pixel  = memory.second;
+        auto buffer = std::make_shared<RT::BufferLinkedCPU>();
+        buffer->create(descriptor, 1, pixel.data());
+
+        RT::ImageLinkedCPU linked;
+        ASSERT_NO_THROW(linked.initialize(RT::Image::Target::Type2D, buffer, { 1, 1, 1 }, true, memory.first));
+        EXPECT_EQ(memory.first, linked.getFormat());
+
+        const auto pngFile = MouCaEnvironment::getOutputPath() / L"linkedEncoderChannel.png";
+        ASSERT_NO_THROW(linked.saveImage(pngFile));
+        EXPECT_EQ(rgba, readFirstPixel(pngFile)) << "VkFormat: " << memory.first;
+        EXPECT_EQ(memory.second, pixel); // Memory is never modified
+
+        linked.release();
+    }
+}
+
 // cppcheck-suppress syntaxError
 TEST(Image, open)
 {
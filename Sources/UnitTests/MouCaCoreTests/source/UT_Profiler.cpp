@@ -0,0 +1,60 @@
+#include "Dependencies.h"
+
+#include <LibCore/include/CoreElapser.h>
+#include <LibCore/include/CoreProfiler.h>
+
+namespace Core
+{
+
+namespace
+{
+    // Avoid optimization of empty loop
+    std::atomic<int64_t> sink = 0;
+
+    void work(const size_t id)
+    {
+        sink.fetch_add(static_cast<int64_t>(id), std::memory_order_relaxed);
+    }
+}
+
+// Compare cost of zone against same loop without instrumentation
+TEST(Profiler, benchmark)
+{
+    const size_t nbZones = 1000000;
+    Profiler::clear();
+
+    int64_t timeReference, timeDisabled, timeEnabled;
+    {
+        Elapser<std::chrono::nanoseconds> elapser;
+        for (size_t id = 0; id < nbZones; ++id)
+        {
+            work(id);
+        }
+        timeReference = elapser.tick();
+
+        Profiler::enable(false);
+        for (size_t id = 0; id < nbZones; ++id)
+        {
+            MOUCA_PROFILE_ZONE("Benchmark");
+            work(id);
+        }
+        timeDisabled = elapser.tick();
+
+        Profiler::enable(true);
+        elapser.reset();
+        for (size_t id = 0; id < nbZones; ++id)
+        {
+            MOUCA_PROFILE_ZONE("Benchmark");
+            work(id);
+        }
+        timeEnabled = elapser.tick();
+        Profiler::enable(false);
+    }
+    EXPECT_EQ(Profiler::_capacity, Profiler::collect().size());
+    Profiler::clear();
+
+    std::cout << "Zone cost: reference " << static_cast<double>(timeReference) / nbZones << " ns, disabled "
+              << static_cast<double>(timeDisabled) / nbZones << " ns, enabled " << static_cast<double>(timeEnabled) / nbZones << " ns" << std::endl;
+}
+
+}
@@ -0,0 +1,69 @@
+#include "Dependencies.h"
+
+#include <LibCore/include/CoreElapser.h>
+#include <LibCore/include/CoreSignal.h>
+
+namespace Core
+{
+
+namespace
+{
+    struct Counter
+    {
+        void add(int value)
+        {
+            _sum += value;
+        }
+
+        int64_t _sum = 0;
+    };
+}
+
+// Compare emit latency against previous std::map<std::function> implementation
+TEST(Signal, benchmark)
+{
+    const size_t nbEmits = 100000;
+    for (const size_t nbSlots : { size_t(1), size_t(16), size_t(256) })
+    {
+        std::vector<Counter> counters(nbSlots);
+
+        Signal<int> signal;
+        std::map<Signal<int>::IdConnexion, std::function<void(int)>> previous;
+        for (auto& counter : counters)
+        {
+            signal.connectMember<Counter>(&counter, &Counter::add);
+
+            Counter* instance = &counter;
+            previous.insert(std::make_pair(reinterpret_cast<Signal<int>::IdConnexion>(instance), [=](int value) { instance->add(value); }));
+        }
+
+        int64_t timePrevious, timeSignal;
+        {
+            Elapser<std::chrono::nanoseconds> elapser;
+            for (size_t id = 0; id < nbEmits; ++id)
+            {
+                for (auto it : previous)
+                {
+                    it.second(1);
+                }
+            }
+            timePrevious = elapser.tick();
+
+            for (size_t id = 0; id < nbEmits; ++id)
+            {
+                signal.emit(1);
+            }
+            timeSignal = elapser.tick();
+        }
+
+        for (const auto& counter : counters)
+        {
+            EXPECT_EQ(static_cast<int64_t>(2 * nbEmits), counter._sum);
+        }
+
+        std::cout << "Emit with " << nbSlots << " slots: previous " << timePrevious / nbEmits << " ns, signal " << timeSignal / nbEmits << " ns"
+                  << " (snapshot lock-free: " << std::boolalpha << signal.isLockFree() << ")" << std::endl;
+    }
+}
+
+}
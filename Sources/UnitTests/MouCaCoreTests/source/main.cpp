@@ -1,5 +1,7 @@
 #include <Dependencies.h>
 
+#include <LibCore/include/CoreLogger.h>
+
 int main(int argc, char** argv)
 {
 	testing::InitGoogleTest(&argc, argv);
@@ -7,6 +9,15 @@ int main(int argc, char** argv)
 	MouCaEnvironment* environment = new MouCaEnvironment;
 	environment->initialize(argc, argv);
 	testing::AddGlobalTestEnvironment(environment);
+
+	// CoreSystem of each test keeps these outputs (no MouCaLab.log into working folder)
+	Core::Logger::Configuration logger;
+	logger._filename = MouCaEnvironment::getOutputPath() / L"MouCaCoreTests.log";
+	logger._console  = false;
+	Core::Logger::initialize(logger);
 	
-	return RUN_ALL_TESTS();
+	const int result = RUN_ALL_TESTS();
+
+	Core::Logger::release();
+	return result;
 }
\ No newline at end of file
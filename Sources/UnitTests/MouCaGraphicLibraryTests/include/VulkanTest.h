@@ -29,6 +29,15 @@ static const RT::ApplicationInfo g_info
     0x00000001
 };
 
+/// Headless tests accept any physical device (software driver like lavapipe included).
+static const Vulkan::PhysicalDeviceTypes g_deviceTypes
+{
+    VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU,
+    VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU,
+    VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU,
+    VK_PHYSICAL_DEVICE_TYPE_CPU
+};
+
 /// A simply RenderPass parameter sample for test
 struct RenderPassParameters
 {
@@ -401,6 +401,9 @@ TEST_F(Engine3DManagerTest, shaderEvent)
 
     signalSync.disconnect(&sync);
 
+    // No frame ring: old module and pipelines are released by rebuild
+    EXPECT_TRUE(context->getDeferredRelease().isNull());
+
     // Run one frame
     {
         for (const auto& sequence : *context->getQueueSequences().at(0))
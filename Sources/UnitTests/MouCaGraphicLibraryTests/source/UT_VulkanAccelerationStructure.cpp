@@ -0,0 +1,179 @@
+#include "Dependencies.h"
+
+#include "include/VulkanTest.h"
+
+#include <LibRT/include/RTBufferCPU.h>
+#include <LibRT/include/RTMesh.h>
+
+#include <LibVulkan/include/VKAccelerationStructure.h>
+#include <LibVulkan/include/VKAccelerationStructureGeometry.h>
+#include <LibVulkan/include/VKBuffer.h>
+#include <LibVulkan/include/VKDevice.h>
+#include <LibVulkan/include/VKEnvironment.h>
+
+class VulkanAccelerationStructure : public ::testing::Test
+{
+protected:
+    static Vulkan::Environment environment;
+    static Vulkan::Device      device;
+
+    static void SetUpTestSuite()
+    {
+        ASSERT_NO_THROW(environment.initialize(g_info));
+
+        // Device features chain ray tracing pipeline features: enable its extension too
+        const std::vector<const char*> extensions =
+        {
+            VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME,
+            VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME,
+            VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME,
+            VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME
+        };
+        Vulkan::PhysicalDeviceFeatures features;
+        features._bufferDeviceAddresFeatures.bufferDeviceAddress      = VK_TRUE;
+        features._accelerationStructureFeatures.accelerationStructure = VK_TRUE;
+        try
+        {
+            device.initializeBestGPU(environment, extensions, nullptr, features, g_deviceTypes);
+        }
+        catch (const Core::Exception&)
+        {
+            // No device with acceleration structures: tests are skipped
+        }
+    }
+
+    static void TearDownTestSuite()
+    {
+        if (!device.isNull())
+        {
+            ASSERT_NO_THROW(device.release());
+        }
+        ASSERT_NO_THROW(environment.release());
+    }
+
+    void SetUp() final
+    {
+        if (device.isNull())
+        {
+            GTEST_SKIP() << "VK_KHR_acceleration_structure is not supported";
+        }
+    }
+
+    void TearDown() final
+    {}
+
+    /// Buffer readable by builds (host visible to refit).
+    static Vulkan::BufferSPtr makeInput(const VkDeviceSize size, const void* data)
+    {
+        auto buffer = std::make_shared<Vulkan::Buffer>(std::make_unique<Vulkan::MemoryBufferAllocate>(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT));
+        buffer->initialize(device, 0, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR, size, data);
+        return buffer;
+    }
+};
+
+Vulkan::Environment VulkanAccelerationStructure::environment;
+Vulkan::Device      VulkanAccelerationStructure::device;
+
+TEST_F(VulkanAccelerationStructure, buildCompactRefit)
+{
+    // Grid of 8x8 quads
+    const uint32_t size = 8;
+    std::vector<glm::vec3> vertices;
+    for (uint32_t y = 0; y <= size; ++y)
+    {
+        for (uint32_t x = 0; x <= size; ++x)
+        {
+            vertices.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+        }
+    }
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (uint32_t y = 0; y < size; ++y)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            const uint32_t first = x + y * (size + 1);
+            triangles.push_back({ first, first + 1, first + size + 1 });
+            triangles.push_back({ first + 1, first + size + 2, first + size + 1 });
+        }
+    }
+
+    RT::BufferDescriptor vboDescriptor;
+    vboDescriptor.addDescriptor(RT::ComponentDescriptor(3, RT::Type::Float, RT::ComponentUsage::Vertex));
+    RT::BufferDescriptor iboDescriptor;
+    iboDescriptor.addDescriptor(RT::ComponentDescriptor(3, RT::Type::UnsignedInt, RT::ComponentUsage::Index));
+
+    auto cpuVertices = std::make_shared<RT::BufferCPU>();
+    memcpy(cpuVertices->create(vboDescriptor, vertices.size()), vertices.data(), vertices.size() * sizeof(glm::vec3));
+    auto cpuIndices = std::make_shared<RT::BufferCPU>();
+    memcpy(cpuIndices->create(iboDescriptor, triangles.size()), triangles.data(), triangles.size() * sizeof(triangles.front()));
+
+    auto mesh = std::make_shared<RT::Mesh>();
+    const RT::Mesh::SubMeshDescriptors info = { { vertices.size(), 0, triangles.size() * 3 } };
+    mesh->initialize(cpuVertices, cpuIndices, info);
+
+    auto vbo = makeInput(vertices.size() * sizeof(glm::vec3), vertices.data());
+    auto ibo = makeInput(triangles.size() * sizeof(triangles.front()), triangles.data());
+
+    // Bottom level: compacted and refittable
+    auto bottom = std::make_shared<Vulkan::AccelerationStructure>();
+    {
+        auto geometry = std::make_unique<Vulkan::AccelerationStructureGeometryTriangles>();
+        geometry->initialize(mesh, vbo, ibo, VK_GEOMETRY_OPAQUE_BIT_KHR);
+        bottom->addGeometry(std::move(geometry));
+    }
+    bottom->setCreateInfo(0, VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR);
+    bottom->setBuildFlags(VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR);
+    ASSERT_NO_THROW(bottom->initialize(device));
+    const VkDeviceSize originalSize = bottom->getSize();
+    EXPECT_LT(0u, originalSize);
+
+    // Top level: one instance of bottom level (geometries are created by initialize())
+    auto top = std::make_shared<Vulkan::AccelerationStructure>();
+    auto instances = std::make_unique<Vulkan::AccelerationStructureGeometryInstance>();
+    auto* instancesPtr = instances.get();
+    {
+        Vulkan::AccelerationStructureGeometryInstance::Instance instance;
+        instance.initialize(bottom, VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR, { 1.0f, 0.0f, 0.0f, 0.0f,
+                                                                                                 0.0f, 1.0f, 0.0f, 0.0f,
+                                                                                                 0.0f, 0.0f, 1.0f, 0.0f });
+        instances->addInstance(std::move(instance));
+        top->addGeometry(std::move(instances));
+    }
+    top->setCreateInfo(0, VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR);
+    top->setBuildFlags(VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR);
+    ASSERT_NO_THROW(top->initialize(device));
+
+    // Build + compaction
+    std::vector<Vulkan::AccelerationStructureWPtr> structures{ top, bottom };
+    ASSERT_NO_THROW(Vulkan::AccelerationStructure::createAccelerationStructure(device, structures));
+    ASSERT_FALSE(bottom->isNull());
+    ASSERT_FALSE(top->isNull());
+    EXPECT_LT(0u, bottom->getSize());
+    EXPECT_LE(bottom->getSize(), originalSize);
+    EXPECT_NE(0u, bottom->getDeviceAdress());
+    EXPECT_NE(0u, top->getDeviceAdress());
+
+    // Top level references compacted bottom level
+    EXPECT_EQ(bottom->getDeviceAdress(), instancesPtr->getInstances().front().compute().accelerationStructureReference);
+
+    // Refit: move one vertex, structures are kept
+    const VkAccelerationStructureKHR bottomHandle = bottom->getHandle();
+    const VkAccelerationStructureKHR topHandle    = top->getHandle();
+    const VkDeviceSize               compacted    = bottom->getSize();
+    ASSERT_NO_THROW(vbo->getMemory().map(device));
+    vbo->getMemory().getMappedMemory<glm::vec3>()[size + 2].z = 0.5f;
+    ASSERT_NO_THROW(vbo->getMemory().unmap(device));
+
+    ASSERT_NO_THROW(Vulkan::AccelerationStructure::updateAccelerationStructure(device, structures));
+    EXPECT_EQ(bottomHandle, bottom->getHandle());
+    EXPECT_EQ(topHandle,    top->getHandle());
+    EXPECT_EQ(compacted,    bottom->getSize());
+    EXPECT_EQ(bottom->getDeviceAdress(), instancesPtr->getInstances().front().compute().accelerationStructureReference);
+
+    ASSERT_NO_THROW(device.waitIdle());
+    ASSERT_NO_THROW(top->release(device));
+    ASSERT_NO_THROW(bottom->release(device));
+    ASSERT_NO_THROW(vbo->release(device));
+    ASSERT_NO_THROW(ibo->release(device));
+    mesh->release();
+}
@@ -5,6 +5,10 @@
 
 #include <LibVulkan/include/VKEnvironment.h>
 #include <LibVulkan/include/VKBuffer.h>
+#include <LibVulkan/include/VKCommand.h>
+#include <LibVulkan/include/VKCommandPool.h>
+#include <LibVulkan/include/VKDeferredRelease.h>
+#include <LibVulkan/include/VKDescriptorSet.h>
 #include <LibVulkan/include/VKDevice.h>
 
 class VulkanBuffer : public ::testing::Test
@@ -16,7 +20,7 @@ protected:
     static void SetUpTestSuite()
     {
         ASSERT_NO_THROW(environment.initialize(g_info));
-        ASSERT_NO_THROW(device.initializeBestGPU(environment));
+        ASSERT_NO_THROW(device.initializeBestGPU(environment, {}, nullptr, {}, g_deviceTypes));
     }
 
     static void TearDownTestSuite()
@@ -83,4 +87,236 @@ TEST_F(VulkanBuffer, mapping)
     ASSERT_NO_THROW(buffer.release(device));
 
     ASSERT_TRUE(buffer.isNull());
-}
\ No newline at end of file
+}
+
+TEST_F(VulkanBuffer, reserve)
+{
+    Vulkan::Buffer buffer(std::make_unique<Vulkan::MemoryBuffer>(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+
+    const std::array<uint32_t, 4> data   = { 1, 2, 3, 4 };
+    const std::array<uint32_t, 2> update = { 10, 11 };
+    ASSERT_NO_THROW(buffer.initialize(device, 0, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, sizeof(data), data.data()));
+    const VkBuffer oldHandle = buffer.getBuffer();
+
+    Vulkan::CommandPool pool;
+    ASSERT_NO_THROW(pool.initialize(device, device.getQueueFamilyGraphicId()));
+
+    const VkCommandBufferAllocateInfo allocateInfo
+    {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, pool.getInstance(), VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1
+    };
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    ASSERT_EQ(VK_SUCCESS, vkAllocateCommandBuffers(device.getInstance(), &allocateInfo, &commandBuffer));
+
+    const VkCommandBufferBeginInfo beginInfo
+    {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr
+    };
+    ASSERT_EQ(VK_SUCCESS, vkBeginCommandBuffer(commandBuffer, &beginInfo));
+
+    Vulkan::DeferredRelease deferred(1);
+
+    // Enough space: nothing to do
+    EXPECT_FALSE(buffer.reserve(device, commandBuffer, sizeof(data), deferred));
+
+    // Geometric growth: 16 bytes -> 32 bytes (at least twice)
+    EXPECT_TRUE(buffer.reserve(device, commandBuffer, sizeof(data) + 4, deferred));
+    EXPECT_EQ(sizeof(data) * 2, buffer.getSize());
+    EXPECT_NE(oldHandle, buffer.getBuffer());
+    EXPECT_EQ(buffer.getBuffer(), buffer.getDescriptor().buffer);
+
+    // Write after old content
+    ASSERT_NO_THROW(buffer.updateRange(device, commandBuffer, sizeof(data), sizeof(update), update.data(), deferred));
+    EXPECT_EQ(2, deferred.getNbPending());
+
+    ASSERT_EQ(VK_SUCCESS, vkEndCommandBuffer(commandBuffer));
+
+    const VkSubmitInfo submitInfo
+    {
+        VK_STRUCTURE_TYPE_SUBMIT_INFO, nullptr, 0, nullptr, nullptr, 1, &commandBuffer, 0, nullptr
+    };
+    ASSERT_EQ(VK_SUCCESS, vkQueueSubmit(device.getQueue(), 1, &submitInfo, VK_NULL_HANDLE));
+    ASSERT_NO_THROW(device.waitIdle());
+
+    // Old buffers are released after frame
+    ASSERT_NO_THROW(deferred.nextFrame(device));
+    EXPECT_EQ(0, deferred.getNbPending());
+
+    // Check content
+    ASSERT_NO_THROW(buffer.getMemory().map(device));
+    const uint32_t* values = buffer.getMemory().getMappedMemory<uint32_t>();
+    for (const uint32_t value : data)
+    {
+        EXPECT_EQ(value, *values);
+        ++values;
+    }
+    for (const uint32_t value : update)
+    {
+        EXPECT_EQ(value, *values);
+        ++values;
+    }
+    ASSERT_NO_THROW(buffer.getMemory().unmap(device));
+
+    ASSERT_NO_THROW(pool.release(device));
+    ASSERT_NO_THROW(buffer.release(device));
+    ASSERT_NO_THROW(deferred.release(device));
+}
+
+TEST_F(VulkanBuffer, reserveDescriptorSet)
+{
+    auto buffer = std::make_shared<Vulkan::Buffer>(std::make_unique<Vulkan::MemoryBuffer>(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT));
+    ASSERT_NO_THROW(buffer->initialize(device, 0, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, 16));
+
+    // Bind buffer into set
+    Vulkan::DescriptorSetLayout layout;
+    layout.addBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+    ASSERT_NO_THROW(layout.initialize(device));
+
+    auto pool = std::make_shared<Vulkan::DescriptorPool>();
+    ASSERT_NO_THROW(pool->initialize(device, { { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 } }, 1));
+
+    Vulkan::DescriptorSet set;
+    ASSERT_NO_THROW(set.initialize(device, pool, { layout.getInstance() }));
+
+    std::vector<Vulkan::WriteDescriptorSet> writes;
+    writes.emplace_back(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, Vulkan::DescriptorBufferInfos{ { buffer, 0, VK_WHOLE_SIZE } });
+    ASSERT_NO_THROW(set.update(device, 0, std::move(writes)));
+    EXPECT_FALSE(set.isDirty());
+    EXPECT_TRUE(buffer->getSignalHandleChanged().isConnected(&set));
+
+    // Grow buffer: set still points to old handle
+    Vulkan::CommandPool commandPool;
+    ASSERT_NO_THROW(commandPool.initialize(device, device.getQueueFamilyGraphicId()));
+
+    const VkCommandBufferAllocateInfo allocateInfo
+    {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, commandPool.getInstance(), VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1
+    };
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    ASSERT_EQ(VK_SUCCESS, vkAllocateCommandBuffers(device.getInstance(), &allocateInfo, &commandBuffer));
+
+    const VkCommandBufferBeginInfo beginInfo
+    {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr
+    };
+    ASSERT_EQ(VK_SUCCESS, vkBeginCommandBuffer(commandBuffer, &beginInfo));
+
+    Vulkan::DeferredRelease deferred(1);
+    const VkBuffer oldHandle = buffer->getBuffer();
+    EXPECT_FALSE(buffer->reserve(device, commandBuffer, 16, deferred));
+    EXPECT_FALSE(set.isDirty());
+
+    EXPECT_TRUE(buffer->reserve(device, commandBuffer, 64, deferred));
+    EXPECT_NE(oldHandle, buffer->getBuffer());
+    EXPECT_TRUE(set.isDirty());
+
+    ASSERT_EQ(VK_SUCCESS, vkEndCommandBuffer(commandBuffer));
+    const VkSubmitInfo submitInfo
+    {
+        VK_STRUCTURE_TYPE_SUBMIT_INFO, nullptr, 0, nullptr, nullptr, 1, &commandBuffer, 0, nullptr
+    };
+    ASSERT_EQ(VK_SUCCESS, vkQueueSubmit(device.getQueue(), 1, &submitInfo, VK_NULL_HANDLE));
+    ASSERT_NO_THROW(device.waitIdle());
+    ASSERT_NO_THROW(deferred.nextFrame(device));
+
+    // Write again set with new handle
+    EXPECT_TRUE(set.refresh(device));
+    EXPECT_FALSE(set.isDirty());
+    EXPECT_FALSE(set.refresh(device));
+
+    // Reallocation emits same signal
+    ASSERT_NO_THROW(buffer->resize(device, 128));
+    EXPECT_TRUE(set.isDirty());
+    EXPECT_TRUE(set.refresh(device));
+
+    // Released set doesn't follow buffer anymore
+    ASSERT_NO_THROW(set.release(device));
+    EXPECT_FALSE(buffer->getSignalHandleChanged().isConnected(&set));
+
+    ASSERT_NO_THROW(commandPool.release(device));
+    ASSERT_NO_THROW(pool->release(device));
+    ASSERT_NO_THROW(layout.release(device));
+    ASSERT_NO_THROW(buffer->release(device));
+    ASSERT_NO_THROW(deferred.release(device));
+}
+
+class VulkanContextBuffer : public VulkanDeviceTest
+{
+    protected:
+        VulkanContextBuffer():
+        VulkanDeviceTest("VulkanContextBuffer")
+        {}
+};
+
+// Refreshed sets keep their handles: static command buffers must be recorded again
+TEST_F(VulkanContextBuffer, refreshRecordsAgain)
+{
+    const auto& device = _contextDevice.getDevice();
+
+    auto buffer = std::make_shared<Vulkan::Buffer>(std::make_unique<Vulkan::MemoryBuffer>(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT));
+    ASSERT_NO_THROW(buffer->initialize(device, 0, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, 16));
+
+    Vulkan::DescriptorSetLayout layout;
+    layout.addBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+    ASSERT_NO_THROW(layout.initialize(device));
+
+    auto set = std::make_shared<Vulkan::DescriptorSet>();
+    ASSERT_NO_THROW(set->initialize(device, _contextDevice.getDescriptorAllocator(), { &layout }));
+    std::vector<Vulkan::WriteDescriptorSet> writes;
+    writes.emplace_back(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, Vulkan::DescriptorBufferInfos{ { buffer, 0, VK_WHOLE_SIZE } });
+    ASSERT_NO_THROW(set->update(device, 0, std::move(writes)));
+    _contextDevice.insertDescriptorSet(set);
+
+    // Static command buffer: recorded once
+    auto pool = std::make_shared<Vulkan::CommandPool>();
+    ASSERT_NO_THROW(pool->initialize(device, device.getQueueFamilyGraphicId()));
+
+    Vulkan::CommandBuffer commandBuffer;
+    ASSERT_NO_THROW(commandBuffer.initialize(device, pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 0));
+    commandBuffer.addCommand(std::make_unique<Vulkan::CommandViewport>(VkViewport{ 0.0f, 0.0f, 10.0f, 10.0f, 0.0f, 1.0f }));
+
+    const auto countRecordings = []() { return Vulkan::ICommandBuffer::getStatistics()._nbRecordings; };
+    const auto start = countRecordings();
+    ASSERT_NO_THROW(commandBuffer.execute());
+    ASSERT_NO_THROW(commandBuffer.execute());
+    EXPECT_EQ(start + 1, countRecordings());
+
+    // Grow buffer: set is dirty
+    const VkCommandBufferAllocateInfo allocateInfo
+    {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, pool->getInstance(), VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1
+    };
+    VkCommandBuffer copyBuffer = VK_NULL_HANDLE;
+    ASSERT_EQ(VK_SUCCESS, vkAllocateCommandBuffers(device.getInstance(), &allocateInfo, &copyBuffer));
+
+    const VkCommandBufferBeginInfo beginInfo
+    {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr
+    };
+    ASSERT_EQ(VK_SUCCESS, vkBeginCommandBuffer(copyBuffer, &beginInfo));
+    EXPECT_TRUE(buffer->reserve(device, copyBuffer, 64, _contextDevice.getDeferredRelease()));
+    ASSERT_EQ(VK_SUCCESS, vkEndCommandBuffer(copyBuffer));
+
+    const VkSubmitInfo submitInfo
+    {
+        VK_STRUCTURE_TYPE_SUBMIT_INFO, nullptr, 0, nullptr, nullptr, 1, &copyBuffer, 0, nullptr
+    };
+    ASSERT_EQ(VK_SUCCESS, vkQueueSubmit(device.getQueue(), 1, &submitInfo, VK_NULL_HANDLE));
+    ASSERT_NO_THROW(device.waitIdle());
+    EXPECT_TRUE(set->isDirty());
+    EXPECT_FALSE(commandBuffer.isDirty());
+
+    // Next frame writes set again and invalidates command buffers
+    ASSERT_EQ(VK_SUCCESS, _contextDevice.beginFrame());
+    EXPECT_FALSE(set->isDirty());
+    EXPECT_TRUE(commandBuffer.isDirty());
+    ASSERT_NO_THROW(commandBuffer.execute());
+    EXPECT_EQ(start + 2, countRecordings());
+
+    ASSERT_EQ(VK_SUCCESS, _contextDevice.getFrameRing().wait(device));
+    vkFreeCommandBuffers(device.getInstance(), pool->getInstance(), 1, &copyBuffer);
+    ASSERT_NO_THROW(commandBuffer.release(device));
+    ASSERT_NO_THROW(pool->release(device));
+    ASSERT_NO_THROW(buffer->release(device));
+    ASSERT_NO_THROW(layout.release(device));
+}
@@ -7,6 +7,7 @@
 #include <LibGLFW/include/GLFWPlatform.h>
 #include <LibGLFW/include/GLFWWindow.h>
 
+#include <LibVulkan/include/VKCommand.h>
 #include <LibVulkan/include/VKCommandBuffer.h>
 #include <LibVulkan/include/VKCommandPool.h>
 #include <LibVulkan/include/VKEnvironment.h>
@@ -174,3 +175,67 @@ TEST_F(VulkanCmdBufferTest, commandPoolInitialize)
     ASSERT_TRUE(commandPool.isNull());
 }
 */
+
+// Static commands are recorded once: only changes record again
+TEST(VulkanCommandBuffer, recordOnce)
+{
+    Vulkan::Environment environment;
+    ASSERT_NO_THROW(environment.initialize(g_info));
+    Vulkan::Device device;
+    ASSERT_NO_THROW(device.initializeBestGPU(environment, {}, nullptr, {}, g_deviceTypes));
+
+    auto pool = std::make_shared<Vulkan::CommandPool>();
+    ASSERT_NO_THROW(pool->initialize(device, device.getQueueFamilyGraphicId()));
+
+    Vulkan::CommandBuffer commandBuffer;
+    ASSERT_NO_THROW(commandBuffer.initialize(device, pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 0));
+
+    // Switch between two viewports
+    auto commandSwitch = std::make_unique<Vulkan::CommandSwitch>();
+    Vulkan::Commands viewports;
+    viewports.emplace_back(std::make_unique<Vulkan::CommandViewport>(VkViewport{ 0.0f, 0.0f, 10.0f, 10.0f, 0.0f, 1.0f }));
+    viewports.emplace_back(std::make_unique<Vulkan::CommandViewport>(VkViewport{ 0.0f, 0.0f, 20.0f, 20.0f, 0.0f, 1.0f }));
+    commandSwitch->transfer(std::move(viewports));
+    Vulkan::CommandSwitch* switchViewport = commandSwitch.get();
+    commandBuffer.addCommand(std::move(commandSwitch));
+
+    const auto countRecordings = []() { return Vulkan::ICommandBuffer::getStatistics()._nbRecordings; };
+    const auto start = Vulkan::ICommandBuffer::getStatistics();
+
+    EXPECT_TRUE(commandBuffer.isDirty());
+    ASSERT_NO_THROW(commandBuffer.execute());
+    EXPECT_EQ(start._nbRecordings + 1, countRecordings());
+    EXPECT_FALSE(commandBuffer.isDirty());
+
+    // Static: nothing is recorded
+    for (size_t loop = 0; loop < 10; ++loop)
+    {
+        ASSERT_NO_THROW(commandBuffer.execute());
+    }
+    EXPECT_EQ(start._nbRecordings + 1, countRecordings());
+    EXPECT_EQ(start._nbResets + 1,     Vulkan::ICommandBuffer::getStatistics()._nbResets);
+    EXPECT_EQ(start._nbSkipped + 10,   Vulkan::ICommandBuffer::getStatistics()._nbSkipped);
+
+    // Same node: no change
+    switchViewport->setIdNode(0);
+    EXPECT_FALSE(commandBuffer.isDirty());
+
+    // New node
+    switchViewport->setIdNode(1);
+    EXPECT_TRUE(commandBuffer.isDirty());
+    ASSERT_NO_THROW(commandBuffer.execute());
+    ASSERT_NO_THROW(commandBuffer.execute());
+    EXPECT_EQ(start._nbRecordings + 2, countRecordings());
+
+    // Forced recording
+    commandBuffer.invalidate();
+    ASSERT_NO_THROW(commandBuffer.execute());
+    Vulkan::ICommandBuffer::invalidateAll();
+    ASSERT_NO_THROW(commandBuffer.execute());
+    EXPECT_EQ(start._nbRecordings + 4, countRecordings());
+
+    ASSERT_NO_THROW(commandBuffer.release(device));
+    ASSERT_NO_THROW(pool->release(device));
+    ASSERT_NO_THROW(device.release());
+    ASSERT_NO_THROW(environment.release());
+}
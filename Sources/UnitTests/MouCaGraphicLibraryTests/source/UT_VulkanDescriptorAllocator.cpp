@@ -0,0 +1,230 @@
+#include <Dependencies.h>
+
+#include "include/VulkanTest.h"
+
+#include <LibVulkan/include/VKBuffer.h>
+#include <LibVulkan/include/VKDescriptorAllocator.h>
+#include <LibVulkan/include/VKDescriptorSet.h>
+#include <LibVulkan/include/VKDevice.h>
+#include <LibVulkan/include/VKEnvironment.h>
+
+class VulkanDescriptorAllocator : public ::testing::Test
+{
+protected:
+    static Vulkan::Environment environment;
+    static Vulkan::Device      device;
+
+    static void SetUpTestSuite()
+    {
+        ASSERT_NO_THROW(environment.initialize(g_info));
+        ASSERT_NO_THROW(device.initializeBestGPU(environment, {}, nullptr, {}, g_deviceTypes));
+    }
+
+    static void TearDownTestSuite()
+    {
+        ASSERT_NO_THROW(device.release());
+        ASSERT_NO_THROW(environment.release());
+    }
+
+    void SetUp() final
+    {}
+
+    void TearDown() final
+    {}
+
+    static std::vector<Vulkan::WriteDescriptorSet> makeWrites(const Vulkan::BufferSPtr& buffer, const VkDeviceSize offset)
+    {
+        std::vector<Vulkan::WriteDescriptorSet> writes;
+        writes.emplace_back(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, Vulkan::DescriptorBufferInfos{ { buffer, offset, 64 } });
+        return writes;
+    }
+};
+
+Vulkan::Environment VulkanDescriptorAllocator::environment;
+Vulkan::Device      VulkanDescriptorAllocator::device;
+
+TEST_F(VulkanDescriptorAllocator, growPools)
+{
+    Vulkan::DescriptorSetLayout layout;
+    layout.addBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT);
+    ASSERT_NO_THROW(layout.initialize(device));
+
+    Vulkan::DescriptorAllocator allocator;
+    ASSERT_TRUE(allocator.isNull());
+    ASSERT_NO_THROW(allocator.initialize(device, 4));
+    ASSERT_FALSE(allocator.isNull());
+
+    // 4 + 8 + 16 sets
+    std::set<VkDescriptorSet> sets;
+    for (size_t id = 0; id < 28; ++id)
+    {
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        ASSERT_NO_THROW(set = allocator.allocate(device, layout));
+        EXPECT_NE(VK_NULL_HANDLE, set);
+        sets.insert(set);
+    }
+    EXPECT_EQ(28, sets.size());
+    EXPECT_EQ(28, allocator.getStatistics()._nbAllocations);
+    EXPECT_EQ(3,  allocator.getStatistics()._nbPools);
+
+    // Transient pools are reused each frame
+    for (size_t frame = 0; frame < 3; ++frame)
+    {
+        for (size_t id = 0; id < 4; ++id)
+        {
+            ASSERT_NO_THROW(allocator.allocate(device, layout, true));
+        }
+        ASSERT_NO_THROW(allocator.resetTransient(device));
+    }
+    EXPECT_EQ(4, allocator.getStatistics()._nbPools);
+
+    ASSERT_NO_THROW(allocator.release(device));
+    ASSERT_TRUE(allocator.isNull());
+    ASSERT_NO_THROW(layout.release(device));
+}
+
+TEST_F(VulkanDescriptorAllocator, frames)
+{
+    Vulkan::DescriptorSetLayout layout;
+    layout.addBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT);
+    ASSERT_NO_THROW(layout.initialize(device));
+
+    Vulkan::DescriptorAllocator allocator;
+    ASSERT_NO_THROW(allocator.initialize(device, 4, 2));
+
+    // Each frame in flight has its own transient pools: starting frame 1 doesn't touch sets of frame 0
+    for (uint32_t frame = 0; frame < 6; ++frame)
+    {
+        ASSERT_NO_THROW(allocator.beginFrame(device, frame % 2));
+        for (size_t id = 0; id < 4; ++id)
+        {
+            ASSERT_NO_THROW(allocator.allocate(device, layout, true));
+        }
+    }
+    EXPECT_EQ(24, allocator.getStatistics()._nbAllocations);
+    EXPECT_EQ(2,  allocator.getStatistics()._nbPools);
+
+    ASSERT_NO_THROW(allocator.release(device));
+    ASSERT_NO_THROW(layout.release(device));
+}
+
+TEST_F(VulkanDescriptorAllocator, cache)
+{
+    Vulkan::DescriptorSetLayout layout;
+    layout.addBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT);
+    ASSERT_NO_THROW(layout.initialize(device));
+
+    auto buffer = std::make_shared<Vulkan::Buffer>(std::make_unique<Vulkan::MemoryBuffer>(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT));
+    ASSERT_NO_THROW(buffer->initialize(device, 0, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, 1024));
+
+    Vulkan::DescriptorAllocator allocator;
+    ASSERT_NO_THROW(allocator.initialize(device));
+
+    auto writesA = makeWrites(buffer, 0);
+    auto writesB = makeWrites(buffer, 256);
+
+    const VkDescriptorSet setA = allocator.getCached(device, layout, writesA);
+    const VkDescriptorSet setB = allocator.getCached(device, layout, writesB);
+    EXPECT_NE(setA, setB);
+
+    // Same content: no allocation, no update
+    for (size_t loop = 0; loop < 8; ++loop)
+    {
+        auto writes = makeWrites(buffer, 0);
+        EXPECT_EQ(setA, allocator.getCached(device, layout, writes));
+    }
+    EXPECT_EQ(setB, allocator.getCached(device, layout, writesB));
+
+    const auto& statistics = allocator.getStatistics();
+    EXPECT_EQ(2, statistics._nbAllocations);
+    EXPECT_EQ(2, statistics._nbUpdates);
+    EXPECT_EQ(9, statistics._nbCacheHits);
+    EXPECT_EQ(2, statistics._nbCacheMisses);
+    EXPECT_DOUBLE_EQ(9.0 / 11.0, statistics.getHitRate());
+
+    // Cache is empty
+    ASSERT_NO_THROW(allocator.clearCache(device));
+    ASSERT_NO_THROW(allocator.getCached(device, layout, writesA));
+    EXPECT_EQ(3, statistics._nbCacheMisses);
+
+    ASSERT_NO_THROW(allocator.release(device));
+    ASSERT_NO_THROW(buffer->release(device));
+    ASSERT_NO_THROW(layout.release(device));
+}
+
+// Cached sets follow written buffers: stale sets are evicted then recycled after frames in flight
+TEST_F(VulkanDescriptorAllocator, cacheEviction)
+{
+    Vulkan::DescriptorSetLayout layout;
+    layout.addBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT);
+    ASSERT_NO_THROW(layout.initialize(device));
+
+    auto buffer = std::make_shared<Vulkan::Buffer>(std::make_unique<Vulkan::MemoryBuffer>(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT));
+    ASSERT_NO_THROW(buffer->initialize(device, 0, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, 1024));
+
+    Vulkan::DescriptorAllocator allocator;
+    ASSERT_NO_THROW(allocator.initialize(device, 4, 2));
+
+    auto writesA = makeWrites(buffer, 0);
+    const VkDescriptorSet setA = allocator.getCached(device, layout, writesA);
+    EXPECT_TRUE(buffer->getSignalHandleChanged().isConnected(&allocator));
+    EXPECT_TRUE(buffer->getSignalRelease().isConnected(&allocator));
+
+    // New handle: old content is never returned
+    ASSERT_NO_THROW(buffer->resize(device, 2048));
+    const auto& statistics = allocator.getStatistics();
+    EXPECT_EQ(1, statistics._nbEvictions);
+
+    auto writesNew = makeWrites(buffer, 0);
+    const VkDescriptorSet setNew = allocator.getCached(device, layout, writesNew);
+    EXPECT_NE(setA, setNew);
+    EXPECT_EQ(2, statistics._nbAllocations);
+
+    // Evicted set is reused once frames in flight are finished
+    ASSERT_NO_THROW(allocator.beginFrame(device, 0));
+    ASSERT_NO_THROW(allocator.beginFrame(device, 1));
+    auto writesB = makeWrites(buffer, 256);
+    EXPECT_EQ(setA, allocator.getCached(device, layout, writesB));
+    EXPECT_EQ(2, statistics._nbAllocations);
+    EXPECT_EQ(3, statistics._nbUpdates);
+
+    // Released buffer evicts all its sets
+    ASSERT_NO_THROW(buffer->release(device));
+    EXPECT_EQ(3, statistics._nbEvictions);
+
+    ASSERT_NO_THROW(allocator.release(device));
+    EXPECT_FALSE(buffer->getSignalRelease().isConnected(&allocator));
+    ASSERT_NO_THROW(layout.release(device));
+}
+
+TEST_F(VulkanDescriptorAllocator, descriptorSet)
+{
+    Vulkan::DescriptorSetLayout layout;
+    layout.addBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT);
+    ASSERT_NO_THROW(layout.initialize(device));
+
+    auto buffer = std::make_shared<Vulkan::Buffer>(std::make_unique<Vulkan::MemoryBuffer>(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT));
+    ASSERT_NO_THROW(buffer->initialize(device, 0, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, 1024));
+
+    Vulkan::DescriptorAllocator allocator;
+    ASSERT_NO_THROW(allocator.initialize(device, 1));
+
+    // Like XML DescriptorSet without descriptorPoolId: no fixed pool
+    Vulkan::DescriptorSet descriptorSet;
+    ASSERT_NO_THROW(descriptorSet.initialize(device, allocator, { &layout, &layout }));
+    ASSERT_FALSE(descriptorSet.isNull());
+    EXPECT_EQ(2, descriptorSet.getDescriptorSets().size());
+    EXPECT_NE(descriptorSet.getInstance(0), descriptorSet.getInstance(1));
+    EXPECT_EQ(2, allocator.getStatistics()._nbAllocations);
+    EXPECT_EQ(2, allocator.getStatistics()._nbPools);
+
+    ASSERT_NO_THROW(descriptorSet.update(device, 1, makeWrites(buffer, 0)));
+
+    // Sets are given back with pools of allocator
+    ASSERT_NO_THROW(descriptorSet.release(device));
+    ASSERT_TRUE(descriptorSet.isNull());
+
+    ASSERT_NO_THROW(allocator.release(device));
+    ASSERT_NO_THROW(buffer->release(device));
+    ASSERT_NO_THROW(layout.release(device));
+}
@@ -15,7 +15,7 @@ protected:
     static void SetUpTestSuite()
     {
         ASSERT_NO_THROW(environment.initialize(g_info));
-        ASSERT_NO_THROW(device.initializeBestGPU(environment));
+        ASSERT_NO_THROW(device.initializeBestGPU(environment, {}, nullptr, {}, g_deviceTypes));
     }
 
     static void TearDownTestSuite()
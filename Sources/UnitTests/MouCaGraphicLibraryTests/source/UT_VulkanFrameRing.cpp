@@ -0,0 +1,93 @@
+#include <Dependencies.h>
+
+#include "include/VulkanTest.h"
+
+#include <LibVulkan/include/VKDevice.h>
+#include <LibVulkan/include/VKEnvironment.h>
+#include <LibVulkan/include/VKFrameRing.h>
+
+class VulkanFrameRing : public ::testing::Test
+{
+protected:
+    static Vulkan::Environment environment;
+    static Vulkan::Device      device;
+
+    static void SetUpTestSuite()
+    {
+        ASSERT_NO_THROW(environment.initialize(g_info));
+        ASSERT_NO_THROW(device.initializeBestGPU(environment, {}, nullptr, {}, g_deviceTypes));
+    }
+
+    static void TearDownTestSuite()
+    {
+        ASSERT_NO_THROW(device.release());
+        ASSERT_NO_THROW(environment.release());
+    }
+
+    void SetUp() final
+    {}
+
+    void TearDown() final
+    {}
+};
+
+Vulkan::Environment VulkanFrameRing::environment;
+Vulkan::Device      VulkanFrameRing::device;
+
+TEST_F(VulkanFrameRing, initialize)
+{
+    Vulkan::FrameRing ring;
+    EXPECT_TRUE(ring.isNull());
+
+    ASSERT_NO_THROW(ring.initialize(device, 3, device.getQueueFamilyGraphicId()));
+    EXPECT_FALSE(ring.isNull());
+    EXPECT_FALSE(ring.isRunning());
+    EXPECT_EQ(3, ring.getNbFrames());
+    EXPECT_FALSE(ring.getFence().isNull());
+    EXPECT_FALSE(ring.getAcquireSemaphore().isNull());
+    EXPECT_FALSE(ring.getRenderSemaphore().isNull());
+    EXPECT_FALSE(ring.getCommandPool().isNull());
+
+    // All fences are signaled
+    EXPECT_EQ(VK_SUCCESS, ring.wait(device, 0));
+
+    ASSERT_NO_THROW(ring.release(device));
+    EXPECT_TRUE(ring.isNull());
+}
+
+TEST_F(VulkanFrameRing, frames)
+{
+    Vulkan::FrameRing ring;
+    ASSERT_NO_THROW(ring.initialize(device, 2, device.getQueueFamilyGraphicId()));
+
+    std::set<VkFence>     fences;
+    std::set<VkSemaphore> semaphores;
+    for (uint32_t frame = 0; frame < 6; ++frame)
+    {
+        ASSERT_EQ(VK_SUCCESS, ring.beginFrame(device, 1000000000ull));
+        EXPECT_TRUE(ring.isRunning());
+        EXPECT_EQ(frame % 2, ring.getCurrent());
+        EXPECT_EQ(frame + 1, ring.getFrame());
+        fences.insert(ring.getFence().getInstance());
+
+        // Each slot has its own semaphores
+        EXPECT_EQ(ring.getAcquireSemaphore().getInstance(), ring.getSemaphore(Vulkan::FrameRing::SemaphoreType::Acquire).getInstance());
+        EXPECT_EQ(ring.getRenderSemaphore().getInstance(),  ring.getSemaphore(Vulkan::FrameRing::SemaphoreType::Render).getInstance());
+        semaphores.insert(ring.getAcquireSemaphore().getInstance());
+        semaphores.insert(ring.getRenderSemaphore().getInstance());
+
+        // Odd frames are never submitted: ring must signal fence itself
+        if (frame % 2 == 0)
+        {
+            ASSERT_EQ(VK_SUCCESS, vkQueueSubmit(device.getQueue(), 0, nullptr, ring.getFence().getInstance()));
+            ring.setSubmitted();
+        }
+    }
+    EXPECT_EQ(2, fences.size());
+    EXPECT_EQ(4, semaphores.size());
+
+    // Replace waitIdle
+    EXPECT_EQ(VK_SUCCESS, ring.wait(device, 1000000000ull));
+
+    ASSERT_NO_THROW(ring.release(device));
+}
@@ -0,0 +1,470 @@
+#include "Dependencies.h"
+
+#include "include/VulkanTest.h"
+
+#include <LibRT/include/RTFrustum.h>
+#include <LibRT/include/RTMassiveInstance.h>
+
+#include <LibVulkan/include/VKBuffer.h>
+#include <LibVulkan/include/VKCommand.h>
+#include <LibVulkan/include/VKCommandBuffer.h>
+#include <LibVulkan/include/VKCommandPool.h>
+#include <LibVulkan/include/VKDevice.h>
+#include <LibVulkan/include/VKEnvironment.h>
+#include <LibVulkan/include/VKFrameBuffer.h>
+#include <LibVulkan/include/VKGraphicsPipeline.h>
+#include <LibVulkan/include/VKImage.h>
+#include <LibVulkan/include/VKMeshIndirect.h>
+#include <LibVulkan/include/VKPipelineLayout.h>
+#include <LibVulkan/include/VKPipelineStates.h>
+#include <LibVulkan/include/VKRenderPass.h>
+#include <LibVulkan/include/VKShaderProgram.h>
+
+class VulkanMeshIndirect : public ::testing::Test
+{
+protected:
+    /// Instances without meshes: only culling data.
+    class Instances final : public RT::BasicMassiveInstance
+    {
+        public:
+            Instances():
+            BasicMassiveInstance(RT::Object::TMassive)
+            {}
+
+            ~Instances() override = default;
+
+            void update(const std::vector<Indirect>& indirects, const std::vector<Instance>& instances) override
+            {
+                _indirects = indirects;
+                _instances = instances;
+            }
+    };
+
+    /// Result of culling read from GPU.
+    struct Result
+    {
+        std::vector<VkDrawIndexedIndirectCommand>      _commands;
+        std::vector<Vulkan::MeshIndirect::Instance>    _visibles;
+    };
+
+    static Vulkan::Environment environment;
+    static Vulkan::Device      device;
+    static bool                drawIndirectCount;   ///< VK_KHR_draw_indirect_count is enabled on device.
+
+    static void SetUpTestSuite()
+    {
+        ASSERT_NO_THROW(environment.initialize(g_info));
+
+        // Draws need VK_KHR_draw_indirect_count: culling is tested without it
+        const std::vector<const char*> extensions = { VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME };
+        try
+        {
+            device.initializeBestGPU(environment, extensions, nullptr, {}, g_deviceTypes);
+            drawIndirectCount = true;
+        }
+        catch (const Core::Exception&)
+        {
+            try
+            {
+                device.initializeBestGPU(environment, {}, nullptr, {}, g_deviceTypes);
+            }
+            catch (const Core::Exception&)
+            {
+                // No device: GPU tests are skipped
+            }
+        }
+    }
+
+    static void TearDownTestSuite()
+    {
+        if (!device.isNull())
+        {
+            ASSERT_NO_THROW(device.release());
+        }
+        ASSERT_NO_THROW(environment.release());
+    }
+
+    void SetUp() final
+    {}
+
+    void TearDown() final
+    {}
+
+    /// Grid of instances: mesh 0 (unit cube), then mesh 1 (small cube shifted then rotated).
+    static void makeInstances(Instances& massive, std::vector<RT::BoundingBox>& boxes)
+    {
+        boxes.emplace_back(RT::Point3(-0.5f), RT::Point3(0.5f));
+        boxes.emplace_back(RT::Point3(0.25f, -0.25f, -0.25f), RT::Point3(0.75f, 0.25f, 0.25f));
+
+        const float halfAngle = glm::radians(45.0f);
+        std::vector<RT::BasicMassiveInstance::Instance> instances;
+        std::vector<RT::BasicMassiveInstance::Indirect> indirects;
+        for (uint32_t meshID = 0; meshID < 2; ++meshID)
+        {
+            const RT::Point4 quaternion = meshID == 0 ? RT::Point4(0.0f, 0.0f, 0.0f, 1.0f) : RT::Point4(0.0f, 0.0f, std::sin(halfAngle), std::cos(halfAngle));
+            for (int y = -8; y <= 8; ++y)
+            {
+                for (int x = -8; x <= 8; ++x)
+                {
+                    instances.emplace_back(meshID, RT::Point3(x, y, -5.0f - static_cast<float>(meshID)), quaternion, RT::Point3(1.0f));
+                }
+            }
+            indirects.emplace_back(17 * 17, 36 * meshID, 36);
+        }
+        massive.update(indirects, instances);
+    }
+
+    static Result cull(Vulkan::MeshIndirect& meshIndirect)
+    {
+        const VkMemoryPropertyFlags host = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        Vulkan::Buffer visibles(std::make_unique<Vulkan::MemoryBuffer>(host));
+        visibles.initialize(device, 0, VK_BUFFER_USAGE_TRANSFER_DST_BIT, meshIndirect.getVisibles()->getSize());
+        Vulkan::Buffer commands(std::make_unique<Vulkan::MemoryBuffer>(host));
+        commands.initialize(device, 0, VK_BUFFER_USAGE_TRANSFER_DST_BIT, meshIndirect.getDrawCommands()->getSize());
+        Vulkan::Buffer count(std::make_unique<Vulkan::MemoryBuffer>(host));
+        count.initialize(device, 0, VK_BUFFER_USAGE_TRANSFER_DST_BIT, sizeof(uint32_t));
+
+        Vulkan::Commands culling;
+        meshIndirect.makeCullingCommands(culling);
+        culling.emplace_back(std::make_unique<Vulkan::CommandCopy>(*meshIndirect.getVisibles(),     visibles, VkBufferCopy{ 0, 0, visibles.getSize() }));
+        culling.emplace_back(std::make_unique<Vulkan::CommandCopy>(*meshIndirect.getDrawCommands(), commands, VkBufferCopy{ 0, 0, commands.getSize() }));
+        culling.emplace_back(std::make_unique<Vulkan::CommandCopy>(*meshIndirect.getDrawCount(),    count,    VkBufferCopy{ 0, 0, count.getSize() }));
+
+        auto pool = std::make_shared<Vulkan::CommandPool>();
+        pool->initialize(device, device.getQueueFamilyGraphicId());
+        auto commandBuffer = std::make_shared<Vulkan::CommandBuffer>();
+        commandBuffer->initialize(device, pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 0);
+        commandBuffer->addCommands(std::move(culling));
+        commandBuffer->execute();
+        device.executeCommandSync({ commandBuffer });
+
+        // Read back
+        Result result;
+        count.getMemory().map(device);
+        result._commands.resize(*count.getMemory().getMappedMemory<uint32_t>());
+        count.getMemory().unmap(device);
+
+        commands.getMemory().map(device);
+        const auto* command = commands.getMemory().getMappedMemory<VkDrawIndexedIndirectCommand>();
+        std::copy(command, command + result._commands.size(), result._commands.begin());
+        commands.getMemory().unmap(device);
+
+        // Visible instances of each draw (order into a draw is not deterministic)
+        std::sort(result._commands.begin(), result._commands.end(), [](const auto& a, const auto& b) { return a.firstInstance < b.firstInstance; });
+        visibles.getMemory().map(device);
+        const auto* visible = visibles.getMemory().getMappedMemory<Vulkan::MeshIndirect::Instance>();
+        for (const auto& draw : result._commands)
+        {
+            result._visibles.insert(result._visibles.end(), visible + draw.firstInstance, visible + draw.firstInstance + draw.instanceCount);
+        }
+        visibles.getMemory().unmap(device);
+
+        commandBuffer->release(device);
+        pool->release(device);
+        count.release(device);
+        commands.release(device);
+        visibles.release(device);
+        return result;
+    }
+
+    static void compare(const Instances& massive, const std::vector<RT::BoundingBox>& boxes, const RT::Frustum& frustum, const Result& result)
+    {
+        std::vector<RT::BasicMassiveInstance::Indirect> indirects;
+        std::vector<RT::BasicMassiveInstance::Instance> instances;
+        massive.cull(frustum, boxes, indirects, instances);
+
+        // Only non-empty draws, in mesh order (slots of mesh are reserved for all its instances)
+        const auto less = [](const RT::Point3& a, const RT::Point3& b) { return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z); };
+        auto itCommand = result._commands.cbegin();
+        auto itVisible = result._visibles.cbegin();
+        uint32_t firstInstance = 0;
+        for (uint32_t meshID = 0; meshID < indirects.size(); ++meshID)
+        {
+            const auto& indirect = indirects[meshID];
+            if (indirect._count > 0)
+            {
+                ASSERT_NE(result._commands.cend(), itCommand);
+                EXPECT_EQ(indirect._count,      itCommand->instanceCount);
+                EXPECT_EQ(indirect._indexCount, itCommand->indexCount);
+                EXPECT_EQ(indirect._indexBase,  itCommand->firstIndex);
+                EXPECT_EQ(firstInstance,        itCommand->firstInstance);
+
+                // Same visible instances (order into a draw is not deterministic)
+                ASSERT_LE(itCommand->instanceCount, static_cast<uint32_t>(std::distance(itVisible, result._visibles.cend())));
+                std::vector<RT::Point3> gpu;
+                for (uint32_t id = 0; id < itCommand->instanceCount; ++id, ++itVisible)
+                {
+                    EXPECT_EQ(meshID, itVisible->_meshID);
+                    gpu.emplace_back(itVisible->_position);
+                }
+                std::vector<RT::Point3> cpu;
+                for (const auto& instance : instances)
+                {
+                    if (instance._meshID == meshID)
+                    {
+                        cpu.emplace_back(instance._position);
+                    }
+                }
+                std::sort(gpu.begin(), gpu.end(), less);
+                std::sort(cpu.begin(), cpu.end(), less);
+                EXPECT_EQ(cpu, gpu);
+
+                ++itCommand;
+            }
+            firstInstance += massive.getIndirects()[meshID]._count;
+        }
+        EXPECT_EQ(result._commands.cend(), itCommand);
+        EXPECT_EQ(instances.size(), result._visibles.size());
+    }
+};
+
+Vulkan::Environment VulkanMeshIndirect::environment;
+Vulkan::Device      VulkanMeshIndirect::device;
+bool                VulkanMeshIndirect::drawIndirectCount = false;
+
+TEST_F(VulkanMeshIndirect, cpuReference)
+{
+    Instances massive;
+    std::vector<RT::BoundingBox> boxes;
+    makeInstances(massive, boxes);
+
+    RT::Frustum frustum;
+    frustum.update(glm::ortho(-4.5f, 4.5f, -4.5f, 4.5f, 0.1f, 100.0f));
+
+    std::vector<RT::BasicMassiveInstance::Indirect> indirects;
+    std::vector<RT::BasicMassiveInstance::Instance> instances;
+    massive.cull(frustum, boxes, indirects, instances);
+
+    // Unit cube (radius 0.87): x/y in [-5; 5]. Small cube (radius 0.43): rotated center x in [-4; 4], y in [-5; 4]
+    ASSERT_EQ(2, indirects.size());
+    EXPECT_EQ(11 * 11, indirects[0]._count);
+    EXPECT_EQ(9 * 10,  indirects[1]._count);
+    EXPECT_EQ(indirects[0]._count + indirects[1]._count, instances.size());
+
+    // Grouped by mesh
+    EXPECT_TRUE(std::is_sorted(instances.cbegin(), instances.cend(), [](const auto& a, const auto& b) { return a._meshID < b._meshID; }));
+
+    massive.release();
+}
+
+TEST_F(VulkanMeshIndirect, gpuCulling)
+{
+    if (device.isNull())
+    {
+        GTEST_SKIP() << "No Vulkan device";
+    }
+
+    Core::File shaderFile(MouCaEnvironment::getInputPath() / L".." / L"SpirV" / L"culling.comp.spv");
+    ASSERT_NO_THROW(shaderFile.open());
+    auto shader = std::make_shared<Vulkan::ShaderModule>();
+    ASSERT_NO_THROW(shader->initialize(device, shaderFile.extractString(), "main", VK_SHADER_STAGE_COMPUTE_BIT));
+    shaderFile.close();
+
+    Instances massive;
+    std::vector<RT::BoundingBox> boxes;
+    makeInstances(massive, boxes);
+
+    Vulkan::MeshIndirect meshIndirect;
+    ASSERT_TRUE(meshIndirect.isNull());
+    ASSERT_NO_THROW(meshIndirect.initialize(device, shader, 4, 1024));
+    ASSERT_FALSE(meshIndirect.isNull());
+
+    ASSERT_NO_THROW(meshIndirect.update(device, massive, boxes));
+
+    // Orthographic view
+    RT::Frustum frustum;
+    frustum.update(glm::ortho(-4.5f, 4.5f, -4.5f, 4.5f, 0.1f, 100.0f));
+    ASSERT_NO_THROW(meshIndirect.setFrustum(device, frustum));
+    compare(massive, boxes, frustum, cull(meshIndirect));
+
+    // Only frustum changes: no upload of instances
+    frustum.update(glm::perspective(glm::radians(30.0f), 1.5f, 0.1f, 5.5f) * glm::lookAt(RT::Point3(1.0f, 0.0f, 0.0f), RT::Point3(1.0f, 0.0f, -1.0f), RT::Point3(0.0f, 1.0f, 0.0f)));
+    ASSERT_NO_THROW(meshIndirect.setFrustum(device, frustum));
+    compare(massive, boxes, frustum, cull(meshIndirect));
+
+    // Nothing visible: no draw
+    frustum.update(glm::ortho(-4.5f, 4.5f, -4.5f, 4.5f, 0.1f, 2.0f));
+    ASSERT_NO_THROW(meshIndirect.setFrustum(device, frustum));
+    const Result result = cull(meshIndirect);
+    EXPECT_TRUE(result._commands.empty());
+
+    ASSERT_NO_THROW(meshIndirect.release(device));
+    ASSERT_TRUE(meshIndirect.isNull());
+    shader->release(device);
+    massive.release();
+}
+
+// Draws consume culling results: each drawn instance marks its slot (indirect.vert)
+TEST_F(VulkanMeshIndirect, gpuDraws)
+{
+    if (!drawIndirectCount)
+    {
+        GTEST_SKIP() << "VK_KHR_draw_indirect_count is not supported";
+    }
+    VkPhysicalDeviceFeatures features;
+    vkGetPhysicalDeviceFeatures(device.getPhysicalDevice(), &features);
+    if (features.vertexPipelineStoresAndAtomics == VK_FALSE)
+    {
+        GTEST_SKIP() << "vertexPipelineStoresAndAtomics is not supported";
+    }
+
+    const auto loadShader = [](const Core::Path& filename, const VkShaderStageFlagBits stage)
+    {
+        Core::File shaderFile(MouCaEnvironment::getInputPath() / L".." / L"SpirV" / filename);
+        shaderFile.open();
+        auto shader = std::make_shared<Vulkan::ShaderModule>();
+        shader->initialize(device, shaderFile.extractString(), "main", stage);
+        shaderFile.close();
+        return shader;
+    };
+    Vulkan::ShaderModuleSPtr culling, vertex;
+    ASSERT_NO_THROW(culling = loadShader(L"culling.comp.spv", VK_SHADER_STAGE_COMPUTE_BIT));
+    ASSERT_NO_THROW(vertex  = loadShader(L"indirect.vert.spv", VK_SHADER_STAGE_VERTEX_BIT));
+
+    Instances massive;
+    std::vector<RT::BoundingBox> boxes;
+    makeInstances(massive, boxes);
+
+    const uint32_t maxInstances = 1024;
+    Vulkan::MeshIndirect meshIndirect;
+    ASSERT_NO_THROW(meshIndirect.initialize(device, culling, 4, maxInstances));
+    ASSERT_NO_THROW(meshIndirect.update(device, massive, boxes));
+
+    RT::Frustum frustum;
+    frustum.update(glm::ortho(-4.5f, 4.5f, -4.5f, 4.5f, 0.1f, 100.0f));
+    ASSERT_NO_THROW(meshIndirect.setFrustum(device, frustum));
+    const Result result = cull(meshIndirect);
+    ASSERT_FALSE(result._commands.empty());
+
+    // Meshes: all indices read vertex 0 (only instances matter)
+    const VkMemoryPropertyFlags host = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    const std::vector<uint32_t> indices(2 * 36, 0);
+    auto ibo = std::make_shared<Vulkan::Buffer>(std::make_unique<Vulkan::MemoryBuffer>(host));
+    ASSERT_NO_THROW(ibo->initialize(device, 0, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, indices.size() * sizeof(uint32_t), indices.data()));
+
+    const std::vector<uint32_t> empty(maxInstances, 0);
+    auto drawn = std::make_shared<Vulkan::Buffer>(std::make_unique<Vulkan::MemoryBuffer>(host));
+    ASSERT_NO_THROW(drawn->initialize(device, 0, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, empty.size() * sizeof(uint32_t), empty.data()));
+
+    Vulkan::DescriptorSetLayout descriptorSetLayout;
+    descriptorSetLayout.addBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT);
+    ASSERT_NO_THROW(descriptorSetLayout.initialize(device));
+    auto descriptorPool = std::make_shared<Vulkan::DescriptorPool>();
+    ASSERT_NO_THROW(descriptorPool->initialize(device, { { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 } }, 1));
+    Vulkan::DescriptorSet descriptorSet;
+    ASSERT_NO_THROW(descriptorSet.initialize(device, descriptorPool, { descriptorSetLayout.getInstance() }));
+    {
+        std::vector<Vulkan::WriteDescriptorSet> writes;
+        writes.emplace_back(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, Vulkan::DescriptorBufferInfos{ { drawn, 0, VK_WHOLE_SIZE } });
+        ASSERT_NO_THROW(descriptorSet.update(device, 0, std::move(writes)));
+    }
+
+    // Render pass without output: rasterization is discarded
+    const VkExtent2D resolution = { 4, 4 };
+    Vulkan::Image image;
+    ASSERT_NO_THROW(image.initialize(device, Vulkan::Image::Size({ resolution.width, resolution.height, 1 }), VK_IMAGE_TYPE_2D, VK_FORMAT_R8G8B8A8_UNORM,
+                                     VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_SHARING_MODE_EXCLUSIVE, VK_IMAGE_LAYOUT_UNDEFINED,
+                                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT));
+    Vulkan::ImageViewWPtr view;
+    ASSERT_NO_THROW(view = image.createView(device, VK_IMAGE_VIEW_TYPE_2D, VK_FORMAT_R8G8B8A8_UNORM, VkComponentMapping(), { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }));
+
+    const std::vector<VkAttachmentReference> references = { { 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL } };
+    auto renderPass = std::make_shared<Vulkan::RenderPass>();
+    ASSERT_NO_THROW(renderPass->initialize(device,
+        { { 0, VK_FORMAT_R8G8B8A8_UNORM, VK_SAMPLE_COUNT_1_BIT, VK_ATTACHMENT_LOAD_OP_DONT_CARE, VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            VK_ATTACHMENT_LOAD_OP_DONT_CARE, VK_ATTACHMENT_STORE_OP_DONT_CARE, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL } },
+        { { 0, VK_PIPELINE_BIND_POINT_GRAPHICS, 0, nullptr, static_cast<uint32_t>(references.size()), references.data(), nullptr, nullptr, 0, nullptr } },
+        {}));
+    auto frameBuffer = std::make_shared<Vulkan::FrameBuffer>();
+    ASSERT_NO_THROW(frameBuffer->initialize(device, renderPass, resolution, { view.lock()->getInstance() }));
+
+    auto pipelineLayout = std::make_shared<Vulkan::PipelineLayout>();
+    ASSERT_NO_THROW(pipelineLayout->initialize(device, { descriptorSetLayout.getInstance() }));
+
+    auto pipeline = std::make_shared<Vulkan::GraphicsPipeline>();
+    auto& info = pipeline->getInfo();
+    info.initialize(static_cast<Vulkan::PipelineStateCreateInfo::States>(Vulkan::PipelineStateCreateInfo::VertexInput | Vulkan::PipelineStateCreateInfo::InputAssembly | Vulkan::PipelineStateCreateInfo::Rasterization));
+    info.getRasterizer()._state.rasterizerDiscardEnable = VK_TRUE;
+    info.getVertexInput().setBindingDescriptions({ { 1, sizeof(Vulkan::MeshIndirect::Instance), VK_VERTEX_INPUT_RATE_INSTANCE } });
+    info.getVertexInput().setAttributeDescriptions(
+    {
+        { 0, 1, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vulkan::MeshIndirect::Instance, _position) },
+        { 1, 1, VK_FORMAT_R32_UINT,         offsetof(Vulkan::MeshIndirect::Instance, _meshID) }
+    });
+    info.getStages().addShaderModule(vertex, Vulkan::ShaderSpecialization());
+    ASSERT_NO_THROW(pipeline->initialize(device, renderPass, pipelineLayout, Vulkan::PipelineCacheWPtr()));
+
+    // Culling + draws into same command buffer
+    Vulkan::Commands commands;
+    meshIndirect.makeCullingCommands(commands);
+    commands.emplace_back(std::make_unique<Vulkan::CommandBeginRenderPass>(*renderPass, frameBuffer, VkRect2D{ { 0, 0 }, resolution }, std::vector<VkClearValue>(), VK_SUBPASS_CONTENTS_INLINE));
+    commands.emplace_back(std::make_unique<Vulkan::CommandBindPipeline>(pipeline, VK_PIPELINE_BIND_POINT_GRAPHICS));
+    commands.emplace_back(std::make_unique<Vulkan::CommandBindDescriptorSets>(*pipelineLayout, VK_PIPELINE_BIND_POINT_GRAPHICS, 0, descriptorSet.getDescriptorSets(), std::vector<uint32_t>()));
+    commands.emplace_back(std::make_unique<Vulkan::CommandBindIndexBuffer>(ibo, 0, VK_INDEX_TYPE_UINT32));
+    ASSERT_NO_THROW(meshIndirect.makeDrawCommands(device, commands, 1));
+    commands.emplace_back(std::make_unique<Vulkan::CommandEndRenderPass>());
+    {
+        Vulkan::CommandPipelineBarrier::MemoryBarriers barriers
+        {
+            { VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT }
+        };
+        commands.emplace_back(std::make_unique<Vulkan::CommandPipelineBarrier>(VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                                                                               std::move(barriers), Vulkan::CommandPipelineBarrier::BufferMemoryBarriers(), Vulkan::CommandPipelineBarrier::ImageMemoryBarriers()));
+    }
+
+    auto pool = std::make_shared<Vulkan::CommandPool>();
+    ASSERT_NO_THROW(pool->initialize(device, device.getQueueFamilyGraphicId()));
+    auto commandBuffer = std::make_shared<Vulkan::CommandBuffer>();
+    ASSERT_NO_THROW(commandBuffer->initialize(device, pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 0));
+    commandBuffer->addCommands(std::move(commands));
+    ASSERT_NO_THROW(commandBuffer->execute());
+    ASSERT_NO_THROW(device.executeCommandSync({ commandBuffer }));
+
+    // Slots of draws are marked with their mesh, others are untouched
+    const auto readDrawn = [&]()
+    {
+        std::vector<uint32_t> slots(maxInstances);
+        drawn->getMemory().map(device);
+        const auto* data = drawn->getMemory().getMappedMemory<uint32_t>();
+        std::copy(data, data + slots.size(), slots.begin());
+        drawn->getMemory().unmap(device);
+        return slots;
+    };
+    std::vector<uint32_t> expected(maxInstances, 0);
+    auto itVisible = result._visibles.cbegin();
+    for (const auto& draw : result._commands)
+    {
+        for (uint32_t slot = draw.firstInstance; slot < draw.firstInstance + draw.instanceCount; ++slot, ++itVisible)
+        {
+            expected[slot] = itVisible->_meshID + 1;
+        }
+    }
+    EXPECT_EQ(expected, readDrawn());
+
+    // Nothing visible: count is 0, so old commands are not drawn again (same recording)
+    drawn->getMemory().map(device);
+    std::fill_n(drawn->getMemory().getMappedMemory<uint32_t>(), maxInstances, 0u);
+    drawn->getMemory().unmap(device);
+    frustum.update(glm::ortho(-4.5f, 4.5f, -4.5f, 4.5f, 0.1f, 2.0f));
+    ASSERT_NO_THROW(meshIndirect.setFrustum(device, frustum));
+    ASSERT_NO_THROW(commandBuffer->execute());
+    ASSERT_NO_THROW(device.executeCommandSync({ commandBuffer }));
+    EXPECT_EQ(empty, readDrawn());
+
+    ASSERT_NO_THROW(commandBuffer->release(device));
+    ASSERT_NO_THROW(pool->release(device));
+    ASSERT_NO_THROW(pipeline->release(device));
+    ASSERT_NO_THROW(pipelineLayout->release(device));
+    ASSERT_NO_THROW(frameBuffer->release(device));
+    ASSERT_NO_THROW(renderPass->release(device));
+    ASSERT_NO_THROW(image.release(device));
+    ASSERT_NO_THROW(descriptorSet.release(device));
+    ASSERT_NO_THROW(descriptorPool->release(device));
+    ASSERT_NO_THROW(descriptorSetLayout.release(device));
+    ASSERT_NO_THROW(drawn->release(device));
+    ASSERT_NO_THROW(ibo->release(device));
+    ASSERT_NO_THROW(meshIndirect.release(device));
+    vertex->release(device);
+    culling->release(device);
+    massive.release();
+}
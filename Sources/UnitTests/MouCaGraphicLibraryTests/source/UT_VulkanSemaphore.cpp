@@ -5,6 +5,7 @@
 #include <LibVulkan/include/VKEnvironment.h>
 #include <LibVulkan/include/VKDevice.h>
 #include <LibVulkan/include/VKSemaphore.h>
+#include <LibVulkan/include/VKSequence.h>
 
 class VulkanSemaphore : public ::testing::Test
 {
@@ -15,7 +16,7 @@ protected:
     static void SetUpTestSuite()
     {
         ASSERT_NO_THROW(environment.initialize(g_info));
-        ASSERT_NO_THROW(device.initializeBestGPU(environment));
+        ASSERT_NO_THROW(device.initializeBestGPU(environment, {}, nullptr, {}, g_deviceTypes));
     }
 
     static void TearDownTestSuite()
@@ -48,4 +49,84 @@ TEST_F(VulkanSemaphore, initialize)
     ASSERT_NO_THROW(semaphore.release(device));
 
     ASSERT_TRUE(semaphore.isNull());
-}
\ No newline at end of file
+}
+
+TEST_F(VulkanSemaphore, timeline)
+{
+    ASSERT_TRUE(device.isTimelineSemaphoreEnabled());
+
+    auto semaphore = std::make_shared<Vulkan::Semaphore>();
+    ASSERT_NO_THROW(semaphore->initialize(device, VK_SEMAPHORE_TYPE_TIMELINE, 5));
+    ASSERT_TRUE(semaphore->isTimeline());
+    EXPECT_EQ(5, semaphore->getValue(device));
+    EXPECT_EQ(5, semaphore->getScheduledValue());
+
+    // Next value is reserved but not signaled
+    EXPECT_EQ(6, semaphore->scheduleSignal());
+    EXPECT_EQ(VK_TIMEOUT, semaphore->wait(device, 6, 0));
+
+    // Host waits latest scheduled value
+    Vulkan::SequenceWaitSemaphore waitSequence({ semaphore }, {}, 0);
+    EXPECT_EQ(VK_TIMEOUT, waitSequence.execute(device));
+
+    ASSERT_NO_THROW(semaphore->signal(device, 6));
+    EXPECT_EQ(6, semaphore->getValue(device));
+    EXPECT_EQ(VK_SUCCESS, semaphore->wait(device, 6, 0));
+    EXPECT_EQ(VK_SUCCESS, waitSequence.execute(device));
+
+    // Explicit value keeps latest one
+    semaphore->scheduleSignal(3);
+    EXPECT_EQ(6, semaphore->getScheduledValue());
+
+    ASSERT_NO_THROW(semaphore->release(device));
+    ASSERT_FALSE(semaphore->isTimeline());
+}
+
+TEST_F(VulkanSemaphore, timelineQueues)
+{
+    ASSERT_TRUE(device.isTimelineSemaphoreEnabled());
+
+    auto semaphore = std::make_shared<Vulkan::Semaphore>();
+    ASSERT_NO_THROW(semaphore->initialize(device, VK_SEMAPHORE_TYPE_TIMELINE, 0));
+
+    // Compute queue waits host (1) then signals 2
+    const uint64_t hostValue    = semaphore->scheduleSignal();
+    const uint64_t computeValue = semaphore->scheduleSignal();
+    const VkPipelineStageFlags stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    const VkTimelineSemaphoreSubmitInfo computeTimeline
+    {
+        VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO, nullptr, 1, &hostValue, 1, &computeValue
+    };
+    const VkSubmitInfo computeSubmit
+    {
+        VK_STRUCTURE_TYPE_SUBMIT_INFO, &computeTimeline, 1, &semaphore->getInstance(), &stage, 0, nullptr, 1, &semaphore->getInstance()
+    };
+    ASSERT_EQ(VK_SUCCESS, vkQueueSubmit(device.getQueue(Vulkan::Device::QueueType::Compute), 1, &computeSubmit, VK_NULL_HANDLE));
+
+    // Transfer queue waits compute (2) then signals 3: submitted before any signal (wait-before-signal)
+    const uint64_t transferValue = semaphore->scheduleSignal();
+    const VkTimelineSemaphoreSubmitInfo transferTimeline
+    {
+        VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO, nullptr, 1, &computeValue, 1, &transferValue
+    };
+    const VkSubmitInfo transferSubmit
+    {
+        VK_STRUCTURE_TYPE_SUBMIT_INFO, &transferTimeline, 1, &semaphore->getInstance(), &stage, 0, nullptr, 1, &semaphore->getInstance()
+    };
+    ASSERT_EQ(VK_SUCCESS, vkQueueSubmit(device.getQueue(Vulkan::Device::QueueType::Transfer), 1, &transferSubmit, VK_NULL_HANDLE));
+
+    // Nothing runs before host signal
+    EXPECT_EQ(0, semaphore->getValue(device));
+    EXPECT_EQ(VK_TIMEOUT, semaphore->wait(device, transferValue, 0));
+
+    ASSERT_NO_THROW(semaphore->signal(device, hostValue));
+
+    // Host waits latest point: both queues are finished
+    Vulkan::SequenceWaitSemaphore waitSequence({ semaphore }, {}, 1000000000ull);
+    ASSERT_EQ(VK_SUCCESS, waitSequence.execute(device));
+    EXPECT_EQ(transferValue, semaphore->getValue(device));
+    EXPECT_EQ(3, semaphore->getScheduledValue());
+
+    ASSERT_NO_THROW(device.waitIdle());
+    ASSERT_NO_THROW(semaphore->release(device));
+}
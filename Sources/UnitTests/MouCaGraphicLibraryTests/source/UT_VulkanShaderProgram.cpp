@@ -4,6 +4,7 @@
 
 #include "LibCore/include/CoreFile.h" 
 
+#include "LibVulkan/include/VKDeferredRelease.h"
 #include "LibVulkan/include/VKDevice.h"
 #include "LibVulkan/include/VKEnvironment.h"
 #include "LibVulkan/include/VKShaderProgram.h"
@@ -17,7 +18,7 @@ protected:
     static void SetUpTestSuite()
     {
         ASSERT_NO_THROW(environment.initialize(g_info));
-        ASSERT_NO_THROW(device.initializeBestGPU(environment));
+        ASSERT_NO_THROW(device.initializeBestGPU(environment, {}, nullptr, {}, g_deviceTypes));
     }
 
     static void TearDownTestSuite()
@@ -65,4 +66,30 @@ TEST_F(VulkanShaderProgram, badInitialize)
     ASSERT_THROW(program.initialize(device, badShaderFile, std::string("main")), Core::Exception);
 
     ASSERT_TRUE(program.isNull());
-}
\ No newline at end of file
+}
+
+TEST_F(VulkanShaderProgram, rebuild)
+{
+    Core::File shaderFile(MouCaEnvironment::getInputPath() / L"libraries" / L"vertex.spv");
+    ASSERT_NO_THROW(shaderFile.open());
+    const Core::String source = shaderFile.extractString();
+    shaderFile.close();
+
+    Vulkan::ShaderModule module;
+    ASSERT_NO_THROW(module.initialize(device, source, "main", VK_SHADER_STAGE_VERTEX_BIT));
+    const VkShaderModule oldModule = module.getInstance();
+
+    // New module is created alongside old one
+    Vulkan::DeferredRelease deferred(1);
+    ASSERT_NO_THROW(module.rebuild(device, source, deferred));
+    EXPECT_NE(oldModule, module.getInstance());
+    EXPECT_EQ(VK_SHADER_STAGE_VERTEX_BIT, module.getStage());
+    EXPECT_EQ(1, deferred.getNbPending());
+
+    // Old module is released after frame
+    ASSERT_NO_THROW(deferred.nextFrame(device));
+    EXPECT_EQ(0, deferred.getNbPending());
+
+    ASSERT_NO_THROW(module.release(device));
+    ASSERT_TRUE(module.isNull());
+}
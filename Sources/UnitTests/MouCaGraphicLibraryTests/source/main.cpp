@@ -1,5 +1,7 @@
 #include <Dependencies.h>
 
+#include <LibCore/include/CoreLogger.h>
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -8,5 +10,14 @@ int main(int argc, char** argv)
     environment->initialize(argc, argv);
     testing::AddGlobalTestEnvironment(environment);
 
-    return RUN_ALL_TESTS();
+    // CoreSystem of each test keeps these outputs (no MouCaLab.log into working folder)
+    Core::Logger::Configuration logger;
+    logger._filename = MouCaEnvironment::getOutputPath() / L"MouCaGraphicLibraryTests.log";
+    logger._console  = false;
+    Core::Logger::initialize(logger);
+
+    const int result = RUN_ALL_TESTS();
+
+    Core::Logger::release();
+    return result;
 }
\ No newline at end of file
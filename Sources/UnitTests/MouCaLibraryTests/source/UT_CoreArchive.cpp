@@ -0,0 +1,176 @@
+#include "Dependencies.h"
+
+#include <LibCore/include/CoreArchive.h>
+
+namespace Core
+{
+
+TEST(CoreArchive, stream)
+{
+    enum class Kind : uint16_t { First, Second = 300 };
+
+    const std::vector<float>  floats  = { 1.0f, 2.0f };
+    const std::vector<String> strings = { "a", "", "bc" };
+
+    ArchiveStream stream;
+    ASSERT_NO_THROW(stream << uint8_t(1) << int32_t(-2) << 3.5f << 4.25 << Kind::Second);
+    ASSERT_NO_THROW(stream << String("name") << floats << strings);
+    ASSERT_NO_THROW(stream.writeVarint(0));
+    ASSERT_NO_THROW(stream.writeVarint(300));
+    ASSERT_NO_THROW(stream.writeVarint(std::numeric_limits<uint64_t>::max()));
+
+    // Fixed little-endian layout
+    const auto* bytes = reinterpret_cast<const uint8_t*>(stream.getBuffer().getData());
+    EXPECT_EQ(0xFE, bytes[1]);
+    EXPECT_EQ(0xFF, bytes[4]);
+    EXPECT_EQ(0x2C, bytes[17]);
+    EXPECT_EQ(0x01, bytes[18]);
+    EXPECT_EQ(4,    bytes[19]);  // Varint size
+
+    ArchiveStream reader;
+    reader.readBuffer(stream.getBuffer().getData(), stream.size());
+    uint8_t  a;
+    int32_t  b;
+    float    c;
+    double   d;
+    Kind     e;
+    String   f;
+    std::vector<float>  g;
+    std::vector<String> h;
+    ASSERT_NO_THROW(reader >> a >> b >> c >> d >> e >> f >> g >> h);
+    EXPECT_EQ(1,            a);
+    EXPECT_EQ(-2,           b);
+    EXPECT_EQ(3.5f,         c);
+    EXPECT_EQ(4.25,         d);
+    EXPECT_EQ(Kind::Second, e);
+    EXPECT_EQ(String("name"), f);
+    EXPECT_EQ(floats,       g);
+    EXPECT_EQ(strings,      h);
+    EXPECT_EQ(0u,   reader.readVarint());
+    EXPECT_EQ(300u, reader.readVarint());
+    EXPECT_EQ(std::numeric_limits<uint64_t>::max(), reader.readVarint());
+    EXPECT_TRUE(reader.isEnd());
+
+    // Overflow
+    EXPECT_ANY_THROW(reader >> a);
+
+    // Corrupted size
+    ArchiveStream corrupted;
+    corrupted.writeVarint(1000);
+    ArchiveStream corruptedReader;
+    corruptedReader.readBuffer(corrupted.getBuffer().getData(), corrupted.size());
+    EXPECT_ANY_THROW(corruptedReader >> g);
+}
+
+TEST(CoreArchive, lz4)
+{
+    std::vector<uint8_t> raw;
+    for (uint32_t id = 0; id < 100000; ++id)
+    {
+        raw.emplace_back(static_cast<uint8_t>((id % 251) ^ (id / 1000)));
+    }
+
+    for (const size_t size : { size_t(0), size_t(5), size_t(13), raw.size() })
+    {
+        const auto compressed = Archive::compressLZ4(raw.data(), size);
+        std::vector<uint8_t> decompressed(size);
+        ASSERT_NO_THROW(Archive::decompressLZ4(compressed.data(), compressed.size(), decompressed.data(), decompressed.size()));
+        EXPECT_TRUE(std::equal(decompressed.cbegin(), decompressed.cend(), raw.cbegin()));
+        if (size == raw.size())
+        {
+            EXPECT_GT(raw.size() / 4, compressed.size());
+            std::vector<uint8_t> tooSmall(size - 1);
+            EXPECT_ANY_THROW(Archive::decompressLZ4(compressed.data(), compressed.size(), tooSmall.data(), tooSmall.size()));
+            EXPECT_ANY_THROW(Archive::decompressLZ4(compressed.data(), compressed.size() / 2, decompressed.data(), decompressed.size()));
+        }
+    }
+}
+
+TEST(CoreArchive, writeRead)
+{
+    const std::vector<float> vertices(10000, 1.5f);
+    const std::vector<String> names = { "glyph", "outline" };
+
+    ArchiveWriter writer;
+    {
+        ArchiveStream mesh;
+        mesh << vertices;
+        ASSERT_NO_THROW(writer.addSection("mesh", 2, mesh, Archive::Compression::LZ4));
+
+        ArchiveStream glyphs;
+        glyphs << names;
+        ASSERT_NO_THROW(writer.addSection("glyphs", 1, glyphs));
+    }
+
+    ByteBuffer memory;
+    ASSERT_NO_THROW(writer.write(memory));
+    EXPECT_GT(vertices.size() * sizeof(float) / 10, memory.size());
+
+    const Path filename = MouCaEnvironment::getOutputPath() / L"archive.mcar";
+    ASSERT_NO_THROW(writer.save(filename));
+
+    // Random access from memory and from file
+    for (const bool fromFile : { false, true })
+    {
+        ArchiveReader reader;
+        if (fromFile)
+        {
+            ASSERT_NO_THROW(reader.open(filename));
+        }
+        else
+        {
+            ASSERT_NO_THROW(reader.open(memory.getData(), memory.size()));
+        }
+        EXPECT_EQ(std::vector<String>({ "glyphs", "mesh" }), reader.getSectionNames());
+        EXPECT_FALSE(reader.hasSection("unknown"));
+        EXPECT_EQ(2u, reader.getVersion("mesh"));
+        EXPECT_EQ(1u, reader.getVersion("glyphs"));
+
+        ArchiveStream glyphs;
+        ASSERT_NO_THROW(reader.readSection("glyphs", glyphs));
+        std::vector<String> readNames;
+        ASSERT_NO_THROW(glyphs >> readNames);
+        EXPECT_EQ(names, readNames);
+
+        ArchiveStream mesh;
+        ASSERT_NO_THROW(reader.readSection("mesh", mesh));
+        std::vector<float> readVertices;
+        ASSERT_NO_THROW(mesh >> readVertices);
+        EXPECT_EQ(vertices, readVertices);
+        EXPECT_TRUE(mesh.isEnd());
+
+        ASSERT_NO_THROW(reader.close());
+        EXPECT_TRUE(reader.isNull());
+    }
+
+    // Corrupted data
+    {
+        std::vector<uint8_t> corrupted(reinterpret_cast<const uint8_t*>(memory.getData()), reinterpret_cast<const uint8_t*>(memory.getData()) + memory.size());
+        corrupted[Archive::headerSize + 2] ^= 0xFF;
+
+        ArchiveReader reader;
+        ASSERT_NO_THROW(reader.open(corrupted.data(), corrupted.size()));
+        ArchiveStream mesh;
+        EXPECT_ANY_THROW(reader.readSection("mesh", mesh));
+        reader.close();
+
+        EXPECT_ANY_THROW(reader.open(corrupted.data(), corrupted.size() - 1));
+        EXPECT_TRUE(reader.isNull());
+    }
+
+    // Corrupted table: offset + size overflows to expected end
+    {
+        std::vector<uint8_t> corrupted(reinterpret_cast<const uint8_t*>(memory.getData()), reinterpret_cast<const uint8_t*>(memory.getData()) + memory.size());
+        const uint32_t tableSize   = std::numeric_limits<uint32_t>::max();
+        const uint64_t tableOffset = static_cast<uint64_t>(corrupted.size() - Archive::footerSize) - tableSize;
+        ArchiveStream footer;
+        footer << tableOffset << tableSize;
+        memcpy(&corrupted[corrupted.size() - Archive::footerSize], footer.getBuffer().getData(), footer.size());
+
+        ArchiveReader reader;
+        EXPECT_ANY_THROW(reader.open(corrupted.data(), corrupted.size()));
+        EXPECT_TRUE(reader.isNull());
+    }
+}
+
+}
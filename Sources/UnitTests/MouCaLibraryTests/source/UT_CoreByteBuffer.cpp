@@ -72,4 +72,63 @@ TEST(CoreByteBuffer, standardUse)
         EXPECT_EQ(b,        br);
         EXPECT_EQ(c,        cr);
     }
-}
\ No newline at end of file
+}
+
+TEST(CoreByteBuffer, bulk)
+{
+    struct Vertex
+    {
+        float    _position[3];
+        uint32_t _color;
+    };
+    const std::vector<Vertex> vertices = { { { 1.0f, 2.0f, 3.0f }, 0xFF00FF00 }, { { 4.0f, 5.0f, 6.0f }, 0x00FF00FF } };
+    const std::vector<Core::String> names = { "first", "", "third" };
+    const std::array<int, 3> indices = { 7, 8, 9 };
+
+    Core::ByteBuffer buffer;
+    buffer.reserve(256);
+    EXPECT_LE(256u, buffer.capacity());
+
+    // Raw vector/span and per-element vector share same format
+    ASSERT_NO_THROW(buffer << vertices << names << std::span<const int>(indices));
+    const size_t bufferSize = 6 * sizeof(size_t) + sizeof(Vertex) * vertices.size() + 10 + sizeof(int) * indices.size();
+    EXPECT_EQ(bufferSize, buffer.size());
+
+    // Writer: grow over hint then truncate to written data
+    const size_t writerSize = sizeof(int) + 2 * sizeof(size_t) + 6 + sizeof(Vertex) * vertices.size();
+    {
+        Core::ByteBuffer::Writer writer(buffer, 4);
+        ASSERT_NO_THROW(writer << 42 << Core::String("writer") << vertices);
+        EXPECT_EQ(bufferSize + writerSize, writer.getCursor());
+    }
+    EXPECT_EQ(bufferSize + writerSize, buffer.size());
+
+    std::vector<Vertex>       rVertices;
+    std::vector<Core::String> rNames;
+    std::array<int, 3>        rIndices;
+    int                       rValue;
+    Core::String              rString;
+    std::vector<Vertex>       rVerticesWriter;
+    ASSERT_NO_THROW(buffer >> rVertices >> rNames >> std::span<int>(rIndices));
+    ASSERT_NO_THROW(buffer >> rValue >> rString >> rVerticesWriter);
+
+    ASSERT_EQ(vertices.size(), rVertices.size());
+    EXPECT_EQ(0, memcmp(vertices.data(), rVertices.data(), sizeof(Vertex) * vertices.size()));
+    EXPECT_EQ(0, memcmp(vertices.data(), rVerticesWriter.data(), sizeof(Vertex) * vertices.size()));
+    EXPECT_EQ(names,    rNames);
+    EXPECT_EQ(indices,  rIndices);
+    EXPECT_EQ(42,       rValue);
+    EXPECT_EQ(Core::String("writer"), rString);
+
+    // Mutable and fixed extent spans are written by elements too (not as span object)
+    std::array<int, 3> mutableIndices = indices;
+    Core::ByteBuffer spans;
+    ASSERT_NO_THROW(spans << std::span<int>(mutableIndices) << std::span<const int, 3>(indices));
+    EXPECT_EQ(2 * (sizeof(size_t) + sizeof(int) * indices.size()), spans.size());
+
+    std::vector<int>   rMutable;
+    std::array<int, 3> rFixed;
+    ASSERT_NO_THROW(spans >> rMutable >> std::span<int, 3>(rFixed));
+    EXPECT_EQ(std::vector<int>(indices.cbegin(), indices.cend()), rMutable);
+    EXPECT_EQ(indices, rFixed);
+}
@@ -0,0 +1,159 @@
+#include "Dependencies.h"
+
+#include <LibCore/include/CoreLogger.h>
+
+namespace Core
+{
+
+namespace
+{
+    std::vector<String> readLines(const Path& filename)
+    {
+        std::vector<String> lines;
+        std::ifstream file(filename);
+        String line;
+        while (std::getline(file, line))
+        {
+            lines.emplace_back(line);
+        }
+        return lines;
+    }
+}
+
+TEST(CoreLogger, filter)
+{
+    Logger::setLevel(Logger::Severity::Warning);
+    Logger::setLevel(Logger::Category::Vulkan, Logger::Severity::Error);
+
+    EXPECT_FALSE(Logger::isEnabled(Logger::Category::Loader, Logger::Severity::Info));
+    EXPECT_TRUE(Logger::isEnabled(Logger::Category::Loader,  Logger::Severity::Warning));
+    EXPECT_FALSE(Logger::isEnabled(Logger::Category::Vulkan, Logger::Severity::Warning));
+    EXPECT_TRUE(Logger::isEnabled(Logger::Category::Vulkan,  Logger::Severity::Critical));
+
+    // Filtered record doesn't evaluate arguments
+    size_t nbCalls = 0;
+    const auto argument = [&]() { ++nbCalls; return nbCalls; };
+    MOUCA_LOG_INFO(Loader, "Filtered {}", argument());
+    MOUCA_LOG_WARNING(Vulkan, "Filtered {}", argument());
+    EXPECT_EQ(0u, nbCalls);
+
+    Logger::setLevel(Logger::Severity::Info);
+}
+
+TEST(CoreLogger, file)
+{
+    const Path filename = MouCaEnvironment::getOutputPath() / L"logger.log";
+    std::filesystem::remove(filename);
+
+    Logger::Configuration configuration;
+    configuration._filename = filename;
+    configuration._console  = false;
+    ASSERT_NO_THROW(Logger::initialize(configuration));
+    ASSERT_TRUE(Logger::isInitialized());
+    const auto statistics = Logger::getStatistics();
+
+    // Arguments are copied: formatting is done later
+    String value("Before");
+    MOUCA_LOG_INFO(Core, "Value={} Number={}", value, 42);
+    value = "After";
+
+    const size_t nbThreads = 4;
+    const size_t nbRecords = 200;
+    std::vector<std::thread> threads;
+    for (size_t id = 0; id < nbThreads; ++id)
+    {
+        threads.emplace_back([id]()
+        {
+            for (size_t record = 0; record < nbRecords; ++record)
+            {
+                MOUCA_LOG_INFO(Loader, "Thread {} record {}", id, record);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    MOUCA_LOG_ERROR(Media, "Failure");
+
+    Logger::flush();
+    EXPECT_EQ(statistics._written + nbThreads * nbRecords + 2, Logger::getStatistics()._written);
+    EXPECT_EQ(statistics._dropped, Logger::getStatistics()._dropped);
+    Logger::release();
+    EXPECT_FALSE(Logger::isInitialized());
+
+    const auto lines = readLines(filename);
+    ASSERT_EQ(nbThreads * nbRecords + 2, lines.size());
+    EXPECT_TRUE(lines.front().find("[INFO ] [Core] [") != String::npos);
+    EXPECT_TRUE(lines.front().find("Value=Before Number=42") != String::npos);
+    EXPECT_TRUE(lines.back().find("[ERROR] [Media]") != String::npos);
+    EXPECT_TRUE(lines.back().find("UT_CoreLogger.cpp") != String::npos);
+}
+
+TEST(CoreLogger, nestedInitialize)
+{
+    const Path filename = MouCaEnvironment::getOutputPath() / L"nested.log";
+    const Path ignored  = MouCaEnvironment::getOutputPath() / L"ignored.log";
+    std::filesystem::remove(filename);
+    std::filesystem::remove(ignored);
+
+    Logger::Configuration configuration;
+    configuration._filename = filename;
+    configuration._console  = false;
+    ASSERT_NO_THROW(Logger::initialize(configuration));
+
+    // Second user (like CoreSystem into tests) keeps outputs of first one
+    Logger::Configuration other;
+    other._filename = ignored;
+    ASSERT_NO_THROW(Logger::initialize(other));
+    MOUCA_LOG_INFO(General, "First");
+    Logger::release();
+    EXPECT_TRUE(Logger::isInitialized());
+
+    MOUCA_LOG_INFO(General, "Second");
+    Logger::release();
+    EXPECT_FALSE(Logger::isInitialized());
+
+    EXPECT_FALSE(std::filesystem::exists(ignored));
+    const auto lines = readLines(filename);
+    ASSERT_EQ(2u, lines.size());
+    EXPECT_TRUE(lines.front().find("First") != String::npos);
+    EXPECT_TRUE(lines.back().find("Second") != String::npos);
+}
+
+TEST(CoreLogger, rotation)
+{
+    const Path filename = MouCaEnvironment::getOutputPath() / L"rotation.log";
+    const Path rotated1 = MouCaEnvironment::getOutputPath() / L"rotation.1.log";
+    const Path rotated2 = MouCaEnvironment::getOutputPath() / L"rotation.2.log";
+    const Path rotated3 = MouCaEnvironment::getOutputPath() / L"rotation.3.log";
+    for (const auto& path : { filename, rotated1, rotated2, rotated3 })
+    {
+        std::filesystem::remove(path);
+    }
+
+    Logger::Configuration configuration;
+    configuration._filename    = filename;
+    configuration._console     = false;
+    configuration._maxFileSize = 1024;
+    configuration._nbFiles     = 2;
+    ASSERT_NO_THROW(Logger::initialize(configuration));
+    for (size_t record = 0; record < 100; ++record)
+    {
+        MOUCA_LOG_INFO(General, "Record {}", record);
+    }
+    Logger::release();
+
+    EXPECT_TRUE(std::filesystem::exists(filename));
+    EXPECT_TRUE(std::filesystem::exists(rotated1));
+    EXPECT_TRUE(std::filesystem::exists(rotated2));
+    EXPECT_FALSE(std::filesystem::exists(rotated3));
+    EXPECT_GE(1024u, std::filesystem::file_size(rotated1));
+
+    // Last record is into current file
+    const auto lines = readLines(filename);
+    ASSERT_FALSE(lines.empty());
+    EXPECT_TRUE(lines.back().find("Record 99") != String::npos);
+}
+
+}
@@ -0,0 +1,101 @@
+#include "Dependencies.h"
+
+#include <LibCore/include/CoreAsyncFileReader.h>
+#include <LibCore/include/CoreMappedFile.h>
+
+namespace Core
+{
+
+namespace
+{
+    Path createFile(const Path& name, const size_t size)
+    {
+        const Path filename = MouCaEnvironment::getOutputPath() / name;
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        for (size_t id = 0; id < size; ++id)
+        {
+            file.put(static_cast<char>(id % 251));
+        }
+        return filename;
+    }
+}
+
+TEST(CoreMappedFile, view)
+{
+    const size_t size = 100000;
+    const Path filename = createFile(L"mapped.bin", size);
+
+    MappedFile file(filename);
+    ASSERT_NO_THROW(file.open(MappedFile::Advice::Sequential));
+    EXPECT_TRUE(file.isLoaded());
+    EXPECT_EQ(size, file.getSize());
+
+    std::span<const uint8_t> view;
+    ASSERT_NO_THROW(view = file.getView(70000, 10));
+    EXPECT_EQ(10u,               view.size());
+    EXPECT_EQ(70000 % 251,       view[0]);
+    EXPECT_EQ((70000 + 9) % 251, view[9]);
+
+    // Whole file and outside
+    EXPECT_NO_THROW(file.getView(0, size));
+    EXPECT_NO_THROW(file.getView(size, 0));
+    EXPECT_ANY_THROW(file.getView(size - 1, 2));
+    EXPECT_ANY_THROW(file.getView(size + 1, 0));
+
+    // Hints on unaligned range
+    EXPECT_NO_THROW(file.advise(MappedFile::Advice::WillNeed, 5000, 100));
+    EXPECT_NO_THROW(file.advise(MappedFile::Advice::DontNeed));
+
+    file.release();
+    EXPECT_FALSE(file.isLoaded());
+
+    // Empty file
+    MappedFile empty(createFile(L"mappedEmpty.bin", 0));
+    ASSERT_NO_THROW(empty.open());
+    EXPECT_EQ(0u, empty.getSize());
+    EXPECT_EQ(nullptr, empty.getData());
+    EXPECT_ANY_THROW(empty.getView(0, 1));
+
+    // Unknown file
+    MappedFile unknown(MouCaEnvironment::getOutputPath() / L"UnknownFileName.bin");
+    EXPECT_ANY_THROW(unknown.open());
+    EXPECT_FALSE(unknown.isLoaded());
+}
+
+TEST(CoreAsyncFileReader, batch)
+{
+    const size_t size = 50000;
+    const Path filename = createFile(L"asyncRead.bin", size);
+
+    AsyncFileReader reader;
+    ASSERT_NO_THROW(reader.initialize(2));
+
+    // Unsorted ranges with one after end of file
+    std::vector<uint8_t> first(1000), second(10), last(100);
+    AsyncFileReader::Batch batch =
+    {
+        { 30000,     first.size(),  first.data()  },
+        { 10,        second.size(), second.data() },
+        { size - 40, last.size(),   last.data()   }
+    };
+    auto pending = reader.read(filename, std::move(batch));
+
+    // Error is given to caller by future
+    auto failed = reader.read(MouCaEnvironment::getOutputPath() / L"UnknownFileName.bin", AsyncFileReader::Batch());
+
+    ASSERT_NO_THROW(batch = pending.get());
+    ASSERT_EQ(3u, batch.size());
+    EXPECT_EQ(first.size(),  batch[0]._read);
+    EXPECT_EQ(second.size(), batch[1]._read);
+    EXPECT_EQ(40u,           batch[2]._read);
+    EXPECT_EQ(30000 % 251,      first[0]);
+    EXPECT_EQ(10 % 251,         second[0]);
+    EXPECT_EQ((size - 1) % 251, last[39]);
+
+    EXPECT_ANY_THROW(failed.get());
+
+    ASSERT_NO_THROW(reader.release());
+    EXPECT_TRUE(reader.isNull());
+}
+
+}
@@ -0,0 +1,129 @@
+#include "Dependencies.h"
+
+#include <LibCore/include/CoreMemory.h>
+
+namespace Core
+{
+
+TEST(CoreMemory, arena)
+{
+    LinearArena arena(256);
+    EXPECT_EQ(0u, arena.getCapacity());
+
+    // Alignment
+    auto* byte   = static_cast<std::byte*>(arena.allocate(1, 1));
+    auto* value  = static_cast<double*>(arena.allocate(sizeof(double), alignof(double)));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(value) % alignof(double));
+    EXPECT_TRUE(reinterpret_cast<std::byte*>(value) > byte);
+    EXPECT_EQ(1u, arena.getNbChunks());
+
+    // Scope releases its allocations
+    const auto marker = arena.getMarker();
+    {
+        ArenaScope scope(arena);
+        auto* inside = arena.allocate(64, 16);
+        EXPECT_TRUE(inside != nullptr);
+    }
+    EXPECT_EQ(marker._chunk,  arena.getMarker()._chunk);
+    EXPECT_EQ(marker._offset, arena.getMarker()._offset);
+
+    // Big allocations create new chunks
+    arena.allocate(300, 8);
+    arena.allocate(1000, 8);
+    EXPECT_EQ(3u, arena.getNbChunks());
+    const size_t capacity = arena.getCapacity();
+
+    // Reset merges chunks: same work is done in one chunk
+    arena.reset();
+    EXPECT_EQ(1u,       arena.getNbChunks());
+    EXPECT_EQ(capacity, arena.getCapacity());
+    arena.allocate(1, 1);
+    arena.allocate(sizeof(double), alignof(double));
+    arena.allocate(300, 8);
+    arena.allocate(1000, 8);
+    EXPECT_EQ(1u, arena.getNbChunks());
+
+    arena.release();
+    EXPECT_EQ(0u, arena.getCapacity());
+}
+
+TEST(CoreMemory, steadyState)
+{
+    const auto frame = []()
+    {
+        ArenaScope scope;
+        std::pmr::vector<uint32_t> indices(&scope.getArena());
+        for (uint32_t id = 0; id < 10000; ++id)
+        {
+            indices.emplace_back(id);
+        }
+        std::pmr::string label("Transient label which doesn't fit into small buffer", &scope.getArena());
+        EXPECT_EQ(9999u, indices.back());
+    };
+
+    // Warm-up: arena grows then merges its chunks
+    frame();
+    frame();
+
+    const auto before = Memory::getStatistics();
+    for (size_t id = 0; id < 100; ++id)
+    {
+        frame();
+    }
+    const auto after = Memory::getStatistics();
+    EXPECT_EQ(before._nbAllocations,   after._nbAllocations);
+    EXPECT_EQ(before._nbDeallocations, after._nbDeallocations);
+}
+
+TEST(CoreMemory, pool)
+{
+    struct Object
+    {
+        std::array<uint64_t, 5> _data;
+    };
+
+    const auto start = Memory::getStatistics();
+    {
+        PoolResource pool(sizeof(Object), 4);
+        EXPECT_EQ(0u, pool.getBlockSize() % alignof(std::max_align_t));
+
+        // Blocks are reused
+        std::pmr::polymorphic_allocator<Object> allocator(&pool);
+        Object* first = allocator.allocate(1);
+        allocator.deallocate(first, 1);
+        Object* second = allocator.allocate(1);
+        EXPECT_EQ(first, second);
+        allocator.deallocate(second, 1);
+        EXPECT_EQ(start._nbAllocations + 1, Memory::getStatistics()._nbAllocations);
+
+        // Concurrent objects
+        std::vector<std::thread> threads;
+        for (size_t id = 0; id < 4; ++id)
+        {
+            threads.emplace_back([&]()
+            {
+                for (size_t loop = 0; loop < 1000; ++loop)
+                {
+                    auto object = std::allocate_shared<Object>(allocator);
+                    object->_data.fill(loop);
+                    EXPECT_EQ(loop, object->_data.back());
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        EXPECT_EQ(0u, pool.getNbUsed());
+
+        // Too big: forwarded to upstream
+        void* big = pool.allocate(pool.getBlockSize() * 2);
+        EXPECT_EQ(0u, pool.getNbUsed());
+        pool.deallocate(big, pool.getBlockSize() * 2);
+    }
+    const auto end = Memory::getStatistics();
+    EXPECT_EQ(start._allocatedBytes, end._allocatedBytes);
+    EXPECT_EQ(end._nbAllocations - start._nbAllocations, end._nbDeallocations - start._nbDeallocations);
+}
+
+}
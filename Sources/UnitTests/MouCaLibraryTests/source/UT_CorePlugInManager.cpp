@@ -2,6 +2,7 @@
 
 #include "LibCore/include/CorePluginEntry.h"
 #include "LibCore/include/CorePluginManager.h"
+#include "LibCore/include/CoreThreadPools.h"
 
 TEST(CorePluginManager, LoadUnexistingPlugIn)
 {
@@ -33,4 +34,105 @@ TEST(CorePluginManager, LoadExistingPlugIn)
         EXPECT_NO_THROW(plugInReloaded = manager.loadDynamicLibrary(MouCaEnvironment::getWorkingPath() / L"MouCaPlugInTest.dll"));
         EXPECT_EQ(plugIn, plugInReloaded);
     }
-}
\ No newline at end of file
+}
+namespace
+{
+    void writeManifest(const Core::Path& filename, const Core::String& content)
+    {
+        std::ofstream file(filename);
+        file << content;
+    }
+}
+
+TEST(CorePluginManager, manifest)
+{
+    const Core::Path folder  = MouCaEnvironment::getOutputPath() / L"PlugIns";
+    const Core::String library = (MouCaEnvironment::getWorkingPath() / L"MouCaPlugInTest.dll").string();
+    std::filesystem::remove_all(folder);
+    std::filesystem::create_directories(folder);
+    writeManifest(folder / L"Base.plugin",  "# Test plugin\nname=Base\nlibrary=" + library + "\nversion=1.0\n");
+    writeManifest(folder / L"Child.plugin", "name = Child\nlibrary = " + library + "\ndependencies = Base\n");
+    writeManifest(folder / L"Other.plugin", "name=Other\nlibrary=" + library + "\n");
+
+    Core::PlugInManager manager;
+    ASSERT_EQ(3u, manager.registerFolder(folder));
+
+    // Nothing is loaded before use
+    EXPECT_FALSE(manager.isLoaded("Base"));
+    EXPECT_EQ(Core::String("1.0"), manager.getInformation("Base")._version);
+    ASSERT_EQ(1u,                  manager.getInformation("Child")._dependencies.size());
+    EXPECT_EQ(Core::String("Base"), manager.getInformation("Child")._dependencies.front());
+    EXPECT_ANY_THROW(manager.getInformation("Unknown"));
+    EXPECT_ANY_THROW(manager.registerPlugIn(folder / L"Base.plugin"));
+
+    // Dependencies are loaded first
+    Core::PlugInEntrySPtr plugIn;
+    ASSERT_NO_THROW(plugIn = manager.getPlugIn("Child"));
+    EXPECT_TRUE(plugIn != nullptr);
+    EXPECT_TRUE(manager.isLoaded("Base"));
+    EXPECT_TRUE(manager.isLoaded("Child"));
+    EXPECT_FALSE(manager.isLoaded("Other"));
+    EXPECT_EQ(plugIn, manager.getPlugIn("Child"));
+
+    const auto reports = manager.getLoadingReports();
+    ASSERT_EQ(2u, reports.size());
+    EXPECT_EQ(Core::String("Base"),  reports[0]._name);
+    EXPECT_EQ(Core::String("Child"), reports[1]._name);
+    EXPECT_LE(0.0, reports[0]._loadingTime);
+
+    EXPECT_ANY_THROW(manager.getPlugIn("Unknown"));
+    plugIn.reset();
+}
+
+TEST(CorePluginManager, invalidManifest)
+{
+    const Core::Path folder  = MouCaEnvironment::getOutputPath() / L"PlugInsInvalid";
+    std::filesystem::remove_all(folder);
+    std::filesystem::create_directories(folder);
+    writeManifest(folder / L"NoLibrary.plugin", "name=NoLibrary\n");
+    writeManifest(folder / L"Syntax.plugin",    "name\n");
+    writeManifest(folder / L"A.plugin",         "name=A\nlibrary=MouCaPlugInTest.dll\ndependencies=B\n");
+    writeManifest(folder / L"B.plugin",         "name=B\nlibrary=MouCaPlugInTest.dll\ndependencies=A\n");
+    writeManifest(folder / L"C.plugin",         "name=C\nlibrary=MouCaPlugInTest.dll\ndependencies=Missing\n");
+
+    Core::PlugInManager manager;
+    EXPECT_ANY_THROW(manager.registerPlugIn(folder / L"NoLibrary.plugin"));
+    EXPECT_ANY_THROW(manager.registerPlugIn(folder / L"Syntax.plugin"));
+    EXPECT_ANY_THROW(manager.registerPlugIn(folder / L"Unknown.plugin"));
+
+    // Cycle and missing dependency are detected before loading
+    ASSERT_NO_THROW(manager.registerPlugIn(folder / L"A.plugin"));
+    ASSERT_NO_THROW(manager.registerPlugIn(folder / L"B.plugin"));
+    ASSERT_NO_THROW(manager.registerPlugIn(folder / L"C.plugin"));
+    EXPECT_ANY_THROW(manager.getPlugIn("A"));
+    EXPECT_ANY_THROW(manager.getPlugIn("C"));
+    EXPECT_FALSE(manager.isLoaded("A"));
+}
+
+TEST(CorePluginManager, preloadAll)
+{
+    const Core::Path folder  = MouCaEnvironment::getOutputPath() / L"PlugInsParallel";
+    const Core::String library = (MouCaEnvironment::getWorkingPath() / L"MouCaPlugInTest.dll").string();
+    std::filesystem::remove_all(folder);
+    std::filesystem::create_directories(folder);
+    writeManifest(folder / L"Base.plugin",   "name=Base\nlibrary=" + library + "\n");
+    writeManifest(folder / L"Left.plugin",   "name=Left\nlibrary=" + library + "\ndependencies=Base\n");
+    writeManifest(folder / L"Right.plugin",  "name=Right\nlibrary=" + library + "\ndependencies=Base\n");
+    writeManifest(folder / L"Merge.plugin",  "name=Merge\nlibrary=" + library + "\ndependencies=Left,Right\n");
+
+    Core::ThreadPools pools;
+    pools.initializeWorkers(2);
+    {
+        Core::PlugInManager manager;
+        ASSERT_EQ(4u, manager.registerFolder(folder));
+        ASSERT_NO_THROW(manager.preloadAll(pools));
+
+        // Order respects dependencies
+        const auto reports = manager.getLoadingReports();
+        ASSERT_EQ(4u, reports.size());
+        EXPECT_EQ(Core::String("Base"),  reports.front()._name);
+        EXPECT_EQ(Core::String("Merge"), reports.back()._name);
+        EXPECT_TRUE(manager.isLoaded("Right"));
+    }
+    pools.releaseWorkers();
+}
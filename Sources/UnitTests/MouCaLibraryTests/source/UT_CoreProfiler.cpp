@@ -0,0 +1,123 @@
+#include "Dependencies.h"
+
+#include <LibCore/include/CoreProfiler.h>
+
+namespace Core
+{
+
+TEST(CoreProfiler, zones)
+{
+    Profiler::clear();
+
+    // Disabled: nothing is recorded
+    {
+        MOUCA_PROFILE_ZONE("Disabled");
+        Profiler::addCounter("Disabled", 1);
+    }
+    Profiler::markFrame();
+    EXPECT_TRUE(Profiler::collect().empty());
+
+    Profiler::enable(true);
+    Profiler::setThreadName("Main \"test\"");
+    Profiler::markFrame();
+    {
+        MOUCA_PROFILE_ZONE("Parent");
+        {
+            MOUCA_PROFILE_ZONE("Child");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        Profiler::addCounter("Items", 42);
+    }
+
+    // Other thread has its own buffer
+    std::thread worker([]()
+    {
+        MOUCA_PROFILE_ZONE("Worker");
+    });
+    worker.join();
+    Profiler::enable(false);
+
+    const auto events = Profiler::collect();
+    ASSERT_EQ(5u, events.size());
+    std::map<String, Profiler::Event> byName;
+    for (const auto& event : events)
+    {
+        byName[event._name] = event;
+    }
+    EXPECT_EQ(Profiler::Type::Frame,   byName["Frame"]._type);
+    EXPECT_EQ(1,                       byName["Frame"]._value);
+    EXPECT_EQ(Profiler::Type::Counter, byName["Items"]._type);
+    EXPECT_EQ(42,                      byName["Items"]._value);
+    EXPECT_LE(1000000,                 byName["Child"]._value);
+    EXPECT_LE(byName["Parent"]._begin, byName["Child"]._begin);
+    EXPECT_LE(byName["Child"]._value,  byName["Parent"]._value);
+    EXPECT_TRUE(byName["Worker"]._threadID != byName["Parent"]._threadID);
+
+    // Export
+    const Path filename = MouCaEnvironment::getOutputPath() / L"profiler.json";
+    ASSERT_NO_THROW(Profiler::exportChromeTrace(filename));
+    std::ifstream file(filename);
+    const String json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_TRUE(json.find("{\"traceEvents\":[") == 0);
+    EXPECT_TRUE(json.find("\"name\":\"Child\"") != String::npos);
+    EXPECT_TRUE(json.find("\"ph\":\"X\"") != String::npos);
+    EXPECT_TRUE(json.find("\"ph\":\"C\",\"args\":{\"value\":42}") != String::npos);
+    EXPECT_TRUE(json.find("Main \\\"test\\\"") != String::npos);
+
+    Profiler::clear();
+    EXPECT_TRUE(Profiler::collect().empty());
+}
+
+TEST(CoreProfiler, ring)
+{
+    Profiler::clear();
+    Profiler::enable(true);
+
+    // Oldest events are overwritten
+    for (size_t id = 0; id < Profiler::_capacity + 10; ++id)
+    {
+        Profiler::addCounter("Counter", static_cast<int64_t>(id));
+    }
+    Profiler::enable(false);
+
+    const auto events = Profiler::collect();
+    ASSERT_EQ(Profiler::_capacity, events.size());
+    EXPECT_EQ(10,                                         events.front()._value);
+    EXPECT_EQ(static_cast<int64_t>(Profiler::_capacity + 9), events.back()._value);
+
+    Profiler::clear();
+}
+
+TEST(CoreProfiler, threadExit)
+{
+    Profiler::clear();
+    const size_t nbThreads = Profiler::getNbThreads();
+
+    // Thread without event: buffer is removed at exit
+    std::thread silent([]()
+    {
+        Profiler::setThreadName("Silent");
+    });
+    silent.join();
+    EXPECT_EQ(nbThreads, Profiler::getNbThreads());
+
+    // Events of finished thread are kept until clear()
+    Profiler::enable(true);
+    std::thread worker([]()
+    {
+        MOUCA_PROFILE_ZONE("Worker");
+    });
+    worker.join();
+    Profiler::enable(false);
+    EXPECT_EQ(nbThreads + 1, Profiler::getNbThreads());
+
+    const auto events = Profiler::collect();
+    ASSERT_EQ(1u, events.size());
+    EXPECT_EQ(String("Worker"), events.front()._name);
+
+    Profiler::clear();
+    EXPECT_EQ(nbThreads, Profiler::getNbThreads());
+    EXPECT_TRUE(Profiler::collect().empty());
+}
+
+}
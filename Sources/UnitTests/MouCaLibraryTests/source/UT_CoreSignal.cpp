@@ -70,4 +70,61 @@ TEST(CoreSignal, checkAPI)
     EXPECT_EQ(valueFinal, receiverSPtr->_doIt);
 }
 
-}
\ No newline at end of file
+struct SelfDisconnect
+{
+    void doSomething(int number)
+    {
+        _doIt = number;
+        _signal->disconnect(this);
+    }
+
+    Core::Signal<int>* _signal = nullptr;
+    int _doIt = 0;
+};
+
+TEST(CoreSignal, snapshot)
+{
+    Core::Signal<int> mySignal;
+    SelfDisconnect first;
+    Receiver       second;
+    first._signal = &mySignal;
+    ASSERT_NO_THROW(mySignal.connectMember<SelfDisconnect>(&first, &SelfDisconnect::doSomething));
+    ASSERT_NO_THROW(mySignal.connectMember<Receiver>(&second, &Receiver::doSomething));
+
+    // Disconnection during emission: current emission is not modified
+    ASSERT_NO_THROW(mySignal.emit(1));
+    EXPECT_EQ(1, first._doIt);
+    EXPECT_EQ(1, second._doIt);
+    EXPECT_FALSE(mySignal.isConnected(&first));
+
+    ASSERT_NO_THROW(mySignal.emit(2));
+    EXPECT_EQ(1, first._doIt);
+    EXPECT_EQ(2, second._doIt);
+
+    // Connection by another thread during emissions
+    std::vector<Receiver> receivers(64);
+    std::atomic<bool> run = true;
+    std::thread emitter([&]()
+    {
+        do
+        {
+            mySignal.emit(3);
+        }
+        while (run);
+    });
+    for (auto& receiver : receivers)
+    {
+        mySignal.connectMember<Receiver>(&receiver, &Receiver::doSomething);
+    }
+    for (auto& receiver : receivers)
+    {
+        mySignal.disconnect(&receiver);
+    }
+    run = false;
+    emitter.join();
+
+    EXPECT_TRUE(mySignal.isConnected(&second));
+    EXPECT_EQ(3, second._doIt);
+}
+
+}
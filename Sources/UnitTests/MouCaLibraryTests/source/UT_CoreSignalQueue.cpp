@@ -0,0 +1,150 @@
+#include "Dependencies.h"
+
+#include "LibCore/include/CoreSignal.h"
+#include "LibCore/include/CoreSignalQueue.h"
+
+namespace Core
+{
+
+namespace
+{
+    struct Accumulator
+    {
+        void add(int number)
+        {
+            _values.emplace_back(number);
+        }
+
+        void resize(const std::string& name, int size)
+        {
+            _name = name;
+            _values.emplace_back(size);
+        }
+
+        std::vector<int> _values;
+        std::string      _name;
+    };
+}
+
+TEST(CoreSignalQueue, queued)
+{
+    SignalQueue queue(8);
+    EXPECT_EQ(8u, queue.getCapacity());
+
+    Signal<int> mySignal;
+    Accumulator receiver;
+    ASSERT_NO_THROW(mySignal.connectQueued<Accumulator>(queue, &receiver, &Accumulator::add));
+    EXPECT_TRUE(mySignal.isConnected(&receiver));
+
+    // Nothing is called before dispatch
+    for (int id = 0; id < 20; ++id)
+    {
+        mySignal.emit(id);
+    }
+    EXPECT_TRUE(receiver._values.empty());
+
+    // Ring buffer overflow keeps order
+    EXPECT_EQ(20u, queue.dispatch());
+    ASSERT_EQ(20u, receiver._values.size());
+    for (int id = 0; id < 20; ++id)
+    {
+        EXPECT_EQ(id, receiver._values[id]);
+    }
+    EXPECT_EQ(0u, queue.dispatch());
+
+    const auto statistics = queue.getStatistics();
+    EXPECT_EQ(20u, statistics._posted);
+    EXPECT_EQ(20u, statistics._dispatched);
+    EXPECT_EQ(12u, statistics._overflowed);
+    EXPECT_EQ(0u,  statistics._depth);
+    EXPECT_EQ(20u, statistics._maxDepth);
+    EXPECT_LE(statistics._averageLatency.count(), statistics._maxLatency.count());
+
+    // Pending events are cancelled by disconnection
+    mySignal.emit(100);
+    ASSERT_NO_THROW(mySignal.disconnect(&receiver));
+    EXPECT_EQ(1u, queue.dispatch());
+    EXPECT_EQ(20u, receiver._values.size());
+}
+
+TEST(CoreSignalQueue, coalesce)
+{
+    SignalQueue queue;
+
+    Signal<const std::string&, int> mySignal;
+    Accumulator receiver;
+    ASSERT_NO_THROW(mySignal.connectQueued<Accumulator>(queue, &receiver, &Accumulator::resize, true));
+
+    // Only latest arguments are sent (const reference is copied)
+    {
+        const std::string name("first");
+        mySignal.emit(name, 1);
+    }
+    mySignal.emit("second", 2);
+    mySignal.emit("third", 3);
+    EXPECT_EQ(1u, queue.getStatistics()._depth);
+    EXPECT_EQ(2u, queue.getStatistics()._coalesced);
+
+    EXPECT_EQ(1u, queue.dispatch());
+    ASSERT_EQ(1u, receiver._values.size());
+    EXPECT_EQ(3, receiver._values[0]);
+    EXPECT_EQ("third", receiver._name);
+
+    // New event after dispatch
+    mySignal.emit("fourth", 4);
+    EXPECT_EQ(1u, queue.dispatch());
+    EXPECT_EQ(4, receiver._values.back());
+
+    mySignal.disconnectAll();
+}
+
+TEST(CoreSignalQueue, multiThread)
+{
+    SignalQueue queue(64);
+
+    Signal<int> mySignal;
+    Accumulator receiver;
+    mySignal.connectQueued<Accumulator>(queue, &receiver, &Accumulator::add);
+
+    const int nbThreads = 4;
+    const int nbEvents  = 10000;
+    std::atomic<int> finished = 0;
+    std::vector<std::thread> producers;
+    for (int thread = 0; thread < nbThreads; ++thread)
+    {
+        producers.emplace_back([&, thread]()
+        {
+            for (int id = 0; id < nbEvents; ++id)
+            {
+                mySignal.emit(thread * nbEvents + id);
+            }
+            ++finished;
+        });
+    }
+
+    // Target thread drains during emission
+    while (finished < nbThreads)
+    {
+        queue.dispatch();
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    queue.dispatch();
+
+    // All events received once and each producer order is kept
+    ASSERT_EQ(static_cast<size_t>(nbThreads * nbEvents), receiver._values.size());
+    std::vector<int> last(nbThreads, -1);
+    for (const int value : receiver._values)
+    {
+        const int thread = value / nbEvents;
+        EXPECT_LE(last[thread] + 1, value % nbEvents);
+        last[thread] = value % nbEvents;
+    }
+    EXPECT_EQ(0u, queue.getStatistics()._depth);
+
+    mySignal.disconnectAll();
+}
+
+}
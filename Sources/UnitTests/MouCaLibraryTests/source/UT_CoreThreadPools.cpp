@@ -101,4 +101,107 @@ TEST(CoreThreadPools, addThread)
     }
 
     EXPECT_EQ(thread0->getModif(), thread0->_info);
-}
\ No newline at end of file
+}
+
+TEST(CoreThreadPools, taskGraph)
+{
+    Core::ThreadPools pools;
+    ASSERT_NO_THROW(pools.initializeWorkers(3));
+    EXPECT_EQ(3u, pools.getNbWorkers());
+
+    // Diamond: first -> (left, right) -> last
+    std::vector<int> order;
+    std::mutex lockOrder;
+    auto push = [&](const int value)
+    {
+        std::lock_guard<std::mutex> lock(lockOrder);
+        order.emplace_back(value);
+    };
+
+    auto first = pools.createTask([&]() { std::this_thread::sleep_for(3ms); push(0); });
+    auto left  = pools.createTask([&]() { push(1); }, Core::Task::Priority::High);
+    auto right = pools.createTask([&]() { push(2); }, Core::Task::Priority::Low);
+    auto last  = pools.createTask([&]() { push(3); });
+    ASSERT_NO_THROW(pools.addDependency(left, first));
+    ASSERT_NO_THROW(pools.addDependency(right, first));
+    ASSERT_NO_THROW(pools.addDependency(last, left));
+    ASSERT_NO_THROW(pools.addDependency(last, right));
+    auto continuation = pools.then(last, [&]() { push(4); });
+
+    ASSERT_NO_THROW(pools.submit(last));
+    ASSERT_NO_THROW(pools.submit(right));
+    ASSERT_NO_THROW(pools.submit(left));
+    EXPECT_FALSE(continuation->isFinished());
+    ASSERT_NO_THROW(pools.submit(first));
+
+    ASSERT_NO_THROW(pools.wait(continuation));
+    EXPECT_TRUE(last->isFinished());
+    // Left and right run concurrently on workers: only dependencies give order
+    ASSERT_EQ(5u, order.size());
+    EXPECT_EQ(0, order[0]);
+    EXPECT_EQ(std::vector<int>({ 1, 2 }), std::vector<int>({ std::min(order[1], order[2]), std::max(order[1], order[2]) }));
+    EXPECT_EQ(3, order[3]);
+    EXPECT_EQ(4, order[4]);
+
+    // Dependency already finished
+    auto after = pools.then(first, [&]() { push(5); });
+    ASSERT_NO_THROW(pools.wait(after));
+    EXPECT_EQ(5, order.back());
+
+    // Parallel for
+    std::vector<std::atomic<int>> counters(10000);
+    auto loop = pools.parallelFor(0, counters.size(), 0, [&](const size_t begin, const size_t end)
+    {
+        for (size_t id = begin; id < end; ++id)
+        {
+            ++counters[id];
+        }
+    });
+    ASSERT_NO_THROW(pools.wait(loop));
+    EXPECT_TRUE(std::all_of(counters.cbegin(), counters.cend(), [](const auto& counter) { return counter == 1; }));
+
+    // Error is given to continuation and to waiting thread
+    bool executed = false;
+    auto failed = pools.createTask([]() { throw std::runtime_error("Error"); });
+    auto next   = pools.then(failed, [&]() { executed = true; });
+    pools.submit(failed);
+    EXPECT_ANY_THROW(pools.wait(next));
+    EXPECT_FALSE(executed);
+
+    ASSERT_NO_THROW(pools.releaseWorkers());
+
+    // Without worker, waiting thread executes ready tasks by priority (submission order inside same priority)
+    Core::ThreadPools single;
+    order.clear();
+    auto low    = single.createTask([&]() { push(2); }, Core::Task::Priority::Low);
+    auto normal = single.createTask([&]() { push(1); });
+    auto high   = single.createTask([&]() { push(0); }, Core::Task::Priority::High);
+    auto high2  = single.createTask([&]() { push(3); }, Core::Task::Priority::High);
+    auto join   = single.createTask([]() {}, Core::Task::Priority::Low);
+    for (const auto& task : { low, normal, high, high2 })
+    {
+        ASSERT_NO_THROW(single.addDependency(join, task));
+        ASSERT_NO_THROW(single.submit(task));
+    }
+    ASSERT_NO_THROW(single.submit(join));
+    ASSERT_NO_THROW(single.wait(join));
+    EXPECT_EQ(std::vector<int>({ 0, 3, 1, 2 }), order);
+}
+
+TEST(CoreThreadPools, waitHelp)
+{
+    // Without worker, waiting thread executes all tasks
+    Core::ThreadPools pools;
+
+    std::atomic<size_t> sum = 0;
+    auto loop = pools.parallelFor(0, 1000, 10, [&](const size_t begin, const size_t end)
+    {
+        for (size_t id = begin; id < end; ++id)
+        {
+            sum += id;
+        }
+    });
+    auto result = pools.then(loop, [&]() { sum += 1; }, Core::Task::Priority::High);
+    ASSERT_NO_THROW(pools.wait(result));
+    EXPECT_EQ(999u * 1000u / 2u + 1u, sum.load());
+}
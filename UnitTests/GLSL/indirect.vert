@@ -0,0 +1,26 @@
+/// https://github.com/Rominitch/MouCaLab
+/// \author  Rominitch
+/// \license No license
+#version 450
+
+// Check of draws of Vulkan::MeshIndirect: each drawn instance writes its mesh into its slot.
+
+layout (location = 0) in vec3 inInstancePosition;
+layout (location = 1) in uint inMeshID;
+
+layout (std430, binding = 0) buffer Drawn
+{
+	uint drawn[];	// meshID + 1 by slot of visible instance (0: not drawn)
+};
+
+out gl_PerVertex
+{
+	vec4 gl_Position;
+};
+
+void main()
+{
+	drawn[gl_InstanceIndex] = inMeshID + 1;
+
+	gl_Position = vec4(inInstancePosition, 1.0);
+}